@@ -543,9 +543,36 @@ extern "C" {
      @brief
      @param detection A pointer to the relevant tPeriodDetection.
      @param tolerance
+     
+     @fn void    tPeriodDetection_setGate            (tPeriodDetection* const, Lfloat threshold)
+     @brief Skip the analysis while the input is quieter than a threshold, holding the last period. Off by default.
+     @param detection A pointer to the relevant tPeriodDetection.
+     @param threshold The RMS level below which frames aren't analysed, or 0 to analyse regardless of level.
+     
+     @fn void    tPeriodDetection_setMaxHop          (tPeriodDetection* const, int maxHop)
+     @brief Analyse fewer frames while the period is steady. The hop doubles after each analysis that agrees with the last one, up to maxHop frames, and goes back to every frame when the period moves or an onset is detected.
+     @param detection A pointer to the relevant tPeriodDetection.
+     @param maxHop The most frames per analysis. Defaults to 1, which analyses every frame.
      ￼￼￼
      @} */
     
+#define ANALYSIS_GATE_BLOCK 64
+    
+    // Silence gate and adaptive hop, shared by tPeriodDetection and tPeriodDetector
+    typedef struct _analysis_gate
+    {
+        tPowerFollower* power;
+        tAttackDetection* onset;
+        Lfloat threshold;   // input power below which analysis is skipped, 0 when off
+        int maxHop;         // most frames per analysis while the estimate is steady
+        int hop;            // current frames per analysis
+        int count;          // frames since the last analysis
+        int attack;         // onset seen since the last analysis
+        Lfloat last;        // period from the last analysis
+        int blockIndex;
+        Lfloat block[ANALYSIS_GATE_BLOCK];
+    } _analysis_gate;
+    
 #define DEFPITCHRATIO 1.0f
 #define DEFTIMECONSTANT 100.0f
 #define DEFHOPSIZE 64
@@ -589,6 +616,8 @@ extern "C" {
         Lfloat tolerance;
         
         Lfloat invSampleRate;
+        
+        _analysis_gate gate;
     } tPeriodDetection;
 
     void    tPeriodDetection_init                 (tPeriodDetection** const, Lfloat* in, int bufSize, int frameSize, LEAF* const leaf);
@@ -605,6 +634,8 @@ extern "C" {
     void    tPeriodDetection_setAlpha             (tPeriodDetection* const, Lfloat alpha);
     void    tPeriodDetection_setTolerance         (tPeriodDetection* const, Lfloat tolerance);
     void    tPeriodDetection_setSampleRate        (tPeriodDetection* const, Lfloat sr);
+    void    tPeriodDetection_setGate              (tPeriodDetection* const, Lfloat threshold);
+    void    tPeriodDetection_setMaxHop            (tPeriodDetection* const, int maxHop);
     
     //==============================================================================
     
@@ -709,6 +740,7 @@ extern "C" {
         
         tBitset* _bitset;
         unsigned int _mid_array;
+        const LEAFKernels* kernels;
     } tBACF;
 
     void    tBACF_init           (tBACF** const bacf, tBitset** const bitset, LEAF* const leaf);
@@ -773,6 +805,16 @@ extern "C" {
      @param detector A pointer to the relevant tPeriodDetector.
      @param hysteresis The hysteresis in decibels. Defaults to -40db.
      
+     @fn void    tPeriodDetector_setGate    (tPeriodDetector* const detector, Lfloat threshold)
+     @brief Skip the autocorrelation while the input is quieter than a threshold. Gated windows report no period. Off by default.
+     @param detector A pointer to the relevant tPeriodDetector.
+     @param threshold The RMS level below which windows aren't analysed, or 0 to analyse regardless of level.
+     
+     @fn void    tPeriodDetector_setMaxHop    (tPeriodDetector* const detector, int maxHop)
+     @brief Analyse fewer windows while the period is steady. The hop doubles after each analysis that agrees with the last one, up to maxHop windows, and goes back to every window when the period moves or an onset is detected.
+     @param detector A pointer to the relevant tPeriodDetector.
+     @param maxHop The most windows per analysis. Defaults to 1, which analyses every window.
+     
      @} */
     
 #define PULSE_THRESHOLD 0.6f
@@ -834,6 +876,8 @@ extern "C" {
         
         tBACF*                   _bacf;
         
+        _analysis_gate          _gate;
+        
     } tPeriodDetector;
 
     void    tPeriodDetector_init    (tPeriodDetector** const detector, Lfloat lowestFreq, Lfloat highestFreq, Lfloat hysteresis, LEAF* const leaf);
@@ -851,6 +895,8 @@ extern "C" {
     int     tPeriodDetector_isReset        (tPeriodDetector* const detector);
     void    tPeriodDetector_setHysteresis  (tPeriodDetector* const detector, Lfloat hysteresis);
     void    tPeriodDetector_setSampleRate  (tPeriodDetector* const detector, Lfloat sr);
+    void    tPeriodDetector_setGate        (tPeriodDetector* const detector, Lfloat threshold);
+    void    tPeriodDetector_setMaxHop      (tPeriodDetector* const detector, int maxHop);
     
     //==============================================================================
     
@@ -905,6 +951,16 @@ extern "C" {
      @brief Set the hysteresis used in zero crossing detection.
      @param detector A pointer to the relevant tPitchDetector.
      @param hysteresis The hysteresis in decibels. Defaults to -40db.
+     
+     @fn void    tPitchDetector_setGate    (tPitchDetector* const detector, Lfloat threshold)
+     @brief Skip the analysis while the input is quieter than a threshold. The pitch becomes indeterminate while gated. Off by default.
+     @param detector A pointer to the relevant tPitchDetector.
+     @param threshold The RMS level below which the input isn't analysed, or 0 to analyse regardless of level.
+     
+     @fn void    tPitchDetector_setMaxHop    (tPitchDetector* const detector, int maxHop)
+     @brief Analyse less often while the pitch is steady. See tPeriodDetector_setMaxHop.
+     @param detector A pointer to the relevant tPitchDetector.
+     @param maxHop The most analysis windows per estimate. Defaults to 1.
      ￼￼￼
      @} */
     
@@ -945,6 +1001,8 @@ extern "C" {
     
     void    tPitchDetector_setHysteresis     (tPitchDetector* const detector, Lfloat hysteresis);
     void    tPitchDetector_setSampleRate     (tPitchDetector* const detector, Lfloat sr);
+    void    tPitchDetector_setGate           (tPitchDetector* const detector, Lfloat threshold);
+    void    tPitchDetector_setMaxHop         (tPitchDetector* const detector, int maxHop);
     
     //==============================================================================
     
@@ -952,6 +1010,7 @@ extern "C" {
      @defgroup tdualpitchdetector tDualPitchDetector
      @ingroup analysis
      @brief Combined pitch detection algorithm using both Joel de Guzman's Q Audio DSP Library and Katya Vetters algorithms
+     @details In the default mode all of the analysis runs inside tDualPitchDetector_tick, so the sample that completes a frame pays for the whole autocorrelation. With tDualPitchDetector_setAsync the audio thread only pushes samples into a lock-free tSPSCRingBuffer, and the analysis runs in tDualPitchDetector_process on another thread. Each estimate is published as separate 32-bit atomics under a sequence count, and tDualPitchDetector_tick copies the newest complete one for the getters, so they never mix values from two estimates. The estimate runs a few milliseconds behind the input. With LEAF_USE_THREADS the detector starts its own analysis thread; otherwise call tDualPitchDetector_process from a thread of your own.
      @{
      
      @fn void tDualPitchDetector_init(tDualPitchDetector** const detector, Lfloat lowestFreq, Lfloat highestFreq, Lfloat* inBuffer, int bufSize, LEAF* const leaf)
@@ -1011,6 +1070,25 @@ extern "C" {
      @brief Set the threshold for periodicity of a signal to be considered as pitched.
      @param detector A pointer to the relevant tDualPitchDetector.
      @param threshold The periodicity threshold from 0.0 to 1.0 with 1.0 being perfectly periodic.
+     
+     @fn void    tDualPitchDetector_setGate (tDualPitchDetector* const detector, Lfloat threshold)
+     @brief Skip the analysis in both detectors while the input is quieter than a threshold, holding the last estimate. Off by default.
+     @param detector A pointer to the relevant tDualPitchDetector.
+     @param threshold The RMS level below which the input isn't analysed, or 0 to analyse regardless of level.
+     
+     @fn void    tDualPitchDetector_setMaxHop (tDualPitchDetector* const detector, int maxHop)
+     @brief Analyse less often in both detectors while the pitch is steady, going back to full rate on onsets. See tPeriodDetector_setMaxHop.
+     @param detector A pointer to the relevant tDualPitchDetector.
+     @param maxHop The most analysis frames per estimate. Defaults to 1.
+     
+     @fn void    tDualPitchDetector_setAsync (tDualPitchDetector* const detector, int async)
+     @brief Move the analysis off the audio thread, or back onto it. Call while the detector isn't being ticked. While async is on, only change the other settings from the thread that runs the analysis.
+     @param detector A pointer to the relevant tDualPitchDetector.
+     @param async 1 to run the analysis in tDualPitchDetector_process, 0 to run it in tDualPitchDetector_tick.
+     
+     @fn void    tDualPitchDetector_process (tDualPitchDetector* const detector)
+     @brief Analyse the samples pushed since the last call and publish any new estimate. Only for async mode, and never from the audio thread. Not needed with LEAF_USE_THREADS, where the detector's own thread calls it.
+     @param detector A pointer to the relevant tDualPitchDetector.
      ￼￼￼
      @} */
 
@@ -1029,6 +1107,22 @@ extern "C" {
         Lfloat thresh;
         
         Lfloat sampleRate;
+        
+        // Async mode: samples go through feed, estimates come back through the atomic fields.
+        // estimateCount works as a sequence lock: it's odd while process is publishing.
+        int async;
+        tSPSCRingBuffer* feed;
+        uint32_t frequency;         // frequency bits
+        uint32_t periodicity;       // periodicity bits
+        uint32_t predicted;         // predicted frequency bits
+        uint32_t estimateCount;     // twice the estimates published so far, plus one while publishing
+        uint32_t estimateSeen;      // estimateCount of the latest snapshot
+        _pitch_info latest;         // snapshot taken by tick, returned by the getters
+        Lfloat latestPredicted;
+#if LEAF_USE_THREADS
+        pthread_t thread;
+        int running;
+#endif
 
     } tDualPitchDetector;
 
@@ -1046,6 +1140,10 @@ extern "C" {
     void    tDualPitchDetector_setHysteresis           (tDualPitchDetector* const detector, Lfloat hysteresis);
     void    tDualPitchDetector_setPeriodicityThreshold (tDualPitchDetector* const detector, Lfloat thresh);
     void    tDualPitchDetector_setSampleRate           (tDualPitchDetector* const detector, Lfloat sr);
+    void    tDualPitchDetector_setGate                 (tDualPitchDetector* const detector, Lfloat threshold);
+    void    tDualPitchDetector_setMaxHop               (tDualPitchDetector* const detector, int maxHop);
+    void    tDualPitchDetector_setAsync                (tDualPitchDetector* const detector, int async);
+    void    tDualPitchDetector_process                 (tDualPitchDetector* const detector);
     
 #ifdef __cplusplus
 }
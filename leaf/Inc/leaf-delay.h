@@ -17,6 +17,7 @@ extern "C" {
     
 #include "leaf-math.h"
 #include "leaf-mempool.h"
+#include "leaf-parallel.h"
     
     /*!
      * @internal
@@ -91,6 +92,18 @@ extern "C" {
      @param input
      @return
      
+     @fn void        tDelay_writeBlock   (tDelay* const, const Lfloat* input, int numSamples)
+     @brief Write a block of samples into the delay line, scaled by the gain, as at most two contiguous copies. Together with tDelay_readBlock this gives the same output as ticking sample by sample, as long as numSamples is no more than the max delay length minus the delay.
+     @param delay A pointer to the relevant tDelay.
+     @param input The samples to write.
+     @param numSamples The number of samples to write. Cannot be greater than the max delay length.
+     
+     @fn void        tDelay_readBlock    (tDelay* const, Lfloat* output, int numSamples)
+     @brief Read the next block of delayed samples as at most two contiguous copies.
+     @param delay A pointer to the relevant tDelay.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to read. Cannot be greater than the max delay length.
+     
      @fn Lfloat       tDelay_getLastOut   (tDelay* const)
      @brief
      @param delay A pointer to the relevant tDelay.
@@ -115,6 +128,7 @@ extern "C" {
         uint32_t inPoint, outPoint;
         
         uint32_t delay, maxDelay;
+        uint32_t bufferMask;
         
     } tDelay;
 
@@ -123,6 +137,8 @@ extern "C" {
     void        tDelay_free         (tDelay** const);
 
     Lfloat      tDelay_tick         (tDelay* const, Lfloat sample);
+    void        tDelay_writeBlock   (tDelay* const, const Lfloat* input, int numSamples);
+    void        tDelay_readBlock    (tDelay* const, Lfloat* output, int numSamples);
 
     void        tDelay_clear        (tDelay* const);
     void        tDelay_setDelay     (tDelay* const, uint32_t delay);
@@ -208,6 +224,18 @@ extern "C" {
      @param delay A pointer to the relevant tLinearDelay.
      @return
      
+     @fn void    tLinearDelay_writeBlock  (tLinearDelay* const, const Lfloat* input, int numSamples)
+     @brief Write a block of samples into the delay line, scaled by the gain, as at most two contiguous copies. Same as calling tLinearDelay_tickIn on each sample.
+     @param delay A pointer to the relevant tLinearDelay.
+     @param input The samples to write.
+     @param numSamples The number of samples to write. Cannot be greater than the max delay length.
+     
+     @fn void    tLinearDelay_readBlock   (tLinearDelay* const, Lfloat* output, int numSamples)
+     @brief Read the next block of interpolated samples. Same as calling tLinearDelay_tickOut numSamples times, with the wraparound checks done once per span instead of every sample.
+     @param delay A pointer to the relevant tLinearDelay.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to read.
+     
      @fn Lfloat   tLinearDelay_getLastOut  (tLinearDelay* const)
      @brief
      @param delay A pointer to the relevant tLinearDelay.
@@ -232,6 +260,7 @@ extern "C" {
         uint32_t inPoint, outPoint;
         
         uint32_t maxDelay;
+        uint32_t bufferMask;
         
         Lfloat delay;
         
@@ -246,6 +275,8 @@ extern "C" {
     Lfloat  tLinearDelay_tick               (tLinearDelay* const, Lfloat sample);
     void    tLinearDelay_tickIn             (tLinearDelay* const, Lfloat input);
     Lfloat  tLinearDelay_tickOut            (tLinearDelay* const);
+    void    tLinearDelay_writeBlock         (tLinearDelay* const, const Lfloat* input, int numSamples);
+    void    tLinearDelay_readBlock          (tLinearDelay* const, Lfloat* output, int numSamples);
 
     void    tLinearDelay_clear              (tLinearDelay* const dl);
     void    tLinearDelay_setDelay           (tLinearDelay* const, Lfloat delay);
@@ -305,6 +336,18 @@ extern "C" {
      @param delay A pointer to the relevant tHermiteDelay.
      @return
      
+     @fn void       tHermiteDelay_writeBlock     (tHermiteDelay* const dl, const Lfloat* input, int numSamples)
+     @brief Write a block of samples into the delay line, scaled by the gain, as at most two contiguous copies.
+     @param delay A pointer to the relevant tHermiteDelay.
+     @param input The samples to write.
+     @param numSamples The number of samples to write. Cannot be greater than the max delay length.
+     
+     @fn void       tHermiteDelay_readBlock      (tHermiteDelay* const dl, Lfloat* output, int numSamples)
+     @brief Read the next block of interpolated samples. Same as calling tHermiteDelay_tickOut numSamples times, with the taps only masked near the ends of the buffer.
+     @param delay A pointer to the relevant tHermiteDelay.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to read.
+     
      @fn void    tHermiteDelay_setDelay         (tHermiteDelay* const dl, Lfloat delay)
      @brief
      @param delay A pointer to the relevant tHermiteDelay.
@@ -387,6 +430,8 @@ extern "C" {
     Lfloat  tHermiteDelay_tick               (tHermiteDelay* const dl, Lfloat input);
     void    tHermiteDelay_tickIn             (tHermiteDelay* const dl, Lfloat input);
     Lfloat  tHermiteDelay_tickOut            (tHermiteDelay* const dl);
+    void    tHermiteDelay_writeBlock         (tHermiteDelay* const dl, const Lfloat* input, int numSamples);
+    void    tHermiteDelay_readBlock          (tHermiteDelay* const dl, Lfloat* output, int numSamples);
 
     void    tHermiteDelay_clear              (tHermiteDelay* const dl);
     void    tHermiteDelay_setDelay           (tHermiteDelay* const dl, Lfloat delay);
@@ -768,6 +813,154 @@ extern "C" {
     
     //==============================================================================
     
+    /*!
+     @defgroup tmultitapdelay tMultiTapDelay
+     @ingroup delay
+     @brief Hermite-interpolating delay with many taps over one shared buffer, for chorus, ensemble and early reflection effects.
+     @details All taps are read in one pass. The interpolation weights of every tap are worked out together in a loop the compiler can vectorize, and only when a delay, depth or modulation value has changed. In tMultiTapDelay_tickBlock a tap that isn't modulated sample by sample keeps the same weights for the whole block, so its inner loop is a straight run over the buffer. Each tap has a delay, a gain and a modulation depth. The delay actually used is the delay plus the depth times a modulation value in [-1, 1], clamped to [1, maxDelay].
+     @{
+     
+     @fn void    tMultiTapDelay_init(tMultiTapDelay** const, int maxTaps, uint32_t maxDelay, LEAF* const leaf)
+     @brief Initialize a tMultiTapDelay to the default mempool of a LEAF instance.
+     @param delay A pointer to the tMultiTapDelay to initialize.
+     @param maxTaps The maximum number of taps.
+     @param maxDelay The maximum tap delay in samples.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tMultiTapDelay_initToPool(tMultiTapDelay** const, int maxTaps, uint32_t maxDelay, tMempool** const)
+     @brief Initialize a tMultiTapDelay to a specified mempool.
+     @param delay A pointer to the tMultiTapDelay to initialize.
+     @param maxTaps The maximum number of taps.
+     @param maxDelay The maximum tap delay in samples.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tMultiTapDelay_free(tMultiTapDelay** const)
+     @brief Free a tMultiTapDelay from its mempool.
+     @param delay A pointer to the tMultiTapDelay to free.
+     
+     @fn Lfloat  tMultiTapDelay_tick(tMultiTapDelay* const, Lfloat input)
+     @brief Write a sample and read every tap, using the modulation values last set with tMultiTapDelay_setModulation.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param input The input sample.
+     @return The sum of the taps times their gains.
+     
+     @fn void    tMultiTapDelay_tickBlock(tMultiTapDelay* const, const Lfloat* input, Lfloat* output, const Lfloat* const* mod, int numSamples)
+     @brief Process a block of samples. Gives the same output as ticking sample by sample, as long as numSamples is no more than maxDelay minus the longest modulated tap delay.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param input The input samples.
+     @param output The buffer to fill with the sum of the taps times their gains.
+     @param mod An array of numTaps modulation buffers of numSamples values each. NULL, or a NULL entry, holds the modulation values last set with tMultiTapDelay_setModulation for the block. A tap given a buffer keeps its last value afterwards.
+     @param numSamples The number of samples to process.
+     
+     @fn void    tMultiTapDelay_setModulation(tMultiTapDelay* const, const Lfloat* mod)
+     @brief Set the modulation value of every tap.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param mod An array of numTaps values in [-1, 1].
+     
+     @fn void    tMultiTapDelay_setNumTaps(tMultiTapDelay* const, int numTaps)
+     @brief Set the number of taps in use.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param numTaps The number of taps, up to the maximum given on initialization.
+     
+     @fn int     tMultiTapDelay_getNumTaps(tMultiTapDelay* const)
+     @brief Get the number of taps in use.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @return The number of taps.
+     
+     @fn void    tMultiTapDelay_setTapDelay(tMultiTapDelay* const, int tap, Lfloat delay)
+     @brief Set the delay of a tap.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param tap The index of the tap.
+     @param delay The delay in samples, in [1, maxDelay].
+     
+     @fn Lfloat  tMultiTapDelay_getTapDelay(tMultiTapDelay* const, int tap)
+     @brief Get the delay of a tap.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param tap The index of the tap.
+     @return The delay in samples.
+     
+     @fn void    tMultiTapDelay_setTapGain(tMultiTapDelay* const, int tap, Lfloat gain)
+     @brief Set the gain a tap is mixed into the output with.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param tap The index of the tap.
+     @param gain The gain.
+     
+     @fn void    tMultiTapDelay_setTapModDepth(tMultiTapDelay* const, int tap, Lfloat depth)
+     @brief Set how far the modulation moves a tap.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param tap The index of the tap.
+     @param depth The modulation depth in samples. 0 turns modulation off for the tap.
+     
+     @fn Lfloat  tMultiTapDelay_getTapOut(tMultiTapDelay* const, int tap)
+     @brief Get the last output of a tap, before its gain.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @param tap The index of the tap.
+     @return The last output of the tap.
+     
+     @fn void    tMultiTapDelay_clear(tMultiTapDelay* const)
+     @brief Clear the delay buffer.
+     @param delay A pointer to the relevant tMultiTapDelay.
+     
+     @fn Lfloat  tMultiTapDelay_getLastOut(tMultiTapDelay* const)
+     @brief
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @return The last output.
+     
+     @fn Lfloat  tMultiTapDelay_getLastIn(tMultiTapDelay* const)
+     @brief
+     @param delay A pointer to the relevant tMultiTapDelay.
+     @return The last input.
+     ￼￼￼
+     @} */
+    
+    typedef struct tMultiTapDelay
+    {
+        tMempool* mempool;
+        
+        Lfloat* buff;
+        uint32_t bufferMask;
+        uint32_t inPoint;
+        uint32_t maxDelay;
+        
+        Lfloat lastOut, lastIn;
+        
+        int maxTaps, numTaps;
+        
+        // Per-tap parameters, one array per parameter
+        Lfloat* delays;
+        Lfloat* gains;
+        Lfloat* modDepths;
+        Lfloat* mods;
+        Lfloat* tapOuts;
+        
+        // Read points and interpolation weights of each tap, worked out again when dirty is set
+        uint32_t* idx;
+        Lfloat* weights;
+        int dirty;
+        
+    } tMultiTapDelay;
+    
+    void    tMultiTapDelay_init             (tMultiTapDelay** const, int maxTaps, uint32_t maxDelay, LEAF* const leaf);
+    void    tMultiTapDelay_initToPool       (tMultiTapDelay** const, int maxTaps, uint32_t maxDelay, tMempool** const);
+    void    tMultiTapDelay_free             (tMultiTapDelay** const);
+    
+    Lfloat  tMultiTapDelay_tick             (tMultiTapDelay* const, Lfloat input);
+    void    tMultiTapDelay_tickBlock        (tMultiTapDelay* const, const Lfloat* input, Lfloat* output, const Lfloat* const* mod, int numSamples);
+    
+    void    tMultiTapDelay_setModulation    (tMultiTapDelay* const, const Lfloat* mod);
+    void    tMultiTapDelay_setNumTaps       (tMultiTapDelay* const, int numTaps);
+    int     tMultiTapDelay_getNumTaps       (tMultiTapDelay* const);
+    void    tMultiTapDelay_setTapDelay      (tMultiTapDelay* const, int tap, Lfloat delay);
+    Lfloat  tMultiTapDelay_getTapDelay      (tMultiTapDelay* const, int tap);
+    void    tMultiTapDelay_setTapGain       (tMultiTapDelay* const, int tap, Lfloat gain);
+    void    tMultiTapDelay_setTapModDepth   (tMultiTapDelay* const, int tap, Lfloat depth);
+    Lfloat  tMultiTapDelay_getTapOut        (tMultiTapDelay* const, int tap);
+    void    tMultiTapDelay_clear            (tMultiTapDelay* const);
+    Lfloat  tMultiTapDelay_getLastOut       (tMultiTapDelay* const);
+    Lfloat  tMultiTapDelay_getLastIn        (tMultiTapDelay* const);
+    
+    //==============================================================================
+    
     /*!
      @defgroup tringbuffer tRingBuffer
      @ingroup delay
@@ -838,6 +1031,94 @@ extern "C" {
     Lfloat  tRingBuffer_get        (tRingBuffer* const ring, int index);
     int     tRingBuffer_getSize    (tRingBuffer* const ring);
     
+    //==============================================================================
+    
+    /*!
+     @defgroup tspscringbuffer tSPSCRingBuffer
+     @ingroup delay
+     @brief Lock-free ring buffer for passing audio from one producer thread to one consumer thread.
+     @details Meant for feeding audio from the audio thread to an analysis or metering thread. Only the producer calls tSPSCRingBuffer_push and only the consumer calls tSPSCRingBuffer_pop and tSPSCRingBuffer_readLatest. Neither side ever waits for the other. Each call moves a block with at most two copies and one atomic store. When the buffer is full, push drops the samples that don't fit rather than overwrite ones the consumer hasn't read. The read and write counts are shared with acquire and release atomics in every build (GCC and Clang), so it works between any two threads, including ones the host starts without LEAF_USE_THREADS.
+     @{
+     
+     @fn void    tSPSCRingBuffer_init(tSPSCRingBuffer** const ring, int size, LEAF* const leaf)
+     @brief Initialize a tSPSCRingBuffer to the default mempool of a LEAF instance.
+     @param buffer A pointer to the tSPSCRingBuffer to initialize.
+     @param size Size of the buffer in samples. Will be rounded up to a power of 2.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tSPSCRingBuffer_initToPool(tSPSCRingBuffer** const ring, int size, tMempool** const mempool)
+     @brief Initialize a tSPSCRingBuffer to a specified mempool.
+     @param buffer A pointer to the tSPSCRingBuffer to initialize.
+     @param size Size of the buffer in samples. Will be rounded up to a power of 2.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tSPSCRingBuffer_free(tSPSCRingBuffer** const ring)
+     @brief Free a tSPSCRingBuffer from its mempool. Neither thread can be using it.
+     @param buffer A pointer to the tSPSCRingBuffer to free.
+     
+     @fn int     tSPSCRingBuffer_push(tSPSCRingBuffer* const ring, const Lfloat* input, int numSamples)
+     @brief Write a block of samples. Producer only.
+     @param buffer A pointer to the relevant tSPSCRingBuffer.
+     @param input The samples to write.
+     @param numSamples The number of samples to write.
+     @return The number of samples written, less than numSamples if the buffer was full.
+     
+     @fn int     tSPSCRingBuffer_pop(tSPSCRingBuffer* const ring, Lfloat* output, int numSamples)
+     @brief Read and remove the oldest samples. Consumer only.
+     @param buffer A pointer to the relevant tSPSCRingBuffer.
+     @param output The buffer to fill.
+     @param numSamples The most samples to read.
+     @return The number of samples read.
+     
+     @fn int     tSPSCRingBuffer_readLatest(tSPSCRingBuffer* const ring, Lfloat* output, int numSamples)
+     @brief Read the newest samples and discard everything older, so the consumer catches up with the producer. Consumer only.
+     @param buffer A pointer to the relevant tSPSCRingBuffer.
+     @param output The buffer to fill, oldest sample first.
+     @param numSamples The most samples to read.
+     @return The number of samples read, less than numSamples if fewer were waiting.
+     
+     @fn int     tSPSCRingBuffer_getNumReady(tSPSCRingBuffer* const ring)
+     @brief Get the number of samples waiting to be read.
+     @param buffer A pointer to the relevant tSPSCRingBuffer.
+     @return The number of samples waiting.
+     
+     @fn int     tSPSCRingBuffer_getSpace(tSPSCRingBuffer* const ring)
+     @brief Get the number of samples that can be pushed without dropping any.
+     @param buffer A pointer to the relevant tSPSCRingBuffer.
+     @return The free space in samples.
+     
+     @fn int     tSPSCRingBuffer_getSize(tSPSCRingBuffer* const ring)
+     @brief Get the size of the ring buffer.
+     @param buffer A pointer to the relevant tSPSCRingBuffer.
+     @return The size of the buffer.
+     ￼￼￼
+     @} */
+    typedef struct tSPSCRingBuffer
+    {
+        tMempool* mempool;
+        
+        Lfloat* buffer;
+        uint32_t size;
+        uint32_t mask;
+        
+        // Free-running counts of samples written and read, each only stored by one side.
+        // Aligned so the two sides don't share a cache line. The pool doesn't align the struct
+        // itself to 64 bytes, but the counts still always end up 64 bytes apart.
+        LEAF_ALIGNED(64) uint32_t writeCount;
+        LEAF_ALIGNED(64) uint32_t readCount;
+    } tSPSCRingBuffer;
+    
+    void    tSPSCRingBuffer_init        (tSPSCRingBuffer** const ring, int size, LEAF* const leaf);
+    void    tSPSCRingBuffer_initToPool  (tSPSCRingBuffer** const ring, int size, tMempool** const mempool);
+    void    tSPSCRingBuffer_free        (tSPSCRingBuffer** const ring);
+    
+    int     tSPSCRingBuffer_push        (tSPSCRingBuffer* const ring, const Lfloat* input, int numSamples);
+    int     tSPSCRingBuffer_pop         (tSPSCRingBuffer* const ring, Lfloat* output, int numSamples);
+    int     tSPSCRingBuffer_readLatest  (tSPSCRingBuffer* const ring, Lfloat* output, int numSamples);
+    int     tSPSCRingBuffer_getNumReady (tSPSCRingBuffer* const ring);
+    int     tSPSCRingBuffer_getSpace    (tSPSCRingBuffer* const ring);
+    int     tSPSCRingBuffer_getSize     (tSPSCRingBuffer* const ring);
+    
 #ifdef __cplusplus
 }
 #endif
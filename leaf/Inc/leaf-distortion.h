@@ -128,10 +128,12 @@ extern "C" {
         uint32_t ratio;
         uint32_t offset;
         Lfloat* pCoeffs;
+        Lfloat* upCoeffs;
         Lfloat* upState;
         Lfloat* downState;
         uint32_t numTaps;
         uint32_t phaseLength;
+        const LEAFKernels* kernels;
     } tOversampler;
 
     void    tOversampler_init           (tOversampler** const, int order, int extraQuality, LEAF* const leaf);
@@ -170,14 +172,30 @@ extern "C" {
  @fn Lfloat   tWavefolder_tick    (tWavefolder* const, Lfloat samp)
  @brief
  @param wavefolder A pointer to the relevant tWavefolder.
+ 
+ @fn void    tWavefolder_setADAAOrder (tWavefolder* const, int order)
+ @brief Set the order of antiderivative anti-aliasing applied to the feedforward fold and saturation. 0 (the default) is the plain waveshaper, 1 and 2 suppress aliasing enough to run at 1x or 2x instead of inside a 4-16x tOversampler. Order 1 adds half a sample of latency and order 2 adds one sample. The feedback path is not anti-aliased.
+ @param wavefolder A pointer to the relevant tWavefolder.
+ @param order 0, 1 or 2.
  ￼￼￼
  @} */
 
+// Running state for antiderivative anti-aliasing (ADAA). Kept in double because the
+// second-order form divides differences of antiderivatives by small input steps.
+typedef struct ADAAState
+{
+    double x1, x2;
+    double F1x1, F2x1;
+    double D1;
+} ADAAState;
+
 typedef struct tWavefolder
 {
 
     tMempool* mempool;
     
+    int adaaOrder;
+    ADAAState adaa;
     Lfloat FBsample;
     Lfloat gain;
     Lfloat offset;
@@ -199,6 +217,7 @@ void    tWavefolder_setFBAmount  (tWavefolder* const wf, Lfloat fbAmount);
 void    tWavefolder_setFoldDepth (tWavefolder* const wf, Lfloat foldDepth);
 void    tWavefolder_setOffset    (tWavefolder* const wf, Lfloat offset);
 void    tWavefolder_setGain      (tWavefolder* const wf, Lfloat gain);
+void    tWavefolder_setADAAOrder (tWavefolder* const wf, int order);
 
 
 //==============================================================================
@@ -344,6 +363,78 @@ void    tWavefolder_setGain      (tWavefolder* const wf, Lfloat gain);
     
     //==============================================================================
     
+    /*!
+     @defgroup tadaashaper tADAAShaper
+     @ingroup distortion
+     @brief Static waveshaper with first- or second-order antiderivative anti-aliasing.
+     @details Instead of evaluating the shape at each sample, ADAA outputs the average of the shape over the line between consecutive inputs, computed from closed-form antiderivatives. This removes most of the aliasing that would otherwise need a tOversampler running at 4-16x. For a hard clip driven by 12 dB at 1.2 kHz, order 2 at 1x has about as much aliasing as the plain curve at 2x. Inside a 2x tOversampler, order 1 beats the plain curve at 4x and order 2 beats it at 8x. Order 1 adds half a sample of latency and order 2 adds one sample. The shapes are the same curves as LEAF_tanh, leaf_softClip and LEAF_clip(-1, x, 1).
+     @{
+     
+     @fn void    tADAAShaper_init(tADAAShaper** const, ADAAShape shape, int order, LEAF* const leaf)
+     @brief Initialize a tADAAShaper to the default mempool of a LEAF instance.
+     @param shaper A pointer to the tADAAShaper to initialize.
+     @param shape The curve to apply. ADAATanh, ADAASoftClip or ADAAHardClip. Out of range values are clamped to the nearest of these.
+     @param order The anti-aliasing order. 0 applies the plain curve, 1 or 2 apply ADAA.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tADAAShaper_initToPool(tADAAShaper** const, ADAAShape shape, int order, tMempool** const)
+     @brief Initialize a tADAAShaper to a specified mempool.
+     @param shaper A pointer to the tADAAShaper to initialize.
+     @param shape The curve to apply. ADAATanh, ADAASoftClip or ADAAHardClip. Out of range values are clamped to the nearest of these.
+     @param order The anti-aliasing order. 0 applies the plain curve, 1 or 2 apply ADAA.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tADAAShaper_free(tADAAShaper** const)
+     @brief Free a tADAAShaper from its mempool.
+     @param shaper A pointer to the tADAAShaper to free.
+     
+     @fn Lfloat   tADAAShaper_tick    (tADAAShaper* const, Lfloat input)
+     @brief Shape one sample. Scale the input beforehand to set the drive.
+     @param shaper A pointer to the relevant tADAAShaper.
+     @param input The input sample.
+     @return The shaped sample.
+     
+     @fn void    tADAAShaper_setShape (tADAAShaper* const, ADAAShape shape)
+     @brief Change the curve. This resets the anti-aliasing state.
+     @param shaper A pointer to the relevant tADAAShaper.
+     @param shape ADAATanh, ADAASoftClip or ADAAHardClip. Out of range values are clamped to the nearest of these.
+     
+     @fn void    tADAAShaper_setOrder (tADAAShaper* const, int order)
+     @brief Change the anti-aliasing order. This resets the anti-aliasing state.
+     @param shaper A pointer to the relevant tADAAShaper.
+     @param order 0, 1 or 2.
+     @} */
+    
+    typedef enum ADAAShape
+    {
+        ADAATanh = 0,
+        ADAASoftClip,
+        ADAAHardClip,
+        ADAAShapeNil
+    } ADAAShape;
+    
+    typedef struct tADAAShaper
+    {
+        
+        tMempool* mempool;
+        
+        ADAAShape shape;
+        int order;
+        ADAAState adaa;
+        
+    } tADAAShaper;
+    
+    void    tADAAShaper_init          (tADAAShaper** const, ADAAShape shape, int order, LEAF* const leaf);
+    void    tADAAShaper_initToPool    (tADAAShaper** const, ADAAShape shape, int order, tMempool** const);
+    void    tADAAShaper_free          (tADAAShaper** const);
+    
+    Lfloat  tADAAShaper_tick          (tADAAShaper* const, Lfloat input);
+    
+    void    tADAAShaper_setShape      (tADAAShaper* const, ADAAShape shape);
+    void    tADAAShaper_setOrder      (tADAAShaper* const, int order);
+    
+    //==============================================================================
+    
 #ifdef __cplusplus
 }
 #endif
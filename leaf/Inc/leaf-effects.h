@@ -293,6 +293,11 @@ extern "C" {
      @brief
      @param vocoder A pointer to the relevant tVocoder.
      
+     @fn void    tVocoder_setCoeffMode   (tVocoder* const, LEAFCoeffMode mode)
+     @brief Set when tVocoder_update does its work. In LEAFCoeffsLazy (or LEAFCoeffsInterpolated, which the vocoder treats the same) tVocoder_update only marks the coefficients stale and the next tick recomputes them once, however many times it was called in between. The band filters are only recomputed when the filter q, frequency range, number of bands or sample rate changed.
+     @param vocoder A pointer to the relevant tVocoder.
+     @param mode The LEAFCoeffMode to use.
+     
      @} */
     
 #define NUM_VOCODER_PARAM 8
@@ -315,6 +320,10 @@ extern "C" {
         Lfloat f[NBANDS][13]; //[0-8][0 1 2 | 0 1 2 3 | 0 1 2 3 | val rate]
         
         Lfloat invSampleRate;
+        
+        LEAFCoeffMode coeffMode;
+        int dirty;
+        Lfloat bandParams[4]; // what the band filters were last computed for
     } tVocoder;
 
     void    tVocoder_init           (tVocoder** const, LEAF* const leaf);
@@ -326,6 +335,7 @@ extern "C" {
     void    tVocoder_update         (tVocoder* const);
     void    tVocoder_suspend        (tVocoder* const);
     void    tVocoder_setSampleRate  (tVocoder* const, Lfloat sr);
+    void    tVocoder_setCoeffMode   (tVocoder* const, LEAFCoeffMode mode);
     
     //==============================================================================
     
@@ -440,8 +450,13 @@ extern "C" {
      @param solad A pointer to the relevant tSOLAD.
      
      @fn void    tSOLAD_resetState       (tSOLAD *w)
-     @brief Reset state variables
+     @brief Reset state variables. A tSOLAD that shares another's input only clears its own state and picks up its source's position, so reset the source first when resetting both.
+     @param solad A pointer to the relevant tSOLAD.
+     
+     @fn void    tSOLAD_setInput         (tSOLAD *w, tSOLAD *source)
+     @brief Read the highpassed input history and attack detection of another tSOLAD instead of conditioning the input again. The source must have the same loop size, get the same block sizes, and run its tSOLAD_ioSamples first in each block. The in argument of this tSOLAD's tSOLAD_ioSamples is then ignored.
      @param solad A pointer to the relevant tSOLAD.
+     @param source The tSOLAD to share the input of, or NULL to condition its own input again.
      
      @} */
     
@@ -458,6 +473,7 @@ extern "C" {
         
         tAttackDetection*  ad;
         tHighpass*  hp;
+        const LEAFKernels* kernels;
         
         int loopSize;
         uint16_t timeindex;              // current reference time, write index
@@ -470,6 +486,9 @@ extern "C" {
         Lfloat xfadevalue;         // crossfade phase and value
         
         Lfloat* delaybuf;
+        Lfloat* ownbuf;            // this tSOLAD's own delay buffer, delaybuf unless sharing
+        struct tSOLAD* source;     // tSOLAD whose input is shared, NULL when conditioning its own
+        int attack;                // attack detected in the last input block
         
     } tSOLAD;
 
@@ -488,6 +507,8 @@ extern "C" {
     // reset state variables
     void    tSOLAD_resetState       (tSOLAD* w);
     void    tSOLAD_setSampleRate    (tSOLAD* const, Lfloat sr);
+    // share the conditioned input of another tSOLAD
+    void    tSOLAD_setInput         (tSOLAD* w, tSOLAD* source);
     
     /*!
      @defgroup tpitchshift tPitchShift
@@ -589,6 +610,11 @@ extern "C" {
      @brief
      @param retune A pointer to the relevant tSimpleRetune.
      
+     @fn void    tSimpleRetune_setAsync              (tSimpleRetune* const, int async)
+     @brief Run the pitch detection off the audio thread. See tDualPitchDetector_setAsync.
+     @param retune A pointer to the relevant tSimpleRetune.
+     @param async 1 to analyse asynchronously, 0 to analyse in tSimpleRetune_tick.
+     
      @} */
     
     typedef struct tSimpleRetune
@@ -625,6 +651,7 @@ extern "C" {
     void    tSimpleRetune_tuneVoice             (tSimpleRetune* const, int voice, Lfloat t);
     Lfloat  tSimpleRetune_getInputFrequency     (tSimpleRetune* const);
     void    tSimpleRetune_setSampleRate         (tSimpleRetune* const, Lfloat sr);
+    void    tSimpleRetune_setAsync              (tSimpleRetune* const, int async);
 
     /*!
      @defgroup tretune tRetune
@@ -662,13 +689,18 @@ extern "C" {
      @brief
      @param retune A pointer to the relevant tRetune.
      
+     @fn void    tRetune_setAsync            (tRetune* const, int async)
+     @brief Run the pitch detection off the audio thread. See tDualPitchDetector_setAsync.
+     @param retune A pointer to the relevant tRetune.
+     @param async 1 to analyse asynchronously, 0 to analyse in tRetune_tick.
+     
      @} */
     
     typedef struct tRetune
     {
         tMempool* mempool;
         
-        tDualPitchDetector** dp;
+        tDualPitchDetector* dp;
         Lfloat minInputFreq, maxInputFreq;
         
         tPitchShift** ps;
@@ -700,6 +732,7 @@ extern "C" {
     void    tRetune_tuneVoice           (tRetune* const, int voice, Lfloat t);
     Lfloat  tRetune_getInputFrequency   (tRetune* const);
     void    tRetune_setSampleRate       (tRetune* const, Lfloat sr);
+    void    tRetune_setAsync            (tRetune* const, int async);
     
     //==============================================================================
     
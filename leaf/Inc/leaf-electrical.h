@@ -152,6 +152,86 @@ extern "C" {
     Lfloat  tWDF_getVoltage             (tWDF* const);
     Lfloat  tWDF_getCurrent             (tWDF* const);
     
+    //==============================================================================
+    
+    /*!
+     @defgroup twdfprogram tWDFProgram
+     @ingroup electrical
+     @brief A tWDF tree compiled into a flat list of scattering operations.
+     @details Initializing a tWDFProgram walks the tree once and lays its nodes out in child-before-parent order with their waves in contiguous arrays. Every node then runs the same multiply-add step, so a tick is two straight loops over the nodes plus one call for the nonlinear root. The program keeps its own copy of the circuit state; the tWDF nodes are only read from when the program is initialized or updated, so tWDF_tick, tWDF_getVoltage and tWDF_getCurrent do not see what the program renders.
+     @{
+     
+     @fn void    tWDFProgram_init(tWDFProgram** const, tWDF* const root, tWDF* const outputPoint, LEAF* const leaf)
+     @brief Compile a tWDF tree into a tWDFProgram in the default mempool of a LEAF instance.
+     @param program A pointer to the tWDFProgram to initialize.
+     @param root The root of the tree, an IdealSource, Diode or DiodePair.
+     @param outputPoint The node whose voltage the program outputs.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tWDFProgram_initToPool(tWDFProgram** const, tWDF* const root, tWDF* const outputPoint, tMempool** const)
+     @brief Compile a tWDF tree into a tWDFProgram in a specified mempool.
+     @param program A pointer to the tWDFProgram to initialize.
+     @param root The root of the tree, an IdealSource, Diode or DiodePair.
+     @param outputPoint The node whose voltage the program outputs.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tWDFProgram_free(tWDFProgram** const)
+     @brief Free a tWDFProgram from its mempool. The tree it was compiled from is left alone.
+     @param program A pointer to the tWDFProgram to free.
+     
+     @fn Lfloat   tWDFProgram_tick            (tWDFProgram* const, Lfloat sample)
+     @brief Run the circuit for one sample.
+     @param program A pointer to the relevant tWDFProgram.
+     @param sample The source input.
+     @return The voltage at the output point.
+     
+     @fn void    tWDFProgram_tickBlock       (tWDFProgram* const, const Lfloat* input, Lfloat* output, int numSamples)
+     @brief Run the circuit for a block of samples.
+     @param program A pointer to the relevant tWDFProgram.
+     @param input The source input, numSamples long.
+     @param output Where to write the voltage at the output point, numSamples long. May be the same buffer as input.
+     @param numSamples The number of samples to render.
+     
+     @fn void    tWDFProgram_update          (tWDFProgram* const)
+     @brief Recompute the port resistances and scattering coefficients after tWDF_setValue or tWDF_setSampleRate on any node of the tree. The wave state is kept.
+     @param program A pointer to the relevant tWDFProgram.
+     
+     @} */
+    
+    // One node of a compiled tWDF tree. Every node runs the same two steps:
+    // up:   b[node] = cState*a[node] + cIn*input + uL*b[left] + uR*b[right]
+    // down: a[left] = kLL*b[left] + kLR*b[right] + kLU*a[node], and likewise for a[right]
+    typedef struct WDFOp
+    {
+        int left, right;    // child slots, 0 (a null port) when there is no child
+        Lfloat sign;        // -1 for inductors, which store the inverted incident wave
+        Lfloat cState, cIn, uL, uR;
+        Lfloat kLL, kLR, kLU;
+        Lfloat kRL, kRR, kRU;
+    } WDFOp;
+    
+    typedef struct tWDFProgram
+    {
+        
+        tMempool* mempool;
+        
+        tWDF* root;
+        int numNodes;       // the tree is in slots 1..numNodes, children first, and the root is numNodes + 1
+        int outputSlot;
+        tWDF** nodes;       // the tree node behind each slot
+        WDFOp* ops;
+        Lfloat* a;          // incident waves
+        Lfloat* b;          // reflected waves
+        
+    } tWDFProgram;
+    
+    void    tWDFProgram_init            (tWDFProgram** const, tWDF* const root, tWDF* const outputPoint, LEAF* const leaf);
+    void    tWDFProgram_initToPool      (tWDFProgram** const, tWDF* const root, tWDF* const outputPoint, tMempool** const);
+    void    tWDFProgram_free            (tWDFProgram** const);
+    
+    Lfloat  tWDFProgram_tick            (tWDFProgram* const, Lfloat sample);
+    void    tWDFProgram_tickBlock       (tWDFProgram* const, const Lfloat* input, Lfloat* output, int numSamples);
+    void    tWDFProgram_update          (tWDFProgram* const);
     
     //==============================================================================
     
@@ -157,6 +157,17 @@ extern "C" {
      @brief
      @param smooth A pointer to the relevant tExpSmooth.
      
+     @fn void    tExpSmooth_setSamplesPerTick(tExpSmooth* const, int samplesPerTick)
+     @brief Run the smoother at control rate. Each tick then covers samplesPerTick samples, with the factor adjusted so the curve keeps the same speed.
+     @param smooth A pointer to the relevant tExpSmooth.
+     @param samplesPerTick How many samples each tick covers. 1 (the default) is audio rate.
+     
+     @fn void    tExpSmooth_tickBlock    (tExpSmooth* const, Lfloat* output, int numSamples)
+     @brief Fill a block with the smoother's output, ticking once every samplesPerTick samples and interpolating linearly in between. numSamples should be a multiple of samplesPerTick; a shorter last segment still advances the smoother by a full tick.
+     @param smooth A pointer to the relevant tExpSmooth.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to write.
+     
      @} */
     
     typedef struct tExpSmooth
@@ -165,6 +176,8 @@ extern "C" {
         tMempool* mempool;
         Lfloat factor, oneminusfactor;
         Lfloat curr,dest;
+        Lfloat baseFactor;
+        int samplesPerTick;
         //Lfloat invSampleRate;
     } tExpSmooth;
 
@@ -173,23 +186,17 @@ extern "C" {
     void    tExpSmooth_free         (tExpSmooth** const);
     
 
-#ifdef ITCMRAM
-Lfloat  __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tExpSmooth_tick(tExpSmooth* const expsmooth);
-#else
-Lfloat   tExpSmooth_tick(tExpSmooth* const expsmooth);
-#endif
+    LEAF_TICK_ITCM Lfloat   tExpSmooth_tick(tExpSmooth* const expsmooth);
 
     Lfloat   tExpSmooth_sample       (tExpSmooth* const);
     void    tExpSmooth_setFactor    (tExpSmooth* const, Lfloat factor);
-#ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
-#else
-void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
-#endif
+    LEAF_TICK_ITCM void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
 
     void    tExpSmooth_setVal       (tExpSmooth* const, Lfloat val);
     void    tExpSmooth_setValAndDest(tExpSmooth* const, Lfloat val);
     void    tExpSmooth_setSampleRate(tExpSmooth* const, Lfloat sr);
+    void    tExpSmooth_setSamplesPerTick(tExpSmooth* const, int samplesPerTick);
+    void    tExpSmooth_tickBlock    (tExpSmooth* const, Lfloat* output, int numSamples);
     
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
@@ -248,8 +255,29 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
      @brief
      @param adsr A pointer to the relevant tADSR.
      
+     @fn Lfloat  tADSR_tickRecursive (tADSR* const)
+     @brief Tick the envelope without reading the lookup tables. Each stage runs as y[n+1] = a * y[n] + b, with a and b worked out when the stage starts from an exponential fitted to the decay table, so the shape matches tADSR_tick to within a small fraction. Use either this or tADSR_tick on an envelope, not both. Attack, decay and release changes also speed up or slow down a running stage from the point it has reached, as they do for the table version. Sustain and leak factor changes also move a running decay or sustain stage.
+     @param adsr A pointer to the relevant tADSR.
+     
+     @fn void    tADSR_renderBlock   (tADSR* const, Lfloat* output, int numSamples)
+     @brief Fill a block with the same output as tADSR_tickRecursive, running each stage in a tight loop with no per-sample stage checks.
+     @param adsr A pointer to the relevant tADSR.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to write.
+     
      @} */
     
+    //! Envelope stages run as one-multiply-one-add recurrences, for the tickRecursive and renderBlock functions of tADSR and tADSRT.
+    typedef struct LEAFExpSegment
+    {
+        Lfloat logRatio, scale, offset, slope;  // lookup buffer fitted as F(p) = scale * exp(logRatio * p) + offset, or offset + slope * p when logRatio is 0
+        Lfloat stageCoef[6], stageStart[6];     // per envState: the per-sample ratio (or step) and F at phase 0
+        uint32_t stageLength[6];                // per envState: samples before the stage ends
+        Lfloat coef, base, value;               // running stage: value is the next output, then value = coef * value + base
+        uint32_t remaining;
+        int stage;
+    } LEAFExpSegment;
+    
     /* ADSR */
     typedef struct tADSR
     {
@@ -275,6 +303,8 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
         Lfloat baseLeakFactor, leakFactor;
         
         Lfloat invSampleRate;
+        
+        LEAFExpSegment seg;
     } tADSR;
 
     void    tADSR_init    (tADSR** const adsrenv, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf);
@@ -290,6 +320,8 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tADSR_on            (tADSR* const, Lfloat velocity);
     void    tADSR_off           (tADSR* const);
     void    tADSR_setSampleRate (tADSR* const, Lfloat sr);
+    Lfloat  tADSR_tickRecursive (tADSR* const);
+    void    tADSR_renderBlock   (tADSR* const, Lfloat* output, int numSamples);
     
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
@@ -349,6 +381,27 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
      @brief
      @param adsr A pointer to the relevant tADSRT.
      
+     @fn void    tADSRT_setSamplesPerTick (tADSRT* const, int samplesPerTick)
+     @brief Run the envelope at control rate. Each tick then advances it by samplesPerTick samples, so stage times stay the same.
+     @param adsr A pointer to the relevant tADSRT.
+     @param samplesPerTick How many samples each tick covers. 1 (the default) is audio rate.
+     
+     @fn Lfloat  tADSRT_tickRecursive (tADSRT* const)
+     @brief Tick the envelope without reading the exp buffer. Each stage runs as y[n+1] = a * y[n] + b, with a and b worked out when the stage starts from an exponential (plus offset) fitted to the buffer. For buffers made with LEAF_generate_exp the shape is the same as tADSRT_tick. The fit is made in tADSRT_init, so the buffer has to be filled before then. Sustain leaks like tADSRT_tickNoInterp. Use either this or tADSRT_tick on an envelope, not both. Attack, decay and release changes also speed up or slow down a running stage from the point it has reached, as they do for the table version. Sustain and leak factor changes also move a running decay or sustain stage.
+     @param adsr A pointer to the relevant tADSRT.
+     
+     @fn void    tADSRT_renderBlock   (tADSRT* const, Lfloat* output, int numSamples)
+     @brief Fill a block with the same output as tADSRT_tickRecursive, running each stage in a tight loop with no per-sample stage checks.
+     @param adsr A pointer to the relevant tADSRT.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to write.
+     
+     @fn void    tADSRT_tickBlock     (tADSRT* const, Lfloat* output, int numSamples)
+     @brief Fill a block with the envelope, ticking once every samplesPerTick samples and interpolating linearly in between. Each segment lands on the value its tick returned, so the output trails the audio-rate envelope by one tick. numSamples should be a multiple of samplesPerTick.
+     @param adsr A pointer to the relevant tADSRT.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to write.
+     
      @} */
     
     typedef struct tADSRT
@@ -375,6 +428,9 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
         Lfloat baseLeakFactor, leakFactor;
         
         Lfloat invSampleRate;
+        int samplesPerTick;
+        
+        LEAFExpSegment seg;
     } tADSRT;
 
     void    tADSRT_init          (tADSRT** const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, Lfloat* expBuffer, int bufferSize, LEAF* const leaf);
@@ -392,6 +448,10 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tADSRT_off           (tADSRT* const);
     void 	tADSRT_clear		 (tADSRT* const adsrenv);
     void    tADSRT_setSampleRate (tADSRT* const, Lfloat sr);
+    void    tADSRT_setSamplesPerTick (tADSRT* const, int samplesPerTick);
+    void    tADSRT_tickBlock     (tADSRT* const, Lfloat* output, int numSamples);
+    Lfloat  tADSRT_tickRecursive (tADSRT* const);
+    void    tADSRT_renderBlock   (tADSRT* const, Lfloat* output, int numSamples);
     
     // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~
     
@@ -493,7 +553,7 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tADSRS_initToPool    (tADSRS** const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool** const);
     void    tADSRS_free          (tADSRS** const);
     
-    Lfloat   tADSRS_tick          (tADSRS* const);
+    LEAF_TICK Lfloat   tADSRS_tick          (tADSRS* const);
     void    tADSRS_setAttack     (tADSRS* const, Lfloat attack);
     void    tADSRS_setDecay      (tADSRS* const, Lfloat decay);
     void    tADSRS_setSustain    (tADSRS* const, Lfloat sustain);
@@ -545,6 +605,17 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
      @brief
      @param ramp A pointer to the relevant tRamp.
      
+     @fn void    tRamp_setSamplesPerTick (tRamp* const, int samplesPerTick)
+     @brief Change how many samples each tick covers after initialization. The ramp time stays the same.
+     @param ramp A pointer to the relevant tRamp.
+     @param samplesPerTick How many samples each tick covers.
+     
+     @fn void    tRamp_tickBlock     (tRamp* const, Lfloat* output, int numSamples)
+     @brief Fill a block with the ramp, ticking once every samplesPerTick samples and interpolating linearly in between. numSamples should be a multiple of samplesPerTick.
+     @param ramp A pointer to the relevant tRamp.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to write.
+     
      @} */
     
     typedef struct tRamp
@@ -570,6 +641,8 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
     void    tRamp_setDest       (tRamp* const, Lfloat dest);
     void    tRamp_setVal        (tRamp* const, Lfloat val);
     void    tRamp_setSampleRate (tRamp* const, Lfloat sr);
+    void    tRamp_setSamplesPerTick (tRamp* const, int samplesPerTick);
+    void    tRamp_tickBlock     (tRamp* const, Lfloat* output, int numSamples);
     
     /*!
      @defgroup trampupdown tRampUpDown
@@ -710,8 +783,75 @@ void    tExpSmooth_setDest      (tExpSmooth* const, Lfloat dest);
 }
 #endif
 
+#define LEAF_ENVELOPES_H_DECLARED
 #endif  // LEAF_ENVELOPES_H_INCLUDED
 
+//==============================================================================
+
+// Tick and hot setter definitions. With LEAF_INLINE_TICKS they are static inline in every file
+// that includes this header; otherwise leaf-envelopes.c defines LEAF_ENVELOPES_C and compiles them once.
+// LEAF_ENVELOPES_H_DECLARED holds them back in a circular include that gets here before the types above.
+#if (LEAF_INLINE_TICKS || defined(LEAF_ENVELOPES_C)) && defined(LEAF_ENVELOPES_H_DECLARED) && !defined(LEAF_ENVELOPES_TICKS_DEFINED)
+#define LEAF_ENVELOPES_TICKS_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+LEAF_TICK Lfloat tADSRS_tick(tADSRS* const adsr)
+{
+    switch (adsr->state) {
+        case env_idle:
+            break;
+        case env_attack:
+            adsr->output = adsr->attackBase + adsr->output * adsr->attackCoef;
+            if (adsr->output >= 1.0f) {
+                adsr->output = 1.0f;
+                adsr->state = env_decay;
+            }
+            break;
+        case env_decay:
+            adsr->output = adsr->decayBase + adsr->output * adsr->decayCoef * adsr->leakFactor;
+            if (adsr->output <= adsr->sustainLevel) {
+                adsr->output = adsr->sustainLevel;
+                adsr->state = env_sustain;
+            }
+            break;
+        case env_sustain:
+            adsr->output = adsr->output * adsr->leakFactor;
+            break;
+        case env_release:
+            adsr->output = adsr->releaseBase + adsr->output * adsr->releaseCoef;
+            if (adsr->output <= 0.0f) {
+                adsr->output = 0.0f;
+                adsr->state = env_idle;
+            }
+        default:
+            break;
+    }
+    //smooth the gain value   -- this is not ideal, a retrigger while the envelope is still going with a new gain will cause a jump, although it will be smoothed quickly. Maybe doing the math so the range is computed based on the gain rather than 0.->1. is preferable? But that's harder to get the exponential curve right without a lookup.
+    adsr->gain = (adsr->factor * adsr->targetGainSquared) + (adsr->oneMinusFactor * adsr->gain);
+    return adsr->output * adsr->gain;
+}
+
+LEAF_TICK_ITCM void tExpSmooth_setDest(tExpSmooth* const smooth, Lfloat dest)
+{
+    smooth->dest = dest;
+}
+
+LEAF_TICK_ITCM Lfloat tExpSmooth_tick(tExpSmooth* const smooth)
+{
+    smooth->curr = smooth->factor * smooth->dest + smooth->oneminusfactor * smooth->curr;
+    return smooth->curr;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_ENVELOPES_TICKS_DEFINED
+
+
 
 
 
@@ -253,7 +253,7 @@ extern "C" {
     void    tOnePole_free            (tOnePole** const);
 
     // Tick function for `tOnePole`
-    Lfloat   tOnePole_tick           (tOnePole* const, Lfloat input);
+    LEAF_TICK Lfloat   tOnePole_tick           (tOnePole* const, Lfloat input);
 
     // Setter functions for `tOnePole`
     void    tOnePole_setB0           (tOnePole* const, Lfloat b0);
@@ -762,7 +762,7 @@ extern "C" {
     void    tBiQuad_free           (tBiQuad** const);
 
     // Tick function for `tBiQuad`
-    Lfloat  tBiQuad_tick           (tBiQuad* const, Lfloat input);
+    LEAF_TICK Lfloat  tBiQuad_tick           (tBiQuad* const, Lfloat input);
 
     // Setter functions for `tBiQuad`
     void    tBiQuad_setB0          (tBiQuad* const, Lfloat b0);
@@ -851,14 +851,14 @@ extern "C" {
     void    tSVF_free                (tSVF** const);
 
     // Tick functions for `tSVF`
-    Lfloat  tSVF_tick                (tSVF* const, Lfloat v0);
-    Lfloat  tSVF_tickLP              (tSVF* const, Lfloat v0);
-    Lfloat  tSVF_tickHP              (tSVF* const, Lfloat v0);
-    Lfloat  tSVF_tickBP              (tSVF* const, Lfloat v0);
+    LEAF_TICK Lfloat  tSVF_tick                (tSVF* const, Lfloat v0);
+    LEAF_TICK Lfloat  tSVF_tickLP              (tSVF* const, Lfloat v0);
+    LEAF_TICK Lfloat  tSVF_tickHP              (tSVF* const, Lfloat v0);
+    LEAF_TICK Lfloat  tSVF_tickBP              (tSVF* const, Lfloat v0);
 
     // Setter functions for `tSVF`
     void    tSVF_setFreq             (tSVF* const, Lfloat freq);
-    void    tSVF_setFreqFast         (tSVF* const vf, Lfloat cutoff);
+    LEAF_TICK void    tSVF_setFreqFast         (tSVF* const vf, Lfloat cutoff);
     void    tSVF_setQ                (tSVF* const, Lfloat Q);
     void    tSVF_setFreqAndQ         (tSVF* const svff, Lfloat freq, Lfloat Q);
     void    tSVF_setFreqAndQFast     (tSVF* const svff, Lfloat cutoff, Lfloat Q);
@@ -1007,7 +1007,7 @@ extern "C" {
     void    tHighpass_free          (tHighpass** const);
 
     // Tick function for `tHighpass`
-    Lfloat  tHighpass_tick          (tHighpass* const, Lfloat x);
+    LEAF_TICK Lfloat  tHighpass_tick          (tHighpass* const, Lfloat x);
 
     // Setter functions for `tHighpass`
     void    tHighpass_setFreq       (tHighpass* const, Lfloat freq);
@@ -1139,7 +1139,7 @@ extern "C" {
     /*!
      @defgroup tmedianfilter tMedianFilter
      @ingroup filters
-     @brief Median filter.
+     @brief Running median filter. Keeps the window in two indexed heaps, so each sample costs O(log size) however long the window is.
      @{
      
      @fn void    tMedianFilter_init(tMedianFilter** const, int size, LEAF* const leaf)
@@ -1157,8 +1157,17 @@ extern "C" {
      @param filter A pointer to the tMedianFilter to free.
      
      @fn Lfloat   tMedianFilter_tick           (tMedianFilter* const, Lfloat input)
-     @brief
+     @brief Add a sample to the window and get the median. For even sizes this is the upper of the two middle values.
+     @param filter A pointer to the relevant tMedianFilter.
+     @param input The input sample.
+     @return The median of the last size inputs.
+     
+     @fn void    tMedianFilter_tickBlock      (tMedianFilter* const, const Lfloat* input, Lfloat* output, int numSamples)
+     @brief Run tMedianFilter_tick over a block. input and output may be the same buffer.
      @param filter A pointer to the relevant tMedianFilter.
+     @param input The input samples.
+     @param output The buffer to write the medians to.
+     @param numSamples The number of samples to process.
      ￼￼￼
      @} */
     
@@ -1166,8 +1175,9 @@ extern "C" {
     {
 
         tMempool* mempool;
-        Lfloat* val;
-        int* age;
+        Lfloat* val;        // ring buffer of the window
+        int* heap;          // ring slots: [0, middlePosition) max-heap of the lower half, the rest a min-heap of the upper half
+        int* heapPos;       // where each ring slot is in heap
         int m;
         int size;
         int middlePosition;
@@ -1182,6 +1192,7 @@ extern "C" {
 
     // Tick function for `tMedianFilter`
     Lfloat  tMedianFilter_tick           (tMedianFilter* const, Lfloat input);
+    void    tMedianFilter_tickBlock      (tMedianFilter* const, const Lfloat* input, Lfloat* output, int numSamples);
     
     
     /*!
@@ -1212,6 +1223,18 @@ extern "C" {
      @brief
      @param filter A pointer to the relevant tVZFilter.
      
+     @fn void    tVZFilter_tickBlock                (tVZFilter* const, const Lfloat* input, Lfloat* output, int numSamples)
+     @brief Run the filter (as tVZFilter_tick) over a block. With LEAFCoeffsInterpolated, coefficients changed since the last tick are ramped in linearly across the block instead of jumping at its start.
+     @param filter A pointer to the relevant tVZFilter.
+     @param input The input block.
+     @param output The output block. May be the same as input.
+     @param numSamples The number of samples in the blocks.
+     
+     @fn void    tVZFilter_setCoeffMode             (tVZFilter* const, LEAFCoeffMode mode)
+     @brief Choose when the setters recompute the coefficients. With LEAFCoeffsLazy or LEAFCoeffsInterpolated, calling several setters (or the same one many times) between ticks costs one recomputation instead of one each. tVZFilter_setFreqFast and the EfficientBP setters are already cheap and always apply right away. Switching back to LEAFCoeffsImmediate applies any pending change.
+     @param filter A pointer to the relevant tVZFilter.
+     @param mode The new LEAFCoeffMode. Defaults to LEAFCoeffsImmediate.
+     
      @fn void    tVZFilter_calcCoeffs           (tVZFilter* const)
      @brief
      @param filter A pointer to the relevant tVZFilter.
@@ -1289,6 +1312,9 @@ extern "C" {
         Lfloat sampRatio;
         Lfloat cutoffMIDI;
         const Lfloat *table;
+        LEAFCoeffMode coeffMode;
+        int dirty;    // parameters changed since the coefficients were last computed
+        Lfloat pendingFc, pendingG, pendingB; // what a deferred bandwidth change is measured against
     } tVZFilter;
 
     // Memory handlers for `tVZFilter`
@@ -1301,6 +1327,7 @@ extern "C" {
     // Tick functions for `tVZFilter`
     Lfloat  tVZFilter_tick                                (tVZFilter* const, Lfloat input);
     Lfloat  tVZFilter_tickEfficient                       (tVZFilter* const vf, Lfloat in);
+    void    tVZFilter_tickBlock                           (tVZFilter* const, const Lfloat* input, Lfloat* output, int numSamples);
 
     // Setter functions for `tVZFilter`
     void    tVZFilter_setSampleRate                       (tVZFilter* const, Lfloat sampleRate);
@@ -1321,6 +1348,7 @@ extern "C" {
     void    tVZFilter_setMorphOnly                        (tVZFilter* const vf, Lfloat morph);
     void    tVZFilter_setMorph                            (tVZFilter* const vf, Lfloat morph);
     void    tVZFilter_setType                             (tVZFilter* const, VZFilterType type);
+    void    tVZFilter_setCoeffMode                        (tVZFilter* const, LEAFCoeffMode mode);
     Lfloat  tVZFilter_BandwidthToR                        (tVZFilter* const vf, Lfloat B);
     Lfloat  tVZFilter_BandwidthToREfficientBP             (tVZFilter* const vf, Lfloat B);
     
@@ -1639,8 +1667,126 @@ extern "C" {
 }
 #endif
 
+#define LEAF_FILTERS_H_DECLARED
 #endif  // LEAF_FILTERS_H_INCLUDED
 
 //==============================================================================
 
+// Tick and hot setter definitions. With LEAF_INLINE_TICKS they are static inline in every file
+// that includes this header; otherwise leaf-filters.c defines LEAF_FILTERS_C and compiles them once.
+// LEAF_FILTERS_H_DECLARED holds them back in a circular include that gets here before the types above.
+#if (LEAF_INLINE_TICKS || defined(LEAF_FILTERS_C)) && defined(LEAF_FILTERS_H_DECLARED) && !defined(LEAF_FILTERS_TICKS_DEFINED)
+#define LEAF_FILTERS_TICKS_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+LEAF_TICK Lfloat tOnePole_tick(tOnePole* const f, Lfloat input)
+{
+    Lfloat in = input * f->gain;
+    Lfloat out = LEAF_flushDenormal((f->b0 * in) + (f->a1 * f->lastOut));
+
+    f->lastIn = in;
+    f->lastOut = out;
+
+    return out;
+}
+
+LEAF_TICK Lfloat tBiQuad_tick(tBiQuad* const f, Lfloat input)
+{
+    Lfloat in = input * f->gain;
+    Lfloat out = f->b0 * in + f->b1 * f->lastIn[0] + f->b2 * f->lastIn[1];
+    out -= f->a2 * f->lastOut[1] + f->a1 * f->lastOut[0];
+
+    f->lastIn[1] = f->lastIn[0];
+    f->lastIn[0] = in;
+
+    f->lastOut[1] = f->lastOut[0];
+    f->lastOut[0] = out;
+
+    return out;
+}
+
+LEAF_TICK Lfloat tSVF_tick(tSVF* const svf, Lfloat v0)
+{
+    Lfloat v1, v2, v3;
+    v3 = v0 - svf->ic2eq;
+    v1 = (svf->a1 * svf->ic1eq) + (svf->a2 * v3);
+    v2 = svf->ic2eq + (svf->a2 * svf->ic1eq) + (svf->a3 * v3);
+    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
+    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
+
+    return (v0 * svf->cH) + (v1 * svf->cB) + (svf->k * v1 * svf->cBK) +
+            (v2 * svf->cL);
+}
+
+LEAF_TICK Lfloat tSVF_tickHP(tSVF* const svf, Lfloat v0)
+{
+    Lfloat v1, v2;
+    v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
+    v2 = svf->ic2eq + svf->g * v1;
+    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
+    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
+    return v0 - (svf->k * v1) - (v2);
+}
+
+LEAF_TICK Lfloat tSVF_tickBP(tSVF* const svf, Lfloat v0)
+{
+    Lfloat v1, v2;
+    v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
+    v2 = svf->ic2eq + svf->g * v1;
+    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
+    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
+
+    return v1;
+}
+
+LEAF_TICK Lfloat tSVF_tickLP(tSVF* const svf, Lfloat v0)
+{
+    Lfloat v1, v2;
+    v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
+    v2 = svf->ic2eq + svf->g * v1;
+    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
+    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
+    return v2;
+}
+
+LEAF_TICK void tSVF_setFreqFast(tSVF* const svf, Lfloat cutoff)
+{
+    svf->cutoffMIDI = cutoff;
+    cutoff *= 30.567164179104478f; //get 0-134 midi range to 0-4095
+    int32_t intVer = (int32_t) cutoff;
+    if (intVer > 4094) {
+        intVer = 4094;
+    }
+    if (intVer < 0) {
+        intVer = 0;
+    }
+    Lfloat LfloatVer = cutoff - (Lfloat) intVer;
+
+    svf->g = ((svf->table[intVer] * (1.0f - LfloatVer)) +
+            (svf->table[intVer + 1] * LfloatVer)) * svf->sampleRatio;
+    svf->a1 = 1.0f / (1.0f + svf->g * (svf->g + svf->k));
+    svf->a2 = svf->g * svf->a1;
+    svf->a3 = svf->g * svf->a2;
+}
+
+// From JOS DC Blocker
+LEAF_TICK Lfloat tHighpass_tick(tHighpass* const f, Lfloat x)
+{
+    f->ys = LEAF_flushDenormal(x - f->xs + f->R * f->ys);
+    f->xs = x;
+    return f->ys;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_FILTERS_TICKS_DEFINED
+
+
+//==============================================================================
+
 
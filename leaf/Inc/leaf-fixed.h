@@ -0,0 +1,592 @@
+/*==============================================================================
+
+ leaf-fixed.h
+ Created: 19 Oct 2026 11:02:51am
+
+ ==============================================================================*/
+
+#ifndef LEAF_FIXED_H_INCLUDED
+#define LEAF_FIXED_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //==============================================================================
+
+#include "leaf-math.h"
+#include "leaf-mempool.h"
+#include "leaf-filters.h"
+#include "leaf-envelopes.h"
+
+    //==============================================================================
+
+    /*!
+     @ingroup fixed
+     @{
+     */
+
+    //! Q31 sample: a signed 32-bit integer standing for value / 2^31, so the range is [-1, 1).
+    typedef int32_t Lq31;
+    //! Q15 sample: a signed 16-bit integer standing for value / 2^15.
+    typedef int16_t Lq15;
+
+#define LEAF_Q31_MAX  ((Lq31) 0x7fffffff)
+#define LEAF_Q31_MIN  ((Lq31) 0x80000000)
+
+    // Clamp a 64-bit intermediate back into Q31 range.
+    static inline Lq31 LEAF_q31Saturate(int64_t x)
+    {
+        if (x > (int64_t) LEAF_Q31_MAX) return LEAF_Q31_MAX;
+        if (x < (int64_t) LEAF_Q31_MIN) return LEAF_Q31_MIN;
+        return (Lq31) x;
+    }
+
+    static inline Lq31 LEAF_q31Add(Lq31 a, Lq31 b)
+    {
+        return LEAF_q31Saturate((int64_t) a + b);
+    }
+
+    static inline Lq31 LEAF_q31Sub(Lq31 a, Lq31 b)
+    {
+        return LEAF_q31Saturate((int64_t) a - b);
+    }
+
+    // Rounds to nearest, so multiplying by LEAF_Q31_MAX leaves small values unchanged. Only -1 * -1 can overflow, and that saturates to just under 1.
+    static inline Lq31 LEAF_q31Mul(Lq31 a, Lq31 b)
+    {
+        return LEAF_q31Saturate(((int64_t) a * b + (1 << 30)) >> 31);
+    }
+
+    // Conversions from float are meant for control-rate code such as setters; the tick functions never touch floats.
+    static inline Lq31 LEAF_floatToQ31(Lfloat x)
+    {
+        if (x >= 1.0f) return LEAF_Q31_MAX;
+        if (x <= -1.0f) return LEAF_Q31_MIN;
+        return (Lq31) (x * 2147483648.0f);
+    }
+
+    static inline Lfloat LEAF_q31ToFloat(Lq31 x)
+    {
+        return (Lfloat) x * (1.0f / 2147483648.0f);
+    }
+
+    static inline Lq15 LEAF_floatToQ15(Lfloat x)
+    {
+        if (x >= 1.0f) return (Lq15) 0x7fff;
+        if (x <= -1.0f) return (Lq15) 0x8000;
+        return (Lq15) (x * 32768.0f);
+    }
+
+    static inline Lfloat LEAF_q15ToFloat(Lq15 x)
+    {
+        return (Lfloat) x * (1.0f / 32768.0f);
+    }
+
+    static inline Lq15 LEAF_q31ToQ15(Lq31 x)
+    {
+        return (Lq15) (x >> 16);
+    }
+
+    static inline Lq31 LEAF_q15ToQ31(Lq15 x)
+    {
+        return (Lq31) x * 65536;
+    }
+
+    /*! @} */
+
+    //==============================================================================
+
+    /*!
+     @defgroup tphasorq31 tPhasorQ31
+     @ingroup fixed
+     @brief Fixed-point version of tPhasor. Ramps from 0 up to just under 1 in Q31.
+     @{
+
+     @fn void    tPhasorQ31_init(tPhasorQ31** const, LEAF* const leaf)
+     @brief Initialize a tPhasorQ31 to the default mempool of a LEAF instance.
+     @param phasor A pointer to the tPhasorQ31 to initialize.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tPhasorQ31_initToPool(tPhasorQ31** const, tMempool** const)
+     @brief Initialize a tPhasorQ31 to a specified mempool.
+     @param phasor A pointer to the tPhasorQ31 to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tPhasorQ31_free(tPhasorQ31** const)
+     @brief Free a tPhasorQ31 from its mempool.
+     @param phasor A pointer to the tPhasorQ31 to free.
+
+     @fn Lq31    tPhasorQ31_tick(tPhasorQ31* const)
+     @brief Tick a tPhasorQ31 and return the current value.
+     @param phasor A pointer to the relevant tPhasorQ31.
+     @return The ramp value in Q31.
+
+     @fn void    tPhasorQ31_setFreq(tPhasorQ31* const, Lfloat freq)
+     @brief Set the frequency of a tPhasorQ31.
+     @param phasor A pointer to the relevant tPhasorQ31.
+     @param freq The frequency to set in Hz.
+
+     @fn void    tPhasorQ31_setPhaseInc(tPhasorQ31* const, uint32_t inc)
+     @brief Set the phase increment directly as a fraction of 2^32 per sample, for setting the frequency without any float math.
+     @param phasor A pointer to the relevant tPhasorQ31.
+     @param inc The phase increment.
+     @} */
+
+    typedef struct tPhasorQ31
+    {
+        tMempool* mempool;
+        uint32_t phase;
+        uint32_t inc;
+        Lfloat freq;
+        Lfloat invSampleRateTimesTwoTo32;
+    } tPhasorQ31;
+
+    void    tPhasorQ31_init          (tPhasorQ31** const, LEAF* const leaf);
+    void    tPhasorQ31_initToPool    (tPhasorQ31** const, tMempool** const);
+    void    tPhasorQ31_free          (tPhasorQ31** const);
+
+    Lq31    tPhasorQ31_tick          (tPhasorQ31* const);
+    void    tPhasorQ31_setFreq       (tPhasorQ31* const, Lfloat freq);
+    void    tPhasorQ31_setPhaseInc   (tPhasorQ31* const, uint32_t inc);
+    void    tPhasorQ31_setSampleRate (tPhasorQ31* const, Lfloat sr);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tcycleq31 tCycleQ31
+     @ingroup fixed
+     @brief Fixed-point version of tCycle. Reads a quarter-wave Q15 sine table with linear interpolation, so it only needs 1 KB of constant data.
+     @{
+
+     @fn void    tCycleQ31_init(tCycleQ31** const, LEAF* const leaf)
+     @brief Initialize a tCycleQ31 to the default mempool of a LEAF instance.
+     @param osc A pointer to the tCycleQ31 to initialize.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tCycleQ31_initToPool(tCycleQ31** const, tMempool** const)
+     @brief Initialize a tCycleQ31 to a specified mempool.
+     @param osc A pointer to the tCycleQ31 to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tCycleQ31_free(tCycleQ31** const)
+     @brief Free a tCycleQ31 from its mempool.
+     @param osc A pointer to the tCycleQ31 to free.
+
+     @fn Lq31    tCycleQ31_tick(tCycleQ31* const)
+     @brief Tick a tCycleQ31 and return the current sample.
+     @param osc A pointer to the relevant tCycleQ31.
+     @return The sample in Q31.
+
+     @fn void    tCycleQ31_setFreq(tCycleQ31* const, Lfloat freq)
+     @brief Set the frequency of a tCycleQ31.
+     @param osc A pointer to the relevant tCycleQ31.
+     @param freq The frequency to set in Hz.
+
+     @fn void    tCycleQ31_setPhaseInc(tCycleQ31* const, uint32_t inc)
+     @brief Set the phase increment directly as a fraction of 2^32 per sample.
+     @param osc A pointer to the relevant tCycleQ31.
+     @param inc The phase increment.
+
+     @fn void    tCycleQ31_setPhase(tCycleQ31* const, Lq31 phase)
+     @brief Set the phase of a tCycleQ31.
+     @param osc A pointer to the relevant tCycleQ31.
+     @param phase The phase as a fraction of a cycle in Q31, from 0 to just under 1.
+     @} */
+
+    typedef struct tCycleQ31
+    {
+        tMempool* mempool;
+        uint32_t phase;
+        uint32_t inc;
+        Lfloat freq;
+        Lfloat invSampleRateTimesTwoTo32;
+    } tCycleQ31;
+
+    void    tCycleQ31_init           (tCycleQ31** const, LEAF* const leaf);
+    void    tCycleQ31_initToPool     (tCycleQ31** const, tMempool** const);
+    void    tCycleQ31_free           (tCycleQ31** const);
+
+    Lq31    tCycleQ31_tick           (tCycleQ31* const);
+    void    tCycleQ31_setFreq        (tCycleQ31* const, Lfloat freq);
+    void    tCycleQ31_setPhaseInc    (tCycleQ31* const, uint32_t inc);
+    void    tCycleQ31_setPhase       (tCycleQ31* const, Lq31 phase);
+    void    tCycleQ31_setSampleRate  (tCycleQ31* const, Lfloat sr);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tpbsawq31 tPBSawQ31
+     @ingroup fixed
+     @brief Fixed-point version of tPBSaw, an anti-aliased sawtooth using PolyBLEP. Used in place of a fixed-point tSawtooth, whose band-limited tables would take 40 KB as Q15.
+     @{
+
+     @fn void    tPBSawQ31_init(tPBSawQ31** const, LEAF* const leaf)
+     @brief Initialize a tPBSawQ31 to the default mempool of a LEAF instance.
+     @param osc A pointer to the tPBSawQ31 to initialize.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tPBSawQ31_initToPool(tPBSawQ31** const, tMempool** const)
+     @brief Initialize a tPBSawQ31 to a specified mempool.
+     @param osc A pointer to the tPBSawQ31 to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tPBSawQ31_free(tPBSawQ31** const)
+     @brief Free a tPBSawQ31 from its mempool.
+     @param osc A pointer to the tPBSawQ31 to free.
+
+     @fn Lq31    tPBSawQ31_tick(tPBSawQ31* const)
+     @brief Tick a tPBSawQ31 and return the current sample.
+     @param osc A pointer to the relevant tPBSawQ31.
+     @return The sample in Q31.
+
+     @fn void    tPBSawQ31_setFreq(tPBSawQ31* const, Lfloat freq)
+     @brief Set the frequency of a tPBSawQ31.
+     @param osc A pointer to the relevant tPBSawQ31.
+     @param freq The frequency to set in Hz.
+
+     @fn void    tPBSawQ31_setPhaseInc(tPBSawQ31* const, uint32_t inc)
+     @brief Set the phase increment directly as a fraction of 2^32 per sample.
+     @param osc A pointer to the relevant tPBSawQ31.
+     @param inc The phase increment.
+     @} */
+
+    typedef struct tPBSawQ31
+    {
+        tMempool* mempool;
+        uint32_t phase;
+        uint32_t inc;
+        Lfloat freq;
+        Lfloat invSampleRateTimesTwoTo32;
+    } tPBSawQ31;
+
+    void    tPBSawQ31_init           (tPBSawQ31** const, LEAF* const leaf);
+    void    tPBSawQ31_initToPool     (tPBSawQ31** const, tMempool** const);
+    void    tPBSawQ31_free           (tPBSawQ31** const);
+
+    Lq31    tPBSawQ31_tick           (tPBSawQ31* const);
+    void    tPBSawQ31_setFreq        (tPBSawQ31* const, Lfloat freq);
+    void    tPBSawQ31_setPhaseInc    (tPBSawQ31* const, uint32_t inc);
+    void    tPBSawQ31_setSampleRate  (tPBSawQ31* const, Lfloat sr);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tonepoleq31 tOnePoleQ31
+     @ingroup fixed
+     @brief Fixed-point version of tOnePole.
+     @{
+
+     @fn void    tOnePoleQ31_init(tOnePoleQ31** const, Lfloat freq, LEAF* const leaf)
+     @brief Initialize a tOnePoleQ31 to the default mempool of a LEAF instance.
+     @param filter A pointer to the tOnePoleQ31 to initialize.
+     @param freq The cutoff frequency in Hz.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tOnePoleQ31_initToPool(tOnePoleQ31** const, Lfloat freq, tMempool** const)
+     @brief Initialize a tOnePoleQ31 to a specified mempool.
+     @param filter A pointer to the tOnePoleQ31 to initialize.
+     @param freq The cutoff frequency in Hz.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tOnePoleQ31_free(tOnePoleQ31** const)
+     @brief Free a tOnePoleQ31 from its mempool.
+     @param filter A pointer to the tOnePoleQ31 to free.
+
+     @fn Lq31    tOnePoleQ31_tick(tOnePoleQ31* const, Lq31 input)
+     @brief Tick a tOnePoleQ31.
+     @param filter A pointer to the relevant tOnePoleQ31.
+     @param input The input sample in Q31.
+     @return The filtered sample in Q31.
+
+     @fn void    tOnePoleQ31_setFreq(tOnePoleQ31* const, Lfloat freq)
+     @brief Set the cutoff frequency the same way tOnePole_setFreq does.
+     @param filter A pointer to the relevant tOnePoleQ31.
+     @param freq The cutoff frequency in Hz.
+
+     @fn void    tOnePoleQ31_setCoefficients(tOnePoleQ31* const, Lq31 b0, Lq31 a1)
+     @brief Set the coefficients directly in Q31.
+     @param filter A pointer to the relevant tOnePoleQ31.
+     @} */
+
+    typedef struct tOnePoleQ31
+    {
+        tMempool* mempool;
+        Lq31 b0, a1;
+        Lq31 lastOut;
+        Lfloat freq;
+        Lfloat twoPiTimesInvSampleRate;
+    } tOnePoleQ31;
+
+    void    tOnePoleQ31_init             (tOnePoleQ31** const, Lfloat freq, LEAF* const leaf);
+    void    tOnePoleQ31_initToPool       (tOnePoleQ31** const, Lfloat freq, tMempool** const);
+    void    tOnePoleQ31_free             (tOnePoleQ31** const);
+
+    Lq31    tOnePoleQ31_tick             (tOnePoleQ31* const, Lq31 input);
+    void    tOnePoleQ31_setFreq          (tOnePoleQ31* const, Lfloat freq);
+    void    tOnePoleQ31_setCoefficients  (tOnePoleQ31* const, Lq31 b0, Lq31 a1);
+    void    tOnePoleQ31_setSampleRate    (tOnePoleQ31* const, Lfloat sr);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tsvfq31 tSVFQ31
+     @ingroup fixed
+     @brief Fixed-point version of tSVF. The a1, a2 and a3 coefficients all stay below 1 for any cutoff, so they fit in Q31; the output mix is kept in Q4.27. The integrator states saturate at full scale, so leave headroom on the input when using high Q.
+     @{
+
+     @fn void    tSVFQ31_init(tSVFQ31** const, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf)
+     @brief Initialize a tSVFQ31 to the default mempool of a LEAF instance.
+     @param filter A pointer to the tSVFQ31 to initialize.
+     @param type The type of the filter. SVFTypeLowShelf and SVFTypeHighShelf are not supported and act as a lowpass.
+     @param freq The cutoff frequency in Hz.
+     @param Q The resonance.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tSVFQ31_initToPool(tSVFQ31** const, SVFType type, Lfloat freq, Lfloat Q, tMempool** const)
+     @brief Initialize a tSVFQ31 to a specified mempool.
+     @param filter A pointer to the tSVFQ31 to initialize.
+     @param type The type of the filter.
+     @param freq The cutoff frequency in Hz.
+     @param Q The resonance.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tSVFQ31_free(tSVFQ31** const)
+     @brief Free a tSVFQ31 from its mempool.
+     @param filter A pointer to the tSVFQ31 to free.
+
+     @fn Lq31    tSVFQ31_tick(tSVFQ31* const, Lq31 input)
+     @brief Tick a tSVFQ31.
+     @param filter A pointer to the relevant tSVFQ31.
+     @param input The input sample in Q31.
+     @return The filtered sample in Q31.
+
+     @fn void    tSVFQ31_setFreq(tSVFQ31* const, Lfloat freq)
+     @brief Set the cutoff frequency.
+     @param filter A pointer to the relevant tSVFQ31.
+     @param freq The cutoff frequency in Hz.
+
+     @fn void    tSVFQ31_setQ(tSVFQ31* const, Lfloat Q)
+     @brief Set the resonance. Values below 0.5 are clamped.
+     @param filter A pointer to the relevant tSVFQ31.
+     @param Q The resonance.
+
+     @fn void    tSVFQ31_setFreqAndQ(tSVFQ31* const, Lfloat freq, Lfloat Q)
+     @brief Set the cutoff frequency and resonance together.
+     @param filter A pointer to the relevant tSVFQ31.
+
+     @fn void    tSVFQ31_setFilterType(tSVFQ31* const, SVFType type)
+     @brief Set the type of the filter.
+     @param filter A pointer to the relevant tSVFQ31.
+     @} */
+
+    typedef struct tSVFQ31
+    {
+        tMempool* mempool;
+        SVFType type;
+        Lq31 ic1eq, ic2eq;
+        Lq31 a1, a2, a3;
+        int32_t cH, cB, cL;     // output mix in Q4.27
+        Lfloat cutoff, Q;
+        Lfloat sampleRate, invSampleRate;
+    } tSVFQ31;
+
+    void    tSVFQ31_init             (tSVFQ31** const, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf);
+    void    tSVFQ31_initToPool       (tSVFQ31** const, SVFType type, Lfloat freq, Lfloat Q, tMempool** const);
+    void    tSVFQ31_free             (tSVFQ31** const);
+
+    Lq31    tSVFQ31_tick             (tSVFQ31* const, Lq31 input);
+    void    tSVFQ31_setFreq          (tSVFQ31* const, Lfloat freq);
+    void    tSVFQ31_setQ             (tSVFQ31* const, Lfloat Q);
+    void    tSVFQ31_setFreqAndQ      (tSVFQ31* const, Lfloat freq, Lfloat Q);
+    void    tSVFQ31_setFilterType    (tSVFQ31* const, SVFType type);
+    void    tSVFQ31_setSampleRate    (tSVFQ31* const, Lfloat sr);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tbiquadq31 tBiQuadQ31
+     @ingroup fixed
+     @brief Fixed-point version of tBiQuad. Direct form I with coefficients in Q2.30 (so they can reach ±2) and a 64-bit accumulator.
+     @{
+
+     @fn void    tBiQuadQ31_init(tBiQuadQ31** const, LEAF* const leaf)
+     @brief Initialize a tBiQuadQ31 to the default mempool of a LEAF instance. It passes nothing until coefficients are set.
+     @param filter A pointer to the tBiQuadQ31 to initialize.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tBiQuadQ31_initToPool(tBiQuadQ31** const, tMempool** const)
+     @brief Initialize a tBiQuadQ31 to a specified mempool.
+     @param filter A pointer to the tBiQuadQ31 to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tBiQuadQ31_free(tBiQuadQ31** const)
+     @brief Free a tBiQuadQ31 from its mempool.
+     @param filter A pointer to the tBiQuadQ31 to free.
+
+     @fn Lq31    tBiQuadQ31_tick(tBiQuadQ31* const, Lq31 input)
+     @brief Tick a tBiQuadQ31.
+     @param filter A pointer to the relevant tBiQuadQ31.
+     @param input The input sample in Q31.
+     @return The filtered sample in Q31.
+
+     @fn void    tBiQuadQ31_setCoefficients(tBiQuadQ31* const, Lfloat b0, Lfloat b1, Lfloat b2, Lfloat a1, Lfloat a2)
+     @brief Set the coefficients, using the same sign convention as tBiQuad. Each is clamped to ±2.
+     @param filter A pointer to the relevant tBiQuadQ31.
+
+     @fn void    tBiQuadQ31_clear(tBiQuadQ31* const)
+     @brief Clear the filter state.
+     @param filter A pointer to the relevant tBiQuadQ31.
+     @} */
+
+    typedef struct tBiQuadQ31
+    {
+        tMempool* mempool;
+        int32_t b0, b1, b2, a1, a2;     // Q2.30
+        Lq31 lastIn[2], lastOut[2];
+    } tBiQuadQ31;
+
+    void    tBiQuadQ31_init              (tBiQuadQ31** const, LEAF* const leaf);
+    void    tBiQuadQ31_initToPool        (tBiQuadQ31** const, tMempool** const);
+    void    tBiQuadQ31_free              (tBiQuadQ31** const);
+
+    Lq31    tBiQuadQ31_tick              (tBiQuadQ31* const, Lq31 input);
+    void    tBiQuadQ31_setCoefficients   (tBiQuadQ31* const, Lfloat b0, Lfloat b1, Lfloat b2, Lfloat a1, Lfloat a2);
+    void    tBiQuadQ31_clear             (tBiQuadQ31* const);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tdelayq31 tDelayQ31
+     @ingroup fixed
+     @brief Fixed-point version of tDelay, a non-interpolating delay line.
+     @{
+
+     @fn void    tDelayQ31_init(tDelayQ31** const, uint32_t delay, uint32_t maxDelay, LEAF* const leaf)
+     @brief Initialize a tDelayQ31 to the default mempool of a LEAF instance.
+     @param delay A pointer to the tDelayQ31 to initialize.
+     @param delay The initial delay in samples.
+     @param maxDelay The maximum delay in samples.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tDelayQ31_initToPool(tDelayQ31** const, uint32_t delay, uint32_t maxDelay, tMempool** const)
+     @brief Initialize a tDelayQ31 to a specified mempool.
+     @param delay A pointer to the tDelayQ31 to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tDelayQ31_free(tDelayQ31** const)
+     @brief Free a tDelayQ31 from its mempool.
+     @param delay A pointer to the tDelayQ31 to free.
+
+     @fn Lq31    tDelayQ31_tick(tDelayQ31* const, Lq31 input)
+     @brief Write a sample and read the delayed one.
+     @param delay A pointer to the relevant tDelayQ31.
+
+     @fn void    tDelayQ31_setDelay(tDelayQ31* const, uint32_t delay)
+     @brief Set the delay in samples, clamped to the maximum.
+     @param delay A pointer to the relevant tDelayQ31.
+
+     @fn Lq31    tDelayQ31_tapOut(tDelayQ31* const, uint32_t tapDelay)
+     @brief Read the sample written tapDelay samples before the most recent one.
+     @param delay A pointer to the relevant tDelayQ31.
+
+     @fn void    tDelayQ31_clear(tDelayQ31* const)
+     @brief Zero the delay buffer.
+     @param delay A pointer to the relevant tDelayQ31.
+     @} */
+
+    typedef struct tDelayQ31
+    {
+        tMempool* mempool;
+        Lq31* buff;
+        uint32_t inPoint, outPoint;
+        uint32_t delay, maxDelay;
+    } tDelayQ31;
+
+    void    tDelayQ31_init           (tDelayQ31** const, uint32_t delay, uint32_t maxDelay, LEAF* const leaf);
+    void    tDelayQ31_initToPool     (tDelayQ31** const, uint32_t delay, uint32_t maxDelay, tMempool** const);
+    void    tDelayQ31_free           (tDelayQ31** const);
+
+    Lq31    tDelayQ31_tick           (tDelayQ31* const, Lq31 input);
+    void    tDelayQ31_setDelay       (tDelayQ31* const, uint32_t delay);
+    uint32_t tDelayQ31_getDelay      (tDelayQ31* const);
+    Lq31    tDelayQ31_tapOut         (tDelayQ31* const, uint32_t tapDelay);
+    void    tDelayQ31_clear          (tDelayQ31* const);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tadsrsq31 tADSRSQ31
+     @ingroup fixed
+     @brief Fixed-point version of tADSRS, the exponential ADSR without lookup tables. The envelope runs in Q1.30 internally because the attack target overshoots 1.
+     @{
+
+     @fn void    tADSRSQ31_init(tADSRSQ31** const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf)
+     @brief Initialize a tADSRSQ31 to the default mempool of a LEAF instance.
+     @param envelope A pointer to the tADSRSQ31 to initialize.
+     @param attack Attack time in ms.
+     @param decay Decay time in ms.
+     @param sustain Sustain level from 0 to 1.
+     @param release Release time in ms.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tADSRSQ31_initToPool(tADSRSQ31** const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool** const)
+     @brief Initialize a tADSRSQ31 to a specified mempool.
+     @param envelope A pointer to the tADSRSQ31 to initialize.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tADSRSQ31_free(tADSRSQ31** const)
+     @brief Free a tADSRSQ31 from its mempool.
+     @param envelope A pointer to the tADSRSQ31 to free.
+
+     @fn Lq31    tADSRSQ31_tick(tADSRSQ31* const)
+     @brief Tick a tADSRSQ31.
+     @param envelope A pointer to the relevant tADSRSQ31.
+     @return The envelope value times the smoothed velocity gain, in Q31.
+
+     @fn void    tADSRSQ31_on(tADSRSQ31* const, Lq31 velocity)
+     @brief Start the envelope.
+     @param envelope A pointer to the relevant tADSRSQ31.
+     @param velocity The velocity in Q31. Like tADSRS, the output is scaled by its square.
+
+     @fn void    tADSRSQ31_off(tADSRSQ31* const)
+     @brief Release the envelope.
+     @param envelope A pointer to the relevant tADSRSQ31.
+     @} */
+
+    typedef struct tADSRSQ31
+    {
+        tMempool* mempool;
+        int state;
+        Lq31 output;                                    // Q1.30
+        Lq31 attackCoef, decayCoef, releaseCoef;        // Q31
+        Lq31 attackBase, decayBase, releaseBase;        // Q1.30
+        Lq31 sustainLevel;                              // Q1.30
+        Lq31 leakFactor;                                // Q31
+        Lq31 gain, targetGainSquared;                   // Q31
+        Lfloat attack, decay, sustain, release, baseLeakFactor;
+        Lfloat sampleRate, sampleRateInMs;
+    } tADSRSQ31;
+
+    void    tADSRSQ31_init           (tADSRSQ31** const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf);
+    void    tADSRSQ31_initToPool     (tADSRSQ31** const, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool** const);
+    void    tADSRSQ31_free           (tADSRSQ31** const);
+
+    Lq31    tADSRSQ31_tick           (tADSRSQ31* const);
+    void    tADSRSQ31_setAttack      (tADSRSQ31* const, Lfloat attack);
+    void    tADSRSQ31_setDecay       (tADSRSQ31* const, Lfloat decay);
+    void    tADSRSQ31_setSustain     (tADSRSQ31* const, Lfloat sustain);
+    void    tADSRSQ31_setRelease     (tADSRSQ31* const, Lfloat release);
+    void    tADSRSQ31_setLeakFactor  (tADSRSQ31* const, Lfloat leakFactor);
+    void    tADSRSQ31_on             (tADSRSQ31* const, Lq31 velocity);
+    void    tADSRSQ31_off            (tADSRSQ31* const);
+    void    tADSRSQ31_setSampleRate  (tADSRSQ31* const, Lfloat sr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_FIXED_H_INCLUDED
+
+//==============================================================================
+
@@ -16,14 +16,50 @@ extern "C" {
 #endif
     
 #include "leaf-mempool.h"
+#include "leaf-kernels.h"
     
 #if _WIN32 || _WIN64
 #include "..\leaf-config.h"
 #else
 #include "../leaf-config.h"
 #endif
+    
+    // Linkage for the functions that LEAF_INLINE_TICKS moves into the headers.
+    // LEAF_TICK_ITCM marks the ones that go in ITCM RAM on targets that define ITCMRAM.
+#if LEAF_INLINE_TICKS
+#define LEAF_TICK static inline
+#define LEAF_TICK_ITCM static inline
+#else
+#define LEAF_TICK
+#ifdef ITCMRAM
+#define LEAF_TICK_ITCM __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))
+#else
+#define LEAF_TICK_ITCM
+#endif
+#endif
+    
+    // Marks old names that are kept so existing code still compiles
+#if defined(__GNUC__) || defined(__clang__)
+#define LEAF_DEPRECATED(msg) __attribute__ ((deprecated(msg)))
+#elif defined(_MSC_VER)
+#define LEAF_DEPRECATED(msg) __declspec(deprecated(msg))
+#else
+#define LEAF_DEPRECATED(msg)
+#endif
+    
     typedef struct tLookupTable tLookupTable;
 
+    /*!
+     * @ingroup leaf
+     * @brief When objects that support it (tVZFilter, tVocoder) recompute their coefficients after a setter is called.
+     */
+    typedef enum LEAFCoeffMode
+    {
+        LEAFCoeffsImmediate = 0, //!< Every setter recomputes the coefficients right away. The default.
+        LEAFCoeffsLazy, //!< Setters only store the parameter and mark the object dirty. The coefficients are recomputed once, at the next tick.
+        LEAFCoeffsInterpolated //!< Like LEAFCoeffsLazy, and block ticks also ramp linearly from the old coefficients to the new ones across the block.
+    } LEAFCoeffMode;
+
     /*!
      * @ingroup leaf
      * @brief Struct for an instance of LEAF.
@@ -48,6 +84,7 @@ extern "C" {
         tLookupTable* lfoRateTable;
         tLookupTable* envTimeTable;
         tLookupTable* resTable;
+        LEAFKernels kernels; //!< Inner loops bound to the best versions for the CPU. Set with LEAF_setCPUFeatures().
 
         ///@}
     };
@@ -0,0 +1,94 @@
+/*==============================================================================
+
+ leaf-kernels.h
+ Created: 19 Oct 2026 2:41:17pm
+
+ ==============================================================================*/
+
+#ifndef LEAF_KERNELS_H_INCLUDED
+#define LEAF_KERNELS_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //==============================================================================
+
+#include <stdint.h>
+
+#if _WIN32 || _WIN64
+#include "..\leaf-config.h"
+#else
+#include "../leaf-config.h"
+#endif
+
+    //==============================================================================
+
+    /*!
+     @defgroup leafkernels LEAFKernels
+     @ingroup kernels
+     @brief Table of inner loops bound to the best versions for the CPU at runtime.
+     @details The few inner loops that vectorise well (the FIR multiply-accumulates in tOversampler, the XOR-popcount in tBACF and the interpolated reads in tSOLAD) are called through a LEAFKernels table held in each LEAF instance. LEAF_init detects the CPU with LEAF_detectCPUFeatures and binds the table to the widest version the machine can run, so one binary built for baseline x86-64 still uses AVX2 or AVX-512 where they are there. On x86 the wider versions are compiled with GCC/Clang target attributes, so no extra compiler flags are needed. On ARM NEON is part of the baseline. When LEAF_USE_CMSIS is on, the CMSIS-DSP versions are bound instead. Call LEAF_setCPUFeatures to force a narrower set, for example to test the scalar path on a machine that has AVX2.
+
+     Objects keep a pointer to the table of the LEAF instance they were made with, so LEAF_setCPUFeatures takes effect on existing objects too. Vector versions add up their products in a different order from the scalar ones, so results can differ in the last bits.
+     @{
+     */
+
+    //! CPU features LEAF can dispatch on, as bits of a mask.
+    typedef enum LEAFCPUFeature
+    {
+        LEAF_CPU_SSE2       = 1 << 0,
+        LEAF_CPU_SSE41      = 1 << 1,
+        LEAF_CPU_POPCNT     = 1 << 2,
+        LEAF_CPU_AVX        = 1 << 3,
+        LEAF_CPU_AVX2       = 1 << 4,
+        LEAF_CPU_FMA        = 1 << 5,
+        LEAF_CPU_AVX512F    = 1 << 6,
+        LEAF_CPU_NEON       = 1 << 7,
+        LEAF_CPU_CMSIS      = 1 << 8
+    } LEAFCPUFeature;
+
+    //! Table of hot inner loops, bound to the best version for the CPU.
+    typedef struct LEAFKernels
+    {
+        uint32_t features; //!< The feature mask the table was bound for.
+        const char* name; //!< Name of the widest instruction set in use, for logging.
+
+        //! Sum of a[i] * b[i] for i in [0, n).
+        Lfloat (*dot)(const Lfloat* a, const Lfloat* b, int n);
+
+        //! Number of set bits in a[i] ^ b[i] for i in [0, n).
+        int (*xorPopcount)(const unsigned int* a, const unsigned int* b, int n);
+
+        //! Same as xorPopcount, with b read as a bitstream starting shift bits into b[0]. Reads b[n]. shift is 1 to 31.
+        int (*xorPopcountShifted)(const unsigned int* a, const unsigned int* b, int n, int shift);
+
+        //! out[i] += lerp(buf, pos + i * step) for i in [0, n), where lerp(buf, p) = buf[j] + f * (buf[j + 1] - buf[j]) with p >= 0 split into whole part w and fraction f, and j = w & mask. Reads buf[mask + 1]. The SSE2 version gives the same results as the scalar one.
+        void (*lerpRampAdd)(Lfloat* out, const Lfloat* buf, int mask, Lfloat pos, Lfloat step, int n);
+
+        //! Crossfading lerpRampAdd: out[i] += lerp(buf, p) * (1 - g) + lerp(buf, p - offset) * g, where p = pos + i * step and g = gain - i * gainStep.
+        void (*lerpRampCrossfadeAdd)(Lfloat* out, const Lfloat* buf, int mask, Lfloat pos, Lfloat step, Lfloat offset, Lfloat gain, Lfloat gainStep, int n);
+    } LEAFKernels;
+
+    //! Detect the CPU features available to the calling process.
+    /*!
+     @return A mask of LEAFCPUFeature bits. Features the OS has not enabled (for example AVX state that is not saved on context switches) are left out.
+     */
+    uint32_t    LEAF_detectCPUFeatures  (void);
+
+    //! Bind a kernel table to the widest versions that only use the given features.
+    /*!
+     @param kernels The table to fill in.
+     @param features A mask of LEAFCPUFeature bits. Pass 0 for the plain C versions.
+     */
+    void        LEAF_bindKernels        (LEAFKernels* const kernels, uint32_t features);
+
+    /*! @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_KERNELS_H_INCLUDED
+
+//==============================================================================
@@ -18,6 +18,7 @@ extern "C" {
 #include "stdint.h"
 #include "stdlib.h"
 #include "limits.h"
+#include "float.h"
 #include "leaf-tables.h"
     //==============================================================================
     
@@ -148,6 +149,16 @@ static inline int   LEAF_clipInt(int min, int val, int max)
     }
 }
 
+// Zero out denormal values, the ones smaller than FLT_MIN, in a feedback path. Compiles to nothing when LEAF_NO_DENORMAL_CHECK is set.
+static inline Lfloat LEAF_flushDenormal(Lfloat x)
+{
+#if LEAF_NO_DENORMAL_CHECK
+    return x;
+#else
+    return (fabsf(x) < FLT_MIN) ? 0.0f : x;
+#endif
+}
+
 
 // This is a fast approximation to log2() found on http://openaudio.blogspot.com/2017/02/faster-log10-and-pow.html credited to this post https://community.arm.com/developer/tools-software/tools/f/armds-forum/4292/cmsis-dsp-new-functionality-proposal/22621#22621
 // Y = C[0]*F*F*F + C[1]*F*F + C[2]*F + C[3] + E;
@@ -877,6 +888,16 @@ static inline Lfloat LEAF_interpolation_linear (Lfloat A, Lfloat B, Lfloat alpha
     return out;
 }
 
+// Fill out[0..n) with a line that starts one step after from and lands on to.
+// Used by the control-rate tickBlock functions to spread one tick over the samples it covers.
+static inline void LEAF_interpolateBlock (Lfloat* out, int n, Lfloat from, Lfloat to)
+{
+    Lfloat step = (to - from) / (Lfloat) n;
+    for (int i = 0; i < n - 1; i++)
+        out[i] = from + step * (Lfloat) (i + 1);
+    out[n - 1] = to;
+}
+
 
 
 static inline Lfloat mtof(Lfloat f)
@@ -1013,6 +1034,13 @@ static inline Lfloat minimum (Lfloat num1, Lfloat num2)
     //==============================================================================
 #if LEAF_INCLUDE_MINBLEP_TABLES
 #ifdef ITCMRAM
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) add_step_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale);
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) add_slope_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale);
+#else
+void add_step_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale);
+void add_slope_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale);
+#endif
+#ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) place_step_dd(Lfloat *buffer, int index, Lfloat phase, Lfloat w, Lfloat scale);
 #else
 void place_step_dd(Lfloat *buffer, int index, Lfloat phase, Lfloat w, Lfloat scale);
@@ -198,6 +198,11 @@ extern "C" {
      @brief
      @param
      
+     @fn void    tPoly_setSamplesPerTick     (tPoly* const poly, int samplesPerTick)
+     @brief Run the pitch glide and bend ramps at control rate, each tick covering samplesPerTick samples. Glide and bend times stay the same.
+     @param poly A pointer to the relevant tPoly.
+     @param samplesPerTick How many samples each tick covers. 1 (the default) is audio rate.
+     
      @fn void    tPoly_tickPitch             (tPoly* const poly)
      @brief Execute all tick-rate changes in the poly handler's pitch, including glide and bend.
      @param poly A pointer to the relevant tPoly.
@@ -210,6 +215,12 @@ extern "C" {
      @brief Execute the tick-rate change of the poly handler's pitch bend.
      @param poly A pointer to the relevant tPoly.
      
+     @fn void    tPoly_tickPitchBlock        (tPoly* const poly, Lfloat** pitches, int numSamples)
+     @brief Fill a block with the pitch of every voice, glide and bend included. Ticks the ramps once every samplesPerTick samples (see tPoly_setSamplesPerTick) and interpolates linearly in between. numSamples should be a multiple of samplesPerTick.
+     @param poly A pointer to the relevant tPoly.
+     @param pitches One buffer per voice, for all maxNumVoices voices, filled with fractional MIDI note numbers.
+     @param numSamples The number of samples to write to each buffer.
+     
      @fn int     tPoly_getNumVoices          (tPoly* const poly)
      @brief Get the current number of voices available to play notes.
      @param poly A pointer to the relevant tPoly.
@@ -281,6 +292,7 @@ extern "C" {
         int currentVoice;
         int currentVelocity;
         int maxLength;
+        int samplesPerTick;
     } tPoly;
 
     void    tPoly_init                  (tPoly** const poly, int maxNumVoices, LEAF* const leaf);
@@ -290,6 +302,7 @@ extern "C" {
     void    tPoly_tickPitch             (tPoly* const poly);
     void    tPoly_tickPitchGlide        (tPoly* const poly);
     void    tPoly_tickPitchBend         (tPoly* const poly);
+    void    tPoly_tickPitchBlock        (tPoly* const poly, Lfloat** pitches, int numSamples);
 
     int     tPoly_noteOn                (tPoly* const poly, int note, uint8_t vel);
     int     tPoly_noteOff               (tPoly* const poly, uint8_t note);
@@ -300,6 +313,7 @@ extern "C" {
     void    tPoly_setPitchBend          (tPoly* const poly, Lfloat pitchBend);
     void 	tPoly_setBendGlideTime		(tPoly* const poly, Lfloat t);
     void 	tPoly_setBendSamplesPerTick	(tPoly* const poly, Lfloat t);
+    void    tPoly_setSamplesPerTick     (tPoly* const poly, int samplesPerTick);
     int     tPoly_getNumVoices          (tPoly* const poly);
     int     tPoly_getNumActiveVoices    (tPoly* const poly);
     Lfloat  tPoly_getPitch              (tPoly* const poly, uint8_t voice);
@@ -78,10 +78,10 @@ extern "C" {
     void    tCycle_free          (tCycle** const osc);
 
     // Tick function for `tCycle`
-    Lfloat  tCycle_tick          (tCycle* const osc);
+    LEAF_TICK Lfloat  tCycle_tick          (tCycle* const osc);
 
     // Setter functions for `tCycle`
-    void    tCycle_setFreq       (tCycle* const osc, Lfloat freq);
+    LEAF_TICK void    tCycle_setFreq       (tCycle* const osc, Lfloat freq);
     void    tCycle_setPhase      (tCycle* const osc, Lfloat phase);
     void    tCycle_setSampleRate (tCycle* const osc, Lfloat sr);
     
@@ -493,18 +493,11 @@ extern "C" {
     void    tPBSaw_initToPool    (tPBSaw** const osc, tMempool** const mempool);
     void    tPBSaw_free          (tPBSaw** const osc);
     
-#ifdef ITCMRAM
-    Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSaw_tick          (tPBSaw* const osc);
-#else
     // Tick function for `tPBSaw`
-    Lfloat  tPBSaw_tick          (tPBSaw* const osc);
-#endif
-#ifdef ITCMRAM
-    void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq);
-#else
+    LEAF_TICK_ITCM Lfloat  tPBSaw_tick          (tPBSaw* const osc);
+
     // Setter functions for `tPBSaw`
-    void    tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq);
-#endif
+    LEAF_TICK_ITCM void    tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq);
     void    tPBSaw_setSampleRate (tPBSaw* const osc, Lfloat sr);
     
     //==============================================================================
@@ -622,10 +615,10 @@ typedef struct tPBSawSquare
     void    tPhasor_free          (tPhasor** const osc);
 
     // Tick function for `tPhasor`
-    Lfloat  tPhasor_tick          (tPhasor* const osc);
+    LEAF_TICK Lfloat  tPhasor_tick          (tPhasor* const osc);
 
     // Setter functions for `tPhasor`
-    void    tPhasor_setFreq       (tPhasor* const osc, Lfloat freq);
+    LEAF_TICK void    tPhasor_setFreq       (tPhasor* const osc, Lfloat freq);
     void    tPhasor_setSampleRate (tPhasor* const osc, Lfloat sr);
     
     //==============================================================================
@@ -880,12 +873,7 @@ typedef struct tPBSawSquare
         Lfloat   _p, _w, _b, _x, _z;
         Lfloat _inv_w;
         int     _j, _k;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][2];
+        Lfloat   _f[FILLEN + STEP_DD_PULSE_LENGTH];
         Lfloat invSampleRate;
 
     } tMBPulse;
@@ -895,10 +883,11 @@ typedef struct tPBSawSquare
     void    tMBPulse_initToPool             (tMBPulse** const osc, tMempool** const mempool);
     void    tMBPulse_free                   (tMBPulse** const osc);
 #ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPulse_place_step_dd(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
 #else
-    void    tMBPulse_place_step_dd_noBuffer (tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
+    void    tMBPulse_place_step_dd (tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
 #endif
+    LEAF_DEPRECATED("use tMBPulse_place_step_dd") void tMBPulse_place_step_dd_noBuffer (tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
     // Tick function for `tMBPulse`
     Lfloat  tMBPulse_tick                   (tMBPulse* const osc);
 
@@ -966,13 +955,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
         int     _j, _k;
         Lfloat _inv_w;
         Lfloat 	shape;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t maxBLEPphaseSlope;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][3];
+        Lfloat   _f[FILLEN + STEP_DD_PULSE_LENGTH];
         Lfloat invSampleRate;
     } tMBTriangle;
 
@@ -981,11 +964,12 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
     void    tMBTriangle_initToPool        (tMBTriangle** const osc, tMempool** const mempool);
     void    tMBTriangle_free              (tMBTriangle** const osc);
 #ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTriangle_place_dd(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
 #else
-    void    tMBTriangle_place_dd_noBuffer (tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale,
-                                           Lfloat stepOrSlope, Lfloat w);
+    void    tMBTriangle_place_dd (tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale,
+                                  Lfloat stepOrSlope, Lfloat w);
 #endif
+    LEAF_DEPRECATED("use tMBTriangle_place_dd") void tMBTriangle_place_dd_noBuffer (tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
 
     // Tick function for `tMBTriangle`
     Lfloat  tMBTriangle_tick              (tMBTriangle* const osc);
@@ -1018,13 +1002,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTri
         Lfloat shape;
         int     _j, _k;
         Lfloat _inv_w;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t maxBLEPphaseSlope;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][3];
+        Lfloat   _f[FILLEN + STEP_DD_PULSE_LENGTH];
         Lfloat invSampleRate;
         uint32_t sineMask;
     } tMBSineTri;
@@ -1034,11 +1012,12 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTri
     void    tMBSineTri_initToPool        (tMBSineTri** const osc, tMempool** const mempool);
     void    tMBSineTri_free              (tMBSineTri** const osc);
 #ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSineTri_place_dd(tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
 #else
-    void    tMBSineTri_place_dd_noBuffer (tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale,
-                                          Lfloat stepOrSlope, Lfloat w);
+    void    tMBSineTri_place_dd (tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale,
+                                 Lfloat stepOrSlope, Lfloat w);
 #endif
+    LEAF_DEPRECATED("use tMBSineTri_place_dd") void tMBSineTri_place_dd_noBuffer (tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w);
     // Tick function for `tMBSineTri`
     Lfloat  tMBSineTri_tick              (tMBSineTri* const osc);
 
@@ -1105,12 +1084,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
         Lfloat   _p, _w, _z;
         Lfloat   _inv_w;
         int     _j;
-        Lfloat   _f[8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t 	BLEPindices[64];
-        Lfloat 	BLEPproperties[64][2];
+        Lfloat   _f[FILLEN + STEP_DD_PULSE_LENGTH];
         Lfloat invSampleRate;
     } tMBSaw;
 
@@ -1119,7 +1093,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
     void    tMBSaw_initToPool             (tMBSaw** const osc, tMempool** const mempool);
     void    tMBSaw_free                   (tMBSaw** const osc);
 
-    void    tMBSaw_place_step_dd_noBuffer (tMBSaw* const osc, int index, Lfloat phase, Lfloat w, Lfloat scale);
+    void    tMBSaw_place_step_dd (tMBSaw* const osc, int index, Lfloat phase, Lfloat w, Lfloat scale);
+    LEAF_DEPRECATED("use tMBSaw_place_step_dd") void tMBSaw_place_step_dd_noBuffer (tMBSaw* const osc, int index, Lfloat phase, Lfloat w, Lfloat scale);
 
     // Tick function for `tMBSaw`
     Lfloat  tMBSaw_tick                   (tMBSaw* const osc);
@@ -1188,12 +1163,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
         Lfloat _inv_w;
         Lfloat invSampleRate;
         Lfloat 	shape;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][2];
+        Lfloat   _f[FILLEN + STEP_DD_PULSE_LENGTH];
         Lfloat gain;
         int active;
 
@@ -1204,11 +1174,12 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
     void    tMBSawPulse_initToPool             (tMBSawPulse** const osc, tMempool** const mempool);
     void    tMBSawPulse_free                   (tMBSawPulse** const osc);
 #ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_place_step_dd(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
 #else
-    void    tMBSawPulse_place_step_dd_noBuffer (tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w,
-                                                Lfloat scale);
+    void    tMBSawPulse_place_step_dd (tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w,
+                                       Lfloat scale);
 #endif
+    LEAF_DEPRECATED("use tMBSawPulse_place_step_dd") void tMBSawPulse_place_step_dd_noBuffer (tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale);
     // Tick function for `tMBSawPulse`
     Lfloat  tMBSawPulse_tick                   (tMBSawPulse* const osc);
 
@@ -1735,6 +1706,17 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @fn void    tTriLFO_setFreq     (tTriLFO* const osc, Lfloat freq)
      @brief
      @param osc A pointer to the relevant tTriLFO.
+     
+     @fn void    tTriLFO_setSamplesPerTick (tTriLFO* const osc, int samplesPerTick)
+     @brief Run the LFO at control rate. Each tick then advances it by samplesPerTick samples, so the frequency stays the same.
+     @param osc A pointer to the relevant tTriLFO.
+     @param samplesPerTick How many samples each tick covers. 1 (the default) is audio rate.
+     
+     @fn void    tTriLFO_tickBlock   (tTriLFO* const osc, Lfloat* output, int numSamples)
+     @brief Fill a block with the LFO, ticking once every samplesPerTick samples and interpolating linearly in between. numSamples should be a multiple of samplesPerTick.
+     @param osc A pointer to the relevant tTriLFO.
+     @param output The buffer to fill.
+     @param numSamples The number of samples to write.
      ￼￼￼
      @} */
     
@@ -1747,6 +1729,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         Lfloat freq;
         Lfloat invSampleRate;
         Lfloat invSampleRateTimesTwoTo32;
+        int samplesPerTick;
     } tTriLFO;
 
     // Memory handlers for `tTriLFO`
@@ -1761,6 +1744,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void    tTriLFO_setFreq       (tTriLFO* const osc, Lfloat freq);
     void    tTriLFO_setSampleRate (tTriLFO* const osc, Lfloat sr);
     void    tTriLFO_setPhase      (tTriLFO* const cy, Lfloat phase);
+    void    tTriLFO_setSamplesPerTick (tTriLFO* const osc, int samplesPerTick);
+    void    tTriLFO_tickBlock     (tTriLFO* const osc, Lfloat* output, int numSamples);
 
     typedef struct tSineTriLFO
     {
@@ -1768,6 +1753,9 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         Lfloat shape;
         tTriLFO*  tri;
         tCycle*  sine;
+        Lfloat freq;
+        Lfloat output;
+        int samplesPerTick;
     } tSineTriLFO;
 
     // Memory handlers for `tSineTriLFO`
@@ -1783,6 +1771,9 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void    tSineTriLFO_setSampleRate (tSineTriLFO* const osc, Lfloat sr);
     void    tSineTriLFO_setPhase      (tSineTriLFO* const cy, Lfloat phase);
     void    tSineTriLFO_setShape      (tSineTriLFO* const cy, Lfloat shape);
+    // Control rate, see tTriLFO_setSamplesPerTick and tTriLFO_tickBlock
+    void    tSineTriLFO_setSamplesPerTick (tSineTriLFO* const osc, int samplesPerTick);
+    void    tSineTriLFO_tickBlock     (tSineTriLFO* const osc, Lfloat* output, int numSamples);
 
 
 
@@ -1842,6 +1833,87 @@ typedef struct tDampedOscillator
 #ifdef __cplusplus
 }
 #endif
+#define LEAF_OSCILLATORS_H_DECLARED
 #endif  // LEAF_OSCILLATORS_H_INCLUDED
 
+//==============================================================================
+
+// Tick and hot setter definitions. With LEAF_INLINE_TICKS they are static inline in every file
+// that includes this header; otherwise leaf-oscillators.c defines LEAF_OSCILLATORS_C and compiles them once.
+// LEAF_OSCILLATORS_H_DECLARED holds them back in a circular include that gets here before the types above.
+#if (LEAF_INLINE_TICKS || defined(LEAF_OSCILLATORS_C)) && defined(LEAF_OSCILLATORS_H_DECLARED) && !defined(LEAF_OSCILLATORS_TICKS_DEFINED)
+#define LEAF_OSCILLATORS_TICKS_DEFINED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LEAF_INCLUDE_SINE_TABLE
+//need to check bounds and wrap table properly to allow through-zero FM
+LEAF_TICK Lfloat tCycle_tick(tCycle* const c)
+{
+    uint32_t tempFrac;
+    uint32_t idx;
+    Lfloat samp0;
+    Lfloat samp1;
+    
+    // Phasor increment
+    c->phase += c->inc;
+    // Wavetable synthesis
+    idx = c->phase >> 21; //11 bit table 
+    tempFrac = (c->phase & 2097151u); //(2^21 - 1) all the lower bits i.e. the remainder of a division by 2^21  (2097151 is the 21 bits after the 11 bits that represent the main index)
+    
+    samp0 = __leaf_table_sinewave[idx];
+    idx = (idx + 1) & c->mask;
+    samp1 = __leaf_table_sinewave[idx];
+    
+    return (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f)); // 1/2097151 
+}
+
+LEAF_TICK void tCycle_setFreq(tCycle* const c, Lfloat freq)
+{
+    
+    //if (!isfinite(freq)) return;
+    
+    c->freq  = freq;
+    c->inc = freq * c->invSampleRateTimesTwoTo32;
+}
+#endif // LEAF_INCLUDE_SINE_TABLE
+
+LEAF_TICK_ITCM Lfloat tPBSaw_tick(tPBSaw* const c)
+{
+    Lfloat out = (c->phase * INV_TWO_TO_31) - 1.0f;
+
+    Lfloat phaseFloat = c->phase * INV_TWO_TO_32;
+    Lfloat incFloat = c->inc * INV_TWO_TO_32;
+    out -= LEAF_poly_blep(phaseFloat, incFloat);
+    c->phase += c->inc;
+    return (-1.0f * out);
+}
+
+LEAF_TICK_ITCM void tPBSaw_setFreq(tPBSaw* const c, Lfloat freq)
+{
+    c->freq  = freq;
+    c->inc = freq * c->invSampleRateTimesTwoTo32;
+}
+
+LEAF_TICK Lfloat tPhasor_tick(tPhasor* const p)
+{
+    p->phase += p->inc; // no need to phase wrap, since integer overflow does it for us
+    return p->phase * INV_TWO_TO_32; //smush back to 0.0-1.0 range
+}
+
+LEAF_TICK void tPhasor_setFreq(tPhasor* const p, Lfloat freq)
+{
+    p->freq  = freq;
+    p->inc = freq * p->invSampleRateTimesTwoTo32;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_OSCILLATORS_TICKS_DEFINED
+
+
 //==============================================================================
@@ -0,0 +1,412 @@
+/*==============================================================================
+
+ leaf-parallel.h
+ Created: 18 Oct 2026 10:12:03am
+
+ ==============================================================================*/
+
+#ifndef LEAF_PARALLEL_H_INCLUDED
+#define LEAF_PARALLEL_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //==============================================================================
+
+#include "leaf-math.h"
+#include "leaf-mempool.h"
+
+#if LEAF_USE_THREADS
+#include <pthread.h>
+#endif
+
+    //==============================================================================
+
+    /*!
+     @ingroup parallel
+     @{
+     */
+
+    // Atomic helpers shared by the multithreaded objects. These map to the GCC/Clang
+    // __atomic builtins so they work the same whether LEAF is compiled as C or C++.
+    // They are real atomics even without LEAF_USE_THREADS, since objects like tSPSCRingBuffer
+    // are shared with threads the host starts. Only use them on 32-bit or smaller values
+    // outside LEAF_USE_THREADS code, as 64-bit atomics aren't lock-free on every target.
+#if defined(__GNUC__) || defined(__clang__)
+#define LEAF_atomicLoad(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define LEAF_atomicStore(ptr, val)      __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#define LEAF_atomicAdd(ptr, val)        __atomic_add_fetch((ptr), (val), __ATOMIC_ACQ_REL)
+#define LEAF_atomicCAS(ptr, exp, val)   __atomic_compare_exchange_n((ptr), (exp), (val), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+    // No atomics for other compilers yet, so these objects are single-threaded there
+#define LEAF_atomicLoad(ptr)            (*(ptr))
+#define LEAF_atomicStore(ptr, val)      (*(ptr) = (val))
+#define LEAF_atomicAdd(ptr, val)        (*(ptr) += (val))
+#define LEAF_atomicCAS(ptr, exp, val)   ((*(ptr) == *(exp)) ? (*(ptr) = (val), 1) : (*(exp) = *(ptr), 0))
+#endif
+
+    // Aligns a struct member, for example to keep values written by different threads on separate cache lines
+#if defined(__GNUC__) || defined(__clang__)
+#define LEAF_ALIGNED(n) __attribute__ ((aligned (n)))
+#elif defined(_MSC_VER)
+#define LEAF_ALIGNED(n) __declspec(align(n))
+#else
+#define LEAF_ALIGNED(n)
+#endif
+
+    /*! @} */
+
+    //==============================================================================
+
+    /*!
+     @defgroup tjobpool tJobPool
+     @ingroup parallel
+     @brief Fixed pool of worker threads that runs a batch of independent jobs with work stealing.
+     @details The jobs of a batch are split into one queue per thread, the calling thread included. Each thread works through its own queue from the front and then steals from the back of the others. Any queue whose worker has not woken up yet is drained by the calling thread, so a batch never waits on a sleeping worker, only on jobs that are already running. Workers pick up the calling thread's floating point mode (see LEAF_enableFlushToZero) at the start of every batch. Requires LEAF_USE_THREADS; without it every batch runs on the calling thread.
+     @{
+
+     @fn void    tJobPool_init(tJobPool** const, int numWorkers, LEAF* const leaf)
+     @brief Initialize a tJobPool to the default mempool of a LEAF instance and start its worker threads.
+     @param pool A pointer to the tJobPool to initialize.
+     @param numWorkers The number of worker threads to start in addition to the calling thread.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tJobPool_initToPool(tJobPool** const, int numWorkers, tMempool** const)
+     @brief Initialize a tJobPool to a specified mempool and start its worker threads.
+     @param pool A pointer to the tJobPool to initialize.
+     @param numWorkers The number of worker threads to start in addition to the calling thread.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tJobPool_free(tJobPool** const)
+     @brief Stop the worker threads and free a tJobPool from its mempool.
+     @param pool A pointer to the tJobPool to free.
+
+     @fn int     tJobPool_run(tJobPool* const, tJobFunction job, void* context, int numJobs, Lfloat deadline)
+     @brief Run job(context, 0) through job(context, numJobs - 1) and return when all of them have finished.
+     @param pool A pointer to the relevant tJobPool.
+     @param job The function to run for each job index. It may run on any thread and must not allocate from a mempool.
+     @param context A pointer passed back to the job function.
+     @param numJobs The number of jobs in the batch.
+     @param deadline The time in seconds the calling thread may wait on the workers. 0 for no deadline.
+     @return 1 if the batch finished after the deadline, 0 otherwise.
+
+     @fn int     tJobPool_getNumWorkers(tJobPool* const)
+     @brief Get the number of worker threads that are running.
+     @param pool A pointer to the relevant tJobPool.
+     @return The number of worker threads, not counting the calling thread.
+
+     @} */
+
+    typedef void (*tJobFunction)(void* context, int job);
+
+    typedef struct tJobPool tJobPool;
+
+    typedef struct _tJobWorker
+    {
+        tJobPool* pool;
+        int lane;
+    } _tJobWorker;
+
+    struct tJobPool
+    {
+        tMempool* mempool;
+
+        int numWorkers;
+        int numLanes;
+
+        tJobFunction job;
+        void* context;
+        uint64_t* queues;       // per lane: head index in the low word, tail index in the high word
+        int remaining;
+
+        _tJobWorker* workers;
+#if LEAF_USE_THREADS
+        pthread_t* threads;
+        pthread_mutex_t mutex;
+        pthread_cond_t cond;
+#endif
+        uint32_t generation;
+        uint32_t fpState;       // floating point control state of the thread that called tJobPool_run
+        int running;
+    };
+
+    void    tJobPool_init           (tJobPool** const, int numWorkers, LEAF* const leaf);
+    void    tJobPool_initToPool     (tJobPool** const, int numWorkers, tMempool** const);
+    void    tJobPool_free           (tJobPool** const);
+
+    int     tJobPool_run            (tJobPool* const, tJobFunction job, void* context, int numJobs, Lfloat deadline);
+    int     tJobPool_getNumWorkers  (tJobPool* const);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tvoicescheduler tVoiceScheduler
+     @ingroup parallel
+     @brief Renders independent voices on a pool of worker threads and mixes them in a fixed order.
+     @details Each voice is a render callback that writes one block into its own buffer. The active voices of each block are run as one batch on a tJobPool. Voices are always summed in voice index order, so the output is bit-identical to single-threaded rendering regardless of which thread rendered which voice. If the workers hold the audio thread past the deadline, the scheduler falls back to rendering on the calling thread alone for a number of blocks. Requires LEAF_USE_THREADS; without it every block is rendered on the calling thread.
+     @{
+
+     @fn void    tVoiceScheduler_init(tVoiceScheduler** const, int numVoices, int numWorkers, int maxBlockSize, LEAF* const leaf)
+     @brief Initialize a tVoiceScheduler to the default mempool of a LEAF instance.
+     @param scheduler A pointer to the tVoiceScheduler to initialize.
+     @param numVoices The number of voices to schedule.
+     @param numWorkers The number of worker threads to start in addition to the calling thread.
+     @param maxBlockSize The largest block size that will be passed to tVoiceScheduler_render().
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tVoiceScheduler_initToPool(tVoiceScheduler** const, int numVoices, int numWorkers, int maxBlockSize, tMempool** const)
+     @brief Initialize a tVoiceScheduler to a specified mempool.
+     @param scheduler A pointer to the tVoiceScheduler to initialize.
+     @param numVoices The number of voices to schedule.
+     @param numWorkers The number of worker threads to start in addition to the calling thread.
+     @param maxBlockSize The largest block size that will be passed to tVoiceScheduler_render().
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tVoiceScheduler_free(tVoiceScheduler** const)
+     @brief Stop the worker threads and free a tVoiceScheduler from its mempool.
+     @param scheduler A pointer to the tVoiceScheduler to free.
+
+     @fn void    tVoiceScheduler_render(tVoiceScheduler* const, Lfloat* output, int numSamples)
+     @brief Render all active voices and write their sum to the output block.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @param output The block to write the mix to. It is overwritten, not added to.
+     @param numSamples The number of samples to render. Cannot be greater than the max block size given on initialization.
+
+     @fn void    tVoiceScheduler_setVoice(tVoiceScheduler* const, int voice, tVoiceRenderCallback render, void* userData)
+     @brief Set the render callback of a voice. The callback may run on any thread and must not allocate from a mempool.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @param voice The voice to set.
+     @param render The function that renders one block of the voice into the buffer it is given.
+     @param userData A pointer passed back to the callback, usually the voice's LEAF objects.
+
+     @fn void    tVoiceScheduler_setVoiceActive(tVoiceScheduler* const, int voice, int active)
+     @brief Set whether a voice is rendered and mixed. Inactive voices cost nothing.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @param voice The voice to set.
+     @param active 1 to render the voice, 0 to skip it.
+
+     @fn void    tVoiceScheduler_setDeadline(tVoiceScheduler* const, Lfloat seconds)
+     @brief Set how long the calling thread will wait on the workers before counting the block as a missed deadline.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @param seconds The deadline in seconds from the start of tVoiceScheduler_render(). 0 disables the fallback.
+
+     @fn void    tVoiceScheduler_setFallbackBlocks(tVoiceScheduler* const, int numBlocks)
+     @brief Set how many blocks are rendered on the calling thread alone after a missed deadline.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @param numBlocks The number of single-threaded blocks.
+
+     @fn int     tVoiceScheduler_getMissedDeadlines(tVoiceScheduler* const)
+     @brief Get the number of blocks that have missed the deadline since initialization.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @return The number of missed deadlines.
+
+     @fn Lfloat* tVoiceScheduler_getVoiceBuffer(tVoiceScheduler* const, int voice)
+     @brief Get the buffer holding the last block rendered by a voice.
+     @param scheduler A pointer to the relevant tVoiceScheduler.
+     @param voice The voice to get the buffer of.
+     @return A pointer to the voice's buffer.
+
+     @} */
+
+    typedef void (*tVoiceRenderCallback)(void* userData, Lfloat* output, int numSamples);
+
+    typedef struct tVoiceScheduler
+    {
+        tMempool* mempool;
+
+        tJobPool* pool;
+
+        int numVoices;
+        int maxBlockSize;
+
+        tVoiceRenderCallback* render;
+        void** userData;
+        int* active;
+        Lfloat** buffers;
+
+        int* jobs;              // active voices of the current block
+        int numSamples;
+
+        Lfloat deadline;
+        int fallbackBlocks;
+        int fallbackCount;
+        int missedDeadlines;
+    } tVoiceScheduler;
+
+    void    tVoiceScheduler_init                (tVoiceScheduler** const, int numVoices, int numWorkers, int maxBlockSize, LEAF* const leaf);
+    void    tVoiceScheduler_initToPool          (tVoiceScheduler** const, int numVoices, int numWorkers, int maxBlockSize, tMempool** const);
+    void    tVoiceScheduler_free                (tVoiceScheduler** const);
+
+    void    tVoiceScheduler_render              (tVoiceScheduler* const, Lfloat* output, int numSamples);
+
+    void    tVoiceScheduler_setVoice            (tVoiceScheduler* const, int voice, tVoiceRenderCallback render, void* userData);
+    void    tVoiceScheduler_setVoiceActive      (tVoiceScheduler* const, int voice, int active);
+    void    tVoiceScheduler_setDeadline         (tVoiceScheduler* const, Lfloat seconds);
+    void    tVoiceScheduler_setFallbackBlocks   (tVoiceScheduler* const, int numBlocks);
+    int     tVoiceScheduler_getMissedDeadlines  (tVoiceScheduler* const);
+    Lfloat* tVoiceScheduler_getVoiceBuffer      (tVoiceScheduler* const, int voice);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tgraph tGraph
+     @ingroup parallel
+     @brief Dataflow patch graph of LEAF objects, compiled into a fixed execution order and run a block at a time.
+     @details Nodes wrap LEAF objects and edges carry audio or control blocks between node ports. Several edges into one input port are summed. tGraph_compile() sorts the nodes into levels where every node only depends on earlier levels, and assigns each edge a block buffer, reusing buffers once their last reader has run. Nodes within a level are independent and are dispatched on a tJobPool when the graph has worker threads. Build and compile the graph outside the audio callback; tGraph_process() does no allocation.
+     @{
+
+     @fn void    tGraph_init(tGraph** const, int maxNodes, int maxEdges, int numInputs, int numOutputs, int maxBlockSize, int numWorkers, LEAF* const leaf)
+     @brief Initialize a tGraph to the default mempool of a LEAF instance.
+     @param graph A pointer to the tGraph to initialize.
+     @param maxNodes The maximum number of nodes.
+     @param maxEdges The maximum number of edges.
+     @param numInputs The number of external input blocks passed to tGraph_process().
+     @param numOutputs The number of external output blocks written by tGraph_process().
+     @param maxBlockSize The largest block size that will be passed to tGraph_process().
+     @param numWorkers The number of worker threads used to run independent nodes. 0 to run everything on the calling thread.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tGraph_initToPool(tGraph** const, int maxNodes, int maxEdges, int numInputs, int numOutputs, int maxBlockSize, int numWorkers, tMempool** const)
+     @brief Initialize a tGraph to a specified mempool.
+     @param graph A pointer to the tGraph to initialize.
+     @param maxNodes The maximum number of nodes.
+     @param maxEdges The maximum number of edges.
+     @param numInputs The number of external input blocks passed to tGraph_process().
+     @param numOutputs The number of external output blocks written by tGraph_process().
+     @param maxBlockSize The largest block size that will be passed to tGraph_process().
+     @param numWorkers The number of worker threads used to run independent nodes. 0 to run everything on the calling thread.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tGraph_free(tGraph** const)
+     @brief Free a tGraph from its mempool. The wrapped LEAF objects are not freed.
+     @param graph A pointer to the tGraph to free.
+
+     @fn int     tGraph_addNode(tGraph* const, void* object, int numInputs, int numOutputs, tGraphProcessFunction process)
+     @brief Add a node that processes a whole block with a custom function.
+     @param graph A pointer to the relevant tGraph.
+     @param object The LEAF object (or any state) passed back to the process function.
+     @param numInputs The number of input ports. Cannot be greater than LEAF_GRAPH_MAX_PORTS.
+     @param numOutputs The number of output ports. Cannot be greater than LEAF_GRAPH_MAX_PORTS.
+     @param process The function that reads the input blocks and writes the output blocks.
+     @return The index of the new node, or -1 if the graph is full, a port count is out of range or process is NULL.
+
+     @fn int     tGraph_addGenerator(tGraph* const, void* object, tGraphTickFunction tick)
+     @brief Add a node with no inputs and one output from a LEAF tick function such as tCycle_tick().
+     @param graph A pointer to the relevant tGraph.
+     @param object The LEAF object.
+     @param tick The object's tick function, cast to tGraphTickFunction.
+     @return The index of the new node, or -1 if the graph is full or tick is NULL.
+
+     @fn int     tGraph_addProcessor(tGraph* const, void* object, tGraphTickInFunction tick)
+     @brief Add a node with one input and one output from a LEAF tick function such as tSVF_tick().
+     @param graph A pointer to the relevant tGraph.
+     @param object The LEAF object.
+     @param tick The object's tick function, cast to tGraphTickInFunction.
+     @return The index of the new node, or -1 if the graph is full or tick is NULL.
+
+     @fn int     tGraph_connect(tGraph* const, int source, int sourcePort, int dest, int destPort)
+     @brief Connect an output port to an input port. Use LEAF_GRAPH_IO as the source to read an external input, or as the destination to write an external output.
+     @param graph A pointer to the relevant tGraph.
+     @param source The source node, or LEAF_GRAPH_IO.
+     @param sourcePort The output port of the source node, or the external input index.
+     @param dest The destination node, or LEAF_GRAPH_IO.
+     @param destPort The input port of the destination node, or the external output index.
+     @return The index of the new edge, or -1 if the graph is full or a port is out of range.
+
+     @fn int     tGraph_compile(tGraph* const)
+     @brief Compute the execution order and buffer assignment. Must be called after changing nodes or edges and before tGraph_process().
+     @param graph A pointer to the relevant tGraph.
+     @return The number of buffers used, or -1 if the graph has a cycle or the buffers could not be allocated.
+
+     @fn void    tGraph_process(tGraph* const, Lfloat** inputs, Lfloat** outputs, int numSamples)
+     @brief Run one block of the compiled graph.
+     @param graph A pointer to the relevant tGraph.
+     @param inputs The external input blocks.
+     @param outputs The external output blocks. They are overwritten, not added to.
+     @param numSamples The number of samples to process. Cannot be greater than the max block size given on initialization.
+
+     @} */
+
+#define LEAF_GRAPH_MAX_PORTS 8
+#define LEAF_GRAPH_IO (-1)
+
+    typedef void (*tGraphProcessFunction)(void* object, Lfloat** inputs, Lfloat** outputs, int numSamples);
+    typedef Lfloat (*tGraphTickFunction)(void* object);
+    typedef Lfloat (*tGraphTickInFunction)(void* object, Lfloat input);
+
+    typedef struct _tGraphNode
+    {
+        void* object;
+        tGraphProcessFunction process;
+        tGraphTickFunction tick;
+        tGraphTickInFunction tickIn;
+        int numInputs;
+        int numOutputs;
+
+        int level;
+        int outputBuffer[LEAF_GRAPH_MAX_PORTS];
+        int inputBuffer[LEAF_GRAPH_MAX_PORTS];
+        int numSources[LEAF_GRAPH_MAX_PORTS];    // > 1 means the port sums into its own buffer
+        int sourceStart[LEAF_GRAPH_MAX_PORTS];   // first entry in the graph's source list
+        Lfloat* inputs[LEAF_GRAPH_MAX_PORTS];
+        Lfloat* outputs[LEAF_GRAPH_MAX_PORTS];
+    } _tGraphNode;
+
+    typedef struct _tGraphEdge
+    {
+        int source, sourcePort;
+        int dest, destPort;
+    } _tGraphEdge;
+
+    typedef struct tGraph
+    {
+        tMempool* mempool;
+
+        tJobPool* pool;
+
+        int maxNodes, numNodes;
+        int maxEdges, numEdges;
+        int numInputs, numOutputs;
+        int maxBlockSize;
+
+        _tGraphNode* nodes;
+        _tGraphEdge* edges;
+
+        int compiled;
+        int numLevels;
+        int* order;             // nodes sorted by level
+        int* levelStart;        // numLevels + 1 offsets into order
+        int* sources;           // source buffers of every port, grouped by port
+        int* outputSourceStart;
+        int* numOutputSources;
+        int* lastUse;           // level after which a buffer can be reused
+        int numBuffers;
+        Lfloat* bufferMemory;
+
+        int currentLevel;
+        int numSamples;
+    } tGraph;
+
+    void    tGraph_init         (tGraph** const, int maxNodes, int maxEdges, int numInputs, int numOutputs, int maxBlockSize, int numWorkers, LEAF* const leaf);
+    void    tGraph_initToPool   (tGraph** const, int maxNodes, int maxEdges, int numInputs, int numOutputs, int maxBlockSize, int numWorkers, tMempool** const);
+    void    tGraph_free         (tGraph** const);
+
+    int     tGraph_addNode      (tGraph* const, void* object, int numInputs, int numOutputs, tGraphProcessFunction process);
+    int     tGraph_addGenerator (tGraph* const, void* object, tGraphTickFunction tick);
+    int     tGraph_addProcessor (tGraph* const, void* object, tGraphTickInFunction tick);
+    int     tGraph_connect      (tGraph* const, int source, int sourcePort, int dest, int destPort);
+    int     tGraph_compile      (tGraph* const);
+
+    void    tGraph_process      (tGraph* const, Lfloat** inputs, Lfloat** outputs, int numSamples);
+
+    //==============================================================================
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_PARALLEL_H_INCLUDED
+
+//==============================================================================
+
@@ -22,6 +22,7 @@ extern "C"
 #include "leaf-envelopes.h"
 #include "leaf-mempool.h"
 #include "leaf-analysis.h"
+#include "leaf-parallel.h"
 
     /*!
      * @internal
@@ -52,6 +53,21 @@ extern "C"
      @param length The length of the buffer in samples.
      @param mempool A pointer to the tMempool to use.
 
+     @fn void  tBuffer_initWithFormat(tBuffer** const, uint32_t length, BufferFormat format, LEAF* const leaf)
+     @brief Initialize a tBuffer that stores its samples in a given format.
+     @details BufferInt16 takes half the memory of a float buffer and BufferInt24 three quarters. Samples are converted to and from Lfloat as they are recorded and read, and the samplers fold the conversion into their interpolation so playback costs the same as a float buffer.
+     @param sampler A pointer to the tBuffer to initialize.
+     @param length The length of the buffer in samples.
+     @param format The storage format of the buffer.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void  tBuffer_initWithFormatToPool(tBuffer** const, uint32_t length, BufferFormat format, tMempool** const)
+     @brief Initialize a tBuffer that stores its samples in a given format to a specified mempool.
+     @param sampler A pointer to the tBuffer to initialize.
+     @param length The length of the buffer in samples.
+     @param format The storage format of the buffer.
+     @param mempool A pointer to the tMempool to use.
+
      @fn void  tBuffer_free(tBuffer** const)
      @brief Free a tBuffer from its mempool.
      @param sampler A pointer to the tBuffer to free.
@@ -62,7 +78,7 @@ extern "C"
      @param input The input sample.
 
      @fn void  tBuffer_read                  (tBuffer* const, Lfloat* buff, uint32_t len)
-     @brief Read an input buffer into the buffer.
+     @brief Read an input buffer into the buffer. Does nothing on a buffer mapped from a file.
      @param sampler A pointer to the relevant tBuffer.
      @param inputBuffer The input buffer.
      @param length The length of the input buffer.
@@ -74,7 +90,7 @@ extern "C"
      @return The recorded sample.
 
      @fn void  tBuffer_record                (tBuffer* const)
-     @brief Start recording samples into the buffer.
+     @brief Start recording samples into the buffer. Does nothing on a buffer mapped from a file, which stays inactive.
      @param sampler A pointer to the relevant tBuffer.
 
      @fn void  tBuffer_stop                  (tBuffer* const)
@@ -97,8 +113,22 @@ extern "C"
      @param mode The new mode, either RecordOneShot to record one buffer length or RecordLoop to record on loop, overwriting old samples.
 
      @fn void  tBuffer_clear                 (tBuffer* const)
-     @brief Clear the buffer.
+     @brief Clear the buffer. Does nothing on a buffer mapped from a file.
+     @param sampler A pointer to the relevant tBuffer.
+
+     @fn void  tBuffer_setBufferWithFormat   (tBuffer* const, void* externalBuffer, int length, int channels, int sampleRate, BufferFormat format)
+     @brief Point the buffer at externally owned sample data in a given format, such as 16-bit sample data kept in flash.
+     @param sampler A pointer to the relevant tBuffer.
+     @param externalBuffer The sample data, interleaved if there is more than one channel.
+     @param length The total number of samples in the data.
+     @param channels The number of channels.
+     @param sampleRate The sample rate of the data.
+     @param format The storage format of the data.
+
+     @fn BufferFormat tBuffer_getFormat      (tBuffer* const)
+     @brief Get the storage format of the buffer.
      @param sampler A pointer to the relevant tBuffer.
+     @return The storage format of the buffer.
 
      @fn uint32_t tBuffer_getBufferLength    (tBuffer* const)
      @brief Get the length of the buffer.
@@ -120,6 +150,30 @@ extern "C"
      @param sampler A pointer to the relevant tBuffer.
      @return 1 if recording, 0 if not.
 
+     @fn int      tBuffer_initFromFile       (tBuffer** const, const char* path, uint32_t preloadLength, LEAF* const leaf)
+     @brief Initialize a tBuffer that plays sample data straight from a memory-mapped file instead of the mempool. Requires LEAF_USE_FILE_STREAMING.
+     @details Accepts 32-bit float, 16-bit and 24-bit PCM WAV files, which are played in place in their own format, or headerless 32-bit float mono files at the LEAF sample rate. Only the first preloadLength frames are read in at initialization; the rest is paged in on demand, ideally ahead of time by a tSampleStreamer. The mapping is read-only, so recording into the buffer is not possible.
+     @param sampler A pointer to the tBuffer to initialize.
+     @param path The path of the file to map.
+     @param preloadLength The number of frames at the start of the file to read in immediately.
+     @param leaf A pointer to the leaf instance.
+     @return 0 on success, -1 if the file could not be opened, mapped or parsed. On failure the buffer is empty but valid.
+
+     @fn int      tBuffer_initFromFileToPool (tBuffer** const, const char* path, uint32_t preloadLength, tMempool** const)
+     @brief Initialize a memory-mapped tBuffer with its struct allocated from a specified mempool.
+     @param sampler A pointer to the tBuffer to initialize.
+     @param path The path of the file to map.
+     @param preloadLength The number of frames at the start of the file to read in immediately.
+     @param mempool A pointer to the tMempool to use.
+     @return 0 on success, -1 if the file could not be opened, mapped or parsed.
+
+     @fn int      tBuffer_prefaultFile       (tBuffer* const, int lock)
+     @brief Read the whole file mapping of a buffer into memory, so the audio thread never waits on a page fault. Call it from a non-audio thread after tBuffer_initFromFile(), since it blocks on the disk.
+     @details Without lock, the pages can still be evicted later under memory pressure. With lock they are pinned with mlock() until the buffer is freed, which counts against RLIMIT_MEMLOCK. Requires LEAF_USE_FILE_STREAMING.
+     @param sampler A pointer to the relevant tBuffer.
+     @param lock 1 to also lock the pages in memory.
+     @return 0 on success, -1 if the buffer is not mapped from a file or the pages could not be locked.
+
      @} */
 
     typedef enum RecordMode
@@ -129,12 +183,22 @@ extern "C"
         RecordModeNil
     } RecordMode;
 
+    typedef enum BufferFormat
+    {
+        BufferFloat = 0,
+        BufferInt16,
+        BufferInt24,
+        BufferFormatNil
+    } BufferFormat;
+
     typedef struct tBuffer
     {
 
         tMempool* mempool;
 
+        // Sample storage. Holds int16_t or packed little-endian 24-bit data unless format is BufferFloat.
         Lfloat *buff;
+        BufferFormat format;
 
         uint32_t idx;
         uint32_t bufferLength;
@@ -144,10 +208,16 @@ extern "C"
         RecordMode mode;
 
         int active;
+
+        void* mapping;
+        size_t mappingSize;
+        uint32_t preloadLength;
     } tBuffer;
 
     void     tBuffer_init              (tBuffer**const, uint32_t length, LEAF *const leaf);
     void     tBuffer_initToPool        (tBuffer**const sb, uint32_t length, tMempool** const mp);
+    void     tBuffer_initWithFormat    (tBuffer**const, uint32_t length, BufferFormat format, LEAF *const leaf);
+    void     tBuffer_initWithFormatToPool(tBuffer**const sb, uint32_t length, BufferFormat format, tMempool** const mp);
     void     tBuffer_free              (tBuffer**const);
 
     void     tBuffer_tick              (tBuffer* const, Lfloat sample);
@@ -161,10 +231,15 @@ extern "C"
     void     tBuffer_setRecordPosition (tBuffer* const, int pos);
     void     tBuffer_setRecordMode     (tBuffer* const, RecordMode mode);
     void     tBuffer_clear             (tBuffer* const);
+    void     tBuffer_setBufferWithFormat(tBuffer* const sb, void *externalBuffer, int length, int channels, int sampleRate, BufferFormat format);
+    BufferFormat tBuffer_getFormat     (tBuffer* const);
     uint32_t tBuffer_getBufferLength   (tBuffer* const);
     uint32_t tBuffer_getRecordedLength (tBuffer* const sb);
     void     tBuffer_setRecordedLength (tBuffer* const sb, int length);
     int      tBuffer_isActive          (tBuffer* const sb);
+    int      tBuffer_initFromFile      (tBuffer** const, const char* path, uint32_t preloadLength, LEAF* const leaf);
+    int      tBuffer_initFromFileToPool(tBuffer** const, const char* path, uint32_t preloadLength, tMempool** const);
+    int      tBuffer_prefaultFile      (tBuffer* const, int lock);
 
     //==============================================================================
 
@@ -194,6 +269,13 @@ extern "C"
      @brief
      @param sampler A pointer to the relevant tSampler.
 
+     @fn void    tSampler_tickBlock          (tSampler* const, Lfloat* output, int numSamples)
+     @brief Render a block of mono output. Gives the same output as calling tSampler_tick numSamples times.
+     @details The loop and crossfade geometry is resolved once per segment, and the stretches of the block that play straight through the buffer run in a tight interpolation loop. Crossfades, start/end changes and note ends fall back to per-sample ticking.
+     @param sampler A pointer to the relevant tSampler.
+     @param output The buffer to write numSamples samples to.
+     @param numSamples The number of samples to render.
+
      @fn void    tSampler_setSample          (tSampler* const, tBuffer* const)
      @brief
      @param sampler A pointer to the relevant tSampler.
@@ -285,6 +367,7 @@ extern "C"
 
     Lfloat  tSampler_tick               (tSampler* const);
     Lfloat  tSampler_tickStereo         (tSampler* const sp, Lfloat *outputArray);
+    void    tSampler_tickBlock          (tSampler* const, Lfloat* output, int numSamples);
 
     void    tSampler_setSample          (tSampler* const, tBuffer* const);
     void    tSampler_setMode            (tSampler* const, PlayMode mode);
@@ -300,6 +383,84 @@ extern "C"
 
     //==============================================================================
 
+    /*!
+     @defgroup tsamplestreamer tSampleStreamer
+     @ingroup sampling
+     @brief Background prefetcher that keeps the file data ahead of each tSampler's play head resident.
+     @details Works with tBuffers initialized with tBuffer_initFromFile(). Once per block the audio thread publishes the play position of each registered tSampler with tSampleStreamer_update(). The prefetch pass reads in the window of frames ahead of every play head (and the start of the loop for looping voices), so the audio thread finds the pages already in memory. With LEAF_USE_THREADS the pass runs on its own thread; otherwise call tSampleStreamer_process() from a low priority thread of your own. Requires LEAF_USE_FILE_STREAMING.
+     @{
+
+     @fn void    tSampleStreamer_init(tSampleStreamer** const, int maxVoices, uint32_t prefetchLength, LEAF* const leaf)
+     @brief Initialize a tSampleStreamer to the default mempool of a LEAF instance.
+     @param streamer A pointer to the tSampleStreamer to initialize.
+     @param maxVoices The number of tSamplers that can be registered.
+     @param prefetchLength The number of frames to keep resident ahead of each play head.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tSampleStreamer_initToPool(tSampleStreamer** const, int maxVoices, uint32_t prefetchLength, tMempool** const)
+     @brief Initialize a tSampleStreamer to a specified mempool.
+     @param streamer A pointer to the tSampleStreamer to initialize.
+     @param maxVoices The number of tSamplers that can be registered.
+     @param prefetchLength The number of frames to keep resident ahead of each play head.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tSampleStreamer_free(tSampleStreamer** const)
+     @brief Stop the prefetch thread and free a tSampleStreamer from its mempool.
+     @param streamer A pointer to the tSampleStreamer to free.
+
+     @fn void    tSampleStreamer_setVoice(tSampleStreamer* const, int voice, tSampler* const sampler)
+     @brief Register the tSampler whose play head a voice slot follows.
+     @param streamer A pointer to the relevant tSampleStreamer.
+     @param voice The voice slot.
+     @param sampler The tSampler to follow, or NULL to clear the slot.
+
+     @fn void    tSampleStreamer_update(tSampleStreamer* const)
+     @brief Publish the current play positions. Call once per block from the audio thread.
+     @param streamer A pointer to the relevant tSampleStreamer.
+
+     @fn void    tSampleStreamer_process(tSampleStreamer* const)
+     @brief Run one prefetch pass over the published play positions. Never call this from the audio thread.
+     @param streamer A pointer to the relevant tSampleStreamer.
+
+     @} */
+
+    typedef struct _tStreamVoice
+    {
+        tBuffer* buffer;
+        uint32_t position;
+        uint32_t loopStart;
+        int direction;
+        int looping;
+    } _tStreamVoice;
+
+    typedef struct tSampleStreamer
+    {
+        tMempool* mempool;
+
+        int maxVoices;
+        uint32_t prefetchLength;
+        tSampler** samplers;
+        _tStreamVoice* voices;
+        uint32_t* sequence;     // odd while the audio thread is writing a voice
+        size_t pageSize;
+        volatile char sink;
+
+#if LEAF_USE_THREADS
+        pthread_t thread;
+        int running;
+#endif
+    } tSampleStreamer;
+
+    void    tSampleStreamer_init        (tSampleStreamer** const, int maxVoices, uint32_t prefetchLength, LEAF* const leaf);
+    void    tSampleStreamer_initToPool  (tSampleStreamer** const, int maxVoices, uint32_t prefetchLength, tMempool** const);
+    void    tSampleStreamer_free        (tSampleStreamer** const);
+
+    void    tSampleStreamer_setVoice    (tSampleStreamer* const, int voice, tSampler* const sampler);
+    void    tSampleStreamer_update      (tSampleStreamer* const);
+    void    tSampleStreamer_process     (tSampleStreamer* const);
+
+    //==============================================================================
+
     /*!
      @defgroup tautosampler tAutoSampler
      @ingroup sampling
@@ -0,0 +1,474 @@
+/*==============================================================================
+
+ leaf-simdmath.h
+ Created: 18 Oct 2026 2:41:17pm
+
+ ==============================================================================*/
+
+#ifndef LEAF_SIMDMATH_H_INCLUDED
+#define LEAF_SIMDMATH_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //==============================================================================
+
+#include "leaf-math.h"
+#include <string.h>
+#include <float.h>
+
+    //==============================================================================
+
+    /*!
+     @defgroup simdmath SIMD Math
+     @ingroup math
+     @brief Vectorised transcendental functions and the scalar accuracy tiers.
+     @details Every kernel works on an Lfloatv of LEAF_SIMD_WIDTH lanes. With GCC or Clang that is a native vector (8 lanes when compiled with AVX, 4 otherwise, so SSE and NEON targets get 128-bit vectors); any other compiler gets a plain float and the same code runs one lane at a time. Define LEAF_SIMD_WIDTH yourself to force a width.
+
+     The kernels are single-precision Cephes polynomials with a vector-friendly range reduction. The error bounds below were measured against double-precision libm over the stated input range; outside those ranges the results saturate rather than becoming inf or NaN.
+
+     | function        | input range                | max error                              |
+     |-----------------|----------------------------|----------------------------------------|
+     | LEAF_vexp2f     | [-126, 127]                | 1.0e-7 relative                        |
+     | LEAF_vexpf      | [-87.3, 88]                | 8.0e-8 relative                        |
+     | LEAF_vlogf      | [FLT_MIN, FLT_MAX]         | 8.0e-8 relative, 3.9e-8 absolute near 1 |
+     | LEAF_vlog2f     | [FLT_MIN, FLT_MAX]         | 1.3e-7 relative, 9.5e-8 absolute near 1 |
+     | LEAF_vpowf      | a > 0, abs(b*log2(a)) < 125 | 1.2e-7 * (1 + abs(b*log2(a))) relative |
+     | LEAF_vsinf      | [-8192, 8192]              | 7.7e-8 absolute                        |
+     | LEAF_vcosf      | [-8192, 8192]              | 7.7e-8 absolute                        |
+     | LEAF_vtanf      | (-pi/2, pi/2)              | 1.7e-7 relative                        |
+     | LEAF_vtanhf     | all                        | 7.6e-8 absolute, 1.4e-7 relative       |
+     | LEAF_vmtof      | [0, 135]                   | 5.5e-7 relative                        |
+     | LEAF_vdbtoa     | [-120, 120]                | 7.7e-7 relative                        |
+     | LEAF_vatodb     | [FLT_MIN, FLT_MAX]         | 1.7e-7 relative, 7.8e-7 absolute near 1 |
+
+     The _block versions apply a kernel to a whole buffer, handling any remainder that does not fill a vector, and may be called in place.
+     @{
+     */
+
+#ifndef LEAF_SIMD_WIDTH
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__AVX__)
+#define LEAF_SIMD_WIDTH 8
+#else
+#define LEAF_SIMD_WIDTH 4
+#endif
+#else
+#define LEAF_SIMD_WIDTH 1
+#endif
+#endif
+
+#if LEAF_SIMD_WIDTH > 1
+    typedef float Lfloatv __attribute__((vector_size(LEAF_SIMD_WIDTH * 4)));
+    typedef int32_t Lintv __attribute__((vector_size(LEAF_SIMD_WIDTH * 4)));
+    // Vector comparisons already give all-ones lanes.
+#define LEAF_VMASK(c)       (c)
+#define LEAF_VTOINT(v)      __builtin_convertvector((v), Lintv)
+#define LEAF_VTOFLOAT(v)    __builtin_convertvector((v), Lfloatv)
+#else
+    typedef float Lfloatv;
+    typedef int32_t Lintv;
+#define LEAF_VMASK(c)       (-(Lintv)(c))
+#define LEAF_VTOINT(v)      ((Lintv)(v))
+#define LEAF_VTOFLOAT(v)    ((Lfloatv)(v))
+#endif
+
+    static inline Lfloatv LEAF_vset1(float x)
+    {
+        Lfloatv v = { 0 };
+        return v + x;
+    }
+
+    static inline Lfloatv LEAF_vload(const float* p)
+    {
+        Lfloatv v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    static inline void LEAF_vstore(float* p, Lfloatv v)
+    {
+        memcpy(p, &v, sizeof(v));
+    }
+
+    static inline Lintv LEAF_vasInt(Lfloatv v)
+    {
+        Lintv i;
+        memcpy(&i, &v, sizeof(i));
+        return i;
+    }
+
+    static inline Lfloatv LEAF_vasFloat(Lintv i)
+    {
+        Lfloatv v;
+        memcpy(&v, &i, sizeof(v));
+        return v;
+    }
+
+    // Lanes where mask is all ones take a, the rest take b.
+    static inline Lfloatv LEAF_vselect(Lintv mask, Lfloatv a, Lfloatv b)
+    {
+        return LEAF_vasFloat((mask & LEAF_vasInt(a)) | (~mask & LEAF_vasInt(b)));
+    }
+
+    static inline Lfloatv LEAF_vmin(Lfloatv a, Lfloatv b)
+    {
+        return LEAF_vselect(LEAF_VMASK(a < b), a, b);
+    }
+
+    static inline Lfloatv LEAF_vmax(Lfloatv a, Lfloatv b)
+    {
+        return LEAF_vselect(LEAF_VMASK(a > b), a, b);
+    }
+
+    static inline Lfloatv LEAF_vabs(Lfloatv x)
+    {
+        return LEAF_vasFloat(LEAF_vasInt(x) & 0x7fffffff);
+    }
+
+    static inline Lfloatv LEAF_vexp2f(Lfloatv x)
+    {
+        x = LEAF_vmin(LEAF_vmax(x, LEAF_vset1(-126.0f)), LEAF_vset1(127.0f));
+        // x + 127.5 is positive so truncating rounds x to nearest and adds the exponent bias
+        Lintv n = LEAF_VTOINT(x + 127.5f);
+        Lfloatv f = x - (LEAF_VTOFLOAT(n) - 127.0f);
+        Lfloatv p = LEAF_vset1(1.535336188319500E-4f);
+        p = p * f + 1.339887440266574E-3f;
+        p = p * f + 9.618437357674640E-3f;
+        p = p * f + 5.550332471162809E-2f;
+        p = p * f + 2.402264791363012E-1f;
+        p = p * f + 6.931472028550421E-1f;
+        p = p * f + 1.0f;
+        return p * LEAF_vasFloat(n << 23);
+    }
+
+    static inline Lfloatv LEAF_vexpf(Lfloatv x)
+    {
+        x = LEAF_vmin(LEAF_vmax(x, LEAF_vset1(-87.3f)), LEAF_vset1(88.0f));
+        Lintv n = LEAF_VTOINT(x * 1.44269504088896341f + 127.5f);
+        Lfloatv fn = LEAF_VTOFLOAT(n) - 127.0f;
+        // Cody-Waite reduction with ln2 split into an exact high part and a correction
+        x = x - fn * 0.693359375f;
+        x = x - fn * -2.12194440e-4f;
+        Lfloatv z = x * x;
+        Lfloatv p = LEAF_vset1(1.9875691500E-4f);
+        p = p * x + 1.3981999507E-3f;
+        p = p * x + 8.3334519073E-3f;
+        p = p * x + 4.1665795894E-2f;
+        p = p * x + 1.6666665459E-1f;
+        p = p * x + 5.0000001201E-1f;
+        p = p * z + x + 1.0f;
+        return p * LEAF_vasFloat(n << 23);
+    }
+
+    static inline Lfloatv LEAF_vlogf(Lfloatv x)
+    {
+        x = LEAF_vmax(x, LEAF_vset1(FLT_MIN));
+        Lintv i = LEAF_vasInt(x);
+        Lintv e = (i >> 23) - 126;
+        // mantissa in [0.5, 1)
+        x = LEAF_vasFloat((i & 0x807fffff) | 0x3f000000);
+        Lintv small = LEAF_VMASK(x < 0.707106781186547524f);
+        e = e + small;
+        x = x - 1.0f + LEAF_vselect(small, x, LEAF_vset1(0.0f));
+        Lfloatv fe = LEAF_VTOFLOAT(e);
+        Lfloatv z = x * x;
+        Lfloatv y = LEAF_vset1(7.0376836292E-2f);
+        y = y * x - 1.1514610310E-1f;
+        y = y * x + 1.1676998740E-1f;
+        y = y * x - 1.2420140846E-1f;
+        y = y * x + 1.4249322787E-1f;
+        y = y * x - 1.6668057665E-1f;
+        y = y * x + 2.0000714765E-1f;
+        y = y * x - 2.4999993993E-1f;
+        y = y * x + 3.3333331174E-1f;
+        y = y * x * z;
+        y = y + fe * -2.12194440e-4f;
+        y = y - 0.5f * z;
+        return x + y + fe * 0.693359375f;
+    }
+
+    static inline Lfloatv LEAF_vlog2f(Lfloatv x)
+    {
+        return LEAF_vlogf(x) * 1.44269504088896341f;
+    }
+
+    //! a must be positive.
+    static inline Lfloatv LEAF_vpowf(Lfloatv a, Lfloatv b)
+    {
+        return LEAF_vexpf(b * LEAF_vlogf(a));
+    }
+
+    // Shared pi/4 octant reduction for sin, cos and tan. Returns the reduced
+    // argument and the even octant index j in 0..6.
+    static inline Lfloatv LEAF_vreduceOctant(Lfloatv ax, Lintv* j)
+    {
+        Lintv q = LEAF_VTOINT(ax * 1.27323954473516f);
+        q = (q + 1) & ~1;
+        Lfloatv y = LEAF_VTOFLOAT(q);
+        *j = q & 7;
+        return ((ax - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+    }
+
+    static inline Lfloatv LEAF_vsinPoly(Lfloatv z, Lfloatv zz)
+    {
+        Lfloatv p = LEAF_vset1(-1.9515295891E-4f);
+        p = p * zz + 8.3321608736E-3f;
+        p = p * zz - 1.6666654611E-1f;
+        return p * zz * z + z;
+    }
+
+    static inline Lfloatv LEAF_vcosPoly(Lfloatv zz)
+    {
+        Lfloatv p = LEAF_vset1(2.443315711809948E-5f);
+        p = p * zz - 1.388731625493765E-3f;
+        p = p * zz + 4.166664568298827E-2f;
+        return p * zz * zz - 0.5f * zz + 1.0f;
+    }
+
+    static inline Lfloatv LEAF_vsinf(Lfloatv x)
+    {
+        Lintv j;
+        Lfloatv z = LEAF_vreduceOctant(LEAF_vabs(x), &j);
+        Lfloatv zz = z * z;
+        Lintv sign = (LEAF_vasInt(x) ^ LEAF_VMASK((j & 4) != 0)) & INT32_MIN;
+        Lfloatv r = LEAF_vselect(LEAF_VMASK((j & 2) == 0), LEAF_vsinPoly(z, zz), LEAF_vcosPoly(zz));
+        return LEAF_vasFloat(LEAF_vasInt(r) ^ sign);
+    }
+
+    static inline Lfloatv LEAF_vcosf(Lfloatv x)
+    {
+        Lintv j;
+        Lfloatv z = LEAF_vreduceOctant(LEAF_vabs(x), &j);
+        Lfloatv zz = z * z;
+        // negative in octants 2 and 4
+        Lintv sign = LEAF_VMASK(((j ^ (j << 1)) & 4) != 0) & INT32_MIN;
+        Lfloatv r = LEAF_vselect(LEAF_VMASK((j & 2) == 0), LEAF_vcosPoly(zz), LEAF_vsinPoly(z, zz));
+        return LEAF_vasFloat(LEAF_vasInt(r) ^ sign);
+    }
+
+    static inline Lfloatv LEAF_vtanf(Lfloatv x)
+    {
+        Lintv j;
+        Lfloatv z = LEAF_vreduceOctant(LEAF_vabs(x), &j);
+        Lfloatv zz = z * z;
+        Lfloatv y = LEAF_vset1(9.38540185543E-3f);
+        y = y * zz + 3.11992232697E-3f;
+        y = y * zz + 2.44301354525E-2f;
+        y = y * zz + 5.34112807005E-2f;
+        y = y * zz + 1.33387994085E-1f;
+        y = y * zz + 3.33331568548E-1f;
+        y = y * zz * z + z;
+        y = LEAF_vselect(LEAF_VMASK((j & 2) == 0), y, -1.0f / y);
+        return LEAF_vasFloat(LEAF_vasInt(y) ^ (LEAF_vasInt(x) & INT32_MIN));
+    }
+
+    static inline Lfloatv LEAF_vtanhf(Lfloatv x)
+    {
+        Lfloatv ax = LEAF_vmin(LEAF_vabs(x), LEAF_vset1(9.0f));
+        Lfloatv big = 1.0f - 2.0f / (LEAF_vexpf(ax + ax) + 1.0f);
+        Lfloatv zz = ax * ax;
+        Lfloatv p = LEAF_vset1(-5.70498872745E-3f);
+        p = p * zz + 2.06390887954E-2f;
+        p = p * zz - 5.37397155531E-2f;
+        p = p * zz + 1.33314422036E-1f;
+        p = p * zz - 3.33332819422E-1f;
+        p = p * zz * ax + ax;
+        Lfloatv r = LEAF_vselect(LEAF_VMASK(ax < 0.625f), p, big);
+        return LEAF_vasFloat(LEAF_vasInt(r) | (LEAF_vasInt(x) & INT32_MIN));
+    }
+
+    static inline Lfloatv LEAF_vmtof(Lfloatv m)
+    {
+        return LEAF_vexp2f((m - 69.0f) * 0.0833333333333333f) * 440.0f;
+    }
+
+    static inline Lfloatv LEAF_vdbtoa(Lfloatv db)
+    {
+        return LEAF_vexp2f(db * 0.166096404744368f);
+    }
+
+    static inline Lfloatv LEAF_vatodb(Lfloatv a)
+    {
+        return LEAF_vlogf(a) * 8.68588963806504f;
+    }
+
+    //==============================================================================
+
+#define LEAF_SIMDMATH_BLOCK(name, kernel)                                       \
+    static inline void name(Lfloat* out, const Lfloat* in, int numSamples)      \
+    {                                                                           \
+        int i = 0;                                                              \
+        for (; i + LEAF_SIMD_WIDTH <= numSamples; i += LEAF_SIMD_WIDTH)         \
+            LEAF_vstore(out + i, kernel(LEAF_vload(in + i)));                   \
+        if (i < numSamples)                                                     \
+        {                                                                       \
+            float tail[LEAF_SIMD_WIDTH] = { 0 };                                \
+            memcpy(tail, in + i, (size_t)(numSamples - i) * sizeof(float));     \
+            LEAF_vstore(tail, kernel(LEAF_vload(tail)));                        \
+            memcpy(out + i, tail, (size_t)(numSamples - i) * sizeof(float));    \
+        }                                                                       \
+    }
+
+    LEAF_SIMDMATH_BLOCK(LEAF_exp2f_block, LEAF_vexp2f)
+    LEAF_SIMDMATH_BLOCK(LEAF_expf_block, LEAF_vexpf)
+    LEAF_SIMDMATH_BLOCK(LEAF_logf_block, LEAF_vlogf)
+    LEAF_SIMDMATH_BLOCK(LEAF_log2f_block, LEAF_vlog2f)
+    LEAF_SIMDMATH_BLOCK(LEAF_sinf_block, LEAF_vsinf)
+    LEAF_SIMDMATH_BLOCK(LEAF_cosf_block, LEAF_vcosf)
+    LEAF_SIMDMATH_BLOCK(LEAF_tanf_block, LEAF_vtanf)
+    LEAF_SIMDMATH_BLOCK(LEAF_tanhf_block, LEAF_vtanhf)
+    LEAF_SIMDMATH_BLOCK(LEAF_mtof_block, LEAF_vmtof)
+    LEAF_SIMDMATH_BLOCK(LEAF_dbtoa_block, LEAF_vdbtoa)
+    LEAF_SIMDMATH_BLOCK(LEAF_atodb_block, LEAF_vatodb)
+
+    //==============================================================================
+
+    // Scalar functions that follow LEAF_MATH_ACCURACY from leaf-config.h.
+    // 0 calls libm, 1 runs the vector kernels above on a single value, and 2 uses
+    // the cheaper approximations from leaf-math.h where there is one with a usable
+    // range (errors measured over the same ranges as the table above):
+    //   LEAF_expf   fastExp4        1.2e-5 relative
+    //   LEAF_exp2f  fastexp2f       3.5e-6 relative
+    //   LEAF_logf   my_faster_logf  1.9e-5 absolute
+    //   LEAF_log2f  log2f_approx    1.3e-3 absolute
+    //   LEAF_powf   fastPowf        15% relative for a in [0.01, 100], b in [-3, 3]
+    //   LEAF_tanhf  fast_tanh5      1.9e-3 absolute
+    //   LEAF_mtof   fast_mtof       2.9% relative
+    //   LEAF_dbtoa  fasterdbtoa     9% relative at +-60 dB
+    // sin, cos and tan have no full-range approximation in leaf-math.h so tier 2 uses tier 1.
+
+#define LEAF_SIMDMATH_LANE0(kernel, x) LEAF_vstore1(kernel(LEAF_vset1(x)))
+
+    static inline Lfloat LEAF_vstore1(Lfloatv v)
+    {
+        float out[LEAF_SIMD_WIDTH];
+        LEAF_vstore(out, v);
+        return out[0];
+    }
+
+    static inline Lfloat LEAF_expf(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return expf(x);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vexpf, x);
+#else
+        return fastExp4(x);
+#endif
+    }
+
+    static inline Lfloat LEAF_exp2f(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return exp2f(x);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vexp2f, x);
+#else
+        return fastexp2f(x);
+#endif
+    }
+
+    static inline Lfloat LEAF_logf(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return logf(x);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vlogf, x);
+#else
+        return my_faster_logf(x);
+#endif
+    }
+
+    static inline Lfloat LEAF_log2f(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return log2f(x);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vlog2f, x);
+#else
+        return log2f_approx(x);
+#endif
+    }
+
+    static inline Lfloat LEAF_powf(Lfloat a, Lfloat b)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return powf(a, b);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_vstore1(LEAF_vpowf(LEAF_vset1(a), LEAF_vset1(b)));
+#else
+        return fastPowf(a, b);
+#endif
+    }
+
+    static inline Lfloat LEAF_sinf(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return sinf(x);
+#else
+        return LEAF_SIMDMATH_LANE0(LEAF_vsinf, x);
+#endif
+    }
+
+    static inline Lfloat LEAF_cosf(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return cosf(x);
+#else
+        return LEAF_SIMDMATH_LANE0(LEAF_vcosf, x);
+#endif
+    }
+
+    static inline Lfloat LEAF_tanf(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return tanf(x);
+#else
+        return LEAF_SIMDMATH_LANE0(LEAF_vtanf, x);
+#endif
+    }
+
+    static inline Lfloat LEAF_tanhf(Lfloat x)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return tanhf(x);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vtanhf, x);
+#else
+        return fast_tanh5(x);
+#endif
+    }
+
+    static inline Lfloat LEAF_mtof(Lfloat m)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return mtof(m);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vmtof, m);
+#else
+        return fast_mtof(m);
+#endif
+    }
+
+    static inline Lfloat LEAF_dbtoa(Lfloat db)
+    {
+#if LEAF_MATH_ACCURACY == 0
+        return dbtoa(db);
+#elif LEAF_MATH_ACCURACY == 1
+        return LEAF_SIMDMATH_LANE0(LEAF_vdbtoa, db);
+#else
+        return fasterdbtoa(db);
+#endif
+    }
+
+    /*! @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_SIMDMATH_H_INCLUDED
+
+//==============================================================================
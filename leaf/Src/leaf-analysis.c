@@ -22,6 +22,10 @@
 #include "../../TestPlugin/JuceLibraryCode/JuceHeader.h"
 #endif
 
+#if LEAF_USE_THREADS
+#include <time.h>
+#endif
+
 /******************************************************************************/
 /*                            Envelope Follower                               */
 /******************************************************************************/
@@ -61,8 +65,7 @@ Lfloat tEnvelopeFollower_tick (tEnvelopeFollower* const e, Lfloat x)
     //ef->y = envelope_pow[(uint16_t)(ef->y * (Lfloat)UINT16_MAX)] * ef->d_coeff; //not quite the right behavior - too much loss of precision?
     //ef->y = powf(ef->y, 1.000009f) * ef->d_coeff;  // too expensive
     
-#ifdef NO_DENORMAL_CHECK
-#else
+#if !LEAF_NO_DENORMAL_CHECK
     if( e->y < VSF)   e->y = 0.0f;
 #endif
     return e->y;
@@ -433,6 +436,7 @@ static void atkdtk_envelope(tAttackDetection* const a, Lfloat *in)
 
 /*********************** Static Function Declarations *************************/
 
+static  void   snac_writeSamples      (tSNAC* const s, Lfloat *in, int size);
 static  void   snac_analyzeframe      (tSNAC* const s);
 static  void   snac_autocorrelation   (tSNAC* const s);
 static  void   snac_normalize         (tSNAC* const s);
@@ -485,23 +489,10 @@ void tSNAC_free (tSNAC** const snac)
 //void tSNAC_ioSamples(tSNAC* const snac, Lfloat *in, Lfloat *out, int size)
 void tSNAC_ioSamples (tSNAC* const s, Lfloat *in, int size)
 {
-    int timeindex = s->timeindex;
-    int mask = s->framesize - 1;
-//    int outindex = 0;
-    Lfloat *inputbuf = s->inputbuf;
-//    Lfloat *processbuf = s->processbuf;
-    
     // call analysis function when it is time
-    if(!(timeindex & (s->framesize / s->overlap - 1))) snac_analyzeframe(s);
+    if(!(s->timeindex & (s->framesize / s->overlap - 1))) snac_analyzeframe(s);
     
-    while(size--)
-    {
-        inputbuf[timeindex] = *in++;
-//        out[outindex++] = processbuf[timeindex++];
-        timeindex++;
-        timeindex &= mask;
-    }
-    s->timeindex = timeindex;
+    snac_writeSamples(s, in, size);
 }
 
 void tSNAC_setOverlap (tSNAC* const s, int lap)
@@ -540,6 +531,22 @@ Lfloat tSNAC_getFidelity (tSNAC* const s)
 
 /************************ Static Function Definitions *************************/
 
+// append input to the circular buffer without analysing
+static void snac_writeSamples(tSNAC* const s, Lfloat *in, int size)
+{
+    int timeindex = s->timeindex;
+    int mask = s->framesize - 1;
+    Lfloat *inputbuf = s->inputbuf;
+    
+    while(size--)
+    {
+        inputbuf[timeindex] = *in++;
+        timeindex++;
+        timeindex &= mask;
+    }
+    s->timeindex = timeindex;
+}
+
 // main analysis function
 static void snac_analyzeframe(tSNAC* const s)
 {
@@ -756,6 +763,108 @@ static void snac_biasbuf (tSNAC* const s)
     }
 }
 
+/******************************************************************************/
+/*                               Analysis Gate                                */
+/******************************************************************************/
+
+// The frame based detectors tick the gate every sample and ask it at the end of
+// each frame whether to analyse: 1 to analyse, 0 to skip the frame on a steady
+// estimate, -1 to skip it because the input is below the threshold. A detector
+// with a cheap period estimate passes it as the cue so that pitch changes without
+// an amplitude onset also bring the hop back to every frame.
+
+static void analysis_gate_setSampleRate (_analysis_gate* const g, Lfloat sr)
+{
+    // Power averaged over about 10ms
+    tPowerFollower_setFactor(g->power, 1.0f - expf(-100.0f / sr));
+    tAttackDetection_setSampleRate(g->onset, sr);
+}
+
+static void analysis_gate_init (_analysis_gate* const g, tMempool** const mp)
+{
+    LEAF* leaf = (*mp)->leaf;
+    
+    tPowerFollower_initToPool(&g->power, 0.0f, mp);
+    tAttackDetection_initToPool(&g->onset, ANALYSIS_GATE_BLOCK, 2, 50, mp);
+    analysis_gate_setSampleRate(g, leaf->sampleRate);
+    
+    g->threshold = 0.0f;
+    g->maxHop = 1;
+    g->hop = 1;
+    g->count = 0;
+    g->attack = 0;
+    g->last = 0.0f;
+    g->blockIndex = 0;
+}
+
+static void analysis_gate_free (_analysis_gate* const g)
+{
+    tPowerFollower_free(&g->power);
+    tAttackDetection_free(&g->onset);
+}
+
+static void analysis_gate_setThreshold (_analysis_gate* const g, Lfloat threshold)
+{
+    g->threshold = threshold > 0.0f ? threshold * threshold : 0.0f;
+}
+
+static void analysis_gate_setMaxHop (_analysis_gate* const g, int maxHop)
+{
+    g->maxHop = maxHop > 1 ? maxHop : 1;
+    g->hop = 1;
+    g->count = 0;
+}
+
+static inline void analysis_gate_tick (_analysis_gate* const g, Lfloat sample)
+{
+    if (g->threshold > 0.0f) tPowerFollower_tick(g->power, sample);
+    
+    if (g->maxHop > 1)
+    {
+        g->block[g->blockIndex++] = sample;
+        if (g->blockIndex >= ANALYSIS_GATE_BLOCK)
+        {
+            g->blockIndex = 0;
+            if (tAttackDetection_detect(g->onset, g->block)) g->attack = 1;
+        }
+    }
+}
+
+static inline int analysis_gate_open (_analysis_gate* const g, Lfloat cue)
+{
+    if (g->threshold > 0.0f && tPowerFollower_getPower(g->power) < g->threshold)
+    {
+        g->hop = 1;
+        g->count = 0;
+        g->attack = 0;
+        g->last = 0.0f;
+        return -1;
+    }
+    
+    if (g->attack || (cue > 0.0f && fabsf(cue - g->last) > g->last * 0.03125f))
+    {
+        g->attack = 0;
+        g->hop = 1;
+    }
+    
+    if (++g->count < g->hop) return 0;
+    
+    g->count = 0;
+    return 1;
+}
+
+static inline void analysis_gate_update (_analysis_gate* const g, Lfloat period)
+{
+    if (g->maxHop <= 1) return;
+    
+    // Stretch the hop while the period stays within about a quarter semitone
+    if (period > 0.0f && g->last > 0.0f && fabsf(period - g->last) < g->last * 0.015625f)
+        g->hop = (g->hop * 2 > g->maxHop) ? g->maxHop : g->hop * 2;
+    else g->hop = 1;
+    
+    g->last = period;
+}
+
 /******************************************************************************/
 /*                             Period Detection                               */
 /******************************************************************************/
@@ -795,6 +904,8 @@ void tPeriodDetection_initToPool (tPeriodDetection** const pd, Lfloat* in, int b
     p->timeConstant = DEFTIMECONSTANT;
     p->radius = expf(-1000.0f * p->hopSize * p->invSampleRate / p->timeConstant);
     p->fidelityThreshold = 0.95f;
+    
+    analysis_gate_init(&p->gate, mp);
 }
 
 void tPeriodDetection_free (tPeriodDetection** const pd)
@@ -803,6 +914,7 @@ void tPeriodDetection_free (tPeriodDetection** const pd)
     
     tEnvPD_free(&p->env);
     tSNAC_free(&p->snac);
+    analysis_gate_free(&p->gate);
     mpool_free((char*)p, p->mempool);
 }
 
@@ -817,6 +929,7 @@ Lfloat tPeriodDetection_tick (tPeriodDetection* const p, Lfloat sample)
     p->iLast = iLast;
     
     p->inBuffer[i+p->index] = sample;
+    analysis_gate_tick(&p->gate, sample);
     
     p->index++;
     p->indexstore = p->index;
@@ -824,12 +937,19 @@ Lfloat tPeriodDetection_tick (tPeriodDetection* const p, Lfloat sample)
     {
         p->index = 0;
         
-        tEnvPD_processBlock(p->env, &(p->inBuffer[i]));
-        
-        tSNAC_ioSamples(p->snac, &(p->inBuffer[i]), p->frameSize);
-        
-        // Fidelity threshold recommended by Katja Vetters is 0.95 for most instruments/voices http://www.katjaas.nl/helmholtz/helmholtz.html
-        p->period = tSNAC_getPeriod(p->snac);
+        if (analysis_gate_open(&p->gate, 0.0f) > 0)
+        {
+            tEnvPD_processBlock(p->env, &(p->inBuffer[i]));
+            
+            tSNAC_ioSamples(p->snac, &(p->inBuffer[i]), p->frameSize);
+            
+            // Fidelity threshold recommended by Katja Vetters is 0.95 for most instruments/voices http://www.katjaas.nl/helmholtz/helmholtz.html
+            p->period = tSNAC_getPeriod(p->snac);
+            
+            analysis_gate_update(&p->gate, p->period);
+        }
+        // Keep the SNAC history continuous for the next analysed frame
+        else snac_writeSamples(p->snac, &(p->inBuffer[i]), p->frameSize);
         
         p->curBlock++;
         if (p->curBlock >= p->framesPerBuffer) p->curBlock = 0;
@@ -879,6 +999,17 @@ void tPeriodDetection_setSampleRate (tPeriodDetection* const p, Lfloat sr)
 {
     p->invSampleRate = 1.0f/sr;
     p->radius = expf(-1000.0f * p->hopSize * p->invSampleRate / p->timeConstant);
+    analysis_gate_setSampleRate(&p->gate, sr);
+}
+
+void tPeriodDetection_setGate (tPeriodDetection* const p, Lfloat threshold)
+{
+    analysis_gate_setThreshold(&p->gate, threshold);
+}
+
+void tPeriodDetection_setMaxHop (tPeriodDetection* const p, int maxHop)
+{
+    analysis_gate_setMaxHop(&p->gate, maxHop);
 }
 
 /******************************************************************************/
@@ -1311,6 +1442,7 @@ void    tBACF_initToPool    (tBACF** const bacf, tBitset** const bitset, tMempoo
     tMempool* m = *mempool;
     tBACF* b = *bacf = (tBACF*) mpool_alloc(sizeof(tBACF), m);
     b->mempool = m;
+    b->kernels = &m->leaf->kernels;
     
     b->_bitset = *bitset;
     b->_mid_array = ((b->_bitset->_bit_size / b->_bitset->_value_size) / 2) - 1;
@@ -1331,42 +1463,11 @@ int    tBACF_getCorrelation  (tBACF* const b, int pos)
     
     const unsigned int* p1 = b->_bitset->_bits;
     const unsigned int* p2 = b->_bitset->_bits + index;
-    int count = 0;
     
     if (shift == 0)
-    {
-        for (unsigned i = 0; i != b->_mid_array; ++i)
-        {
-            // built in compiler popcount functions should be faster but we want this to be portable
-            // could try to add some define that call the correct function depending on compiler
-            // or let the user pointer popcount() to whatever they want
-            // something to look into...
-#ifdef __GNUC__
-            count += __builtin_popcount(*p1++ ^ *p2++);
-#elif _MSC_VER
-            count += __popcnt(*p1++ ^ *p2++);
-#else
-            count += popcount(*p1++ ^ *p2++);
-#endif
-        }
-    }
-    else
-    {
-        const int shift2 = value_size - shift;
-        for (unsigned i = 0; i != b->_mid_array; ++i)
-        {
-            unsigned int v = *p2++ >> shift;
-            v |= *p2 << shift2;
-#ifdef __GNUC__
-            count += __builtin_popcount(*p1++ ^ v++);
-#elif _MSC_VER
-            count += __popcnt(*p1++ ^ v++);
-#else
-            count += popcount(*p1++ ^ v++);
-#endif
-        }
-    }
-    return count;
+        return b->kernels->xorPopcount(p1, p2, (int) b->_mid_array);
+    
+    return b->kernels->xorPopcountShifted(p1, p2, (int) b->_mid_array, shift);
 }
 
 void    tBACF_set  (tBACF* const b, tBitset** const bitset)
@@ -1420,6 +1521,8 @@ void    tPeriodDetector_initToPool  (tPeriodDetector** const detector, Lfloat lo
     p->_half_empty = 0;
     
     tBACF_initToPool(&p->_bacf, &p->_bits, mempool);
+    
+    analysis_gate_init(&p->_gate, mempool);
 }
 
 void    tPeriodDetector_free    (tPeriodDetector** const detector)
@@ -1429,6 +1532,7 @@ void    tPeriodDetector_free    (tPeriodDetector** const detector)
     tZeroCrossingCollector_free(&p->_zc);
     tBitset_free(&p->_bits);
     tBACF_free(&p->_bacf);
+    analysis_gate_free(&p->_gate);
     
     mpool_free((char*) p, p->mempool);
 }
@@ -1438,6 +1542,7 @@ int   tPeriodDetector_tick    (tPeriodDetector* const p, Lfloat s)
     // Zero crossing
     int prev = tZeroCrossingCollector_getState(p->_zc);
     int zc = tZeroCrossingCollector_tick(p->_zc, s);
+    analysis_gate_tick(&p->_gate, s);
     
     if (!zc && prev != zc)
     {
@@ -1453,8 +1558,21 @@ int   tPeriodDetector_tick    (tPeriodDetector* const p, Lfloat s)
     
     if (tZeroCrossingCollector_isReady(p->_zc))
     {
+        Lfloat cue = p->_gate.hop > 1 ? tPeriodDetector_predictPeriod(p) : 0.0f;
+        int open = analysis_gate_open(&p->_gate, cue);
+        if (open == 0) return 0;
+        if (open < 0)
+        {
+            // Too quiet to analyse, report an aperiodic window
+            p->_fundamental.period = -1.0f;
+            p->_fundamental.periodicity = -1.0f;
+            return 1;
+        }
+        
         set_bitstream(p);
         autocorrelate(p);
+        
+        analysis_gate_update(&p->_gate, p->_fundamental.periodicity > 0.0f ? p->_fundamental.period : 0.0f);
         return 1;
     }
     return 0;
@@ -1544,6 +1662,17 @@ void    tPeriodDetector_setSampleRate   (tPeriodDetector* const p, Lfloat sr)
     tZeroCrossingCollector_free(&p->_zc);
     tZeroCrossingCollector_initToPool(&p->_zc, (1.0f / p->lowestFreq) * p->sampleRate * 2.0f, hysteresis, &m);
     p->_min_period = (1.0f / p->highestFreq) * p->sampleRate;
+    analysis_gate_setSampleRate(&p->_gate, sr);
+}
+
+void    tPeriodDetector_setGate (tPeriodDetector* const p, Lfloat threshold)
+{
+    analysis_gate_setThreshold(&p->_gate, threshold);
+}
+
+void    tPeriodDetector_setMaxHop (tPeriodDetector* const p, int maxHop)
+{
+    analysis_gate_setMaxHop(&p->_gate, maxHop);
 }
 
 static inline void set_bitstream(tPeriodDetector* const p)
@@ -1793,7 +1922,7 @@ void    tPitchDetector_free (tPitchDetector** const detector)
 
 int     tPitchDetector_tick    (tPitchDetector* const p, Lfloat s)
 {
-    tPeriodDetector_tick(p->_pd, s);
+    int ready = tPeriodDetector_tick(p->_pd, s);
     
     if (tPeriodDetector_isReset(p->_pd))
     {
@@ -1801,7 +1930,6 @@ int     tPitchDetector_tick    (tPitchDetector* const p, Lfloat s)
         p->_current.periodicity = 0.0f;
     }
     
-    int ready = tPeriodDetector_isReady(p->_pd);
     if (ready)
     {
         Lfloat periodicity = p->_pd->_fundamental.periodicity;
@@ -1880,6 +2008,16 @@ void    tPitchDetector_setSampleRate    (tPitchDetector* const p, Lfloat sr)
     tPeriodDetector_setSampleRate(p->_pd, p->sampleRate);
 }
 
+void    tPitchDetector_setGate  (tPitchDetector* const p, Lfloat threshold)
+{
+    tPeriodDetector_setGate(p->_pd, threshold);
+}
+
+void    tPitchDetector_setMaxHop    (tPitchDetector* const p, int maxHop)
+{
+    tPeriodDetector_setMaxHop(p->_pd, maxHop);
+}
+
 static inline Lfloat calculate_frequency(tPitchDetector* const p)
 {
     Lfloat period = p->_pd->_fundamental.period;
@@ -1983,6 +2121,39 @@ static inline void bias(tPitchDetector* const p, _pitch_info incoming)
 
 static inline void compute_predicted_frequency(tDualPitchDetector* const detector);
 
+// Samples the audio thread can get ahead of the analysis in async mode
+#define DUALPITCH_FEED_SIZE 4096
+#define DUALPITCH_PROCESS_BLOCK 64
+
+static inline uint32_t dualPitchBits (Lfloat value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline Lfloat dualPitchValue (uint32_t bits)
+{
+    Lfloat value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+#if LEAF_USE_THREADS
+static void* tDualPitchDetector_threadLoop(void* arg)
+{
+    tDualPitchDetector* p = (tDualPitchDetector*) arg;
+    struct timespec period = { 0, 1000000 };
+    
+    while (LEAF_atomicLoad(&p->running))
+    {
+        tDualPitchDetector_process(p);
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+#endif
+
 void    tDualPitchDetector_init(tDualPitchDetector** const detector, Lfloat lowestFreq, Lfloat highestFreq, Lfloat* inBuffer, int bufSize, LEAF* const leaf)
 {
     tDualPitchDetector_initToPool(detector, lowestFreq, highestFreq, inBuffer, bufSize, &leaf->mempool);
@@ -2009,22 +2180,42 @@ void    tDualPitchDetector_initToPool   (tDualPitchDetector** const detector, Lf
     
     p->lowest = lowestFreq;
     p->highest = highestFreq;
+    
+    p->async = 0;
+    p->feed = NULL;
+    p->frequency = 0;
+    p->periodicity = 0;
+    p->predicted = 0;
+    p->estimateCount = 0;
+    p->estimateSeen = 0;
+    p->latest = p->_current;
+    p->latestPredicted = 0.0f;
+#if LEAF_USE_THREADS
+    p->running = 0;
+#endif
 }
 
 void    tDualPitchDetector_free (tDualPitchDetector** const detector)
 {
     tDualPitchDetector* p = *detector;
     
+    tDualPitchDetector_setAsync(p, 0);
+    if (p->feed != NULL) tSPSCRingBuffer_free(&p->feed);
+    
     tPeriodDetection_free(&p->_pd1);
     tPitchDetector_free(&p->_pd2);
     
     mpool_free((char*) p, p->mempool);
 }
 
-int     tDualPitchDetector_tick    (tDualPitchDetector* const p, Lfloat sample)
+// The full analysis of one sample, run by tick or, in async mode, by process
+static int tDualPitchDetector_analyse (tDualPitchDetector* const p, Lfloat sample)
 {
     tPeriodDetection_tick(p->_pd1, sample);
     int ready = tPitchDetector_tick(p->_pd2, sample);
+    
+    // Bring the SNAC detector back to every frame while the BACF detector follows a change
+    if (ready && p->_pd2->_pd->_gate.hop == 1) p->_pd1->gate.hop = 1;
 
     if (ready)
     {
@@ -2101,18 +2292,105 @@ int     tDualPitchDetector_tick    (tDualPitchDetector* const p, Lfloat sample)
     return ready;
 }
 
+int     tDualPitchDetector_tick    (tDualPitchDetector* const p, Lfloat sample)
+{
+    if (p->async)
+    {
+        // Hand the sample to the analysis thread and copy any estimate it has published since the last snapshot.
+        // If process is in the middle of publishing one, keep the old snapshot and try again next tick rather than wait.
+        tSPSCRingBuffer_push(p->feed, &sample, 1);
+        uint32_t count = LEAF_atomicLoad(&p->estimateCount);
+        if (count == p->estimateSeen || (count & 1)) return 0;
+        
+        uint32_t frequency = LEAF_atomicLoad(&p->frequency);
+        uint32_t periodicity = LEAF_atomicLoad(&p->periodicity);
+        uint32_t predicted = LEAF_atomicLoad(&p->predicted);
+        if (LEAF_atomicLoad(&p->estimateCount) != count) return 0;
+        
+        p->latest.frequency = dualPitchValue(frequency);
+        p->latest.periodicity = dualPitchValue(periodicity);
+        p->latestPredicted = dualPitchValue(predicted);
+        p->estimateSeen = count;
+        return 1;
+    }
+    
+    return tDualPitchDetector_analyse(p, sample);
+}
+
+void    tDualPitchDetector_process (tDualPitchDetector* const p)
+{
+    Lfloat block[DUALPITCH_PROCESS_BLOCK];
+    int n;
+    
+    while ((n = tSPSCRingBuffer_pop(p->feed, block, DUALPITCH_PROCESS_BLOCK)) > 0)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            if (!tDualPitchDetector_analyse(p, block[i])) continue;
+            
+            compute_predicted_frequency(p);
+            LEAF_atomicAdd(&p->estimateCount, 1);
+            LEAF_atomicStore(&p->frequency, dualPitchBits(p->_current.frequency));
+            LEAF_atomicStore(&p->periodicity, dualPitchBits(p->_current.periodicity));
+            LEAF_atomicStore(&p->predicted, dualPitchBits(p->_predicted_frequency));
+            LEAF_atomicAdd(&p->estimateCount, 1);
+        }
+    }
+}
+
+void    tDualPitchDetector_setAsync (tDualPitchDetector* const p, int async)
+{
+    async = async ? 1 : 0;
+    if (async == p->async) return;
+    
+    if (async)
+    {
+        if (p->feed == NULL) tSPSCRingBuffer_initToPool(&p->feed, DUALPITCH_FEED_SIZE, &p->mempool);
+        
+        // Drop anything left from the last time and start from the current estimate
+        Lfloat discard;
+        tSPSCRingBuffer_readLatest(p->feed, &discard, 0);
+        p->frequency = dualPitchBits(p->_current.frequency);
+        p->periodicity = dualPitchBits(p->_current.periodicity);
+        p->predicted = dualPitchBits(p->_predicted_frequency);
+        p->latest = p->_current;
+        p->latestPredicted = p->_predicted_frequency;
+        p->estimateSeen = p->estimateCount;
+        p->async = 1;
+        
+#if LEAF_USE_THREADS
+        p->running = 1;
+        if (pthread_create(&p->thread, NULL, tDualPitchDetector_threadLoop, p) != 0) p->running = 0;
+#endif
+    }
+    else
+    {
+#if LEAF_USE_THREADS
+        if (p->running)
+        {
+            LEAF_atomicStore(&p->running, 0);
+            pthread_join(p->thread, NULL);
+        }
+#endif
+        p->async = 0;
+    }
+}
+
 Lfloat   tDualPitchDetector_getFrequency    (tDualPitchDetector* const p)
 {
+    if (p->async) return p->latest.frequency;
     return p->_current.frequency;
 }
 
 Lfloat   tDualPitchDetector_getPeriodicity  (tDualPitchDetector* const p)
 {
+    if (p->async) return p->latest.periodicity;
     return p->_current.periodicity;
 }
 
 Lfloat   tDualPitchDetector_predictFrequency (tDualPitchDetector* const p)
 {
+    if (p->async) return p->latestPredicted;
     if (p->_predicted_frequency == 0.0f)
         compute_predicted_frequency(p);
     return p->_predicted_frequency;
@@ -2135,6 +2413,18 @@ void    tDualPitchDetector_setSampleRate (tDualPitchDetector* const p, Lfloat sr
     tPitchDetector_setSampleRate(p->_pd2, p->sampleRate);
 }
 
+void    tDualPitchDetector_setGate (tDualPitchDetector* const p, Lfloat threshold)
+{
+    tPeriodDetection_setGate(p->_pd1, threshold);
+    tPitchDetector_setGate(p->_pd2, threshold);
+}
+
+void    tDualPitchDetector_setMaxHop (tDualPitchDetector* const p, int maxHop)
+{
+    tPeriodDetection_setMaxHop(p->_pd1, maxHop);
+    tPitchDetector_setMaxHop(p->_pd2, maxHop);
+}
+
 static inline void compute_predicted_frequency(tDualPitchDetector* const p)
 {
     Lfloat f1 = 1.0f / tPeriodDetection_getPeriod(p->_pd1);
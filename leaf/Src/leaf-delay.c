@@ -18,6 +18,55 @@
 
 #endif
 
+// Next read or write point after p. With LEAF_POW2_DELAYS the buffer length is a power of two and wraps with a mask.
+#if LEAF_POW2_DELAYS
+#define DELAY_NEXT(d, p)        (((p) + 1) & (d)->bufferMask)
+#define DELAY_ADVANCE(d, p, n)  (((p) + (n)) & (d)->bufferMask)
+#else
+#define DELAY_NEXT(d, p)        ((p) + 1 == (d)->maxDelay ? 0 : (p) + 1)
+#define DELAY_ADVANCE(d, p, n)  ((p) + (n) >= (d)->maxDelay ? (p) + (n) - (d)->maxDelay : (p) + (n))
+#endif
+
+// Smallest power of two not less than size
+static uint32_t delayPow2Size (uint32_t size)
+{
+    size--;
+    size |= size >> 1;
+    size |= size >> 2;
+    size |= size >> 4;
+    size |= size >> 8;
+    size |= size >> 16;
+    return size + 1;
+}
+
+// Write n samples scaled by gain into a circular buffer starting at start, as at most two contiguous spans
+static void delayWriteSpans (Lfloat* buff, uint32_t size, uint32_t start, const Lfloat* in, int n, Lfloat gain)
+{
+    uint32_t first = size - start;
+    if (first > (uint32_t) n) first = (uint32_t) n;
+
+    if (gain == 1.0f)
+    {
+        memcpy(buff + start, in, first * sizeof(Lfloat));
+        memcpy(buff, in + first, (n - first) * sizeof(Lfloat));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < first; i++)            buff[start + i] = in[i] * gain;
+        for (uint32_t i = first; i < (uint32_t) n; i++) buff[i - first] = in[i] * gain;
+    }
+}
+
+// Read n samples from a circular buffer starting at start, as at most two contiguous spans
+static void delayReadSpans (const Lfloat* buff, uint32_t size, uint32_t start, Lfloat* out, int n)
+{
+    uint32_t first = size - start;
+    if (first > (uint32_t) n) first = (uint32_t) n;
+
+    memcpy(out, buff + start, first * sizeof(Lfloat));
+    memcpy(out + first, buff, (n - first) * sizeof(Lfloat));
+}
+
 // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Delay ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
 void    tDelay_init(tDelay** const dl, uint32_t delay, uint32_t maxDelay, LEAF* const leaf)
 {
@@ -30,6 +79,12 @@ void    tDelay_initToPool   (tDelay** const dl, uint32_t delay, uint32_t maxDela
     tDelay* d = *dl = (tDelay*) mpool_alloc(sizeof(tDelay), m);
     d->mempool = m;
 
+#if LEAF_POW2_DELAYS
+    maxDelay = delayPow2Size(maxDelay);
+    d->bufferMask = maxDelay - 1;
+#else
+    d->bufferMask = 0;
+#endif
     d->maxDelay = maxDelay;
 
     d->delay = delay;
@@ -67,15 +122,33 @@ Lfloat   tDelay_tick (tDelay* const d, Lfloat input)
     // Input
     d->lastIn = input;
     d->buff[d->inPoint] = input * d->gain;
-    if (++(d->inPoint) == d->maxDelay)     d->inPoint = 0;
+    d->inPoint = DELAY_NEXT(d, d->inPoint);
 
     // Output
     d->lastOut = d->buff[d->outPoint];
-    if (++(d->outPoint) == d->maxDelay)    d->outPoint = 0;
+    d->outPoint = DELAY_NEXT(d, d->outPoint);
 
     return d->lastOut;
 }
 
+void    tDelay_writeBlock (tDelay* const d, const Lfloat* input, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    delayWriteSpans(d->buff, d->maxDelay, d->inPoint, input, numSamples, d->gain);
+    d->inPoint = DELAY_ADVANCE(d, d->inPoint, (uint32_t) numSamples);
+    d->lastIn = input[numSamples - 1];
+}
+
+void    tDelay_readBlock (tDelay* const d, Lfloat* output, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    delayReadSpans(d->buff, d->maxDelay, d->outPoint, output, numSamples);
+    d->outPoint = DELAY_ADVANCE(d, d->outPoint, (uint32_t) numSamples);
+    d->lastOut = output[numSamples - 1];
+}
+
 void     tDelay_setDelay (tDelay* const d, uint32_t delay)
 {
     d->delay = LEAF_clip(0.0f, delay,  d->maxDelay);
@@ -154,6 +227,12 @@ void tLinearDelay_initToPool  (tLinearDelay** const dl, Lfloat delay, uint32_t m
     tLinearDelay* d = *dl = (tLinearDelay*) mpool_alloc(sizeof(tLinearDelay), m);
     d->mempool = m;
 
+#if LEAF_POW2_DELAYS
+    maxDelay = delayPow2Size(maxDelay);
+    d->bufferMask = maxDelay - 1;
+#else
+    d->bufferMask = 0;
+#endif
     d->maxDelay = maxDelay;
 
     if (delay > maxDelay)   d->delay = maxDelay;
@@ -194,19 +273,16 @@ Lfloat   tLinearDelay_tick (tLinearDelay* const d, Lfloat input)
     d->buff[d->inPoint] = input * d->gain;
 
     // Increment input pointer modulo length.
-    if (++(d->inPoint) == d->maxDelay )    d->inPoint = 0;
+    d->inPoint = DELAY_NEXT(d, d->inPoint);
 
     uint32_t idx = (uint32_t) d->outPoint;
     // First 1/2 of interpolation
     d->lastOut = d->buff[idx] * d->omAlpha;
         // Second 1/2 of interpolation
-    if ((idx + 1) < d->maxDelay)
-        d->lastOut += d->buff[idx+1] * d->alpha;
-    else
-        d->lastOut += d->buff[0] * d->alpha;
+    d->lastOut += d->buff[DELAY_NEXT(d, idx)] * d->alpha;
 
     // Increment output pointer modulo length
-    if ( (++d->outPoint) >= d->maxDelay )   d->outPoint = 0;
+    d->outPoint = DELAY_NEXT(d, d->outPoint);
 
     return d->lastOut;
 }
@@ -216,7 +292,7 @@ void   tLinearDelay_tickIn (tLinearDelay* const d, Lfloat input)
     d->buff[d->inPoint] = input * d->gain;
     d->lastIn = input;
     // Increment input pointer modulo length.
-    if (++(d->inPoint) == d->maxDelay )    d->inPoint = 0;
+    d->inPoint = DELAY_NEXT(d, d->inPoint);
 }
 
 Lfloat   tLinearDelay_tickOut (tLinearDelay* const d)
@@ -225,18 +301,58 @@ Lfloat   tLinearDelay_tickOut (tLinearDelay* const d)
     // First 1/2 of interpolation
     d->lastOut = d->buff[idx] * d->omAlpha;
         // Second 1/2 of interpolation
-        
-    if ((idx + 1) < d->maxDelay)
-        d->lastOut += d->buff[idx+1] * d->alpha;
-    else
-        d->lastOut += d->buff[0] * d->alpha;
+    d->lastOut += d->buff[DELAY_NEXT(d, idx)] * d->alpha;
 
     // Increment output pointer modulo length
-    if ( (++d->outPoint) >= d->maxDelay )   d->outPoint = 0;
+    d->outPoint = DELAY_NEXT(d, d->outPoint);
 
     return d->lastOut;
 }
 
+void   tLinearDelay_writeBlock (tLinearDelay* const d, const Lfloat* input, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    delayWriteSpans(d->buff, d->maxDelay, d->inPoint, input, numSamples, d->gain);
+    d->inPoint = DELAY_ADVANCE(d, d->inPoint, (uint32_t) numSamples);
+    d->lastIn = input[numSamples - 1];
+}
+
+void   tLinearDelay_readBlock (tLinearDelay* const d, Lfloat* output, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    const Lfloat* buff = d->buff;
+    const Lfloat alpha = d->alpha;
+    const Lfloat omAlpha = d->omAlpha;
+    uint32_t idx = d->outPoint;
+    int i = 0;
+
+    while (i < numSamples)
+    {
+        // Span where the interpolation neighbour doesn't wrap
+        int run = (int) (d->maxDelay - 1 - idx);
+        if (run > numSamples - i) run = numSamples - i;
+        for (int k = 0; k < run; k++, idx++)
+        {
+            Lfloat out = buff[idx] * omAlpha;
+            out += buff[idx + 1] * alpha;
+            output[i++] = out;
+        }
+
+        if (i < numSamples)
+        {
+            Lfloat out = buff[idx] * omAlpha;
+            out += buff[0] * alpha;
+            output[i++] = out;
+            idx = 0;
+        }
+    }
+
+    d->outPoint = idx;
+    d->lastOut = output[numSamples - 1];
+}
+
 void     tLinearDelay_setDelay (tLinearDelay* const d, Lfloat delay)
 {
     d->delay = LEAF_clip(2.0f, delay,  d->maxDelay);
@@ -351,24 +467,10 @@ void tHermiteDelay_initToPool  (tHermiteDelay** const dl, Lfloat delay, uint32_t
     else                    d->delay = delay;
 
     
-    if ((maxDelay != 0) && ((maxDelay & (maxDelay - 1)) == 0))
-    {
-        d->maxDelay = maxDelay;
-        d->bufferMask = maxDelay - 1;
-    }
-    else
-    {
-        //make the delay size into a power of 2
-        maxDelay--;
-        maxDelay |= maxDelay >> 1;
-        maxDelay |= maxDelay >> 2;
-        maxDelay |= maxDelay >> 4;
-        maxDelay |= maxDelay >> 8;
-        maxDelay |= maxDelay >> 16;
-        maxDelay++;
-        d->maxDelay = maxDelay;
-        d->bufferMask = maxDelay - 1;
-    }
+    //make the delay size into a power of 2
+    maxDelay = delayPow2Size(maxDelay);
+    d->maxDelay = maxDelay;
+    d->bufferMask = maxDelay - 1;
     d->buff = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxDelay, m);
 
     d->gain = 1.0f;
@@ -447,6 +549,50 @@ Lfloat   tHermiteDelay_tickOut (tHermiteDelay* const d)
     return d->lastOut;
 }
 
+void   tHermiteDelay_writeBlock (tHermiteDelay* const d, const Lfloat* input, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    delayWriteSpans(d->buff, d->maxDelay, d->inPoint, input, numSamples, d->gain);
+    d->inPoint = (d->inPoint + numSamples) & d->bufferMask;
+    d->lastIn = input[numSamples - 1];
+}
+
+void   tHermiteDelay_readBlock (tHermiteDelay* const d, Lfloat* output, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    const Lfloat* buff = d->buff;
+    const Lfloat alpha = d->alpha;
+    const uint32_t mask = d->bufferMask;
+    uint32_t idx = d->outPoint;
+    int i = 0;
+
+    while (i < numSamples)
+    {
+        if (idx >= 1 && idx + 2 < d->maxDelay)
+        {
+            // Span where none of the four taps wrap
+            int run = (int) (d->maxDelay - 2 - idx);
+            if (run > numSamples - i) run = numSamples - i;
+            for (int k = 0; k < run; k++, idx++)
+                output[i++] = LEAF_interpolate_hermite_x(buff[idx - 1], buff[idx], buff[idx + 1], buff[idx + 2], alpha);
+        }
+        else
+        {
+            output[i++] = LEAF_interpolate_hermite_x(buff[(idx - 1) & mask],
+                                                     buff[idx],
+                                                     buff[(idx + 1) & mask],
+                                                     buff[(idx + 2) & mask],
+                                                     alpha);
+            idx = (idx + 1) & mask;
+        }
+    }
+
+    d->outPoint = idx & mask;
+    d->lastOut = output[numSamples - 1];
+}
+
 void tHermiteDelay_setDelay (tHermiteDelay* const d, Lfloat delay)
 {
     //d->delay = LEAF_clip(0.0f, delay,  d->maxDelay);
@@ -542,24 +688,10 @@ void tLagrangeDelay_initToPool  (tLagrangeDelay** const dl, Lfloat delay, uint32
     else                    d->delay = delay;
 
 
-    if ((maxDelay != 0) && ((maxDelay & (maxDelay - 1)) == 0))
-    {
-        d->maxDelay = maxDelay;
-        d->bufferMask = maxDelay - 1;
-    }
-    else
-    {
-        //make the delay size into a power of 2
-        maxDelay--;
-        maxDelay |= maxDelay >> 1;
-        maxDelay |= maxDelay >> 2;
-        maxDelay |= maxDelay >> 4;
-        maxDelay |= maxDelay >> 8;
-        maxDelay |= maxDelay >> 16;
-        maxDelay++;
-        d->maxDelay = maxDelay;
-        d->bufferMask = maxDelay - 1;
-    }
+    //make the delay size into a power of 2
+    maxDelay = delayPow2Size(maxDelay);
+    d->maxDelay = maxDelay;
+    d->bufferMask = maxDelay - 1;
     d->buff = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxDelay, m);
 
 
@@ -1057,6 +1189,280 @@ Lfloat tTapeDelay_getGain (tTapeDelay* const d)
     return d->gain;
 }
 
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ MultiTapDelay ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+void tMultiTapDelay_init(tMultiTapDelay** const dl, int maxTaps, uint32_t maxDelay, LEAF* const leaf)
+{
+    tMultiTapDelay_initToPool(dl, maxTaps, maxDelay, &leaf->mempool);
+}
+
+void tMultiTapDelay_initToPool (tMultiTapDelay** const dl, int maxTaps, uint32_t maxDelay, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tMultiTapDelay* d = *dl = (tMultiTapDelay*) mpool_alloc(sizeof(tMultiTapDelay), m);
+    d->mempool = m;
+
+    if (maxTaps < 1)    maxTaps = 1;
+    if (maxDelay < 1)   maxDelay = 1;
+    d->maxDelay = maxDelay;
+
+    // Leave room for the interpolation points either side of the longest delay
+    uint32_t size = delayPow2Size(maxDelay + 3);
+    d->bufferMask = size - 1;
+    d->buff = (Lfloat*) mpool_calloc(sizeof(Lfloat) * size, m);
+    d->inPoint = 0;
+
+    d->maxTaps = maxTaps;
+    d->numTaps = maxTaps;
+    d->delays = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxTaps, m);
+    d->gains = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxTaps, m);
+    d->modDepths = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxTaps, m);
+    d->mods = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxTaps, m);
+    d->tapOuts = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxTaps, m);
+    d->idx = (uint32_t*) mpool_calloc(sizeof(uint32_t) * maxTaps, m);
+    d->weights = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 4 * maxTaps, m);
+
+    for (int t = 0; t < maxTaps; t++)
+    {
+        d->delays[t] = 1.0f;
+        d->gains[t] = 1.0f / maxTaps;
+    }
+
+    d->lastIn = 0.0f;
+    d->lastOut = 0.0f;
+    d->dirty = 1;
+}
+
+void tMultiTapDelay_free (tMultiTapDelay** const dl)
+{
+    tMultiTapDelay* d = *dl;
+
+    mpool_free((char*)d->weights, d->mempool);
+    mpool_free((char*)d->idx, d->mempool);
+    mpool_free((char*)d->tapOuts, d->mempool);
+    mpool_free((char*)d->mods, d->mempool);
+    mpool_free((char*)d->modDepths, d->mempool);
+    mpool_free((char*)d->gains, d->mempool);
+    mpool_free((char*)d->delays, d->mempool);
+    mpool_free((char*)d->buff, d->mempool);
+    mpool_free((char*)d, d->mempool);
+}
+
+// Read point and interpolation point of a tap delay for the sample written at writePoint
+static inline uint32_t multiTapPosition (Lfloat delay, Lfloat maxDelay, uint32_t writePoint, uint32_t mask, Lfloat* x)
+{
+    delay = delay < 1.0f ? 1.0f : (delay > maxDelay ? maxDelay : delay);
+    int32_t whole = (int32_t) delay;
+    *x = 1.0f - (delay - (Lfloat) whole);
+    return (writePoint - (uint32_t) whole - 1) & mask;
+}
+
+// Weights of the 4-point Hermite interpolation at x, the same curve as LEAF_interpolate_hermite_x
+static inline void multiTapWeights (Lfloat x, Lfloat* w0, Lfloat* w1, Lfloat* w2, Lfloat* w3)
+{
+    Lfloat x2 = x * x;
+    Lfloat x3 = x2 * x;
+    *w0 = -0.5f * x + x2 - 0.5f * x3;
+    *w1 = 1.0f - 2.5f * x2 + 1.5f * x3;
+    *w2 = 0.5f * x + 2.0f * x2 - 1.5f * x3;
+    *w3 = 0.5f * (x3 - x2);
+}
+
+static inline Lfloat multiTapRead (const Lfloat* buff, uint32_t mask, uint32_t idx, const Lfloat* w)
+{
+    return w[0] * buff[(idx - 1) & mask] + w[1] * buff[idx] + w[2] * buff[(idx + 1) & mask] + w[3] * buff[(idx + 2) & mask];
+}
+
+// Add gain times a tap with fixed weights to out, reading forward from idx. Only masks near the ends of the buffer.
+static void multiTapAccumulate (const Lfloat* buff, uint32_t mask, uint32_t idx, const Lfloat* w, Lfloat gain, Lfloat* out, int n)
+{
+    const uint32_t size = mask + 1;
+    const Lfloat w0 = w[0], w1 = w[1], w2 = w[2], w3 = w[3];
+    int i = 0;
+
+    while (i < n)
+    {
+        if (idx >= 1 && idx + 2 < size)
+        {
+            int run = (int) (size - 2 - idx);
+            if (run > n - i) run = n - i;
+            const Lfloat* b = buff + idx;
+            for (int k = 0; k < run; k++)
+                out[i + k] += gain * (w0 * b[k - 1] + w1 * b[k] + w2 * b[k + 1] + w3 * b[k + 2]);
+            i += run;
+            idx += run;
+        }
+        else
+        {
+            out[i++] += gain * multiTapRead(buff, mask, idx, w);
+            idx = (idx + 1) & mask;
+        }
+    }
+}
+
+Lfloat tMultiTapDelay_tick (tMultiTapDelay* const d, Lfloat input)
+{
+    const int numTaps = d->numTaps;
+    const uint32_t mask = d->bufferMask;
+    const uint32_t writePoint = d->inPoint;
+    const Lfloat maxDelay = (Lfloat) d->maxDelay;
+    const Lfloat* delays = d->delays;
+    const Lfloat* modDepths = d->modDepths;
+    const Lfloat* mods = d->mods;
+    const Lfloat* gains = d->gains;
+    Lfloat* buff = d->buff;
+    Lfloat* tapOuts = d->tapOuts;
+    uint32_t* idx = d->idx;
+    Lfloat* w0 = d->weights;
+    Lfloat* w1 = w0 + d->maxTaps;
+    Lfloat* w2 = w1 + d->maxTaps;
+    Lfloat* w3 = w2 + d->maxTaps;
+
+    buff[writePoint] = input;
+
+    // Work out the positions and weights of all taps together when a delay has moved.
+    // Otherwise the weights hold and the read points just follow the write point.
+    if (d->dirty)
+    {
+        for (int t = 0; t < numTaps; t++)
+        {
+            Lfloat x;
+            idx[t] = multiTapPosition(delays[t] + modDepths[t] * mods[t], maxDelay, writePoint, mask, &x);
+            multiTapWeights(x, &w0[t], &w1[t], &w2[t], &w3[t]);
+        }
+        d->dirty = 0;
+    }
+
+    Lfloat sum = 0.0f;
+    for (int t = 0; t < numTaps; t++)
+    {
+        uint32_t i = idx[t];
+        Lfloat y = w0[t] * buff[(i - 1) & mask] + w1[t] * buff[i] + w2[t] * buff[(i + 1) & mask] + w3[t] * buff[(i + 2) & mask];
+        tapOuts[t] = y;
+        sum += gains[t] * y;
+        idx[t] = (i + 1) & mask;
+    }
+
+    d->inPoint = (writePoint + 1) & mask;
+
+    d->lastIn = input;
+    d->lastOut = sum;
+    return sum;
+}
+
+void tMultiTapDelay_tickBlock (tMultiTapDelay* const d, const Lfloat* input, Lfloat* output, const Lfloat* const* mod, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    const uint32_t mask = d->bufferMask;
+    const uint32_t start = d->inPoint;
+    const Lfloat maxDelay = (Lfloat) d->maxDelay;
+    const Lfloat* buff = d->buff;
+
+    delayWriteSpans(d->buff, mask + 1, start, input, numSamples, 1.0f);
+
+    for (int i = 0; i < numSamples; i++)
+        output[i] = 0.0f;
+
+    for (int t = 0; t < d->numTaps; t++)
+    {
+        const Lfloat* m = (mod != NULL) ? mod[t] : NULL;
+        uint32_t idx;
+        Lfloat x, w[4];
+
+        if (m == NULL || d->modDepths[t] == 0.0f)
+        {
+            // Fixed delay, so the weights hold for the whole block
+            idx = multiTapPosition(d->delays[t] + d->modDepths[t] * d->mods[t], maxDelay, start, mask, &x);
+            multiTapWeights(x, &w[0], &w[1], &w[2], &w[3]);
+            multiTapAccumulate(buff, mask, idx, w, d->gains[t], output, numSamples);
+            idx = (idx + numSamples - 1) & mask;
+        }
+        else
+        {
+            const Lfloat delay = d->delays[t];
+            const Lfloat depth = d->modDepths[t];
+            for (int i = 0; i < numSamples; i++)
+            {
+                idx = multiTapPosition(delay + depth * m[i], maxDelay, start + i, mask, &x);
+                multiTapWeights(x, &w[0], &w[1], &w[2], &w[3]);
+                output[i] += d->gains[t] * multiTapRead(buff, mask, idx, w);
+            }
+            d->mods[t] = m[numSamples - 1];
+        }
+
+        d->tapOuts[t] = multiTapRead(buff, mask, idx, w);
+    }
+
+    d->inPoint = (start + numSamples) & mask;
+    d->dirty = 1;
+
+    d->lastIn = input[numSamples - 1];
+    d->lastOut = output[numSamples - 1];
+}
+
+void tMultiTapDelay_setModulation (tMultiTapDelay* const d, const Lfloat* mod)
+{
+    for (int t = 0; t < d->numTaps; t++)
+        d->mods[t] = mod[t];
+    d->dirty = 1;
+}
+
+void tMultiTapDelay_setNumTaps (tMultiTapDelay* const d, int numTaps)
+{
+    d->numTaps = LEAF_clipInt(0, numTaps, d->maxTaps);
+    d->dirty = 1;
+}
+
+int tMultiTapDelay_getNumTaps (tMultiTapDelay* const d)
+{
+    return d->numTaps;
+}
+
+void tMultiTapDelay_setTapDelay (tMultiTapDelay* const d, int tap, Lfloat delay)
+{
+    d->delays[tap] = LEAF_clip(1.0f, delay, (Lfloat) d->maxDelay);
+    d->dirty = 1;
+}
+
+Lfloat tMultiTapDelay_getTapDelay (tMultiTapDelay* const d, int tap)
+{
+    return d->delays[tap];
+}
+
+void tMultiTapDelay_setTapGain (tMultiTapDelay* const d, int tap, Lfloat gain)
+{
+    d->gains[tap] = gain;
+}
+
+void tMultiTapDelay_setTapModDepth (tMultiTapDelay* const d, int tap, Lfloat depth)
+{
+    d->modDepths[tap] = depth;
+    d->dirty = 1;
+}
+
+Lfloat tMultiTapDelay_getTapOut (tMultiTapDelay* const d, int tap)
+{
+    return d->tapOuts[tap];
+}
+
+void tMultiTapDelay_clear (tMultiTapDelay* const d)
+{
+    for (uint32_t i = 0; i <= d->bufferMask; i++)
+    {
+        d->buff[i] = 0.0f;
+    }
+}
+
+Lfloat tMultiTapDelay_getLastOut (tMultiTapDelay* const d)
+{
+    return d->lastOut;
+}
+
+Lfloat tMultiTapDelay_getLastIn (tMultiTapDelay* const d)
+{
+    return d->lastIn;
+}
+
 
 
 
@@ -1114,3 +1520,90 @@ int     tRingBuffer_getSize  (tRingBuffer* const r)
 {
     return r->size;
 }
+
+void    tSPSCRingBuffer_init (tSPSCRingBuffer** const ring, int size, LEAF* const leaf)
+{
+    tSPSCRingBuffer_initToPool(ring, size, &leaf->mempool);
+}
+
+void    tSPSCRingBuffer_initToPool (tSPSCRingBuffer** const ring, int size, tMempool** const mempool)
+{
+    tMempool* m = *mempool;
+    tSPSCRingBuffer* r = *ring = (tSPSCRingBuffer*) mpool_alloc(sizeof(tSPSCRingBuffer), m);
+    r->mempool = m;
+    
+    if (size < 1) size = 1;
+    r->size = delayPow2Size((uint32_t) size);
+    r->mask = r->size - 1;
+    
+    r->buffer = (Lfloat*) mpool_calloc(sizeof(Lfloat) * r->size, m);
+    r->writeCount = 0;
+    r->readCount = 0;
+}
+
+void    tSPSCRingBuffer_free (tSPSCRingBuffer** const ring)
+{
+    tSPSCRingBuffer* r = *ring;
+    
+    mpool_free((char*) r->buffer, r->mempool);
+    mpool_free((char*) r, r->mempool);
+}
+
+int     tSPSCRingBuffer_push (tSPSCRingBuffer* const r, const Lfloat* input, int numSamples)
+{
+    if (numSamples <= 0) return 0;
+    
+    // Acquire pairs with the consumer's release, so the slots it has read are free to reuse
+    const uint32_t write = r->writeCount;
+    const uint32_t space = r->size - (write - LEAF_atomicLoad(&r->readCount));
+    if ((uint32_t) numSamples > space) numSamples = (int) space;
+    
+    delayWriteSpans(r->buffer, r->size, write & r->mask, input, numSamples, 1.0f);
+    
+    // Release publishes the samples before the new count
+    LEAF_atomicStore(&r->writeCount, write + (uint32_t) numSamples);
+    return numSamples;
+}
+
+int     tSPSCRingBuffer_pop (tSPSCRingBuffer* const r, Lfloat* output, int numSamples)
+{
+    if (numSamples <= 0) return 0;
+    
+    const uint32_t read = r->readCount;
+    const uint32_t ready = LEAF_atomicLoad(&r->writeCount) - read;
+    if ((uint32_t) numSamples > ready) numSamples = (int) ready;
+    
+    delayReadSpans(r->buffer, r->size, read & r->mask, output, numSamples);
+    
+    LEAF_atomicStore(&r->readCount, read + (uint32_t) numSamples);
+    return numSamples;
+}
+
+int     tSPSCRingBuffer_readLatest (tSPSCRingBuffer* const r, Lfloat* output, int numSamples)
+{
+    const uint32_t write = LEAF_atomicLoad(&r->writeCount);
+    const uint32_t ready = write - r->readCount;
+    
+    if (numSamples < 0) numSamples = 0;
+    if ((uint32_t) numSamples > ready) numSamples = (int) ready;
+    
+    delayReadSpans(r->buffer, r->size, (write - (uint32_t) numSamples) & r->mask, output, numSamples);
+    
+    LEAF_atomicStore(&r->readCount, write);
+    return numSamples;
+}
+
+int     tSPSCRingBuffer_getNumReady (tSPSCRingBuffer* const r)
+{
+    return (int) (LEAF_atomicLoad(&r->writeCount) - LEAF_atomicLoad(&r->readCount));
+}
+
+int     tSPSCRingBuffer_getSpace (tSPSCRingBuffer* const r)
+{
+    return (int) (r->size - (LEAF_atomicLoad(&r->writeCount) - LEAF_atomicLoad(&r->readCount)));
+}
+
+int     tSPSCRingBuffer_getSize (tSPSCRingBuffer* const r)
+{
+    return (int) r->size;
+}
@@ -75,6 +75,20 @@ void tSampleReducer_setRatio(tSampleReducer* const s, Lfloat ratio)
 //============================================================================================================
 // Oversampler
 //============================================================================================================
+// Pick the FIR for the current ratio and quality, and split it into its polyphase
+// components so each upsampled output is one contiguous dot product
+static void tOversampler_setFilter (tOversampler* const os)
+{
+    int idx = (int)(log2f(os->ratio))-1+os->offset;
+    os->numTaps = __leaf_tablesize_firNumTaps[idx];
+    os->phaseLength = os->numTaps / os->ratio;
+    os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
+    
+    for (uint32_t p = 0; p < os->ratio; p++)
+        for (uint32_t k = 0; k < os->phaseLength; k++)
+            os->upCoeffs[p * os->phaseLength + k] = os->pCoeffs[(os->ratio - 1 - p) + k * os->ratio];
+}
+
 // Latency is equal to the phase length (numTaps / ratio)
 void tOversampler_init(tOversampler** const osr, int ratio, int extraQuality, LEAF* const leaf)
 {
@@ -96,12 +110,19 @@ void tOversampler_initToPool (tOversampler** const osr, int maxRatio, int extraQ
         os->maxRatio = maxRatio;
         os->allowHighQuality = extraQuality;
         os->ratio = os->maxRatio;
-        uint_fast16_t idx = (int)(log2f(os->ratio))-1+os->offset;
-        os->numTaps = __leaf_tablesize_firNumTaps[idx];
-        os->phaseLength = os->numTaps / os->ratio;
-        os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
-        os->upState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * os->numTaps * 2, m);
-        os->downState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * os->numTaps * 2, m);
+        os->kernels = &m->leaf->kernels;
+        
+        // Size the buffers for the longest filter setRatio and setQuality can switch to
+        uint32_t maxTaps = 0;
+        int maxIdx = (int)(log2f(os->maxRatio))-1;
+        for (int q = 0; q <= (extraQuality ? 6 : 0); q += 6)
+            for (int i = 0; i <= maxIdx; i++)
+                if (__leaf_tablesize_firNumTaps[i+q] > maxTaps) maxTaps = __leaf_tablesize_firNumTaps[i+q];
+        
+        os->upState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxTaps * 2, m);
+        os->downState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxTaps * 2, m);
+        os->upCoeffs = (Lfloat*) mpool_alloc(sizeof(Lfloat) * maxTaps, m);
+        tOversampler_setFilter(os);
     }
 }
 
@@ -111,6 +132,7 @@ void tOversampler_free (tOversampler** const osr)
     
     mpool_free((char*)os->upState, os->mempool);
     mpool_free((char*)os->downState, os->mempool);
+    mpool_free((char*)os->upCoeffs, os->mempool);
     mpool_free((char*)os, os->mempool);
 }
 
@@ -139,14 +161,10 @@ void tOversampler_upsample(tOversampler* const os, Lfloat input, Lfloat* output)
     }
     
     Lfloat *pState = os->upState;                 /* State pointer */
-    Lfloat *pCoeffs = os->pCoeffs;               /* Coefficient pointer */
+    Lfloat *pCoeffs = os->upCoeffs;              /* Polyphase coefficient pointer */
     Lfloat *pStateCur;
-    Lfloat *ptr1;                               /* Temporary pointer for state buffer */
-    Lfloat *ptr2;                               /* Temporary pointer for coefficient buffer */
-    Lfloat sum0;                                /* Accumulators */
     uint_fast16_t i, tapCnt;                    /* Loop counters */
     uint_fast16_t phaseLen = os->phaseLength;            /* Length of each polyphase filter component */
-    uint_fast16_t j;
     
     /* os->pState buffer contains previous frame (phaseLen - 1) samples */
     /* pStateCur points to the location where the new input data should be written */
@@ -155,51 +173,13 @@ void tOversampler_upsample(tOversampler* const os, Lfloat input, Lfloat* output)
     /* Copy new input sample into the state buffer */
     *pStateCur = input;
     
-    /* Address modifier index of coefficient buffer */
-    j = 1U;
-    
-    /* Loop over the Interpolation factor. */
-    i = os->ratio;
-    
-    while (i > 0U)
+    /* Loop over the Interpolation factor. Upsampling is done by stuffing L-1 zeros
+     * between each sample, so each output only sees one polyphase component of the
+     * filter, stored contiguously in upCoeffs. */
+    for (i = 0; i < os->ratio; i++)
     {
-        /* Set accumulator to zero */
-        sum0 = 0.0f;
-        
-        /* Initialize state pointer */
-        ptr1 = pState;
-        
-        /* Initialize coefficient pointer */
-        ptr2 = pCoeffs + (os->ratio - j);
-        
-        /* Loop over the polyPhase length.
-         Repeat until we've computed numTaps-(4*os->L) coefficients. */
-        
-        /* Initialize tapCnt with number of samples */
-        tapCnt = phaseLen;
-        
-        while (tapCnt > 0U)
-        {
-            /* Perform the multiply-accumulate */
-            sum0 += *ptr1++ * *ptr2;
-            
-            /* Upsampling is done by stuffing L-1 zeros between each sample.
-             * So instead of multiplying zeros with coefficients,
-             * Increment the coefficient pointer by interpolation factor times. */
-            ptr2 += os->ratio;
-            
-            /* Decrement loop counter */
-            tapCnt--;
-        }
-        
-        /* The result is in the accumulator, store in the destination buffer. */
-        *output++ = sum0 * os->ratio;
-        
-        /* Increment the address modifier index of coefficient buffer */
-        j++;
-        
-        /* Decrement the loop counter */
-        i--;
+        *output++ = os->kernels->dot(pState, pCoeffs, (int) phaseLen) * os->ratio;
+        pCoeffs += phaseLen;
     }
     
     /* Advance the state pointer by 1
@@ -238,10 +218,6 @@ Lfloat tOversampler_downsample(tOversampler* const os, Lfloat* input)
     Lfloat *pState = os->downState;                 /* State pointer */
     Lfloat *pCoeffs = os->pCoeffs;               /* Coefficient pointer */
     Lfloat *pStateCur;                          /* Points to the current sample of the state */
-    Lfloat *px0;                                /* Temporary pointer for state buffer */
-    Lfloat *pb;                                 /* Temporary pointer for coefficient buffer */
-    Lfloat x0, c0;                              /* Temporary variables to hold state and coefficient values */
-    Lfloat acc0;                                /* Accumulator */
     uint32_t numTaps = os->numTaps;                 /* Number of filter coefficients in the filter */
     uint32_t i, tapCnt;
     Lfloat output;
@@ -259,40 +235,13 @@ Lfloat tOversampler_downsample(tOversampler* const os, Lfloat* input)
         
     } while (--i);
     
-    /* Set accumulator to zero */
-    acc0 = 0.0f;
-    
-    /* Initialize state pointer */
-    px0 = pState;
-    
-    /* Initialize coeff pointer */
-    pb = pCoeffs;
-    
-    /* Initialize tapCnt with number of taps */
-    tapCnt = numTaps;
-    
-    while (tapCnt > 0U)
-    {
-        /* Read coefficients */
-        c0 = *pb++;
-        
-        /* Fetch 1 state variable */
-        x0 = *px0++;
-        
-        /* Perform the multiply-accumulate */
-        acc0 += x0 * c0;
-        
-        /* Decrement loop counter */
-        tapCnt--;
-    }
+    /* Perform the multiply-accumulate */
+    output = os->kernels->dot(pState, pCoeffs, (int) numTaps);
     
     /* Advance the state pointer by the decimation factor
      * to process the next group of decimation factor number samples */
     pState = pState + os->ratio;
     
-    /* The result is in the accumulator, store in the destination buffer. */
-    output = acc0;
-    
     /* Processing is complete.
      Now copy the last numTaps - 1 samples to the start of the state buffer.
      This prepares the state buffer for the next function call. */
@@ -324,10 +273,7 @@ void    tOversampler_setRatio       (tOversampler* const os, int ratio)
         ratio == 16 || ratio == 32 || ratio == 64)
     {
         os->ratio = ratio;
-        int idx = (int)(log2f(os->ratio))-1+os->offset;
-        os->numTaps = __leaf_tablesize_firNumTaps[idx];
-        os->phaseLength = os->numTaps / os->ratio;
-        os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
+        tOversampler_setFilter(os);
     }
 }
 
@@ -340,10 +286,7 @@ void    tOversampler_setQuality     (tOversampler* const os, int quality)
     
     if (os->ratio == 1) return;
     
-    int idx = (int)(log2f(os->ratio))-1+os->offset;
-    os->numTaps = __leaf_tablesize_firNumTaps[idx];
-    os->phaseLength = os->numTaps / os->ratio;
-    os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
+    tOversampler_setFilter(os);
 }
 
 int tOversampler_getLatency(tOversampler* const os)
@@ -352,10 +295,191 @@ int tOversampler_getLatency(tOversampler* const os)
 }
 #endif // LEAF_INCLUDE_OVERSAMPLER_TABLES
 
+//============================================================================================================
+// ANTIDERIVATIVE ANTI-ALIASING
+//============================================================================================================
+
+// First- and second-order ADAA after Parker, Zavalishin and Le Bivic, "Reducing the aliasing of
+// nonlinear waveshaping using continuous-time convolution" (DAFx 2016) and Bilbao, Esqueda, Parker
+// and Valimaki, "Antiderivative antialiasing for memoryless nonlinearities" (IEEE SPL 2017).
+// Each shape supplies itself and its first two antiderivatives. Below ADAA_TOL the difference
+// quotients are ill-conditioned, so the shape is evaluated at the midpoint instead.
+
+#define ADAA_TOL 1.0e-5
+
+typedef double (*adaaFunc)(double x, const void* ctx);
+
+static void adaaReset(ADAAState* const s, adaaFunc F1, adaaFunc F2, const void* ctx)
+{
+    s->x1 = 0.0;
+    s->x2 = 0.0;
+    s->F1x1 = F1(0.0, ctx);
+    s->F2x1 = F2(0.0, ctx);
+    s->D1 = s->F1x1;
+}
+
+// Recomputes the stored antiderivative terms at the previous inputs after the shape's
+// parameters change, so the next difference quotient doesn't mix old and new shapes
+static void adaaRebuild(ADAAState* const s, adaaFunc F1, adaaFunc F2, const void* ctx)
+{
+    double dx = s->x1 - s->x2;
+    s->F1x1 = F1(s->x1, ctx);
+    s->F2x1 = F2(s->x1, ctx);
+    s->D1 = (fabs(dx) < ADAA_TOL) ? F1(0.5 * (s->x1 + s->x2), ctx) : (s->F2x1 - F2(s->x2, ctx)) / dx;
+}
+
+static double adaaTick(ADAAState* const s, int order, double x, adaaFunc f, adaaFunc F1, adaaFunc F2, const void* ctx)
+{
+    double y;
+    
+    if (order == 1)
+    {
+        double F1x = F1(x, ctx);
+        double dx = x - s->x1;
+        if (fabs(dx) < ADAA_TOL) y = f(0.5 * (x + s->x1), ctx);
+        else y = (F1x - s->F1x1) / dx;
+        s->F1x1 = F1x;
+    }
+    else if (order == 2)
+    {
+        double F2x = F2(x, ctx);
+        double dx = x - s->x1;
+        double D = (fabs(dx) < ADAA_TOL) ? F1(0.5 * (x + s->x1), ctx) : (F2x - s->F2x1) / dx;
+        double dx2 = x - s->x2;
+        if (fabs(dx2) < ADAA_TOL)
+        {
+            double xBar = 0.5 * (x + s->x2);
+            double delta = xBar - s->x1;
+            if (fabs(delta) < ADAA_TOL) y = f(0.5 * (xBar + s->x1), ctx);
+            else y = (2.0 / delta) * (F1(xBar, ctx) + (s->F2x1 - F2(xBar, ctx)) / delta);
+        }
+        else y = 2.0 * (D - s->D1) / dx2;
+        s->F2x1 = F2x;
+        s->D1 = D;
+    }
+    else y = f(x, ctx);
+    
+    s->x2 = s->x1;
+    s->x1 = x;
+    return y;
+}
+
+// LEAF_tanh: x(27 + x^2) / (27 + 9x^2) = x/9 + (8/3) x / (x^2 + 3), clipped to +-1 beyond +-3
+#define ADAA_TANH_F1_3 3.8132088663840005 // F1(3) = 1/2 + (4/3) ln 12
+#define ADAA_TANH_F2_3 7.276424903776581  // F2(3) = 1/2 + (4/3)(3 ln 12 - 6 + 2 sqrt(3) pi / 3)
+
+static double adaaTanh(double x, const void* ctx)
+{
+    (void) ctx;
+    if (x > 3.0) return 1.0;
+    if (x < -3.0) return -1.0;
+    return x * (27.0 + x * x) / (27.0 + 9.0 * x * x);
+}
+
+static double adaaTanhF1(double x, const void* ctx)
+{
+    (void) ctx;
+    double ax = fabs(x);
+    if (ax > 3.0) return ax - 3.0 + ADAA_TANH_F1_3;
+    return x * x * (1.0 / 18.0) + (4.0 / 3.0) * log(x * x + 3.0);
+}
+
+static double adaaTanhF2(double x, const void* ctx)
+{
+    (void) ctx;
+    double ax = fabs(x);
+    if (ax > 3.0)
+    {
+        double d = ax - 3.0;
+        double F2 = ADAA_TANH_F2_3 + 0.5 * d * d + ADAA_TANH_F1_3 * d;
+        return x < 0.0 ? -F2 : F2;
+    }
+    return x * x * x * (1.0 / 54.0) + (4.0 / 3.0) * (x * log(x * x + 3.0) - 2.0 * x + 3.4641016151377546 * atan(x * 0.5773502691896258));
+}
+
+// leaf_softClip: 1.5(x - x^3/3), clipped to +-1 beyond +-1
+static double adaaSoftClip(double x, const void* ctx)
+{
+    (void) ctx;
+    if (x >= 1.0) return 1.0;
+    if (x <= -1.0) return -1.0;
+    return 1.5 * x - 0.5 * x * x * x;
+}
+
+static double adaaSoftClipF1(double x, const void* ctx)
+{
+    (void) ctx;
+    double ax = fabs(x);
+    if (ax > 1.0) return ax - 0.375;
+    return 0.75 * x * x - 0.125 * x * x * x * x;
+}
+
+static double adaaSoftClipF2(double x, const void* ctx)
+{
+    (void) ctx;
+    double ax = fabs(x);
+    if (ax > 1.0)
+    {
+        double F2 = 0.5 * x * x - 0.375 * ax + 0.1;
+        return x < 0.0 ? -F2 : F2;
+    }
+    return 0.25 * x * x * x - 0.025 * x * x * x * x * x;
+}
+
+static double adaaHardClip(double x, const void* ctx)
+{
+    (void) ctx;
+    if (x > 1.0) return 1.0;
+    if (x < -1.0) return -1.0;
+    return x;
+}
+
+static double adaaHardClipF1(double x, const void* ctx)
+{
+    (void) ctx;
+    double ax = fabs(x);
+    if (ax > 1.0) return ax - 0.5;
+    return 0.5 * x * x;
+}
+
+static double adaaHardClipF2(double x, const void* ctx)
+{
+    (void) ctx;
+    double ax = fabs(x);
+    if (ax > 1.0)
+    {
+        double F2 = 0.5 * x * x - 0.5 * ax + (1.0 / 6.0);
+        return x < 0.0 ? -F2 : F2;
+    }
+    return x * x * x * (1.0 / 6.0);
+}
+
 //============================================================================================================
 // SIMPLER WAVEFOLDER
 //============================================================================================================
 
+// The feedforward part of tWavefolder_tick as one memoryless function of the input:
+// FF * softclip(x) + (1 - FF) x - foldDepth * sin(2 pi x)
+static double wavefolderShape(double x, const void* ctx)
+{
+    const tWavefolder* w = (const tWavefolder*) ctx;
+    return w->FFAmount * adaaSoftClip(x, ctx) + (1.0 - w->FFAmount) * x - w->foldDepth * sin(6.283185307179586 * x);
+}
+
+static double wavefolderShapeF1(double x, const void* ctx)
+{
+    const tWavefolder* w = (const tWavefolder*) ctx;
+    return w->FFAmount * adaaSoftClipF1(x, ctx) + (1.0 - w->FFAmount) * 0.5 * x * x
+         + w->foldDepth * 0.15915494309189535 * cos(6.283185307179586 * x);
+}
+
+static double wavefolderShapeF2(double x, const void* ctx)
+{
+    const tWavefolder* w = (const tWavefolder*) ctx;
+    return w->FFAmount * adaaSoftClipF2(x, ctx) + (1.0 - w->FFAmount) * x * x * x * (1.0 / 6.0)
+         + w->foldDepth * 0.025330295910584444 * sin(6.283185307179586 * x);
+}
+
 void tWavefolder_init(tWavefolder** const wf, Lfloat ffAmount, Lfloat fbAmount, Lfloat foldDepth, LEAF* const leaf)
 {
     tWavefolder_initToPool   (wf, ffAmount, fbAmount, foldDepth, &leaf->mempool);
@@ -374,6 +498,8 @@ void tWavefolder_initToPool (tWavefolder** const wf, Lfloat ffAmount, Lfloat fbA
     w->FBAmount = fbAmount;
     w->FFAmount = ffAmount;
     w->invFBAmount = 1.0f / (1.0f + fbAmount);
+    w->adaaOrder = 0;
+    adaaReset(&w->adaa, wavefolderShapeF1, wavefolderShapeF2, w);
 }
 
 void tWavefolder_free (tWavefolder** const wf)
@@ -386,6 +512,7 @@ void tWavefolder_free (tWavefolder** const wf)
 void tWavefolder_setFFAmount(tWavefolder* const w, Lfloat ffAmount)
 {
     w->FFAmount = ffAmount;
+    if (w->adaaOrder > 0) adaaRebuild(&w->adaa, wavefolderShapeF1, wavefolderShapeF2, w);
 }
 void tWavefolder_setFBAmount(tWavefolder* const w, Lfloat fbAmount)
 {
@@ -397,6 +524,7 @@ void tWavefolder_setFBAmount(tWavefolder* const w, Lfloat fbAmount)
 void tWavefolder_setFoldDepth(tWavefolder* const w, Lfloat foldDepth)
 {
     w->foldDepth = foldDepth;
+    if (w->adaaOrder > 0) adaaRebuild(&w->adaa, wavefolderShapeF1, wavefolderShapeF2, w);
 }
 
 void tWavefolder_setOffset(tWavefolder* const w, Lfloat offset)
@@ -409,6 +537,12 @@ void tWavefolder_setGain(tWavefolder* const w, Lfloat gain)
     w->gain = gain;
 }
 
+void tWavefolder_setADAAOrder(tWavefolder* const w, int order)
+{
+    w->adaaOrder = LEAF_clipInt(0, order, 2);
+    adaaReset(&w->adaa, wavefolderShapeF1, wavefolderShapeF2, w);
+}
+
 Lfloat tWavefolder_tick(tWavefolder* const w, Lfloat in)
 {
     //Lfloat sample = in * w->offset + (w->gain * w->offset);
@@ -416,19 +550,6 @@ Lfloat tWavefolder_tick(tWavefolder* const w, Lfloat in)
     float curFB = w->FBAmount;
     float curFF = w->FFAmount;
 
-    //softclip approx for tanh saturation in original code
-    float ffSample = sample;
-    if (ffSample <= -1.0f)
-    {
-        ffSample = -1.0f;
-    } else if (ffSample >= 1.0f)
-    {
-        ffSample = 1.0f;
-    }
-    ffSample = ffSample - ((ffSample * ffSample * ffSample)* 0.3333333f);
-    ffSample *= 1.499999f;
-    float ff = (curFF * ffSample) + ((1.0f - curFF) * sample);
-
     //softclip approx for tanh saturation in original code
     float fbSample = w->FBsample;
     if (fbSample <= -1.0f)
@@ -442,13 +563,35 @@ Lfloat tWavefolder_tick(tWavefolder* const w, Lfloat in)
     fbSample *= 1.499999f;
     float fb = curFB * fbSample;
 
-    Lfloat tempVal = 0.0f;
+    if (w->adaaOrder > 0)
+    {
+        Lfloat folded = (Lfloat) adaaTick(&w->adaa, w->adaaOrder, sample,
+                                          wavefolderShape, wavefolderShapeF1, wavefolderShapeF2, w);
+        w->FBsample = folded + fb;
+    }
+    else
+    {
+        //softclip approx for tanh saturation in original code
+        float ffSample = sample;
+        if (ffSample <= -1.0f)
+        {
+            ffSample = -1.0f;
+        } else if (ffSample >= 1.0f)
+        {
+            ffSample = 1.0f;
+        }
+        ffSample = ffSample - ((ffSample * ffSample * ffSample)* 0.3333333f);
+        ffSample *= 1.499999f;
+        float ff = (curFF * ffSample) + ((1.0f - curFF) * sample);
+
+        Lfloat tempVal = 0.0f;
 #ifdef ARM_MATH_CM7
-    tempVal =arm_sin_f32(TWO_PI * sample);
+        tempVal =arm_sin_f32(TWO_PI * sample);
 #else
-    tempVal =sinf(TWO_PI * sample);
+        tempVal =sinf(TWO_PI * sample);
 #endif
-    w->FBsample = (ff + fb) - w->foldDepth * tempVal;
+        w->FBsample = (ff + fb) - w->foldDepth * tempVal;
+    }
     sample = w->FBsample * w->invFBAmount;
     sample = tHighpass_tick(w->dcBlock, sample);
     return sample;
@@ -788,3 +931,54 @@ void    tCrusher_setSamplingRatio (tCrusher* const c, Lfloat ratio)
     c->srr = ratio;
     tSampleReducer_setRatio(c->sReducer, ratio);
 }
+
+//============================================================================================================
+// ADAA SHAPER
+//============================================================================================================
+
+static const adaaFunc adaaShapes[ADAAShapeNil][3] =
+{
+    { adaaTanh, adaaTanhF1, adaaTanhF2 },
+    { adaaSoftClip, adaaSoftClipF1, adaaSoftClipF2 },
+    { adaaHardClip, adaaHardClipF1, adaaHardClipF2 }
+};
+
+void tADAAShaper_init (tADAAShaper** const sh, ADAAShape shape, int order, LEAF* const leaf)
+{
+    tADAAShaper_initToPool(sh, shape, order, &leaf->mempool);
+}
+
+void tADAAShaper_initToPool (tADAAShaper** const sh, ADAAShape shape, int order, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tADAAShaper* s = *sh = (tADAAShaper*) mpool_alloc(sizeof(tADAAShaper), m);
+    s->mempool = m;
+    
+    s->shape = (ADAAShape) LEAF_clipInt(0, (int) shape, ADAAShapeNil - 1);
+    tADAAShaper_setOrder(s, order);
+}
+
+void tADAAShaper_free (tADAAShaper** const sh)
+{
+    tADAAShaper* s = *sh;
+    
+    mpool_free((char*)s, s->mempool);
+}
+
+Lfloat tADAAShaper_tick (tADAAShaper* const s, Lfloat input)
+{
+    const adaaFunc* f = adaaShapes[s->shape];
+    return (Lfloat) adaaTick(&s->adaa, s->order, input, f[0], f[1], f[2], NULL);
+}
+
+void tADAAShaper_setShape (tADAAShaper* const s, ADAAShape shape)
+{
+    s->shape = (ADAAShape) LEAF_clipInt(0, (int) shape, ADAAShapeNil - 1);
+    adaaReset(&s->adaa, adaaShapes[s->shape][1], adaaShapes[s->shape][2], NULL);
+}
+
+void tADAAShaper_setOrder (tADAAShaper* const s, int order)
+{
+    s->order = LEAF_clipInt(0, order, 2);
+    adaaReset(&s->adaa, adaaShapes[s->shape][1], adaaShapes[s->shape][2], NULL);
+}
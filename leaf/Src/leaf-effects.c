@@ -698,6 +698,10 @@ void tVocoder_initToPool (tVocoder** const voc, tMempool** const mp)
     v->param[6] = 0.6667f;//freq range
     v->param[7] = 0.33f;  //num bands
     
+    v->coeffMode = LEAFCoeffsImmediate;
+    v->dirty = 0;
+    for (int i = 0; i < 4; i++) v->bandParams[i] = -1.0f;
+    
     tVocoder_update(*voc);
 }
 
@@ -708,7 +712,7 @@ void tVocoder_free (tVocoder** const voc)
     mpool_free((char*)v, v->mempool);
 }
 
-void        tVocoder_update      (tVocoder* const v)
+static void tVocoder_calcCoeffs (tVocoder* const v)
 {
     Lfloat tpofs = 6.2831853f * v->invSampleRate;
     
@@ -718,6 +722,12 @@ void        tVocoder_update      (tVocoder* const v)
     
     int32_t i;
     
+    // The band filters cost two acosf each, so only redo them when something they use has changed
+    Lfloat bandParams[4] = { v->param[5], v->param[6], (Lfloat) (v->param[7] < 0.5f), v->invSampleRate };
+    int bandsChanged = memcmp(bandParams, v->bandParams, sizeof(bandParams)) != 0;
+    memcpy(v->bandParams, bandParams, sizeof(bandParams));
+    v->dirty = 0;
+    
     v->gain = (Lfloat)pow(10.0f, 2.0f * v->param[1] - 3.0f * v->param[5] - 2.0f);
     
     v->thru = (Lfloat)pow(10.0f, 0.5f + 2.0f * v->param[1]);
@@ -728,33 +738,39 @@ void        tVocoder_update      (tVocoder* const v)
     {
         v->nbnd=8;
 
-        v->f[1][2] = 3000.0f;
-        v->f[2][2] = 2200.0f;
-        v->f[3][2] = 1500.0f;
-        v->f[4][2] = 1080.0f;
-        v->f[5][2] = 700.0f;
-        v->f[6][2] = 390.0f;
-        v->f[7][2] = 190.0f;
+        if (bandsChanged)
+        {
+            v->f[1][2] = 3000.0f;
+            v->f[2][2] = 2200.0f;
+            v->f[3][2] = 1500.0f;
+            v->f[4][2] = 1080.0f;
+            v->f[5][2] = 700.0f;
+            v->f[6][2] = 390.0f;
+            v->f[7][2] = 190.0f;
+        }
     }
     else
     {
         v->nbnd=16;
 
-        v->f[ 1][2] = 5000.0f; //+1000
-        v->f[ 2][2] = 4000.0f; //+750
-        v->f[ 3][2] = 3250.0f; //+500
-        v->f[ 4][2] = 2750.0f; //+450
-        v->f[ 5][2] = 2300.0f; //+300
-        v->f[ 6][2] = 2000.0f; //+250
-        v->f[ 7][2] = 1750.0f; //+250
-        v->f[ 8][2] = 1500.0f; //+250
-        v->f[ 9][2] = 1250.0f; //+250
-        v->f[10][2] = 1000.0f; //+250
-        v->f[11][2] =  750.0f; //+210
-        v->f[12][2] =  540.0f; //+190
-        v->f[13][2] =  350.0f; //+155
-        v->f[14][2] =  195.0f; //+100
-        v->f[15][2] =   95.0f;
+        if (bandsChanged)
+        {
+            v->f[ 1][2] = 5000.0f; //+1000
+            v->f[ 2][2] = 4000.0f; //+750
+            v->f[ 3][2] = 3250.0f; //+500
+            v->f[ 4][2] = 2750.0f; //+450
+            v->f[ 5][2] = 2300.0f; //+300
+            v->f[ 6][2] = 2000.0f; //+250
+            v->f[ 7][2] = 1750.0f; //+250
+            v->f[ 8][2] = 1500.0f; //+250
+            v->f[ 9][2] = 1250.0f; //+250
+            v->f[10][2] = 1000.0f; //+250
+            v->f[11][2] =  750.0f; //+210
+            v->f[12][2] =  540.0f; //+190
+            v->f[13][2] =  350.0f; //+155
+            v->f[14][2] =  195.0f; //+100
+            v->f[15][2] =   95.0f;
+        }
     }
     
     if(v->param[4]<0.05f) //freeze
@@ -774,6 +790,8 @@ void        tVocoder_update      (tVocoder* const v)
         v->f[0][12] = 0.5f * v->f[0][12]; //only top band is at full rate
     }
     
+    if (!bandsChanged) return;
+    
     rr = 1.0f - powf(10.0f, -1.0f - 1.2f * v->param[5]);
     sh = (Lfloat)pow(2.0f, 3.0f * v->param[6] - 1.0f); //filter bank range shift
     
@@ -790,8 +808,22 @@ void        tVocoder_update      (tVocoder* const v)
     }
 }
 
+void        tVocoder_update      (tVocoder* const v)
+{
+    if (v->coeffMode == LEAFCoeffsImmediate) tVocoder_calcCoeffs(v);
+    else v->dirty = 1;
+}
+
+void        tVocoder_setCoeffMode (tVocoder* const v, LEAFCoeffMode mode)
+{
+    v->coeffMode = mode;
+    if (mode == LEAFCoeffsImmediate && v->dirty) tVocoder_calcCoeffs(v);
+}
+
 Lfloat       tVocoder_tick        (tVocoder* const v, Lfloat synth, Lfloat voice)
 {
+    if (v->dirty) tVocoder_calcCoeffs(v);
+    
     Lfloat a, b, o=0.0f, aa, bb, oo = v->kout, g = v->gain, ht = v->thru, hh = v->high, tmp;
     uint32_t i, k = v->kval, nb = v->nbnd;
     
@@ -841,8 +873,7 @@ Lfloat       tVocoder_tick        (tVocoder* const v, Lfloat synth, Lfloat voice
     
     v->kout = oo;
     v->kval = k & 0x1;
-#ifdef NO_DENORMAL_CHECK
-#else
+#if !LEAF_NO_DENORMAL_CHECK
     if(fabs(v->f[0][11])<1.0e-10) v->f[0][11] = 0.0f; //catch HF envelope denormal
     
     for(i=1;i<nb;i++)
@@ -992,7 +1023,7 @@ void   tRosenbergGlottalPulse_setSampleRate(tRosenbergGlottalPulse* const g, Lfl
 /***************** static function declarations *******************************/
 /******************************************************************************/
 
-static inline Lfloat read_sample(tSOLAD *w, Lfloat Lfloatindex);
+static void solad_write(tSOLAD *w, Lfloat *in, int blocksize);
 static void pitchdown(tSOLAD *w, Lfloat *out);
 static void pitchup(tSOLAD *w, Lfloat *out);
 
@@ -1011,10 +1042,14 @@ void tSOLAD_initToPool (tSOLAD** const wp, int loopSize, tMempool** const mp)
     tMempool* m = *mp;
     tSOLAD* w = *wp = (tSOLAD*) mpool_calloc(sizeof(tSOLAD), m);
     w->mempool = m;
+    w->kernels = &m->leaf->kernels;
     
     w->loopSize = loopSize;
     w->pitchfactor = 1.;
     w->delaybuf = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (w->loopSize+1), m);
+    w->ownbuf = w->delaybuf;
+    w->source = NULL;
+    w->attack = 0;
 
     w->timeindex = 0;
     w->xfadevalue = -1;
@@ -1032,29 +1067,19 @@ void tSOLAD_free (tSOLAD** const wp)
     
     tAttackDetection_free(&w->ad);
     tHighpass_free(&w->hp);
-    mpool_free((char*)w->delaybuf, w->mempool);
+    mpool_free((char*)w->ownbuf, w->mempool);
     mpool_free((char*)w, w->mempool);
 }
 
 // send one block of input samples, receive one block of output samples
 void tSOLAD_ioSamples(tSOLAD* const w, Lfloat* in, Lfloat* out, int blocksize)
 {
-    int i = w->timeindex;
-    int n = w->blocksize = blocksize;
+    w->blocksize = blocksize;
     
-    if(!i)
-    {
-        Lfloat sample = tHighpass_tick(w->hp, in[0]);
-        w->delaybuf[0] = sample;
-        w->delaybuf[w->loopSize] = sample;   // copy one sample for interpolation
-        n--;
-        i++;
-        in++;
-    }
-    while(n--) w->delaybuf[i++] = tHighpass_tick(w->hp, *in++);    // copy one input block to delay buffer
+    // A shared source has already written this block to the buffer
+    if (w->source == NULL) solad_write(w, in, blocksize);
     
-    tAttackDetection_setBlocksize(w->ad, n);
-    if (tAttackDetection_detect(w->ad, in))
+    if (w->source != NULL ? w->source->attack : w->attack)
     {
         tSOLAD_setReadLag(w, w->blocksize);
     }
@@ -1101,11 +1126,12 @@ void tSOLAD_setReadLag(tSOLAD* const w, Lfloat readlag)
 void tSOLAD_resetState(tSOLAD* const w)
 {
     int n = w->loopSize;
-    Lfloat *buf = w->delaybuf;
+    Lfloat *buf = w->ownbuf;
     
     while(n--) *buf++ = 0;
     
-    w->timeindex = 0;
+    // A voice sharing another's input leaves that buffer alone and keeps writing in step with its source
+    w->timeindex = (w->source != NULL) ? w->source->timeindex : 0;
     w->xfadevalue = -1;
     w->period = INITPERIOD;
     w->readlag = INITPERIOD;
@@ -1118,10 +1144,42 @@ void tSOLAD_setSampleRate(tSOLAD* const w, Lfloat sr)
     tHighpass_setSampleRate(w->hp, sr);
 }
 
+void tSOLAD_setInput(tSOLAD* const w, tSOLAD* const source)
+{
+    w->source = source;
+    if (source != NULL)
+    {
+        w->delaybuf = source->delaybuf;
+        w->timeindex = source->timeindex;
+    }
+    else w->delaybuf = w->ownbuf;
+}
+
 /******************************************************************************/
 /******************** private procedures **************************************/
 /******************************************************************************/
 
+// highpass one input block into the delay buffer and run attack detection on it
+static void solad_write(tSOLAD* const w, Lfloat *in, int blocksize)
+{
+    int i = w->timeindex;
+    int n = blocksize;
+    
+    if(!i)
+    {
+        Lfloat sample = tHighpass_tick(w->hp, in[0]);
+        w->delaybuf[0] = sample;
+        w->delaybuf[w->loopSize] = sample;   // copy one sample for interpolation
+        n--;
+        i++;
+        in++;
+    }
+    while(n--) w->delaybuf[i++] = tHighpass_tick(w->hp, *in++);    // copy one input block to delay buffer
+    
+    tAttackDetection_setBlocksize(w->ad, n);
+    w->attack = tAttackDetection_detect(w->ad, in);
+}
+
 /*
  Function pitchdown() is called to read samples from the delay buffer when pitch
  factor is between 0.25 and 1. The read pointer lags behind because of the slowed
@@ -1161,13 +1219,18 @@ static void pitchdown(tSOLAD* const w, Lfloat *out)
     Lfloat jump = w->jump;
     Lfloat xfadevalue = w->xfadevalue;
     Lfloat xfadelength = w->xfadelength;
-    Lfloat xfadespeed, xfadestep, readindex, outputsample;
+    Lfloat xfadespeed, xfadestep, pos, gain;
+    int mask = w->loopSize - 1;
+    int length, fading;
     
     if(pitchfactor > 0.5) xfadespeed = pitchfactor;
     else xfadespeed = 1 - pitchfactor;
     xfadestep = xfadespeed / xfadelength;
     
-    while(n--)
+    // Between read pointer events the read index moves by pitchfactor and the
+    // crossfade by xfadestep per output sample, so each stretch up to the next
+    // event is read and mixed in one go
+    while(n > 0)
     {
         if(readlag > period)        // check if read pointer may jump forward...
         {
@@ -1182,19 +1245,28 @@ static void pitchdown(tSOLAD* const w, Lfloat *out)
             }
         }
         
-        readindex = refindex - readlag;
-        outputsample = read_sample(w, readindex);
-        
-        if(xfadevalue > 0)
+        // Step the read lag and crossfade sample by sample up to the end of the crossfade or the
+        // next sample that may jump, so that jumps land on the same samples as a per-sample loop
+        pos = refindex - readlag;
+        gain = xfadevalue;
+        fading = xfadevalue > 0;
+        length = 0;
+        do
         {
-            outputsample *= (1 - xfadevalue);                               // fadein
-            outputsample += read_sample(w, readindex - jump) * xfadevalue;  // fadeout
-            xfadevalue -= xfadestep;
+            if(fading) xfadevalue -= xfadestep;
+            readlag += readlagstep;
+            length++;
         }
+        while((length < n) && ((xfadevalue > 0) == fading) && !((readlag > period) && (xfadevalue <= 0)));
+        
+        // fadein at the read index, fadeout one jump behind
+        if(fading) w->kernels->lerpRampCrossfadeAdd(out, w->delaybuf, mask, pos, pitchfactor,
+                                                    jump, gain, xfadestep, length);
+        else w->kernels->lerpRampAdd(out, w->delaybuf, mask, pos, pitchfactor, length);
         
-        *out++ += outputsample;
-        refindex += 1;
-        readlag += readlagstep;
+        out += length;
+        n -= length;
+        refindex += length;
     }
     
     w->jump = jump;                 // state variables
@@ -1284,7 +1356,9 @@ static void pitchup(tSOLAD* const w, Lfloat *out)
     Lfloat xfadestep = xfadespeed / xfadelength;
     Lfloat limitfactor = (pitchfactor - (Lfloat)0.99) / xfadespeed;
     Lfloat limit = period * limitfactor;
-    Lfloat readindex, outputsample;
+    Lfloat pos, gain;
+    int mask = w->loopSize - 1;
+    int length, fading;
     
     if((readlag > (period + 2 * limit)) & (xfadevalue < 0))
     {
@@ -1296,7 +1370,8 @@ static void pitchup(tSOLAD* const w, Lfloat *out)
         xfadestep = xfadespeed / xfadelength;
     }
     
-    while(n--)
+    // read and mix one stretch between read pointer events at a time, as in pitchdown()
+    while(n > 0)
     {
         if(readlag < limit)  // check if read pointer should jump backward...
         {
@@ -1312,19 +1387,25 @@ static void pitchup(tSOLAD* const w, Lfloat *out)
             }
         }
         
-        readindex = refindex - readlag;
-        outputsample = read_sample(w, readindex);
-        
-        if(xfadevalue > 0)
+        pos = refindex - readlag;
+        gain = xfadevalue;
+        fading = xfadevalue > 0;
+        length = 0;
+        do
         {
-            outputsample *= (1 - xfadevalue);
-            outputsample += read_sample(w, readindex - jump) * xfadevalue;
-            xfadevalue -= xfadestep;
+            if(fading) xfadevalue -= xfadestep;
+            readlag -= readlagstep;
+            length++;
         }
+        while((length < n) && ((xfadevalue > 0) == fading) && !((readlag < limit) && ((xfadevalue < 0) | (readlag < 0))));
+        
+        if(fading) w->kernels->lerpRampCrossfadeAdd(out, w->delaybuf, mask, pos, pitchfactor,
+                                                    jump, gain, xfadestep, length);
+        else w->kernels->lerpRampAdd(out, w->delaybuf, mask, pos, pitchfactor, length);
         
-        *out++ += outputsample;
-        refindex += 1;
-        readlag -= readlagstep;
+        out += length;
+        n -= length;
+        refindex += length;
     }
     
     w->readlag = readlag;               // state variables
@@ -1333,17 +1414,6 @@ static void pitchup(tSOLAD* const w, Lfloat *out)
     w->xfadevalue = xfadevalue;
 }
 
-// read one sample from delay buffer, with linear interpolation
-static inline Lfloat read_sample(tSOLAD* const w, Lfloat Lfloatindex)
-{
-    int index = (int)Lfloatindex;
-    Lfloat fraction = Lfloatindex - (Lfloat)index;
-    Lfloat *buf = w->delaybuf;
-    index &= (w->loopSize - 1);
-    
-    return (buf[index] + (fraction * (buf[index+1] - buf[index])));
-}
-
 //============================================================================================================
 // PITCHSHIFT
 //============================================================================================================
@@ -1452,6 +1522,8 @@ void tSimpleRetune_initToPool (tSimpleRetune** const rt, int numVoices, Lfloat m
     for (int i = 0; i < r->numVoices; ++i)
     {
         tPitchShift_initToPool(&r->ps[i], &r->dp, r->bufSize, mp);
+        // Highpass and attack detection run once per block, in the first voice
+        if (i > 0) tSOLAD_setInput(r->ps[i]->sola, r->ps[0]->sola);
     }
     
     r->shiftFunction = &tPitchShift_shiftBy;
@@ -1549,6 +1621,11 @@ void tSimpleRetune_setSampleRate (tSimpleRetune* const r, Lfloat sr)
     }
 }
 
+void tSimpleRetune_setAsync (tSimpleRetune* const r, int async)
+{
+    tDualPitchDetector_setAsync(r->dp, async);
+}
+
 //============================================================================================================
 // RETUNE
 //============================================================================================================
@@ -1579,11 +1656,13 @@ void tRetune_initToPool (tRetune** const rt, int numVoices, Lfloat minInputFreq,
     
     r->minInputFreq = minInputFreq;
     r->maxInputFreq = maxInputFreq;
-    tDualPitchDetector_initToPool(r->dp, r->minInputFreq, r->maxInputFreq, r->pdBuffer, 2048, mp);
+    tDualPitchDetector_initToPool(&r->dp, r->minInputFreq, r->maxInputFreq, r->pdBuffer, 2048, mp);
 
     for (int i = 0; i < r->numVoices; ++i)
     {
-        tPitchShift_initToPool(&r->ps[i], r->dp, r->bufSize, mp);
+        tPitchShift_initToPool(&r->ps[i], &r->dp, r->bufSize, mp);
+        // Highpass and attack detection run once per block, in the first voice
+        if (i > 0) tSOLAD_setInput(r->ps[i]->sola, r->ps[0]->sola);
         r->outBuffers[i] = (Lfloat*) mpool_calloc(sizeof(Lfloat) * r->bufSize, m);
     }
     
@@ -1594,7 +1673,7 @@ void tRetune_free (tRetune** const rt)
 {
     tRetune* r = *rt;
     
-    tDualPitchDetector_free(r->dp);
+    tDualPitchDetector_free(&r->dp);
     for (int i = 0; i < r->numVoices; ++i)
     {
         tPitchShift_free(&r->ps[i]);
@@ -1611,7 +1690,7 @@ void tRetune_free (tRetune** const rt)
 
 Lfloat* tRetune_tick(tRetune* const r, Lfloat sample)
 {
-    tDualPitchDetector_tick(*r->dp, sample);
+    tDualPitchDetector_tick(r->dp, sample);
     
     r->inBuffer[r->index] = sample;
     for (int i = 0; i < r->numVoices; ++i)
@@ -1641,7 +1720,7 @@ void tRetune_setMode (tRetune* const r, int mode)
 
 void tRetune_setPickiness (tRetune* const r, Lfloat p)
 {
-    tDualPitchDetector_setPeriodicityThreshold(*r->dp, p);
+    tDualPitchDetector_setPeriodicityThreshold(r->dp, p);
 }
 //currently broken
 void tRetune_setNumVoices(tRetune* const r, int numVoices)
@@ -1671,18 +1750,23 @@ void tRetune_tuneVoice(tRetune* const r, int voice, Lfloat t)
 
 Lfloat tRetune_getInputFrequency (tRetune* const r)
 {
-    return tDualPitchDetector_getFrequency(*r->dp);
+    return tDualPitchDetector_getFrequency(r->dp);
 }
 
 void tRetune_setSampleRate(tRetune* const r, Lfloat sr)
 {
-    tDualPitchDetector_setSampleRate(*r->dp, sr);
+    tDualPitchDetector_setSampleRate(r->dp, sr);
     for (int i = 0; i < r->numVoices; ++i)
     {
         tPitchShift_setSampleRate(r->ps[i], sr);
     }
 }
 
+void tRetune_setAsync (tRetune* const r, int async)
+{
+    tDualPitchDetector_setAsync(r->dp, async);
+}
+
 //============================================================================================================
 // FORMANTSHIFTER
 //============================================================================================================
@@ -176,6 +176,7 @@ void    tWDF_initToPool(tWDF** const wdf, WDFComponentType type, Lfloat value, t
 {
     tMempool* m = *mp;
     *wdf = (tWDF*) mpool_alloc(sizeof(tWDF), m);
+    (*wdf)->mempool = m;
     
     wdf_init(wdf, type, value, rL, rR);
 }
@@ -268,6 +269,193 @@ Lfloat tWDF_getCurrent(tWDF* const r)
     return (((r->incident_wave_up * 0.5f) - (r->reflected_wave_up * 0.5f)) * r->port_conductance_up);
 }
 
+//============ Compiled Programs ====================================
+//===================================================================
+
+static int wdf_count_nodes(tWDF* const r)
+{
+    if (r == NULL) return 0;
+    return 1 + wdf_count_nodes(r->child_left) + wdf_count_nodes(r->child_right);
+}
+
+// Number the nodes children first so the up pass can run forwards and the down pass backwards.
+static int wdf_layout(tWDFProgram* const p, tWDF* const r, int* const next)
+{
+    if (r == NULL) return 0;
+    int left = wdf_layout(p, r->child_left, next);
+    int right = wdf_layout(p, r->child_right, next);
+    int slot = (*next)++;
+    p->nodes[slot] = r;
+    p->ops[slot].left = left;
+    p->ops[slot].right = right;
+    p->ops[slot].sign = (r->type == Inductor) ? -1.0f : 1.0f;
+    return slot;
+}
+
+void tWDFProgram_init(tWDFProgram** const prog, tWDF* const root, tWDF* const outputPoint, LEAF* const leaf)
+{
+    tWDFProgram_initToPool(prog, root, outputPoint, &leaf->mempool);
+}
+
+void tWDFProgram_initToPool(tWDFProgram** const prog, tWDF* const root, tWDF* const outputPoint, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tWDFProgram* p = *prog = (tWDFProgram*) mpool_alloc(sizeof(tWDFProgram), m);
+    p->mempool = m;
+    
+    p->root = root;
+    tWDF* child;
+    if (root->child_left != NULL) child = root->child_left;
+    else child = root->child_right;
+    p->numNodes = wdf_count_nodes(child);
+    
+    int numSlots = p->numNodes + 2;
+    p->nodes = (tWDF**) mpool_calloc(sizeof(tWDF*) * numSlots, m);
+    p->ops = (WDFOp*) mpool_calloc(sizeof(WDFOp) * numSlots, m);
+    p->a = (Lfloat*) mpool_calloc(sizeof(Lfloat) * numSlots, m);
+    p->b = (Lfloat*) mpool_calloc(sizeof(Lfloat) * numSlots, m);
+    
+    int next = 1;
+    wdf_layout(p, child, &next);
+    p->nodes[p->numNodes + 1] = root;
+    
+    p->outputSlot = p->numNodes + 1;
+    for (int i = 1; i <= p->numNodes; i++)
+    {
+        if (p->nodes[i] == outputPoint) p->outputSlot = i;
+        // pick up the wave state the tree already has
+        p->a[i] = p->nodes[i]->incident_wave_up;
+        p->b[i] = p->nodes[i]->reflected_wave_up;
+    }
+    
+    tWDFProgram_update(p);
+}
+
+void tWDFProgram_free(tWDFProgram** const prog)
+{
+    tWDFProgram* p = *prog;
+    
+    mpool_free((char*)p->b, p->mempool);
+    mpool_free((char*)p->a, p->mempool);
+    mpool_free((char*)p->ops, p->mempool);
+    mpool_free((char*)p->nodes, p->mempool);
+    mpool_free((char*)p, p->mempool);
+}
+
+void tWDFProgram_update(tWDFProgram* const p)
+{
+    tWDF_getPortResistance(p->root);
+    
+    for (int i = 1; i <= p->numNodes; i++)
+    {
+        WDFOp* op = &p->ops[i];
+        tWDF* r = p->nodes[i];
+        Lfloat sl = p->ops[op->left].sign;
+        Lfloat sr = p->ops[op->right].sign;
+        
+        op->cState = 0.0f;
+        op->cIn = 0.0f;
+        op->uL = 0.0f;
+        op->uR = 0.0f;
+        op->kLL = 0.0f;
+        op->kLR = 0.0f;
+        op->kLU = 0.0f;
+        op->kRL = 0.0f;
+        op->kRR = 0.0f;
+        op->kRU = 0.0f;
+        
+        if (r->type == Capacitor || r->type == Inductor)
+        {
+            op->cState = 1.0f;
+        }
+        else if (r->type == ResistiveSource)
+        {
+            op->cIn = 1.0f;
+        }
+        else if (r->type == Inverter)
+        {
+            op->uL = -1.0f;
+            op->kLU = -1.0f * sl;
+        }
+        else if (r->type == SeriesAdaptor)
+        {
+            Lfloat gamma_left = r->port_resistance_left * r->gamma_zero;
+            Lfloat gamma_right = r->port_resistance_right * r->gamma_zero;
+            op->uL = -1.0f;
+            op->uR = -1.0f;
+            op->kLL = gamma_right * sl;
+            op->kLR = -gamma_left * sl;
+            op->kLU = -gamma_left * sl;
+            op->kRL = -gamma_right * sr;
+            op->kRR = gamma_left * sr;
+            op->kRU = -gamma_right * sr;
+        }
+        else if (r->type == ParallelAdaptor)
+        {
+            Lfloat gamma_left = r->port_conductance_left * r->gamma_zero;
+            Lfloat gamma_right = r->port_conductance_right * r->gamma_zero;
+            op->uL = gamma_left;
+            op->uR = gamma_right;
+            op->kLL = (gamma_left - 1.0f) * sl;
+            op->kLR = gamma_right * sl;
+            op->kLU = sl;
+            op->kRL = gamma_left * sr;
+            op->kRR = (gamma_right - 1.0f) * sr;
+            op->kRU = sr;
+        }
+        // a Resistor reflects nothing, so its row stays zero
+    }
+}
+
+Lfloat tWDFProgram_tick(tWDFProgram* const p, Lfloat sample)
+{
+    tWDFProgram_tickBlock(p, &sample, &sample, 1);
+    return sample;
+}
+
+void tWDFProgram_tickBlock(tWDFProgram* const p, const Lfloat* input, Lfloat* output, int numSamples)
+{
+    const int n = p->numNodes;
+    const int rootSlot = n + 1;
+    const int out = p->outputSlot;
+    const WDFOp* ops = p->ops;
+    Lfloat* a = p->a;
+    Lfloat* b = p->b;
+    tWDF* root = p->root;
+    const Lfloat rootSign = ops[n].sign;
+    
+    for (int s = 0; s < numSamples; s++)
+    {
+        Lfloat x = input[s];
+        
+        // scan the waves up the tree
+        for (int i = 1; i <= n; i++)
+        {
+            const WDFOp* op = &ops[i];
+            b[i] = (op->cState * a[i] + op->cIn * x) + (op->uL * b[op->left] + op->uR * b[op->right]);
+        }
+        
+        // root scattering
+        a[rootSlot] = b[n];
+        if (root->type == IdealSource) b[rootSlot] = (2.0f * x) - a[rootSlot];
+        else b[rootSlot] = root->get_reflected_wave_down(root, x, a[rootSlot]);
+        a[n] = rootSign * b[rootSlot];
+        
+        // propagate waves down the tree. Leaves write into the null slot 0.
+        for (int i = n; i >= 1; i--)
+        {
+            const WDFOp* op = &ops[i];
+            Lfloat bl = b[op->left];
+            Lfloat br = b[op->right];
+            Lfloat au = a[i];
+            a[op->left] = (op->kLL * bl + op->kLR * br) + op->kLU * au;
+            a[op->right] = (op->kRL * bl + op->kRR * br) + op->kRU * au;
+        }
+        
+        output[s] = (a[out] * 0.5f) + (b[out] * 0.5f);
+    }
+}
+
 //============ Static Functions to be Pointed To ====================
 //===================================================================
 //============ Get and Calculate Port Resistances ===================
@@ -9,6 +9,8 @@
 */
 
 
+#define LEAF_ENVELOPES_C
+
 #if _WIN32 || _WIN64
 
 #include "..\Inc\leaf-envelopes.h"
@@ -193,6 +195,161 @@ Lfloat tEnvelope_tick (tEnvelope* const env)
 
 #endif // LEAF_INCLUDE_ADSR_TABLES
 
+/* One-multiply-one-add envelope stages */
+// A stage's output is A + B * F(phase), where F is the lookup buffer and phase steps by inc each sample.
+// When F is an exponential plus an offset, F(p) = scale * exp(logRatio * p) + offset, the output obeys
+// y[n+1] = R * y[n] + (1 - R) * (A + B * offset) with R = exp(logRatio * inc), so it can be run without
+// the buffer. The shape is fitted through F(0), F(last / 2) and F(last); a buffer that is not exponential
+// falls back to a straight line.
+static void LEAFExpSegment_fit (LEAFExpSegment* const s, const Lfloat* buffer, uint32_t last)
+{
+    uint32_t half = last / 2;
+    Lfloat y0 = buffer[0], ym = buffer[half], y1 = buffer[2 * half];
+    Lfloat d0 = ym - y0;
+    Lfloat q = (d0 != 0.0f) ? (y1 - ym) / d0 : 0.0f;
+
+    if (half == 0 || q <= 0.0f || fabsf(q - 1.0f) < 0.0001f)
+    {
+        s->logRatio = 0.0f;
+        s->scale = 0.0f;
+        s->offset = y0;
+        s->slope = (half > 0) ? (y1 - y0) / (Lfloat) (2 * half) : 0.0f;
+    }
+    else
+    {
+        s->logRatio = logf(q) / (Lfloat) half;
+        s->scale = d0 / (q - 1.0f);
+        s->offset = y0 - s->scale;
+        s->slope = 0.0f;
+    }
+    s->coef = 0.0f;
+    s->base = 0.0f;
+    s->value = 0.0f;
+    s->remaining = UINT32_MAX;
+    s->stage = env_idle;
+}
+
+// Work out a stage's per-sample coefficient and length. reversed reads the buffer from the end, as tADSR's attack does.
+static void LEAFExpSegment_setStage (LEAFExpSegment* const s, int stage, Lfloat inc, uint32_t last, int reversed)
+{
+    Lfloat n = (inc > 0.0f) ? (Lfloat) last / inc : 4294967295.0f;
+    s->stageLength[stage] = (n < 4294967040.0f) ? (uint32_t) n + 1 : UINT32_MAX;
+
+    if (s->logRatio != 0.0f)
+    {
+        Lfloat logRatio = reversed ? -s->logRatio : s->logRatio;
+        s->stageCoef[stage] = expf(logRatio * inc);
+        s->stageStart[stage] = reversed ? s->scale * expf(s->logRatio * (Lfloat) last) + s->offset : s->scale + s->offset;
+    }
+    else
+    {
+        s->stageCoef[stage] = (reversed ? -s->slope : s->slope) * inc;
+        s->stageStart[stage] = reversed ? s->offset + s->slope * (Lfloat) last : s->offset;
+    }
+}
+
+// Change a stage's speed. If that stage is running it carries on from the phase it has reached at the new speed,
+// as the table versions do; A and B are its output A + B * F(phase), as given to LEAFExpSegment_start.
+static void LEAFExpSegment_setStageSpeed (LEAFExpSegment* const s, int stage, Lfloat oldInc, Lfloat inc, uint32_t last,
+                                          int reversed, Lfloat A, Lfloat B)
+{
+    uint32_t length = s->stageLength[stage];
+    LEAFExpSegment_setStage(s, stage, inc, last, reversed);
+    if (s->stage != stage) return;
+
+    Lfloat phase = (s->remaining < length) ? (Lfloat) (length - s->remaining) * oldInc : 0.0f;
+    Lfloat n = (inc > 0.0f) ? ((Lfloat) last - phase) / inc : 4294967295.0f;
+    if (n < 0.0f) s->remaining = 0;
+    else s->remaining = (n < 4294967040.0f) ? (uint32_t) n + 1 : UINT32_MAX;
+    if (s->logRatio != 0.0f)
+    {
+        s->coef = s->stageCoef[stage];
+        s->base = (1.0f - s->coef) * (A + B * s->offset);
+    }
+    else
+    {
+        s->coef = 1.0f;
+        s->base = B * s->stageCoef[stage];
+    }
+}
+
+// Start a stage whose output is A + B * F(phase)
+static void LEAFExpSegment_start (LEAFExpSegment* const s, int stage, Lfloat A, Lfloat B)
+{
+    s->stage = stage;
+    s->remaining = s->stageLength[stage];
+    s->value = A + B * s->stageStart[stage];
+    if (s->logRatio != 0.0f)
+    {
+        s->coef = s->stageCoef[stage];
+        s->base = (1.0f - s->coef) * (A + B * s->offset);
+    }
+    else
+    {
+        s->coef = 1.0f;
+        s->base = B * s->stageCoef[stage];
+    }
+}
+
+// Start a stage with no end that scales its value by coef each sample (sustain leak, or idle at 0)
+static void LEAFExpSegment_hold (LEAFExpSegment* const s, int stage, Lfloat value, Lfloat coef)
+{
+    s->stage = stage;
+    s->remaining = UINT32_MAX;
+    s->value = value;
+    s->coef = coef;
+    s->base = 0.0f;
+}
+
+// Render up to n samples of the running stage, stopping early where it ends. Returns the number written.
+static int LEAFExpSegment_render (LEAFExpSegment* const s, Lfloat* output, int n)
+{
+    if ((uint32_t) n > s->remaining) n = (int) s->remaining;
+    Lfloat y = s->value, coef = s->coef, base = s->base;
+    for (int i = 0; i < n; i++)
+    {
+        output[i] = y;
+        y = coef * y + base;
+    }
+    s->value = y;
+    s->remaining -= n;
+    return n;
+}
+
+// Move the running stage from output A + B * F(phase) to A2 + B2 * F(phase) at the same phase
+static void LEAFExpSegment_retarget (LEAFExpSegment* const s, Lfloat A, Lfloat B, Lfloat A2, Lfloat B2)
+{
+    Lfloat F;
+    if (B != 0.0f) F = (s->value - A) / B;
+    else
+    {
+        // A flat stage doesn't show its phase, so work it out from the samples already run
+        uint32_t length = s->stageLength[s->stage];
+        Lfloat k = (s->remaining < length) ? (Lfloat) (length - s->remaining) : 0.0f;
+        if (s->logRatio != 0.0f) F = s->scale * powf(s->stageCoef[s->stage], k) + s->offset;
+        else F = s->stageStart[s->stage] + s->stageCoef[s->stage] * k;
+    }
+    s->value = A2 + B2 * F;
+    if (s->logRatio != 0.0f) s->base = (1.0f - s->coef) * (A2 + B2 * s->offset);
+    else s->base = (B != 0.0f) ? s->base * (B2 / B) : B2 * s->stageCoef[s->stage];
+}
+
+// Carry a sustain level or leak change into a running decay or sustain stage, which fixed both when they started
+static void LEAFExpSegment_setSustain (LEAFExpSegment* const s, Lfloat gain, Lfloat sustain, Lfloat leak,
+                                       Lfloat newSustain, Lfloat newLeak)
+{
+    if (s->stage == env_decay)
+    {
+        LEAFExpSegment_retarget(s, gain * sustain * leak, gain * (1.0f - sustain) * leak,
+                                gain * newSustain * newLeak, gain * (1.0f - newSustain) * newLeak);
+    }
+    else if (s->stage == env_sustain)
+    {
+        s->value = (sustain > 0.0f) ? s->value * (newSustain / sustain) : gain * newSustain * newLeak;
+        s->coef = newLeak;
+    }
+}
+
 #if LEAF_INCLUDE_ADSR_TABLES
 
 /* ADSR */
@@ -268,6 +425,12 @@ void tADSR_initToPool (tADSR** const adsrenv, Lfloat attack, Lfloat decay,
     adsr->baseLeakFactor = 1.0f;
     adsr->leakFactor = 1.0f;
     adsr->invSampleRate = adsr->mempool->leaf->invSampleRate;
+
+    LEAFExpSegment_fit(&adsr->seg, adsr->exp_buff, UINT16_MAX);
+    LEAFExpSegment_setStage(&adsr->seg, env_attack, adsr->attackInc, UINT16_MAX, 1);
+    LEAFExpSegment_setStage(&adsr->seg, env_decay, adsr->decayInc, UINT16_MAX, 0);
+    LEAFExpSegment_setStage(&adsr->seg, env_release, adsr->releaseInc, UINT16_MAX, 0);
+    LEAFExpSegment_setStage(&adsr->seg, env_ramp, adsr->rampInc, UINT16_MAX, 0);
 }
 
 void tADSR_free (tADSR** const adsrenv)
@@ -290,7 +453,9 @@ void tADSR_setAttack (tADSR* const adsr, Lfloat attack)
         attackIndex = ((int32_t) (8192.0f * 8.0f)) - 1;
     }
 
+    Lfloat oldInc = adsr->attackInc;
     adsr->attackInc = adsr->inc_buff[attackIndex] * (44100.f * adsr->invSampleRate);
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_attack, oldInc, adsr->attackInc, UINT16_MAX, 1, 0.0f, adsr->gain);
 }
 
 void tADSR_setDecay (tADSR* const adsr, Lfloat decay)
@@ -307,14 +472,22 @@ void tADSR_setDecay (tADSR* const adsr, Lfloat decay)
         decayIndex = ((int32_t) (8192.0f * 8.0f)) - 1;
     }
 
+    Lfloat oldInc = adsr->decayInc;
     adsr->decayInc = adsr->inc_buff[decayIndex] * (44100.f * adsr->invSampleRate);
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_decay, oldInc, adsr->decayInc, UINT16_MAX, 0,
+                                 adsr->gain * adsr->sustain * adsr->leakFactor,
+                                 adsr->gain * (1.0f - adsr->sustain) * adsr->leakFactor);
 }
 
 void tADSR_setSustain (tADSR* const adsr, Lfloat sustain)
 {
+    Lfloat old = adsr->sustain;
+    
     if (sustain > 1.0f) adsr->sustain = 1.0f;
     else if (sustain < 0.0f) adsr->sustain = 0.0f;
     else adsr->sustain = sustain;
+    
+    LEAFExpSegment_setSustain(&adsr->seg, adsr->gain, old, adsr->leakFactor, adsr->sustain, adsr->leakFactor);
 }
 
 void tADSR_setRelease (tADSR* const adsr, Lfloat release)
@@ -331,14 +504,21 @@ void tADSR_setRelease (tADSR* const adsr, Lfloat release)
         releaseIndex = ((int32_t) (8192.0f * 8.0f)) - 1;
     }
 
+    Lfloat oldInc = adsr->releaseInc;
     adsr->releaseInc = adsr->inc_buff[releaseIndex] * (44100.f * adsr->invSampleRate);
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_release, oldInc, adsr->releaseInc, UINT16_MAX, 0,
+                                 0.0f, adsr->releasePeak);
 }
 
 // 0.999999 is slow leak, 0.9 is fast leak
 void tADSR_setLeakFactor (tADSR* const adsr, Lfloat leakFactor)
 {
+    Lfloat old = adsr->leakFactor;
+    
     adsr->baseLeakFactor = leakFactor;
     adsr->leakFactor = powf(leakFactor, 44100.0f * adsr->invSampleRate);
+    
+    LEAFExpSegment_setSustain(&adsr->seg, adsr->gain, adsr->sustain, old, adsr->sustain, adsr->leakFactor);
 }
 
 void tADSR_on (tADSR* const adsr, Lfloat velocity)
@@ -361,6 +541,9 @@ void tADSR_on (tADSR* const adsr, Lfloat velocity)
     adsr->inSustain = 0;
     adsr->inRelease = 0;
     adsr->gain = velocity;
+
+    if (adsr->inRamp) LEAFExpSegment_start(&adsr->seg, env_ramp, 0.0f, adsr->rampPeak);
+    else LEAFExpSegment_start(&adsr->seg, env_attack, 0.0f, adsr->gain);
 }
 
 void tADSR_off (tADSR* const adsr)
@@ -373,6 +556,7 @@ void tADSR_off (tADSR* const adsr)
     adsr->inRelease = 1;
 
     adsr->releasePeak = adsr->next;
+    LEAFExpSegment_start(&adsr->seg, env_release, 0.0f, adsr->releasePeak);
 }
 
 Lfloat tADSR_tick(tADSR* const adsr)
@@ -456,6 +640,67 @@ void tADSR_setSampleRate (tADSR* const adsr, Lfloat sr)
     tADSR_setLeakFactor(adsr, adsr->baseLeakFactor);
 }
 
+static Lfloat tADSR_endStage (tADSR* const adsr)
+{
+    LEAFExpSegment* s = &adsr->seg;
+    switch (s->stage)
+    {
+        case env_ramp:
+            adsr->inRamp = 0;
+            adsr->inAttack = 1;
+            adsr->next = 0.0f;
+            LEAFExpSegment_start(s, env_attack, 0.0f, adsr->gain);
+            break;
+        case env_attack:
+            adsr->inAttack = 0;
+            adsr->inDecay = 1;
+            adsr->next = adsr->gain;
+            LEAFExpSegment_start(s, env_decay, adsr->gain * adsr->sustain * adsr->leakFactor,
+                                 adsr->gain * (1.0f - adsr->sustain) * adsr->leakFactor);
+            break;
+        case env_decay:
+            adsr->inDecay = 0;
+            adsr->inSustain = 1;
+            adsr->next = adsr->gain * adsr->sustain;
+            LEAFExpSegment_hold(s, env_sustain, adsr->next * adsr->leakFactor, adsr->leakFactor);
+            break;
+        case env_release:
+            adsr->inRelease = 0;
+            adsr->next = 0.0f;
+            LEAFExpSegment_hold(s, env_idle, 0.0f, 0.0f);
+            break;
+        default: // sustain and idle only run out after 2^32 samples
+            adsr->next = s->value;
+            LEAFExpSegment_hold(s, s->stage, s->value * s->coef, s->coef);
+            break;
+    }
+    return adsr->next;
+}
+
+Lfloat tADSR_tickRecursive (tADSR* const adsr)
+{
+    LEAFExpSegment* s = &adsr->seg;
+    if (s->remaining == 0) return tADSR_endStage(adsr);
+    adsr->next = s->value;
+    s->value = s->coef * s->value + s->base;
+    s->remaining--;
+    return adsr->next;
+}
+
+void tADSR_renderBlock (tADSR* const adsr, Lfloat* output, int numSamples)
+{
+    int i = 0;
+    while (i < numSamples)
+    {
+        if (adsr->seg.remaining == 0) output[i++] = tADSR_endStage(adsr);
+        else
+        {
+            i += LEAFExpSegment_render(&adsr->seg, output + i, numSamples - i);
+            adsr->next = output[i - 1];
+        }
+    }
+}
+
 #endif // LEAF_INCLUDE_ADSR_TABLES
 
 
@@ -574,42 +819,6 @@ void tADSRS_off (tADSRS* const adsr)
     }
 }
 
-Lfloat tADSRS_tick (tADSRS* const adsr)
-{
-    switch (adsr->state) {
-        case env_idle:
-            break;
-        case env_attack:
-            adsr->output = adsr->attackBase + adsr->output * adsr->attackCoef;
-            if (adsr->output >= 1.0f) {
-                adsr->output = 1.0f;
-                adsr->state = env_decay;
-            }
-            break;
-        case env_decay:
-            adsr->output = adsr->decayBase + adsr->output * adsr->decayCoef * adsr->leakFactor;
-            if (adsr->output <= adsr->sustainLevel) {
-                adsr->output = adsr->sustainLevel;
-                adsr->state = env_sustain;
-            }
-            break;
-        case env_sustain:
-            adsr->output = adsr->output * adsr->leakFactor;
-            break;
-        case env_release:
-            adsr->output = adsr->releaseBase + adsr->output * adsr->releaseCoef;
-            if (adsr->output <= 0.0f) {
-                adsr->output = 0.0f;
-                adsr->state = env_idle;
-            }
-        default:
-            break;
-    }
-    //smooth the gain value   -- this is not ideal, a retrigger while the envelope is still going with a new gain will cause a jump, although it will be smoothed quickly. Maybe doing the math so the range is computed based on the gain rather than 0.->1. is preferable? But that's harder to get the exponential curve right without a lookup.
-    adsr->gain = (adsr->factor * adsr->targetGainSquared) + (adsr->oneMinusFactor * adsr->gain);
-    return adsr->output * adsr->gain;
-}
-
 void tADSRS_setSampleRate (tADSRS* const adsr, Lfloat sr)
 {
     adsr->sampleRate = sr;
@@ -683,6 +892,13 @@ tADSRT_initToPool(tADSRT** const adsrenv, Lfloat attack, Lfloat decay, Lfloat su
     adsr->baseLeakFactor = 1.0f;
     adsr->leakFactor = 1.0f;
     adsr->invSampleRate = leaf->invSampleRate;
+    adsr->samplesPerTick = 1;
+
+    LEAFExpSegment_fit(&adsr->seg, adsr->exp_buff, adsr->buff_sizeMinusOne);
+    LEAFExpSegment_setStage(&adsr->seg, env_attack, adsr->attackInc, adsr->buff_sizeMinusOne, 0);
+    LEAFExpSegment_setStage(&adsr->seg, env_decay, adsr->decayInc, adsr->buff_sizeMinusOne, 0);
+    LEAFExpSegment_setStage(&adsr->seg, env_release, adsr->releaseInc, adsr->buff_sizeMinusOne, 0);
+    LEAFExpSegment_setStage(&adsr->seg, env_ramp, adsr->rampInc, adsr->buff_sizeMinusOne, 0);
 }
 
 void tADSRT_free (tADSRT** const adsrenv)
@@ -702,7 +918,10 @@ void tADSRT_setAttack (tADSRT* const adsr, Lfloat attack)
         attack = 0.01f;
     }
     adsr->attack = attack;
+    Lfloat oldInc = adsr->attackInc;
     adsr->attackInc = adsr->bufferSizeDividedBySampleRateInMs / attack;
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_attack, oldInc, adsr->attackInc, adsr->buff_sizeMinusOne, 0,
+                                 adsr->gain, -adsr->gain);
 }
 
 #ifdef ITCMRAM
@@ -716,7 +935,11 @@ void tADSRT_setDecay (tADSRT* const adsr, Lfloat decay)
         decay = 0.01f;
     }
     adsr->decay = decay;
+    Lfloat oldInc = adsr->decayInc;
     adsr->decayInc = adsr->bufferSizeDividedBySampleRateInMs / decay;
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_decay, oldInc, adsr->decayInc, adsr->buff_sizeMinusOne, 0,
+                                 adsr->gain * adsr->sustain * adsr->leakFactor,
+                                 adsr->gain * (1.0f - adsr->sustain) * adsr->leakFactor);
 }
 
 #ifdef ITCMRAM
@@ -726,9 +949,13 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT
 void tADSRT_setSustain (tADSRT* const adsr, Lfloat sustain)
 #endif
 {
+    Lfloat old = adsr->sustain;
+    
     if (sustain > 1.0f) adsr->sustain = 1.0f;
     else if (sustain < 0.0f) adsr->sustain = 0.0f;
     else adsr->sustain = sustain;
+    
+    LEAFExpSegment_setSustain(&adsr->seg, adsr->gain, old, adsr->leakFactor, adsr->sustain, adsr->leakFactor);
 }
 
 #ifdef ITCMRAM
@@ -743,7 +970,10 @@ void tADSRT_setRelease (tADSRT* const adsr, Lfloat release)
         release = 0.01f;
     }
     adsr->release = release;
+    Lfloat oldInc = adsr->releaseInc;
     adsr->releaseInc = adsr->bufferSizeDividedBySampleRateInMs / release;
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_release, oldInc, adsr->releaseInc, adsr->buff_sizeMinusOne, 0,
+                                 0.0f, adsr->releasePeak);
 }
 
 // 0.999999 is slow leak, 0.9 is fast leak
@@ -754,8 +984,12 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT
 void tADSRT_setLeakFactor (tADSRT* const adsr, Lfloat leakFactor)
 #endif
 {
+    Lfloat old = adsr->leakFactor;
+    
     adsr->baseLeakFactor = leakFactor;
-    adsr->leakFactor = powf(leakFactor, 44100.0f * adsr->invSampleRate);;
+    adsr->leakFactor = powf(leakFactor, 44100.0f * adsr->invSampleRate * adsr->samplesPerTick);
+    
+    LEAFExpSegment_setSustain(&adsr->seg, adsr->gain, adsr->sustain, old, adsr->sustain, adsr->leakFactor);
 }
 
 #ifdef ITCMRAM
@@ -779,6 +1013,9 @@ void tADSRT_on (tADSRT* const adsr, Lfloat velocity)
     adsr->decayPhase = 0;
     adsr->releasePhase = 0;
     adsr->gain = velocity;
+
+    if (adsr->whichStage == env_ramp) LEAFExpSegment_start(&adsr->seg, env_ramp, 0.0f, adsr->rampPeak);
+    else LEAFExpSegment_start(&adsr->seg, env_attack, adsr->gain, -adsr->gain);
 }
 
 #ifdef ITCMRAM
@@ -793,6 +1030,7 @@ void tADSRT_off (tADSRT* const adsr)
     } else {
         adsr->whichStage = env_release;
         adsr->releasePeak = adsr->next;
+        LEAFExpSegment_start(&adsr->seg, env_release, 0.0f, adsr->releasePeak);
     }
 }
 
@@ -805,6 +1043,7 @@ void tADSRT_clear (tADSRT* const adsr)
 {
     adsr->whichStage = env_idle;
     adsr->next = 0.0f;
+    LEAFExpSegment_hold(&adsr->seg, env_idle, 0.0f, 0.0f);
 }
 
 #ifdef ITCMRAM
@@ -997,12 +1236,95 @@ void tADSRT_setSampleRate (tADSRT* const adsr, Lfloat sr)
 {
     adsr->sampleRate = sr;
     adsr->invSampleRate = 1.0f / sr;
-    adsr->bufferSizeDividedBySampleRateInMs = adsr->buff_size / (adsr->sampleRate * 0.001f);
-    adsr->attackInc = adsr->bufferSizeDividedBySampleRateInMs / adsr->attack;
-    adsr->decayInc = adsr->bufferSizeDividedBySampleRateInMs / adsr->decay;
-    adsr->releaseInc = adsr->bufferSizeDividedBySampleRateInMs / adsr->release;
+    // Phase increments are per tick, so they scale with the samples each tick covers
+    adsr->bufferSizeDividedBySampleRateInMs = adsr->buff_size / (adsr->sampleRate * 0.001f) * adsr->samplesPerTick;
+    Lfloat oldRampInc = adsr->rampInc;
     adsr->rampInc = adsr->bufferSizeDividedBySampleRateInMs / 8.0f;
-    adsr->leakFactor = powf(adsr->baseLeakFactor, 44100.0f * adsr->invSampleRate);
+    LEAFExpSegment_setStageSpeed(&adsr->seg, env_ramp, oldRampInc, adsr->rampInc, adsr->buff_sizeMinusOne, 0,
+                                 0.0f, adsr->rampPeak);
+    tADSRT_setAttack(adsr, adsr->attack);
+    tADSRT_setRelease(adsr, adsr->release);
+    // The decay's running level uses the new leak factor
+    Lfloat oldLeak = adsr->leakFactor;
+    adsr->leakFactor = powf(adsr->baseLeakFactor, 44100.0f * adsr->invSampleRate * adsr->samplesPerTick);
+    LEAFExpSegment_setSustain(&adsr->seg, adsr->gain, adsr->sustain, oldLeak, adsr->sustain, adsr->leakFactor);
+    tADSRT_setDecay(adsr, adsr->decay);
+}
+
+static Lfloat tADSRT_endStage (tADSRT* const adsr)
+{
+    LEAFExpSegment* s = &adsr->seg;
+    switch (s->stage)
+    {
+        case env_ramp:
+            adsr->whichStage = env_attack;
+            adsr->next = 0.0f;
+            LEAFExpSegment_start(s, env_attack, adsr->gain, -adsr->gain);
+            break;
+        case env_attack:
+            adsr->whichStage = env_decay;
+            adsr->next = adsr->gain;
+            LEAFExpSegment_start(s, env_decay, adsr->gain * adsr->sustain * adsr->leakFactor,
+                                 adsr->gain * (1.0f - adsr->sustain) * adsr->leakFactor);
+            break;
+        case env_decay:
+            adsr->whichStage = env_sustain;
+            adsr->next = adsr->gain * adsr->sustain;
+            adsr->sustainWithLeak = 1.0f;
+            LEAFExpSegment_hold(s, env_sustain, adsr->next * adsr->leakFactor, adsr->leakFactor);
+            break;
+        case env_release:
+            adsr->whichStage = env_idle;
+            adsr->next = 0.0f;
+            LEAFExpSegment_hold(s, env_idle, 0.0f, 0.0f);
+            break;
+        default: // sustain and idle only run out after 2^32 samples
+            adsr->next = s->value;
+            LEAFExpSegment_hold(s, s->stage, s->value * s->coef, s->coef);
+            break;
+    }
+    return adsr->next;
+}
+
+Lfloat tADSRT_tickRecursive (tADSRT* const adsr)
+{
+    LEAFExpSegment* s = &adsr->seg;
+    if (s->remaining == 0) return tADSRT_endStage(adsr);
+    adsr->next = s->value;
+    s->value = s->coef * s->value + s->base;
+    s->remaining--;
+    return adsr->next;
+}
+
+void tADSRT_renderBlock (tADSRT* const adsr, Lfloat* output, int numSamples)
+{
+    int i = 0;
+    while (i < numSamples)
+    {
+        if (adsr->seg.remaining == 0) output[i++] = tADSRT_endStage(adsr);
+        else
+        {
+            i += LEAFExpSegment_render(&adsr->seg, output + i, numSamples - i);
+            adsr->next = output[i - 1];
+        }
+    }
+}
+
+void tADSRT_setSamplesPerTick (tADSRT* const adsr, int samplesPerTick)
+{
+    if (samplesPerTick < 1) samplesPerTick = 1;
+    adsr->samplesPerTick = samplesPerTick;
+    tADSRT_setSampleRate(adsr, adsr->sampleRate);
+}
+
+void tADSRT_tickBlock (tADSRT* const adsr, Lfloat* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i += adsr->samplesPerTick)
+    {
+        int n = LEAF_clipInt(1, numSamples - i, adsr->samplesPerTick);
+        Lfloat from = adsr->next;
+        LEAF_interpolateBlock(output + i, n, from, tADSRT_tick(adsr));
+    }
 }
 
 /////-----------------
@@ -1084,6 +1406,25 @@ Lfloat tRamp_sample (tRamp* const r)
     return r->curr;
 }
 
+void tRamp_setSamplesPerTick (tRamp* const r, int samplesPerTick)
+{
+    if (samplesPerTick < 1) samplesPerTick = 1;
+    r->samples_per_tick = samplesPerTick;
+    r->minimum_time = r->inv_sr_ms * samplesPerTick;
+    tRamp_setTime(r, r->time);
+}
+
+void tRamp_tickBlock (tRamp* const r, Lfloat* output, int numSamples)
+{
+    int samplesPerTick = r->samples_per_tick > 0 ? r->samples_per_tick : 1;
+    for (int i = 0; i < numSamples; i += samplesPerTick)
+    {
+        int n = LEAF_clipInt(1, numSamples - i, samplesPerTick);
+        Lfloat from = r->curr;
+        LEAF_interpolateBlock(output + i, n, from, tRamp_tick(r));
+    }
+}
+
 void tRamp_setSampleRate (tRamp* const r, Lfloat sr)
 {
     r->sampleRate = sr;
@@ -1222,9 +1563,10 @@ void tExpSmooth_initToPool(tExpSmooth** const expsmooth, Lfloat val, Lfloat fact
     smooth->dest = val;
     if (factor < 0.0f) factor = 0.0f;
     if (factor > 1.0f) factor = 1.0f;
-    //smooth->baseFactor = factor;
+    smooth->baseFactor = factor;
     smooth->factor = factor;
     smooth->oneminusfactor = 1.0f - factor;
+    smooth->samplesPerTick = 1;
     //smooth->invSampleRate = smooth->mempool->leaf->invSampleRate;
 }
 
@@ -1240,20 +1582,16 @@ void tExpSmooth_setFactor (tExpSmooth* const smooth, Lfloat factor)
     if (factor < 0.0f)
         factor = 0.0f;
     else if (factor > 1.0f) factor = 1.0f;
-    //smooth->baseFactor = factor;
+    smooth->baseFactor = factor;
     //smooth->factor = powf(factor, 44100.f * smooth->invSampleRate);
     smooth->factor = factor;
     smooth->oneminusfactor = 1.0f - smooth->factor;
-}
-
-#ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tExpSmooth_setDest(tExpSmooth* const expsmooth, Lfloat dest)
-#else
-
-void tExpSmooth_setDest (tExpSmooth* const smooth, Lfloat dest)
-#endif
-{
-    smooth->dest = dest;
+    if (smooth->samplesPerTick > 1)
+    {
+        // samplesPerTick steps at the base factor leave (1 - factor)^samplesPerTick of the distance
+        smooth->oneminusfactor = powf(1.0f - factor, (Lfloat) smooth->samplesPerTick);
+        smooth->factor = 1.0f - smooth->oneminusfactor;
+    }
 }
 
 void tExpSmooth_setVal (tExpSmooth* const smooth, Lfloat val)
@@ -1267,20 +1605,26 @@ void tExpSmooth_setValAndDest (tExpSmooth* const smooth, Lfloat val)
     smooth->dest = val;
 }
 
-#ifdef ITCMRAM
-Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tExpSmooth_tick(tExpSmooth* const expsmooth)
-#else
-
-Lfloat tExpSmooth_tick (tExpSmooth* const smooth)
-#endif
+Lfloat tExpSmooth_sample (tExpSmooth* const smooth)
 {
-    smooth->curr = smooth->factor * smooth->dest + smooth->oneminusfactor * smooth->curr;
     return smooth->curr;
 }
 
-Lfloat tExpSmooth_sample (tExpSmooth* const smooth)
+void tExpSmooth_setSamplesPerTick (tExpSmooth* const smooth, int samplesPerTick)
 {
-    return smooth->curr;
+    if (samplesPerTick < 1) samplesPerTick = 1;
+    smooth->samplesPerTick = samplesPerTick;
+    tExpSmooth_setFactor(smooth, smooth->baseFactor);
+}
+
+void tExpSmooth_tickBlock (tExpSmooth* const smooth, Lfloat* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i += smooth->samplesPerTick)
+    {
+        int n = LEAF_clipInt(1, numSamples - i, smooth->samplesPerTick);
+        Lfloat from = smooth->curr;
+        LEAF_interpolateBlock(output + i, n, from, tExpSmooth_tick(smooth));
+    }
 }
 
 void tExpSmooth_setSampleRate (tExpSmooth* const smooth, Lfloat sr)
@@ -1350,8 +1694,7 @@ Lfloat tSlide_tickNoInput (tSlide* const s)
     } else {
         s->currentOut = s->prevOut + ((in - s->prevOut) * s->invDownSlide);
     }
-#ifdef NO_DENORMAL_CHECK
-#else
+#if !LEAF_NO_DENORMAL_CHECK
     if (s->currentOut < VSF) s->currentOut = 0.0f;
 #endif
     s->prevIn = in;
@@ -1366,8 +1709,7 @@ Lfloat tSlide_tick (tSlide* const s, Lfloat in)
     } else {
         s->currentOut = s->prevOut + ((in - s->prevOut) * s->invDownSlide);
     }
-#ifdef NO_DENORMAL_CHECK
-#else
+#if !LEAF_NO_DENORMAL_CHECK
     if (s->currentOut < VSF) s->currentOut = 0.0f;
 #endif
     s->prevIn = in;
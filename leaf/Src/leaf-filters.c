@@ -6,6 +6,8 @@
  
  ==============================================================================*/
 
+#define LEAF_FILTERS_C
+
 #if _WIN32 || _WIN64
 
 #include "..\Inc\leaf-filters.h"
@@ -70,7 +72,7 @@ void tAllpass_setGain (tAllpass* const f, Lfloat gain)
 
 Lfloat tAllpass_tick (tAllpass* const f, Lfloat input)
 {
-    Lfloat s1 = (-f->gain) * f->lastOut + input;
+    Lfloat s1 = LEAF_flushDenormal((-f->gain) * f->lastOut + input);
     Lfloat s2 = tLinearDelay_tick(f->delay, s1) + (f->gain) * input;
 
     f->lastOut = s2;
@@ -383,17 +385,6 @@ void tOnePole_setGain (tOnePole* const f, Lfloat gain)
     f->gain = gain;
 }
 
-Lfloat tOnePole_tick (tOnePole* const f, Lfloat input)
-{
-    Lfloat in = input * f->gain;
-    Lfloat out = (f->b0 * in) + (f->a1 * f->lastOut);
-
-    f->lastIn = in;
-    f->lastOut = out;
-
-    return out;
-}
-
 void tOnePole_setSampleRate (tOnePole* const f, Lfloat sr)
 {
     f->twoPiTimesInvSampleRate = (1.0f / sr) * TWO_PI;
@@ -917,21 +908,6 @@ void tBiQuad_free (tBiQuad** const ft)
     mpool_free((char *) f, f->mempool);
 }
 
-Lfloat tBiQuad_tick (tBiQuad* const f, Lfloat input)
-{
-    Lfloat in = input * f->gain;
-    Lfloat out = f->b0 * in + f->b1 * f->lastIn[0] + f->b2 * f->lastIn[1];
-    out -= f->a2 * f->lastOut[1] + f->a1 * f->lastOut[0];
-
-    f->lastIn[1] = f->lastIn[0];
-    f->lastIn[0] = in;
-
-    f->lastOut[1] = f->lastOut[0];
-    f->lastOut[0] = out;
-
-    return out;
-}
-
 void tBiQuad_setResonance (tBiQuad* const f, Lfloat freq, Lfloat radius, int normalize)
 {
     if (freq < 0.0f) freq = 0.0f;
@@ -1116,50 +1092,6 @@ void tSVF_free (tSVF** const svff)
     mpool_free((char *) svf, svf->mempool);
 }
 
-Lfloat tSVF_tick (tSVF* const svf, Lfloat v0)
-{
-    Lfloat v1, v2, v3;
-    v3 = v0 - svf->ic2eq;
-    v1 = (svf->a1 * svf->ic1eq) + (svf->a2 * v3);
-    v2 = svf->ic2eq + (svf->a2 * svf->ic1eq) + (svf->a3 * v3);
-    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
-    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
-
-    return (v0 * svf->cH) + (v1 * svf->cB) + (svf->k * v1 * svf->cBK) +
-            (v2 * svf->cL);
-}
-
-Lfloat tSVF_tickHP (tSVF* const svf, Lfloat v0)
-{
-    Lfloat v1, v2;
-    v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
-    v2 = svf->ic2eq + svf->g * v1;
-    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
-    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
-    return v0 - (svf->k * v1) - (v2);
-}
-
-Lfloat tSVF_tickBP (tSVF* const svf, Lfloat v0)
-{
-    Lfloat v1, v2;
-    v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
-    v2 = svf->ic2eq + svf->g * v1;
-    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
-    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
-
-    return v1;
-}
-
-Lfloat tSVF_tickLP (tSVF* const svf, Lfloat v0)
-{
-    Lfloat v1, v2;
-    v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
-    v2 = svf->ic2eq + svf->g * v1;
-    svf->ic1eq = (2.0f * v1) - svf->ic1eq;
-    svf->ic2eq = (2.0f * v2) - svf->ic2eq;
-    return v2;
-}
-
 void tSVF_setFreq (tSVF* const svf, Lfloat freq)
 {
     svf->cutoff = LEAF_clip(0.0f, freq, svf->sampleRate * 0.5f);
@@ -1169,26 +1101,6 @@ void tSVF_setFreq (tSVF* const svf, Lfloat freq)
     svf->a3 = svf->g * svf->a2;
 }
 
-void tSVF_setFreqFast (tSVF* const svf, Lfloat cutoff)
-{
-    svf->cutoffMIDI = cutoff;
-    cutoff *= 30.567164179104478f; //get 0-134 midi range to 0-4095
-    int32_t intVer = (int32_t) cutoff;
-    if (intVer > 4094) {
-        intVer = 4094;
-    }
-    if (intVer < 0) {
-        intVer = 0;
-    }
-    Lfloat LfloatVer = cutoff - (Lfloat) intVer;
-
-    svf->g = ((svf->table[intVer] * (1.0f - LfloatVer)) +
-            (svf->table[intVer + 1] * LfloatVer)) * svf->sampleRatio;
-    svf->a1 = 1.0f / (1.0f + svf->g * (svf->g + svf->k));
-    svf->a2 = svf->g * svf->a1;
-    svf->a3 = svf->g * svf->a2;
-}
-
 void tSVF_setQ (tSVF* const svf, Lfloat Q)
 {
     svf->Q = Q;
@@ -1618,14 +1530,6 @@ Lfloat tHighpass_getFreq (tHighpass* const f)
     return f->frequency;
 }
 
-// From JOS DC Blocker
-Lfloat tHighpass_tick (tHighpass* const f, Lfloat x)
-{
-    f->ys = x - f->xs + f->R * f->ys;
-    f->xs = x;
-    return f->ys;
-}
-
 void tHighpass_setSampleRate (tHighpass* const f, Lfloat sr)
 {
     f->twoPiTimesInvSampleRate = TWO_PI * (1.0f / sr);
@@ -1786,10 +1690,12 @@ void tMedianFilter_initToPool (tMedianFilter** const mf, int size, tMempool** co
     f->last = size - 1;
     f->pos = -1;
     f->val = (Lfloat *) mpool_alloc(sizeof(Lfloat) * size, m);
-    f->age = (int *) mpool_alloc(sizeof(int) * size, m);
+    f->heap = (int *) mpool_alloc(sizeof(int) * size, m);
+    f->heapPos = (int *) mpool_alloc(sizeof(int) * size, m);
     for (int i = 0; i < f->size; ++i) {
         f->val[i] = 0.0f;
-        f->age[i] = i;
+        f->heap[i] = i;
+        f->heapPos[i] = i;
     }
 
 }
@@ -1799,44 +1705,88 @@ void tMedianFilter_free (tMedianFilter** const mf)
     tMedianFilter *f = *mf;
 
     mpool_free((char *) f->val, f->mempool);
-    mpool_free((char *) f->age, f->mempool);
+    mpool_free((char *) f->heap, f->mempool);
+    mpool_free((char *) f->heapPos, f->mempool);
     mpool_free((char *) f, f->mempool);
 }
 
-Lfloat tMedianFilter_tick (tMedianFilter* const f, Lfloat input)
+static inline void tMedianFilter_swap (tMedianFilter* const f, int a, int b)
 {
-    for (int i = 0; i < f->size; i++) {
-        int thisAge = f->age[i];
-        if (thisAge == f->last) {
-            f->pos = i;
-        } else {
-            thisAge++;
-            f->age[i] = thisAge;
-        }
-    }
+    int t = f->heap[a];
+    f->heap[a] = f->heap[b];
+    f->heap[b] = t;
+    f->heapPos[f->heap[a]] = a;
+    f->heapPos[f->heap[b]] = b;
+}
 
-    while (f->pos != 0) {
-        Lfloat test = f->val[f->pos - 1];
-        if (input < test) {
-            f->val[f->pos] = test;
-            f->age[f->pos] = f->age[f->pos - 1];
-            f->pos -= 1;
-        } else { break; }
+// Restore the max-heap of the lower half after the value at heap[i] changed
+static void tMedianFilter_siftLower (tMedianFilter* const f, int i)
+{
+    const Lfloat* v = f->val;
+    const int n = f->middlePosition;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (v[f->heap[parent]] >= v[f->heap[i]]) break;
+        tMedianFilter_swap(f, parent, i);
+        i = parent;
+    }
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && v[f->heap[child + 1]] > v[f->heap[child]]) child++;
+        if (v[f->heap[child]] <= v[f->heap[i]]) break;
+        tMedianFilter_swap(f, i, child);
+        i = child;
     }
+}
 
-    while (f->pos != f->last) {
-        Lfloat test = f->val[f->pos + 1];
-        if (input > test) {
-            f->val[f->pos] = test;
-            f->age[f->pos] = f->age[f->pos + 1];
-            f->pos += 1;
-        } else { break; }
+// Restore the min-heap of the upper half, which starts at heap[middlePosition], after its entry i changed
+static void tMedianFilter_siftUpper (tMedianFilter* const f, int i)
+{
+    const Lfloat* v = f->val;
+    const int o = f->middlePosition;
+    const int n = f->size - o;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (v[f->heap[o + parent]] <= v[f->heap[o + i]]) break;
+        tMedianFilter_swap(f, o + parent, o + i);
+        i = parent;
     }
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && v[f->heap[o + child + 1]] < v[f->heap[o + child]]) child++;
+        if (v[f->heap[o + child]] >= v[f->heap[o + i]]) break;
+        tMedianFilter_swap(f, o + i, o + child);
+        i = child;
+    }
+}
+
+Lfloat tMedianFilter_tick (tMedianFilter* const f, Lfloat input)
+{
+    const int o = f->middlePosition;
 
+    // Overwrite the oldest sample where it sits in its heap
+    if (++f->pos > f->last) f->pos = 0;
     f->val[f->pos] = input;
-    f->age[f->pos] = 0;
+    int i = f->heapPos[f->pos];
+    if (i < o) tMedianFilter_siftLower(f, i);
+    else tMedianFilter_siftUpper(f, i - o);
+
+    // Only one value changed, so at most the two tops are out of order across the halves
+    if (o > 0 && f->val[f->heap[0]] > f->val[f->heap[o]]) {
+        tMedianFilter_swap(f, 0, o);
+        tMedianFilter_siftLower(f, 0);
+        tMedianFilter_siftUpper(f, 0);
+    }
+
+    return f->val[f->heap[o]];
+}
 
-    return f->val[f->middlePosition];
+void tMedianFilter_tickBlock (tMedianFilter* const f, const Lfloat* input, Lfloat* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++)
+        output[i] = tMedianFilter_tick(f, input[i]);
 }
 
 
@@ -1845,6 +1795,51 @@ Lfloat tMedianFilter_tick (tMedianFilter* const f, Lfloat input)
 /******************************************************************************/
 
 
+// Pending work for lazy coefficient updates
+#define VZ_DIRTY_COEFFS     1
+#define VZ_DIRTY_BANDWIDTH  2
+#define VZ_SET_R2           4   // R2 was set directly, so a pending bandwidth no longer applies
+
+static void tVZFilter_applyBandwidth (tVZFilter* const f)
+{
+    if (f->coeffMode == LEAFCoeffsImmediate)
+    {
+        f->R2 = 2.0f * tVZFilter_BandwidthToR(f, f->B);
+        return;
+    }
+    
+    // Measure against what the filter had when the bandwidth was set, like the immediate setter does
+    Lfloat fc = f->fc, g = f->g;
+    f->fc = f->pendingFc;
+    f->g = f->pendingG;
+    f->R2 = 2.0f * tVZFilter_BandwidthToR(f, f->pendingB);
+    f->fc = fc;
+    f->g = g;
+}
+
+static void tVZFilter_applyPending (tVZFilter* const f)
+{
+    if (f->dirty & VZ_DIRTY_BANDWIDTH) tVZFilter_applyBandwidth(f);
+    tVZFilter_calcCoeffs(f);
+    f->dirty = 0;
+}
+
+// Called by the setters once the new parameters are stored
+static inline void tVZFilter_paramsChanged (tVZFilter* const f, int what)
+{
+    if (what & VZ_SET_R2) f->dirty &= ~VZ_DIRTY_BANDWIDTH;
+    if ((what & VZ_DIRTY_BANDWIDTH) && f->coeffMode != LEAFCoeffsImmediate)
+    {
+        // The bandwidth depends on g, so bring g up to date before taking a snapshot of it
+        if (f->dirty) tVZFilter_applyPending(f);
+        f->pendingFc = f->fc;
+        f->pendingG = f->g;
+        f->pendingB = f->B;
+    }
+    f->dirty |= what & (VZ_DIRTY_COEFFS | VZ_DIRTY_BANDWIDTH);
+    if (f->coeffMode == LEAFCoeffsImmediate) tVZFilter_applyPending(f);
+}
+
 void tVZFilter_init(tVZFilter** const vf, VZFilterType type, Lfloat freq,
                      Lfloat bandWidth, LEAF *const leaf)
 {
@@ -1857,6 +1852,8 @@ void tVZFilter_initToPool (tVZFilter** const vf, VZFilterType type, Lfloat freq,
     tMempool *m = *mp;
     tVZFilter *f = *vf = (tVZFilter *) mpool_alloc(sizeof(tVZFilter), m);
     f->mempool = m;
+    f->coeffMode = LEAFCoeffsImmediate;
+    f->dirty = 0;
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -1896,17 +1893,19 @@ Lfloat tVZFilter_tick (tVZFilter* const f, Lfloat in)
 {
     Lfloat yL, yB, yH, v1, v2;
 
+    if (f->dirty) tVZFilter_applyPending(f);
+
     // compute highpass output via Eq. 5.1:
     //yH = (in - f->R2*f->s1 - f->g*f->s1 - f->s2) * f->h;
     yH = (in - (f->R2Plusg * f->s1) - f->s2) * f->h;
     // compute bandpass output by applying 1st integrator to highpass output:
     v1 = f->g * yH;
-    yB = tanhf(v1) + f->s1;
+    yB = LEAF_tanhf(v1) + f->s1;
     f->s1 = v1 + yB; // state update in 1st integrator
 
     // compute lowpass output by applying 2nd integrator to bandpass output:
     v2 = f->g * yB;
-    yL = tanhf(v2) + f->s2;
+    yL = LEAF_tanhf(v2) + f->s2;
     f->s2 = v2 + yL; // state update in 2nd integrator
 
     //according to the Vadim paper, we could add saturation to this model by adding a tanh in the integration stage.
@@ -1928,6 +1927,8 @@ Lfloat tVZFilter_tickEfficient (tVZFilter* const f, Lfloat in)
 {
     Lfloat yL, yB, yH, v1, v2;
 
+    if (f->dirty) tVZFilter_applyPending(f);
+
     // compute highpass output via Eq. 5.1:
     //yH = (in - f->R2*f->s1 - f->g*f->s1 - f->s2) * f->h;
     yH = (in - (f->R2Plusg * f->s1) - f->s2) * f->h;
@@ -1944,9 +1945,44 @@ Lfloat tVZFilter_tickEfficient (tVZFilter* const f, Lfloat in)
     return f->cL * yL + f->cB * yB + f->cH * yH;
 }
 
+void tVZFilter_tickBlock (tVZFilter* const f, const Lfloat* input, Lfloat* output, int numSamples)
+{
+    int i = 0;
+    
+    if (f->dirty && f->coeffMode == LEAFCoeffsInterpolated && numSamples > 1)
+    {
+        // Ramp g, R2 and the mix from where they were to the new targets, keeping h and
+        // R2Plusg consistent with them so every intermediate filter is a valid SVF
+        Lfloat g0 = f->g, R20 = f->R2, cL0 = f->cL, cB0 = f->cB, cH0 = f->cH;
+        tVZFilter_applyPending(f);
+        Lfloat g1 = f->g, R21 = f->R2, cL1 = f->cL, cB1 = f->cB, cH1 = f->cH;
+        Lfloat h1 = f->h, R2Plusg1 = f->R2Plusg;
+        Lfloat step = 1.0f / (Lfloat) numSamples;
+        
+        for (; i < numSamples - 1; i++)
+        {
+            Lfloat t = (Lfloat) (i + 1) * step;
+            f->g = g0 + (g1 - g0) * t;
+            f->R2 = R20 + (R21 - R20) * t;
+            f->cL = cL0 + (cL1 - cL0) * t;
+            f->cB = cB0 + (cB1 - cB0) * t;
+            f->cH = cH0 + (cH1 - cH0) * t;
+            f->R2Plusg = f->R2 + f->g;
+            f->h = 1.0f / (1.0f + (f->R2 * f->g) + (f->g * f->g));
+            output[i] = tVZFilter_tick(f, input[i]);
+        }
+        
+        f->g = g1; f->R2 = R21; f->cL = cL1; f->cB = cB1; f->cH = cH1;
+        f->h = h1; f->R2Plusg = R2Plusg1;
+    }
+    
+    for (; i < numSamples; i++)
+        output[i] = tVZFilter_tick(f, input[i]);
+}
+
 void tVZFilter_calcCoeffs (tVZFilter* const f)
 {
-    f->g = tanf(PI * f->fc * f->invSampleRate);  // embedded integrator gain (Fig 3.11)
+    f->g = LEAF_tanf(PI * f->fc * f->invSampleRate);  // embedded integrator gain (Fig 3.11)
 
     switch (f->type) {
         case Bypass: {
@@ -2000,8 +2036,8 @@ void tVZFilter_calcCoeffs (tVZFilter* const f)
         }
             break;
         case Bell: {
-            Lfloat fl = f->fc * powf(2.0f, (-f->B) * 0.5f); // lower bandedge frequency (in Hz)
-            Lfloat wl = tanf(PI * fl * f->invSampleRate);   // warped radian lower bandedge frequency /(2*fs)
+            Lfloat fl = f->fc * LEAF_powf(2.0f, (-f->B) * 0.5f); // lower bandedge frequency (in Hz)
+            Lfloat wl = LEAF_tanf(PI * fl * f->invSampleRate);   // warped radian lower bandedge frequency /(2*fs)
             Lfloat r = f->g / wl;
             r *= r;    // warped frequency ratio wu/wl == (wc/wl)^2 where wu is the
             // warped upper bandedge, wc the center
@@ -2085,18 +2121,21 @@ void tVZFilter_calcCoeffsEfficientBP (tVZFilter* const f)
 void tVZFilter_setBandwidth (tVZFilter* const f, Lfloat B)
 {
     f->B = LEAF_clip(0.0f, B, 100.0f);
-    f->R2 = 2.0f * tVZFilter_BandwidthToR(f, f->B);
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_BANDWIDTH | VZ_DIRTY_COEFFS);
 }
 
 void tVZFilter_setFreq (tVZFilter* const f, Lfloat freq)
 {
     f->fc = LEAF_clip(1.0f, freq, 0.5f * f->sampleRate);
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS);
 }
 
 void tVZFilter_setFreqFast (tVZFilter* const f, Lfloat cutoff)
 {
+    // This computes every coefficient itself, so it also settles anything a lazy setter left pending
+    if (f->dirty & VZ_DIRTY_BANDWIDTH) tVZFilter_applyBandwidth(f);
+    f->dirty = 0;
+    
     f->cutoffMIDI = cutoff;
     cutoff *= 30.567164179104478f;
     int32_t intVer = (int32_t) cutoff;
@@ -2239,7 +2278,7 @@ void tVZFilter_setFreqAndBandwidth (tVZFilter* const f, Lfloat freq, Lfloat bw)
 {
     f->B = LEAF_clip(0.0f, bw, 100.0f);
     f->fc = LEAF_clip(0.0f, freq, 0.5f * f->sampleRate);
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS);
 }
 
 void tVZFilter_setFreqAndBandwidthEfficientBP (tVZFilter* const f, Lfloat freq, Lfloat bw)
@@ -2247,20 +2286,21 @@ void tVZFilter_setFreqAndBandwidthEfficientBP (tVZFilter* const f, Lfloat freq,
     f->B = LEAF_clip(0.0f, bw, 100.0f);
     f->fc = LEAF_clip(0.0f, freq, 0.5f * f->sampleRate);
     tVZFilter_calcCoeffsEfficientBP(f);
+    f->dirty = 0;
 }
 
 void tVZFilter_setGain (tVZFilter* const f, Lfloat gain)
 {
     f->G = LEAF_clip(0.000001f, gain, 4000.0f);
     f->invG = 1.0f / f->G;
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS);
 }
 
 void tVZFilter_setResonance (tVZFilter* const f, Lfloat res)
 {
     f->Q = LEAF_clip(0.01f, res, 100.0f);
     f->R2 = 1.0f / f->Q;
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS | VZ_SET_R2);
 }
 
 void tVZFilter_setFrequencyAndResonance (tVZFilter* const f, Lfloat freq, Lfloat res)
@@ -2268,7 +2308,7 @@ void tVZFilter_setFrequencyAndResonance (tVZFilter* const f, Lfloat freq, Lfloat
     f->fc = LEAF_clip(0.1f, freq, 0.4f * f->sampleRate);
     f->Q = LEAF_clip(0.01f, res, 100.0f);
     f->R2 = 1.0f / f->Q;
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS | VZ_SET_R2);
 }
 
 void tVZFilter_setFrequencyAndResonanceAndGain (tVZFilter* const f, Lfloat freq,
@@ -2279,7 +2319,7 @@ void tVZFilter_setFrequencyAndResonanceAndGain (tVZFilter* const f, Lfloat freq,
     f->R2 = 1.0f / f->Q;
     f->G = LEAF_clip(0.000001f, gain, 4000.0f);
     f->invG = 1.0f / f->G;
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS | VZ_SET_R2);
 }
 
 void tVZFilter_setFastFrequencyAndResonanceAndGain (tVZFilter* const f, Lfloat freq,
@@ -2290,6 +2330,7 @@ void tVZFilter_setFastFrequencyAndResonanceAndGain (tVZFilter* const f, Lfloat f
     f->G = LEAF_clip(0.000001f, gain, 4000.0f);
     f->invG = 1.0f / f->G;
     f->cutoffMIDI = freq;
+    f->dirty &= ~VZ_DIRTY_BANDWIDTH;
     tVZFilter_setFreqFast(f, freq);
 }
 
@@ -2301,7 +2342,7 @@ void tVZFilter_setFrequencyAndBandwidthAndGain (tVZFilter* const f, Lfloat freq,
     f->B = LEAF_clip(0.01, BW, 100.f);
     f->G = LEAF_clip(0.000001f, gain, 4000.0f);
     f->invG = 1.0f / f->G;
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS);
 }
 
 
@@ -2312,13 +2353,13 @@ void tVZFilter_setFrequencyAndResonanceAndMorph (tVZFilter* const f, Lfloat freq
     f->Q = LEAF_clip(0.01f, res, 100.0f);
     f->R2 = 1.0f / f->Q;
     f->m = LEAF_clip(0.0f, morph, 1.0f);
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS | VZ_SET_R2);
 }
 
 void tVZFilter_setMorph (tVZFilter* const f, Lfloat morph)
 {
     f->m = LEAF_clip(0.0f, morph, 1.0f);
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS);
 }
 
 void tVZFilter_setMorphOnly (tVZFilter* const f, Lfloat morph)
@@ -2330,13 +2371,19 @@ void tVZFilter_setMorphOnly (tVZFilter* const f, Lfloat morph)
 void tVZFilter_setType (tVZFilter* const f, VZFilterType type)
 {
     f->type = type;
-    tVZFilter_calcCoeffs(f);
+    tVZFilter_paramsChanged(f, VZ_DIRTY_COEFFS);
+}
+
+void tVZFilter_setCoeffMode (tVZFilter* const f, LEAFCoeffMode mode)
+{
+    f->coeffMode = mode;
+    if (mode == LEAFCoeffsImmediate && f->dirty) tVZFilter_applyPending(f);
 }
 
 Lfloat tVZFilter_BandwidthToR (tVZFilter* const f, Lfloat B)
 {
-    Lfloat fl = f->fc * powf(2.0f, -B * 0.5f); // lower bandedge frequency (in Hz)
-    Lfloat gl = tanf(PI * fl * f->invSampleRate);   // warped radian lower bandedge frequency /(2*fs)
+    Lfloat fl = f->fc * LEAF_powf(2.0f, -B * 0.5f); // lower bandedge frequency (in Hz)
+    Lfloat gl = LEAF_tanf(PI * fl * f->invSampleRate);   // warped radian lower bandedge frequency /(2*fs)
     Lfloat r = gl / f->g;            // ratio between warped lower bandedge- and center-frequencies
     // unwarped: r = pow(2, -B/2) -> approximation for low
     // center-frequencies
@@ -0,0 +1,699 @@
+/*==============================================================================
+
+    leaf-fixed.c
+    Created: 19 Oct 2026 11:02:51am
+
+==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-fixed.h"
+#include "..\leaf.h"
+
+#else
+
+#include "../Inc/leaf-fixed.h"
+#include "../leaf.h"
+
+#endif
+
+// Largest increment we accept, half a cycle per sample (Nyquist)
+#define MAX_PHASE_INC 0x7fffffffu
+
+static uint32_t freqToPhaseInc(Lfloat freq, Lfloat invSampleRateTimesTwoTo32)
+{
+    Lfloat inc = fabsf(freq) * invSampleRateTimesTwoTo32;
+    if (inc >= (Lfloat) MAX_PHASE_INC) return MAX_PHASE_INC;
+    return (uint32_t) inc;
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Phasor ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+void    tPhasorQ31_init(tPhasorQ31** const ph, LEAF* const leaf)
+{
+    tPhasorQ31_initToPool(ph, &leaf->mempool);
+}
+
+void    tPhasorQ31_initToPool(tPhasorQ31** const ph, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tPhasorQ31* p = *ph = (tPhasorQ31*) mpool_alloc(sizeof(tPhasorQ31), m);
+    p->mempool = m;
+    LEAF* leaf = p->mempool->leaf;
+
+    p->phase = 0;
+    p->inc = 0;
+    p->freq = 0.0f;
+    p->invSampleRateTimesTwoTo32 = leaf->invSampleRate * TWO_TO_32;
+}
+
+void    tPhasorQ31_free(tPhasorQ31** const ph)
+{
+    tPhasorQ31* p = *ph;
+
+    mpool_free((char*)p, p->mempool);
+}
+
+Lq31    tPhasorQ31_tick(tPhasorQ31* const p)
+{
+    p->phase += p->inc;
+    return (Lq31) (p->phase >> 1);
+}
+
+void    tPhasorQ31_setFreq(tPhasorQ31* const p, Lfloat freq)
+{
+    p->freq = freq;
+    p->inc = freqToPhaseInc(freq, p->invSampleRateTimesTwoTo32);
+}
+
+void    tPhasorQ31_setPhaseInc(tPhasorQ31* const p, uint32_t inc)
+{
+    p->inc = inc;
+}
+
+void    tPhasorQ31_setSampleRate(tPhasorQ31* const p, Lfloat sr)
+{
+    p->invSampleRateTimesTwoTo32 = (1.0f / sr) * TWO_TO_32;
+    tPhasorQ31_setFreq(p, p->freq);
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Cycle ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+// First quarter of a 2048 point sine in Q15, with the peak as the last entry
+static const Lq15 __leaf_table_sinewave_q15_quarter[513] =
+{
+    0, 101, 201, 302, 402, 503, 603, 704, 804, 905, 1005, 1106, 1206, 1307, 1407, 1507,
+    1608, 1708, 1809, 1909, 2009, 2110, 2210, 2310, 2411, 2511, 2611, 2711, 2811, 2912, 3012, 3112,
+    3212, 3312, 3412, 3512, 3612, 3712, 3812, 3911, 4011, 4111, 4211, 4310, 4410, 4510, 4609, 4709,
+    4808, 4907, 5007, 5106, 5205, 5305, 5404, 5503, 5602, 5701, 5800, 5899, 5998, 6097, 6195, 6294,
+    6393, 6491, 6590, 6688, 6787, 6885, 6983, 7081, 7180, 7278, 7376, 7473, 7571, 7669, 7767, 7864,
+    7962, 8059, 8157, 8254, 8351, 8449, 8546, 8643, 8740, 8836, 8933, 9030, 9127, 9223, 9319, 9416,
+    9512, 9608, 9704, 9800, 9896, 9992, 10088, 10183, 10279, 10374, 10469, 10565, 10660, 10755, 10850, 10945,
+    11039, 11134, 11228, 11323, 11417, 11511, 11605, 11699, 11793, 11887, 11980, 12074, 12167, 12261, 12354, 12447,
+    12540, 12633, 12725, 12818, 12910, 13003, 13095, 13187, 13279, 13371, 13463, 13554, 13646, 13737, 13828, 13919,
+    14010, 14101, 14192, 14282, 14373, 14463, 14553, 14643, 14733, 14823, 14912, 15002, 15091, 15180, 15269, 15358,
+    15447, 15535, 15624, 15712, 15800, 15888, 15976, 16064, 16151, 16239, 16326, 16413, 16500, 16587, 16673, 16760,
+    16846, 16932, 17018, 17104, 17190, 17275, 17361, 17446, 17531, 17616, 17700, 17785, 17869, 17953, 18037, 18121,
+    18205, 18288, 18372, 18455, 18538, 18621, 18703, 18786, 18868, 18950, 19032, 19114, 19195, 19277, 19358, 19439,
+    19520, 19601, 19681, 19761, 19841, 19921, 20001, 20081, 20160, 20239, 20318, 20397, 20475, 20554, 20632, 20710,
+    20788, 20865, 20943, 21020, 21097, 21174, 21251, 21327, 21403, 21479, 21555, 21631, 21706, 21781, 21856, 21931,
+    22006, 22080, 22154, 22228, 22302, 22375, 22449, 22522, 22595, 22668, 22740, 22812, 22884, 22956, 23028, 23099,
+    23170, 23241, 23312, 23383, 23453, 23523, 23593, 23663, 23732, 23801, 23870, 23939, 24008, 24076, 24144, 24212,
+    24279, 24347, 24414, 24481, 24548, 24614, 24680, 24746, 24812, 24878, 24943, 25008, 25073, 25138, 25202, 25266,
+    25330, 25394, 25457, 25520, 25583, 25646, 25708, 25771, 25833, 25894, 25956, 26017, 26078, 26139, 26199, 26259,
+    26320, 26379, 26439, 26498, 26557, 26616, 26674, 26733, 26791, 26848, 26906, 26963, 27020, 27077, 27133, 27190,
+    27246, 27301, 27357, 27412, 27467, 27522, 27576, 27630, 27684, 27738, 27791, 27844, 27897, 27950, 28002, 28054,
+    28106, 28158, 28209, 28260, 28311, 28361, 28411, 28461, 28511, 28560, 28610, 28658, 28707, 28755, 28803, 28851,
+    28899, 28946, 28993, 29040, 29086, 29132, 29178, 29224, 29269, 29314, 29359, 29404, 29448, 29492, 29535, 29579,
+    29622, 29665, 29707, 29750, 29792, 29833, 29875, 29916, 29957, 29997, 30038, 30078, 30118, 30157, 30196, 30235,
+    30274, 30312, 30350, 30388, 30425, 30462, 30499, 30536, 30572, 30608, 30644, 30680, 30715, 30750, 30784, 30819,
+    30853, 30886, 30920, 30953, 30986, 31018, 31050, 31082, 31114, 31146, 31177, 31207, 31238, 31268, 31298, 31328,
+    31357, 31386, 31415, 31443, 31471, 31499, 31527, 31554, 31581, 31608, 31634, 31660, 31686, 31711, 31737, 31761,
+    31786, 31810, 31834, 31858, 31881, 31904, 31927, 31950, 31972, 31994, 32015, 32037, 32058, 32078, 32099, 32119,
+    32138, 32158, 32177, 32196, 32214, 32233, 32251, 32268, 32286, 32303, 32319, 32336, 32352, 32368, 32383, 32398,
+    32413, 32428, 32442, 32456, 32470, 32483, 32496, 32509, 32522, 32534, 32546, 32557, 32568, 32579, 32590, 32600,
+    32610, 32620, 32629, 32638, 32647, 32656, 32664, 32672, 32679, 32686, 32693, 32700, 32706, 32712, 32718, 32723,
+    32729, 32733, 32738, 32742, 32746, 32749, 32753, 32756, 32758, 32760, 32762, 32764, 32766, 32767, 32767, 32767,
+    32767
+};
+
+void    tCycleQ31_init(tCycleQ31** const cy, LEAF* const leaf)
+{
+    tCycleQ31_initToPool(cy, &leaf->mempool);
+}
+
+void    tCycleQ31_initToPool(tCycleQ31** const cy, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tCycleQ31* c = *cy = (tCycleQ31*) mpool_alloc(sizeof(tCycleQ31), m);
+    c->mempool = m;
+    LEAF* leaf = c->mempool->leaf;
+
+    c->phase = 0;
+    c->inc = 0;
+    c->freq = 0.0f;
+    c->invSampleRateTimesTwoTo32 = leaf->invSampleRate * TWO_TO_32;
+}
+
+void    tCycleQ31_free(tCycleQ31** const cy)
+{
+    tCycleQ31* c = *cy;
+
+    mpool_free((char*)c, c->mempool);
+}
+
+Lq31    tCycleQ31_tick(tCycleQ31* const c)
+{
+    const Lq15* table = __leaf_table_sinewave_q15_quarter;
+    int32_t s0, s1;
+
+    c->phase += c->inc;
+
+    // Same 11 bit index as tCycle, folded into the quarter table by the top two bits
+    uint32_t quadrant = c->phase >> 30;
+    uint32_t idx = (c->phase >> 21) & 511u;
+    int32_t frac = (int32_t) ((c->phase >> 5) & 0xffffu);
+
+    if (quadrant & 1u)
+    {
+        s0 = table[512 - idx];
+        s1 = table[511 - idx];
+    }
+    else
+    {
+        s0 = table[idx];
+        s1 = table[idx + 1];
+    }
+
+    Lq31 out = (s0 * 65536) + (s1 - s0) * frac;
+    return (quadrant & 2u) ? -out : out;
+}
+
+void    tCycleQ31_setFreq(tCycleQ31* const c, Lfloat freq)
+{
+    c->freq = freq;
+    c->inc = freqToPhaseInc(freq, c->invSampleRateTimesTwoTo32);
+}
+
+void    tCycleQ31_setPhaseInc(tCycleQ31* const c, uint32_t inc)
+{
+    c->inc = inc;
+}
+
+void    tCycleQ31_setPhase(tCycleQ31* const c, Lq31 phase)
+{
+    c->phase = (uint32_t) phase << 1;
+}
+
+void    tCycleQ31_setSampleRate(tCycleQ31* const c, Lfloat sr)
+{
+    c->invSampleRateTimesTwoTo32 = (1.0f / sr) * TWO_TO_32;
+    tCycleQ31_setFreq(c, c->freq);
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ PolyBLEP Saw ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+void    tPBSawQ31_init(tPBSawQ31** const osc, LEAF* const leaf)
+{
+    tPBSawQ31_initToPool(osc, &leaf->mempool);
+}
+
+void    tPBSawQ31_initToPool(tPBSawQ31** const osc, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tPBSawQ31* c = *osc = (tPBSawQ31*) mpool_alloc(sizeof(tPBSawQ31), m);
+    c->mempool = m;
+    LEAF* leaf = c->mempool->leaf;
+
+    c->phase = 0;
+    c->inc = 0;
+    c->freq = 0.0f;
+    c->invSampleRateTimesTwoTo32 = leaf->invSampleRate * TWO_TO_32;
+}
+
+void    tPBSawQ31_free(tPBSawQ31** const osc)
+{
+    tPBSawQ31* c = *osc;
+
+    mpool_free((char*)c, c->mempool);
+}
+
+Lq31    tPBSawQ31_tick(tPBSawQ31* const c)
+{
+    uint32_t phase = c->phase;
+    uint32_t inc = c->inc;
+    int64_t saw = (int64_t) phase - 0x80000000LL;
+    int64_t blep = 0;
+
+    // Same residual as LEAF_poly_blep, which reduces to -(1 - t/dt)^2 just after the
+    // wrap and (1 - (1 - t)/dt)^2 just before it. The divide only runs on those two samples.
+    if (phase < inc)
+    {
+        int64_t w = 0x80000000LL - (int64_t) ((((uint64_t) phase) << 31) / inc);
+        blep = -((w * w) >> 31);
+    }
+    else if (phase > 0xffffffffu - inc)
+    {
+        uint64_t r = 0x100000000ULL - phase;
+        int64_t u = 0x80000000LL - (int64_t) ((r << 31) / inc);
+        blep = (u * u) >> 31;
+    }
+
+    c->phase += inc;
+    return LEAF_q31Saturate(blep - saw);
+}
+
+void    tPBSawQ31_setFreq(tPBSawQ31* const c, Lfloat freq)
+{
+    c->freq = freq;
+    c->inc = freqToPhaseInc(freq, c->invSampleRateTimesTwoTo32);
+}
+
+void    tPBSawQ31_setPhaseInc(tPBSawQ31* const c, uint32_t inc)
+{
+    c->inc = inc > MAX_PHASE_INC ? MAX_PHASE_INC : inc;
+}
+
+void    tPBSawQ31_setSampleRate(tPBSawQ31* const c, Lfloat sr)
+{
+    c->invSampleRateTimesTwoTo32 = (1.0f / sr) * TWO_TO_32;
+    tPBSawQ31_setFreq(c, c->freq);
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ OnePole ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+void    tOnePoleQ31_init(tOnePoleQ31** const ft, Lfloat freq, LEAF* const leaf)
+{
+    tOnePoleQ31_initToPool(ft, freq, &leaf->mempool);
+}
+
+void    tOnePoleQ31_initToPool(tOnePoleQ31** const ft, Lfloat freq, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tOnePoleQ31* f = *ft = (tOnePoleQ31*) mpool_alloc(sizeof(tOnePoleQ31), m);
+    f->mempool = m;
+    LEAF* leaf = f->mempool->leaf;
+
+    f->lastOut = 0;
+    f->twoPiTimesInvSampleRate = leaf->twoPiTimesInvSampleRate;
+
+    tOnePoleQ31_setFreq(*ft, freq);
+}
+
+void    tOnePoleQ31_free(tOnePoleQ31** const ft)
+{
+    tOnePoleQ31* f = *ft;
+
+    mpool_free((char*)f, f->mempool);
+}
+
+Lq31    tOnePoleQ31_tick(tOnePoleQ31* const f, Lq31 input)
+{
+    int64_t acc = (int64_t) f->b0 * input + (int64_t) f->a1 * f->lastOut;
+    f->lastOut = LEAF_q31Saturate((acc + (1 << 30)) >> 31);
+    return f->lastOut;
+}
+
+void    tOnePoleQ31_setFreq(tOnePoleQ31* const f, Lfloat freq)
+{
+    f->freq = freq;
+    Lfloat b0 = LEAF_clip(0.0f, freq * f->twoPiTimesInvSampleRate, 1.0f);
+    f->b0 = LEAF_floatToQ31(b0);
+    f->a1 = LEAF_floatToQ31(1.0f - b0);
+}
+
+void    tOnePoleQ31_setCoefficients(tOnePoleQ31* const f, Lq31 b0, Lq31 a1)
+{
+    f->b0 = b0;
+    f->a1 = a1;
+}
+
+void    tOnePoleQ31_setSampleRate(tOnePoleQ31* const f, Lfloat sr)
+{
+    f->twoPiTimesInvSampleRate = TWO_PI / sr;
+    tOnePoleQ31_setFreq(f, f->freq);
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ SVF ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+#define SVF_MIX_ONE (1 << 27)
+
+static void svfQ31UpdateCoefficients(tSVFQ31* const svf)
+{
+    Lfloat k = 1.0f / svf->Q;
+    Lfloat g = tanf(PI * svf->cutoff * svf->invSampleRate);
+    Lfloat a1 = 1.0f / (1.0f + g * (g + k));
+    Lfloat a2 = g * a1;
+
+    svf->a1 = LEAF_floatToQ31(a1);
+    svf->a2 = LEAF_floatToQ31(a2);
+    svf->a3 = LEAF_floatToQ31(g * a2);
+
+    // Fold the k * v1 term of tSVF's output into the bandpass weight
+    Lfloat cH = 0.0f, cB = 0.0f, cL = 1.0f;
+    if (svf->type == SVFTypeBandpass)       { cL = 0.0f; cB = 1.0f; }
+    else if (svf->type == SVFTypeHighpass)  { cH = 1.0f; cB = -k; cL = -1.0f; }
+    else if (svf->type == SVFTypeNotch)     { cH = 1.0f; cB = -k; cL = 0.0f; }
+    else if (svf->type == SVFTypePeak)      { cH = 1.0f; cB = -k; cL = -2.0f; }
+
+    svf->cH = (int32_t) (cH * SVF_MIX_ONE);
+    svf->cB = (int32_t) (cB * SVF_MIX_ONE);
+    svf->cL = (int32_t) (cL * SVF_MIX_ONE);
+}
+
+void    tSVFQ31_init(tSVFQ31** const svff, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf)
+{
+    tSVFQ31_initToPool(svff, type, freq, Q, &leaf->mempool);
+}
+
+void    tSVFQ31_initToPool(tSVFQ31** const svff, SVFType type, Lfloat freq, Lfloat Q, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tSVFQ31* svf = *svff = (tSVFQ31*) mpool_alloc(sizeof(tSVFQ31), m);
+    svf->mempool = m;
+    LEAF* leaf = svf->mempool->leaf;
+
+    svf->sampleRate = leaf->sampleRate;
+    svf->invSampleRate = leaf->invSampleRate;
+    svf->type = type;
+    svf->ic1eq = 0;
+    svf->ic2eq = 0;
+
+    tSVFQ31_setFreqAndQ(*svff, freq, Q);
+}
+
+void    tSVFQ31_free(tSVFQ31** const svff)
+{
+    tSVFQ31* svf = *svff;
+
+    mpool_free((char*)svf, svf->mempool);
+}
+
+Lq31    tSVFQ31_tick(tSVFQ31* const svf, Lq31 v0)
+{
+    const int64_t half = 1 << 30;
+    Lq31 v3 = LEAF_q31Sub(v0, svf->ic2eq);
+    Lq31 v1 = LEAF_q31Saturate(((int64_t) svf->a1 * svf->ic1eq + (int64_t) svf->a2 * v3 + half) >> 31);
+    Lq31 v2 = LEAF_q31Saturate((int64_t) svf->ic2eq + (((int64_t) svf->a2 * svf->ic1eq + (int64_t) svf->a3 * v3 + half) >> 31));
+    svf->ic1eq = LEAF_q31Saturate(2 * (int64_t) v1 - svf->ic1eq);
+    svf->ic2eq = LEAF_q31Saturate(2 * (int64_t) v2 - svf->ic2eq);
+
+    int64_t out = (int64_t) svf->cH * v0 + (int64_t) svf->cB * v1 + (int64_t) svf->cL * v2;
+    return LEAF_q31Saturate((out + (SVF_MIX_ONE >> 1)) >> 27);
+}
+
+void    tSVFQ31_setFreq(tSVFQ31* const svf, Lfloat freq)
+{
+    svf->cutoff = LEAF_clip(0.0f, freq, svf->sampleRate * 0.49f);
+    svfQ31UpdateCoefficients(svf);
+}
+
+void    tSVFQ31_setQ(tSVFQ31* const svf, Lfloat Q)
+{
+    svf->Q = Q < 0.5f ? 0.5f : Q;
+    svfQ31UpdateCoefficients(svf);
+}
+
+void    tSVFQ31_setFreqAndQ(tSVFQ31* const svf, Lfloat freq, Lfloat Q)
+{
+    svf->cutoff = LEAF_clip(0.0f, freq, svf->sampleRate * 0.49f);
+    svf->Q = Q < 0.5f ? 0.5f : Q;
+    svfQ31UpdateCoefficients(svf);
+}
+
+void    tSVFQ31_setFilterType(tSVFQ31* const svf, SVFType type)
+{
+    svf->type = type;
+    svfQ31UpdateCoefficients(svf);
+}
+
+void    tSVFQ31_setSampleRate(tSVFQ31* const svf, Lfloat sr)
+{
+    svf->sampleRate = sr;
+    svf->invSampleRate = 1.0f / sr;
+    tSVFQ31_setFreq(svf, svf->cutoff);
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ BiQuad ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+static int32_t floatToQ2_30(Lfloat x)
+{
+    return LEAF_floatToQ31(x * 0.5f);
+}
+
+void    tBiQuadQ31_init(tBiQuadQ31** const ft, LEAF* const leaf)
+{
+    tBiQuadQ31_initToPool(ft, &leaf->mempool);
+}
+
+void    tBiQuadQ31_initToPool(tBiQuadQ31** const ft, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tBiQuadQ31* f = *ft = (tBiQuadQ31*) mpool_alloc(sizeof(tBiQuadQ31), m);
+    f->mempool = m;
+
+    f->b0 = f->b1 = f->b2 = 0;
+    f->a1 = f->a2 = 0;
+    tBiQuadQ31_clear(f);
+}
+
+void    tBiQuadQ31_free(tBiQuadQ31** const ft)
+{
+    tBiQuadQ31* f = *ft;
+
+    mpool_free((char*)f, f->mempool);
+}
+
+Lq31    tBiQuadQ31_tick(tBiQuadQ31* const f, Lq31 input)
+{
+    // Each Q2.30 * Q31 product is dropped to Q59 so five of them can't overflow the accumulator
+    int64_t acc = (((int64_t) f->b0 * input) >> 2)
+                + (((int64_t) f->b1 * f->lastIn[0]) >> 2)
+                + (((int64_t) f->b2 * f->lastIn[1]) >> 2)
+                - (((int64_t) f->a1 * f->lastOut[0]) >> 2)
+                - (((int64_t) f->a2 * f->lastOut[1]) >> 2);
+    Lq31 out = LEAF_q31Saturate((acc + (1 << 27)) >> 28);
+
+    f->lastIn[1] = f->lastIn[0];
+    f->lastIn[0] = input;
+    f->lastOut[1] = f->lastOut[0];
+    f->lastOut[0] = out;
+
+    return out;
+}
+
+void    tBiQuadQ31_setCoefficients(tBiQuadQ31* const f, Lfloat b0, Lfloat b1, Lfloat b2, Lfloat a1, Lfloat a2)
+{
+    f->b0 = floatToQ2_30(b0);
+    f->b1 = floatToQ2_30(b1);
+    f->b2 = floatToQ2_30(b2);
+    f->a1 = floatToQ2_30(a1);
+    f->a2 = floatToQ2_30(a2);
+}
+
+void    tBiQuadQ31_clear(tBiQuadQ31* const f)
+{
+    f->lastIn[0] = f->lastIn[1] = 0;
+    f->lastOut[0] = f->lastOut[1] = 0;
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Delay ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+void    tDelayQ31_init(tDelayQ31** const dl, uint32_t delay, uint32_t maxDelay, LEAF* const leaf)
+{
+    tDelayQ31_initToPool(dl, delay, maxDelay, &leaf->mempool);
+}
+
+void    tDelayQ31_initToPool(tDelayQ31** const dl, uint32_t delay, uint32_t maxDelay, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tDelayQ31* d = *dl = (tDelayQ31*) mpool_alloc(sizeof(tDelayQ31), m);
+    d->mempool = m;
+
+    if (maxDelay < 1) maxDelay = 1;
+    d->maxDelay = maxDelay;
+    d->buff = (Lq31*) mpool_calloc(sizeof(Lq31) * maxDelay, m);
+    d->inPoint = 0;
+    d->outPoint = 0;
+
+    tDelayQ31_setDelay(*dl, delay);
+}
+
+void    tDelayQ31_free(tDelayQ31** const dl)
+{
+    tDelayQ31* d = *dl;
+
+    mpool_free((char*)d->buff, d->mempool);
+    mpool_free((char*)d, d->mempool);
+}
+
+Lq31    tDelayQ31_tick(tDelayQ31* const d, Lq31 input)
+{
+    d->buff[d->inPoint] = input;
+    if (++(d->inPoint) == d->maxDelay) d->inPoint = 0;
+
+    Lq31 out = d->buff[d->outPoint];
+    if (++(d->outPoint) == d->maxDelay) d->outPoint = 0;
+
+    return out;
+}
+
+void    tDelayQ31_setDelay(tDelayQ31* const d, uint32_t delay)
+{
+    // A full maxDelay would land the read on the sample just written
+    if (delay > d->maxDelay - 1) delay = d->maxDelay - 1;
+    d->delay = delay;
+
+    // read chases write
+    if (d->inPoint >= delay)    d->outPoint = d->inPoint - delay;
+    else                        d->outPoint = d->maxDelay + d->inPoint - delay;
+}
+
+uint32_t tDelayQ31_getDelay(tDelayQ31* const d)
+{
+    return d->delay;
+}
+
+Lq31    tDelayQ31_tapOut(tDelayQ31* const d, uint32_t tapDelay)
+{
+    int32_t tap = (int32_t) d->inPoint - (int32_t) tapDelay - 1;
+
+    while (tap < 0) tap += d->maxDelay;
+
+    return d->buff[tap];
+}
+
+void    tDelayQ31_clear(tDelayQ31* const d)
+{
+    for (uint32_t i = 0; i < d->maxDelay; i++) d->buff[i] = 0;
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ADSRS ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+#define ADSRS_ONE           (1 << 30)       // 1.0 in the envelope's Q1.30
+#define ADSRS_RATIO_A       0.3f
+#define ADSRS_RATIO_DR      0.0001f
+#define ADSRS_GAIN_FACTOR   ((Lq31) 21474836)  // 0.01 in Q31, the velocity smoothing of tADSRS
+
+static Lfloat adsrsCoef(Lfloat rate, Lfloat targetRatio)
+{
+    return (rate <= 0.0f) ? 0.0f : expf(-logf((1.0f + targetRatio) / targetRatio) / rate);
+}
+
+static Lq31 floatToQ1_30(Lfloat x)
+{
+    return LEAF_floatToQ31(x * 0.5f);
+}
+
+void    tADSRSQ31_init(tADSRSQ31** const adsrenv, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, LEAF* const leaf)
+{
+    tADSRSQ31_initToPool(adsrenv, attack, decay, sustain, release, &leaf->mempool);
+}
+
+void    tADSRSQ31_initToPool(tADSRSQ31** const adsrenv, Lfloat attack, Lfloat decay, Lfloat sustain, Lfloat release, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tADSRSQ31* adsr = *adsrenv = (tADSRSQ31*) mpool_alloc(sizeof(tADSRSQ31), m);
+    adsr->mempool = m;
+    LEAF* leaf = adsr->mempool->leaf;
+
+    adsr->sampleRate = leaf->sampleRate;
+    adsr->sampleRateInMs = adsr->sampleRate * 0.001f;
+
+    adsr->state = env_idle;
+    adsr->output = 0;
+    adsr->gain = LEAF_Q31_MAX;
+    adsr->targetGainSquared = LEAF_Q31_MAX;
+
+    adsr->sustain = sustain;
+    tADSRSQ31_setAttack(adsr, attack);
+    tADSRSQ31_setDecay(adsr, decay);
+    tADSRSQ31_setRelease(adsr, release);
+    tADSRSQ31_setLeakFactor(adsr, 1.0f);
+}
+
+void    tADSRSQ31_free(tADSRSQ31** const adsrenv)
+{
+    tADSRSQ31* adsr = *adsrenv;
+
+    mpool_free((char*)adsr, adsr->mempool);
+}
+
+Lq31    tADSRSQ31_tick(tADSRSQ31* const adsr)
+{
+    switch (adsr->state) {
+        case env_idle:
+            break;
+        case env_attack:
+            adsr->output = adsr->attackBase + LEAF_q31Mul(adsr->output, adsr->attackCoef);
+            if (adsr->output >= ADSRS_ONE) {
+                adsr->output = ADSRS_ONE;
+                adsr->state = env_decay;
+            }
+            break;
+        case env_decay:
+            adsr->output = adsr->decayBase + LEAF_q31Mul(LEAF_q31Mul(adsr->output, adsr->decayCoef), adsr->leakFactor);
+            if (adsr->output <= adsr->sustainLevel) {
+                adsr->output = adsr->sustainLevel;
+                adsr->state = env_sustain;
+            }
+            break;
+        case env_sustain:
+            adsr->output = LEAF_q31Mul(adsr->output, adsr->leakFactor);
+            break;
+        case env_release:
+            adsr->output = adsr->releaseBase + LEAF_q31Mul(adsr->output, adsr->releaseCoef);
+            if (adsr->output <= 0) {
+                adsr->output = 0;
+                adsr->state = env_idle;
+            }
+            break;
+        default:
+            break;
+    }
+    adsr->gain += LEAF_q31Mul(ADSRS_GAIN_FACTOR, adsr->targetGainSquared - adsr->gain);
+
+    // Q1.30 times Q31 is Q1.30; the shift back to Q31 saturates the one-sample overshoot at full scale
+    return LEAF_q31Saturate((int64_t) LEAF_q31Mul(adsr->output, adsr->gain) * 2);
+}
+
+void    tADSRSQ31_setAttack(tADSRSQ31* const adsr, Lfloat attack)
+{
+    adsr->attack = attack;
+    Lfloat coef = adsrsCoef(attack * adsr->sampleRateInMs, ADSRS_RATIO_A);
+    adsr->attackCoef = LEAF_floatToQ31(coef);
+    adsr->attackBase = floatToQ1_30((1.0f + ADSRS_RATIO_A) * (1.0f - coef));
+}
+
+void    tADSRSQ31_setDecay(tADSRSQ31* const adsr, Lfloat decay)
+{
+    adsr->decay = decay;
+    Lfloat coef = adsrsCoef(decay * adsr->sampleRateInMs, ADSRS_RATIO_DR);
+    adsr->decayCoef = LEAF_floatToQ31(coef);
+    adsr->decayBase = floatToQ1_30((adsr->sustain - ADSRS_RATIO_DR) * (1.0f - coef));
+    adsr->sustainLevel = floatToQ1_30(adsr->sustain);
+}
+
+void    tADSRSQ31_setSustain(tADSRSQ31* const adsr, Lfloat sustain)
+{
+    adsr->sustain = sustain;
+    tADSRSQ31_setDecay(adsr, adsr->decay);
+}
+
+void    tADSRSQ31_setRelease(tADSRSQ31* const adsr, Lfloat release)
+{
+    adsr->release = release;
+    Lfloat coef = adsrsCoef(release * adsr->sampleRateInMs, ADSRS_RATIO_DR);
+    adsr->releaseCoef = LEAF_floatToQ31(coef);
+    adsr->releaseBase = floatToQ1_30(-ADSRS_RATIO_DR * (1.0f - coef));
+}
+
+// 0.999999 is slow leak, 0.9 is fast leak
+void    tADSRSQ31_setLeakFactor(tADSRSQ31* const adsr, Lfloat leakFactor)
+{
+    adsr->baseLeakFactor = leakFactor;
+    adsr->leakFactor = LEAF_floatToQ31(powf(leakFactor, 44100.0f / adsr->sampleRate));
+}
+
+void    tADSRSQ31_on(tADSRSQ31* const adsr, Lq31 velocity)
+{
+    adsr->state = env_attack;
+    adsr->targetGainSquared = LEAF_q31Mul(velocity, velocity);
+}
+
+void    tADSRSQ31_off(tADSRSQ31* const adsr)
+{
+    if (adsr->state != env_idle) {
+        adsr->state = env_release;
+    }
+}
+
+void    tADSRSQ31_setSampleRate(tADSRSQ31* const adsr, Lfloat sr)
+{
+    adsr->sampleRate = sr;
+    adsr->sampleRateInMs = sr * 0.001f;
+    tADSRSQ31_setAttack(adsr, adsr->attack);
+    tADSRSQ31_setDecay(adsr, adsr->decay);
+    tADSRSQ31_setRelease(adsr, adsr->release);
+    tADSRSQ31_setLeakFactor(adsr, adsr->baseLeakFactor);
+}
@@ -0,0 +1,319 @@
+/*==============================================================================
+
+    leaf-kernels.c
+    Created: 19 Oct 2026 2:41:17pm
+
+==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-kernels.h"
+#include "..\leaf.h"
+
+#else
+
+#include "../Inc/leaf-kernels.h"
+#include "../leaf.h"
+
+#endif
+
+#if LEAF_USE_CMSIS
+#include "arm_math.h"
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+// Wider versions are built with per-function target attributes, so only GCC and Clang get them
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LEAF_KERNELS_X86 1
+#else
+#define LEAF_KERNELS_X86 0
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__ARM_NEON))
+#define LEAF_KERNELS_NEON 1
+#else
+#define LEAF_KERNELS_NEON 0
+#endif
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Plain C ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+static Lfloat kernelDot_scalar (const Lfloat* a, const Lfloat* b, int n)
+{
+    Lfloat acc = 0.0f;
+    for (int i = 0; i < n; i++)
+        acc += a[i] * b[i];
+    return acc;
+}
+
+// Elsewhere count with shifts and masks. The plain C table has to run on any CPU, so no POPCNT intrinsic.
+static inline int kernelPopcount (unsigned int x)
+{
+#ifdef __GNUC__
+    return __builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0f0f0f0fu;
+    return (int) ((x * 0x01010101u) >> 24);
+#endif
+}
+
+static int kernelXorPopcount_scalar (const unsigned int* a, const unsigned int* b, int n)
+{
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += kernelPopcount(a[i] ^ b[i]);
+    return count;
+}
+
+static int kernelXorPopcountShifted_scalar (const unsigned int* a, const unsigned int* b, int n, int shift)
+{
+    const int shift2 = (int) (CHAR_BIT * sizeof(unsigned int)) - shift;
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += kernelPopcount(a[i] ^ ((b[i] >> shift) | (b[i + 1] << shift2)));
+    return count;
+}
+
+static inline Lfloat kernelLerp (const Lfloat* buf, int mask, Lfloat p)
+{
+    int index = (int) p;
+    Lfloat fraction = p - (Lfloat) index;
+    index &= mask;
+    return buf[index] + fraction * (buf[index + 1] - buf[index]);
+}
+
+static void kernelLerpRampAdd_scalar (Lfloat* out, const Lfloat* buf, int mask, Lfloat pos, Lfloat step, int n)
+{
+    Lfloat x = 0.0f;    // i as a float, without converting every sample
+    for (int i = 0; i < n; i++, x += 1.0f)
+        out[i] += kernelLerp(buf, mask, pos + x * step);
+}
+
+static void kernelLerpRampCrossfadeAdd_scalar (Lfloat* out, const Lfloat* buf, int mask, Lfloat pos, Lfloat step,
+                                               Lfloat offset, Lfloat gain, Lfloat gainStep, int n)
+{
+    Lfloat x = 0.0f;
+    for (int i = 0; i < n; i++, x += 1.0f)
+    {
+        Lfloat p = pos + x * step;
+        Lfloat g = gain - x * gainStep;
+        out[i] += kernelLerp(buf, mask, p) * (1.0f - g) + kernelLerp(buf, mask, p - offset) * g;
+    }
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Vector ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+// Dot product over WIDTH-lane GCC vectors with four accumulators to hide the add latency.
+// Built once per instruction set; ATTR is the target attribute of that set.
+#define LEAF_KERNEL_DOT(NAME, WIDTH, ATTR)                                          \
+    typedef float NAME##_v __attribute__((vector_size((WIDTH) * 4)));               \
+    ATTR static Lfloat NAME (const Lfloat* a, const Lfloat* b, int n)               \
+    {                                                                               \
+        NAME##_v acc0 = { 0 }, acc1 = { 0 }, acc2 = { 0 }, acc3 = { 0 };            \
+        NAME##_v x, y;                                                              \
+        float lanes[WIDTH];                                                         \
+        Lfloat sum = 0.0f;                                                          \
+        int i = 0;                                                                  \
+        for (; i + 4 * (WIDTH) <= n; i += 4 * (WIDTH))                              \
+        {                                                                           \
+            memcpy(&x, a + i, sizeof(x)); memcpy(&y, b + i, sizeof(y));             \
+            acc0 += x * y;                                                          \
+            memcpy(&x, a + i + (WIDTH), sizeof(x));                                 \
+            memcpy(&y, b + i + (WIDTH), sizeof(y));                                 \
+            acc1 += x * y;                                                          \
+            memcpy(&x, a + i + 2 * (WIDTH), sizeof(x));                             \
+            memcpy(&y, b + i + 2 * (WIDTH), sizeof(y));                             \
+            acc2 += x * y;                                                          \
+            memcpy(&x, a + i + 3 * (WIDTH), sizeof(x));                             \
+            memcpy(&y, b + i + 3 * (WIDTH), sizeof(y));                             \
+            acc3 += x * y;                                                          \
+        }                                                                           \
+        for (; i + (WIDTH) <= n; i += (WIDTH))                                      \
+        {                                                                           \
+            memcpy(&x, a + i, sizeof(x)); memcpy(&y, b + i, sizeof(y));             \
+            acc0 += x * y;                                                          \
+        }                                                                           \
+        acc0 += acc1 + acc2 + acc3;                                                 \
+        memcpy(lanes, &acc0, sizeof(lanes));                                        \
+        for (int k = 0; k < (WIDTH); k++) sum += lanes[k];                          \
+        for (; i < n; i++) sum += a[i] * b[i];                                      \
+        return sum;                                                                 \
+    }
+
+#if LEAF_KERNELS_X86
+LEAF_KERNEL_DOT(kernelDot_sse2, 4, __attribute__((target("sse2"))))
+LEAF_KERNEL_DOT(kernelDot_avx2, 8, __attribute__((target("avx2,fma"))))
+LEAF_KERNEL_DOT(kernelDot_avx512, 16, __attribute__((target("avx512f"))))
+
+// With the popcnt target __builtin_popcount is one instruction instead of a libgcc call
+__attribute__((target("popcnt")))
+static int kernelXorPopcount_popcnt (const unsigned int* a, const unsigned int* b, int n)
+{
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += __builtin_popcount(a[i] ^ b[i]);
+    return count;
+}
+
+__attribute__((target("popcnt")))
+static int kernelXorPopcountShifted_popcnt (const unsigned int* a, const unsigned int* b, int n, int shift)
+{
+    const int shift2 = (int) (CHAR_BIT * sizeof(unsigned int)) - shift;
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        count += __builtin_popcount(a[i] ^ ((b[i] >> shift) | (b[i + 1] << shift2)));
+    return count;
+}
+
+// Gathers are slower than plain loads on many x86 parts, so only the position and
+// interpolation arithmetic is vectorised. No FMA, so each lane rounds like the scalar version.
+__attribute__((target("sse2")))
+static inline __m128 kernelLerp4_sse2 (const Lfloat* buf, __m128i mask, __m128 p)
+{
+    int index[4];
+    __m128i whole = _mm_cvttps_epi32(p);
+    __m128 fraction = _mm_sub_ps(p, _mm_cvtepi32_ps(whole));
+    _mm_storeu_si128((__m128i*) index, _mm_and_si128(whole, mask));
+    __m128 a = _mm_setr_ps(buf[index[0]], buf[index[1]], buf[index[2]], buf[index[3]]);
+    __m128 b = _mm_setr_ps(buf[index[0] + 1], buf[index[1] + 1], buf[index[2] + 1], buf[index[3] + 1]);
+    return _mm_add_ps(a, _mm_mul_ps(fraction, _mm_sub_ps(b, a)));
+}
+
+__attribute__((target("sse2")))
+static void kernelLerpRampAdd_sse2 (Lfloat* out, const Lfloat* buf, int mask, Lfloat pos, Lfloat step, int n)
+{
+    const __m128i vmask = _mm_set1_epi32(mask);
+    const __m128 vpos = _mm_set1_ps(pos), vstep = _mm_set1_ps(step), four = _mm_set1_ps(4.0f);
+    __m128 vi = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 p = _mm_add_ps(vpos, _mm_mul_ps(vi, vstep));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), kernelLerp4_sse2(buf, vmask, p)));
+        vi = _mm_add_ps(vi, four);
+    }
+    for (; i < n; i++)
+        out[i] += kernelLerp(buf, mask, pos + (Lfloat) i * step);
+}
+
+__attribute__((target("sse2")))
+static void kernelLerpRampCrossfadeAdd_sse2 (Lfloat* out, const Lfloat* buf, int mask, Lfloat pos, Lfloat step,
+                                             Lfloat offset, Lfloat gain, Lfloat gainStep, int n)
+{
+    const __m128i vmask = _mm_set1_epi32(mask);
+    const __m128 vpos = _mm_set1_ps(pos), vstep = _mm_set1_ps(step), voffset = _mm_set1_ps(offset);
+    const __m128 vgain = _mm_set1_ps(gain), vgainStep = _mm_set1_ps(gainStep);
+    const __m128 one = _mm_set1_ps(1.0f), four = _mm_set1_ps(4.0f);
+    __m128 vi = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 p = _mm_add_ps(vpos, _mm_mul_ps(vi, vstep));
+        __m128 g = _mm_sub_ps(vgain, _mm_mul_ps(vi, vgainStep));
+        __m128 a = _mm_mul_ps(kernelLerp4_sse2(buf, vmask, p), _mm_sub_ps(one, g));
+        __m128 b = _mm_mul_ps(kernelLerp4_sse2(buf, vmask, _mm_sub_ps(p, voffset)), g);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_add_ps(a, b)));
+        vi = _mm_add_ps(vi, four);
+    }
+    for (; i < n; i++)
+    {
+        Lfloat p = pos + (Lfloat) i * step;
+        Lfloat g = gain - (Lfloat) i * gainStep;
+        out[i] += kernelLerp(buf, mask, p) * (1.0f - g) + kernelLerp(buf, mask, p - offset) * g;
+    }
+}
+#endif
+
+#if LEAF_KERNELS_NEON
+LEAF_KERNEL_DOT(kernelDot_neon, 4, )
+#endif
+
+#if LEAF_USE_CMSIS
+static Lfloat kernelDot_cmsis (const Lfloat* a, const Lfloat* b, int n)
+{
+    float32_t result;
+    arm_dot_prod_f32((const float32_t*) a, (const float32_t*) b, (uint32_t) n, &result);
+    return result;
+}
+#endif
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Dispatch ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+uint32_t LEAF_detectCPUFeatures (void)
+{
+    uint32_t features = 0;
+
+#if LEAF_KERNELS_X86
+    // __builtin_cpu_supports also checks that the OS saves the AVX registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))     features |= LEAF_CPU_SSE2;
+    if (__builtin_cpu_supports("sse4.1"))   features |= LEAF_CPU_SSE41;
+    if (__builtin_cpu_supports("popcnt"))   features |= LEAF_CPU_POPCNT;
+    if (__builtin_cpu_supports("avx"))      features |= LEAF_CPU_AVX;
+    if (__builtin_cpu_supports("avx2"))     features |= LEAF_CPU_AVX2;
+    if (__builtin_cpu_supports("fma"))      features |= LEAF_CPU_FMA;
+    if (__builtin_cpu_supports("avx512f"))  features |= LEAF_CPU_AVX512F;
+#elif LEAF_KERNELS_NEON
+    features |= LEAF_CPU_NEON;
+#endif
+
+#if LEAF_USE_CMSIS
+    features |= LEAF_CPU_CMSIS;
+#endif
+
+    return features;
+}
+
+void LEAF_bindKernels (LEAFKernels* const k, uint32_t features)
+{
+    k->features = features;
+    k->name = "scalar";
+    k->dot = kernelDot_scalar;
+    k->xorPopcount = kernelXorPopcount_scalar;
+    k->xorPopcountShifted = kernelXorPopcountShifted_scalar;
+    k->lerpRampAdd = kernelLerpRampAdd_scalar;
+    k->lerpRampCrossfadeAdd = kernelLerpRampCrossfadeAdd_scalar;
+
+#if LEAF_KERNELS_X86
+    if (features & LEAF_CPU_SSE2)
+    {
+        k->name = "SSE2";
+        k->dot = kernelDot_sse2;
+        k->lerpRampAdd = kernelLerpRampAdd_sse2;
+        k->lerpRampCrossfadeAdd = kernelLerpRampCrossfadeAdd_sse2;
+    }
+    if ((features & (LEAF_CPU_AVX2 | LEAF_CPU_FMA)) == (LEAF_CPU_AVX2 | LEAF_CPU_FMA))
+    {
+        k->name = "AVX2";
+        k->dot = kernelDot_avx2;
+    }
+    if (features & LEAF_CPU_AVX512F)
+    {
+        k->name = "AVX-512";
+        k->dot = kernelDot_avx512;
+    }
+    if (features & LEAF_CPU_POPCNT)
+    {
+        k->xorPopcount = kernelXorPopcount_popcnt;
+        k->xorPopcountShifted = kernelXorPopcountShifted_popcnt;
+    }
+#elif LEAF_KERNELS_NEON
+    if (features & LEAF_CPU_NEON)
+    {
+        k->name = "NEON";
+        k->dot = kernelDot_neon;
+    }
+#endif
+
+#if LEAF_USE_CMSIS
+    if (features & LEAF_CPU_CMSIS)
+    {
+        k->name = "CMSIS";
+        k->dot = kernelDot_cmsis;
+    }
+#endif
+}
@@ -236,6 +236,39 @@ float fast_sinf2(Lfloat x)
 #if LEAF_INCLUDE_MINBLEP_TABLES
 /// MINBLEPS
 // https://github.com/MrBlueXav/Dekrispator_v2 blepvco.c
+
+// Add a whole step residual to buffer[index] .. buffer[index + STEP_DD_PULSE_LENGTH - 1].
+// phase is the table phase in [0, MINBLEP_PHASES) and r the fraction towards the next one.
+// The trip count is fixed so the loop unrolls and vectorises.
+#ifdef ITCMRAM
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) add_step_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale)
+#else
+void add_step_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale)
+#endif
+{
+    const Lfloat_value_delta* table = &step_dd_table[phase];
+    Lfloat* out = &buffer[index];
+    for (int n = 0; n < STEP_DD_PULSE_LENGTH; n++)
+    {
+        out[n] += scale * (table[n * MINBLEP_PHASES].value + r * table[n * MINBLEP_PHASES].delta);
+    }
+}
+
+#ifdef ITCMRAM
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) add_slope_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale)
+#else
+void add_slope_dd(Lfloat *buffer, int index, int phase, Lfloat r, Lfloat scale)
+#endif
+{
+    const Lfloat* table = &slope_dd_table[phase];
+    Lfloat* out = &buffer[index];
+    for (int n = 0; n < SLOPE_DD_PULSE_LENGTH; n++)
+    {
+        Lfloat a = table[n * MINBLEP_PHASES];
+        out[n] += scale * (a + r * (table[n * MINBLEP_PHASES + 1] - a));
+    }
+}
+
 #ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) place_step_dd(Lfloat *buffer, int index, Lfloat phase, Lfloat w, Lfloat scale)
 #else
@@ -250,11 +283,7 @@ void place_step_dd(Lfloat *buffer, int index, Lfloat phase, Lfloat w, Lfloat sca
     r -= (Lfloat)i;
     i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
 
-    while (i < MINBLEP_PHASES * STEP_DD_PULSE_LENGTH) {
-        buffer[index] += scale * (step_dd_table[i].value + r * step_dd_table[i].delta);
-        i += MINBLEP_PHASES;
-        index++;
-    }
+    add_step_dd(buffer, index, (int) i, r, scale);
 }
 
 
@@ -276,11 +305,7 @@ void place_slope_dd(Lfloat *buffer, int index, float phase, float w, Lfloat slop
 
     slope_delta *= w;
 
-    while (i < MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH) {
-        buffer[index] += slope_delta * (slope_dd_table[i] + r * (slope_dd_table[i + 1] - slope_dd_table[i]));
-        i += MINBLEP_PHASES;
-        index++;
-    }
+    add_slope_dd(buffer, index, (int) i, r, slope_delta);
 }
 #endif // LEAF_INCLUDE_MINBLEP_TABLES
 
@@ -267,6 +267,7 @@ void    tPoly_initToPool            (tPoly** const polyh, int maxNumVoices, tMem
     }
     
     poly->glideTime = 5.0f;
+    poly->samplesPerTick = 1;
     
     poly->ramps = (tRamp*) mpool_alloc(sizeof(tRamp) * poly->maxNumVoices, m);
     poly->rampVals = (Lfloat*) mpool_alloc(sizeof(Lfloat) * poly->maxNumVoices, m);
@@ -331,6 +332,22 @@ void tPoly_tickPitchBend(tPoly* poly)
     tRamp_tick(poly->pitchBendRamp);
 }
 
+void tPoly_tickPitchBlock(tPoly* const poly, Lfloat** pitches, int numSamples)
+{
+    for (int i = 0; i < numSamples; i += poly->samplesPerTick)
+    {
+        int n = LEAF_clipInt(1, numSamples - i, poly->samplesPerTick);
+        Lfloat bendFrom = tRamp_sample(poly->pitchBendRamp);
+        Lfloat bendTo = tRamp_tick(poly->pitchBendRamp);
+        for (int v = 0; v < poly->maxNumVoices; ++v)
+        {
+            Lfloat from = tRamp_sample(poly->ramps[v]) + bendFrom;
+            Lfloat to = tRamp_tick(poly->ramps[v]) + bendTo;
+            LEAF_interpolateBlock(pitches[v] + i, n, from, to);
+        }
+    }
+}
+
 void tPoly_setPitchBend(tPoly* const poly, Lfloat pitchBend)
 {
     poly->pitchBend = pitchBend;
@@ -535,7 +552,18 @@ void tPoly_setBendGlideTime(tPoly* const poly, Lfloat t)
 
 void tPoly_setBendSamplesPerTick(tPoly* const poly, Lfloat t)
 {
-	 poly->pitchBendRamp->samples_per_tick =  t;
+    tRamp_setSamplesPerTick(poly->pitchBendRamp, (int) t);
+}
+
+void tPoly_setSamplesPerTick(tPoly* const poly, int samplesPerTick)
+{
+    if (samplesPerTick < 1) samplesPerTick = 1;
+    poly->samplesPerTick = samplesPerTick;
+    for (int i = 0; i < poly->maxNumVoices; ++i)
+    {
+        tRamp_setSamplesPerTick(poly->ramps[i], samplesPerTick);
+    }
+    tRamp_setSamplesPerTick(poly->pitchBendRamp, samplesPerTick);
 }
 
 int tPoly_getNumVoices(tPoly* const poly)
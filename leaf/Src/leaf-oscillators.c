@@ -4,6 +4,8 @@
  Author:  Michael R Mulshine
  ==============================================================================*/
 
+#define LEAF_OSCILLATORS_C
+
 #if _WIN32 || _WIN64
 
 #include "..\Inc\leaf-oscillators.h"
@@ -72,36 +74,6 @@ void    tCycle_free (tCycle** const cy)
     mpool_free((char*)c, c->mempool);
 }
 
-//need to check bounds and wrap table properly to allow through-zero FM
-Lfloat   tCycle_tick(tCycle* const c)
-{
-    uint32_t tempFrac;
-    uint32_t idx;
-    Lfloat samp0;
-    Lfloat samp1;
-    
-    // Phasor increment
-    c->phase += c->inc;
-    // Wavetable synthesis
-    idx = c->phase >> 21; //11 bit table 
-    tempFrac = (c->phase & 2097151u); //(2^21 - 1) all the lower bits i.e. the remainder of a division by 2^21  (2097151 is the 21 bits after the 11 bits that represent the main index)
-    
-    samp0 = __leaf_table_sinewave[idx];
-    idx = (idx + 1) & c->mask;
-    samp1 = __leaf_table_sinewave[idx];
-    
-    return (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f)); // 1/2097151 
-}
-
-void     tCycle_setFreq(tCycle* const c, Lfloat freq)
-{
-    
-    //if (!isfinite(freq)) return;
-    
-    c->freq  = freq;
-    c->inc = freq * c->invSampleRateTimesTwoTo32;
-}
-
 void    tCycle_setPhase(tCycle* const c, Lfloat phase)
 {
     
@@ -685,31 +657,6 @@ void    tPBSaw_free  (tPBSaw** const osc)
     mpool_free((char*)c, c->mempool);
 }
 
-#ifdef ITCMRAM
-    Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSaw_tick          (tPBSaw* const osc)
-#else
-Lfloat   tPBSaw_tick          (tPBSaw* const c)
-#endif
-{
-    Lfloat out = (c->phase * INV_TWO_TO_31) - 1.0f;
-
-    Lfloat phaseFloat = c->phase * INV_TWO_TO_32;
-    Lfloat incFloat = c->inc * INV_TWO_TO_32;
-    out -= LEAF_poly_blep(phaseFloat, incFloat);
-    c->phase += c->inc;
-    return (-1.0f * out);
-}
-
-#ifdef ITCMRAM
-    void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq)
-#else
-void    tPBSaw_setFreq       (tPBSaw* const c, Lfloat freq)
-#endif
-{
-    c->freq  = freq;
-    c->inc = freq * c->invSampleRateTimesTwoTo32;
-}
-
 void    tPBSaw_setSampleRate (tPBSaw* const c, Lfloat sr)
 {
     c->invSampleRate = 1.0f/sr;
@@ -901,18 +848,6 @@ void    tPhasor_free (tPhasor** const ph)
     mpool_free((char*)p, p->mempool);
 }
 
-void    tPhasor_setFreq(tPhasor* const p, Lfloat freq)
-{
-    p->freq  = freq;
-    p->inc = freq * p->invSampleRateTimesTwoTo32;
-}
-
-Lfloat   tPhasor_tick(tPhasor* const p)
-{
-    p->phase += p->inc; // no need to phase wrap, since integer overflow does it for us
-    return p->phase * INV_TWO_TO_32; //smush back to 0.0-1.0 range
-}
-
 void     tPhasor_setSampleRate (tPhasor* const p, Lfloat sr)
 {
     p->invSampleRate = 1.0f/sr;
@@ -1205,11 +1140,7 @@ void tMBPulse_initToPool(tMBPulse** const osc, tMempool** const pool)
     c->_x = 0.5f;  /* temporary output variable */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, (FILLEN + STEP_DD_PULSE_LENGTH) * sizeof (Lfloat));
 }
 
 void tMBPulse_free(tMBPulse** const osc)
@@ -1219,9 +1150,9 @@ void tMBPulse_free(tMBPulse** const osc)
 }
 
 //#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPulse_place_step_dd(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
 //#else
-void tMBPulse_place_step_dd_noBuffer(tMBPulse* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+void tMBPulse_place_step_dd(tMBPulse* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
 //#endif
 {
 	Lfloat r;
@@ -1231,11 +1162,12 @@ void tMBPulse_place_step_dd_noBuffer(tMBPulse* const c, int index, Lfloat phase,
 	i = lrintf(r - 0.5f);
 	r -= (Lfloat)i;
 	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+	add_step_dd(c->_f, index, (int) i, r, scale);
+}
+
+void tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+{
+    tMBPulse_place_step_dd(osc, index, phase, inv_w, scale);
 }
 
 
@@ -1275,13 +1207,13 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
             if (sw > 0)
             {
                 if (p_at_reset >= b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f);
+                	tMBPulse_place_step_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f);
                     k = 1;
                     x = -0.5f;
                 }
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+                    tMBPulse_place_step_dd(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
                     k = 0;
                     x = 0.5f;
                 }
@@ -1290,12 +1222,12 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
             {
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+                    tMBPulse_place_step_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
                     k = 1;
                     x = -0.5f;
                 }
                 if (k && p_at_reset < b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
+                	tMBPulse_place_step_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
                     k = 0;
                     x = 0.5f;
                 }
@@ -1305,12 +1237,12 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
             {
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+                    tMBPulse_place_step_dd(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
                     k = 0;
                     x = 0.5f;
                 }
                 if (!k && p_at_reset >= b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f);
+                	tMBPulse_place_step_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f);
                     k = 1;
                     x = -0.5f;
                 }
@@ -1318,13 +1250,13 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
             else if (sw < 0)
             {
                 if (p_at_reset < b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
+                	tMBPulse_place_step_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
                     k = 0;
                     x = 0.5f;
                 }
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+                    tMBPulse_place_step_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
                     k = 1;
                     x = -0.5f;
                 }
@@ -1335,12 +1267,12 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
         if (sw > 0)
         {
             if (k) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+            	tMBPulse_place_step_dd(c, j, p, inv_sw, 1.0f);
                 k = 0;
                 x = 0.5f;
             }
             if (p >= b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f);
+            	tMBPulse_place_step_dd(c, j, p - b, inv_sw, -1.0f);
                 k = 1;
                 x = -0.5f;
             }
@@ -1348,12 +1280,12 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
         else if (sw < 0)
         {
             if (!k) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+            	tMBPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f);
                 k = 1;
                 x = -0.5f;
             }
             if (p < b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f);
+            	tMBPulse_place_step_dd(c, j, b - p, -inv_sw, 1.0f);
                 k = 0;
                 x = 0.5f;
             }
@@ -1363,13 +1295,13 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
         if (sw > 0)
         {
             if (p >= b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f);
+            	tMBPulse_place_step_dd(c, j, p - b, inv_sw, -1.0f);
                 k = 1;
                 x = -0.5f;
             }
             if (p >= 1.0f) {
                 p -= 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+                tMBPulse_place_step_dd(c, j, p, inv_sw, 1.0f);
                 k = 0;
                 x = 0.5f;
             }
@@ -1378,12 +1310,12 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
         {
             if (p < 0.0f) {
                 p += 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+                tMBPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f);
                 k = 1;
                 x = -0.5f;
             }
             if (k && p < b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f);
+            	tMBPulse_place_step_dd(c, j, b - p, -inv_sw, 1.0f);
                 k = 0;
                 x = 0.5f;
             }
@@ -1395,12 +1327,12 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
         {
             if (p >= 1.0f) {
                 p -= 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+                tMBPulse_place_step_dd(c, j, p, inv_sw, 1.0f);
                 k = 0;
                 x = 0.5f;
             }
             if (!k && p >= b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f);
+            	tMBPulse_place_step_dd(c, j, p - b, inv_sw, -1.0f);
                 k = 1;
                 x = -0.5f;
             }
@@ -1408,46 +1340,32 @@ Lfloat tMBPulse_tick(tMBPulse* const c)
         else if (sw < 0)
         {
             if (p < b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f);
+            	tMBPulse_place_step_dd(c, j, b - p, -inv_sw, 1.0f);
                 k = 0;
                 x = 0.5f;
             }
             if (p < 0.0f) {
                 p += 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+                tMBPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f);
                 k = 1;
                 x = -0.5f;
             }
         }
     }
 
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
+    int currentSamp = j + DD_SAMPLE_DELAY;
     
-    c->_f[currentSamp] = x;
-
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-	for (int i = 0; i < numBLEPsAtLoopStart; i++)
-	{
-		volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-		whichBLEP &= 63;
-
-		//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-
-		//increment the position in the BLEP table
-		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-		{
-			c->numBLEPs--;
-		}
-
-	}
+    c->_f[currentSamp] += x;
 
     z += 0.5f * (c->_f[j] - z);
     c->out = z;
 
-    j = (j+1) & 7;
+    if (++j == FILLEN)
+    {
+        j = 0;
+        memcpy (c->_f, c->_f + FILLEN, STEP_DD_PULSE_LENGTH * sizeof (Lfloat));
+        memset (c->_f + STEP_DD_PULSE_LENGTH, 0,  FILLEN * sizeof (Lfloat));
+    }
 
     c->_p = p;
     c->_w = w;
@@ -1538,12 +1456,7 @@ void tMBTriangle_initToPool(tMBTriangle** const osc, tMempool** const pool)
     c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    c->maxBLEPphaseSlope = MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, (FILLEN + STEP_DD_PULSE_LENGTH) * sizeof (Lfloat));
 }
 
 void tMBTriangle_free(tMBTriangle** const osc)
@@ -1553,9 +1466,9 @@ void tMBTriangle_free(tMBTriangle** const osc)
 }
 
 //#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTriangle_place_dd(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
 //#else
-void tMBTriangle_place_dd_noBuffer(tMBTriangle* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+void tMBTriangle_place_dd(tMBTriangle* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
 //#endif
 {
 	Lfloat r;
@@ -1566,12 +1479,13 @@ void tMBTriangle_place_dd_noBuffer(tMBTriangle* const c, int index, Lfloat phase
 	r -= (Lfloat)i;
 	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
 	scale *= w;
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->BLEPproperties[c->mostRecentBLEP][2] = stepOrSlope;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+	if (stepOrSlope < 0.5f) add_step_dd(c->_f, index, (int) i, r, scale);
+	else add_slope_dd(c->_f, index, (int) i, r, scale);
+}
+
+void tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+{
+    tMBTriangle_place_dd(osc, index, phase, inv_w, scale, stepOrSlope, w);
 }
 
 Lfloat tMBTriangle_tick(tMBTriangle* const c)
@@ -1617,13 +1531,13 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
             {
                 if (p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBTriangle_place_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBTriangle_place_dd(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
             }
@@ -1632,12 +1546,12 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b)  * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
                 if (k && p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
             }
@@ -1648,12 +1562,12 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBTriangle_place_dd(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
                 if (!k && p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBTriangle_place_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
             }
@@ -1661,13 +1575,13 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
             {
                 if (p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
             }
@@ -1677,26 +1591,26 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
         if (sw > 0)
         {
             if (k)
-            	tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
-            tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, -0.5f - x, 0.0f, sw);
+            	tMBTriangle_place_dd(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+            tMBTriangle_place_dd(c, j, p, inv_sw, -0.5f - x, 0.0f, sw);
             x = -0.5f + p * invB;
             k = 0;
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBTriangle_place_dd(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
         else if (sw < 0)
         {
             if (!k)
-            	tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
-            tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -0.5f - x, 0.0f, -sw);
+            	tMBTriangle_place_dd(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+            tMBTriangle_place_dd(c, j, 1.0f - p, -inv_sw, -0.5f - x, 0.0f, -sw);
             x = 0.5f - (p - b) * invB1;
             k = 1;
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBTriangle_place_dd(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
@@ -1707,13 +1621,13 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
         {
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;;
-                tMBTriangle_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBTriangle_place_dd(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBTriangle_place_dd(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
         }
@@ -1722,12 +1636,12 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBTriangle_place_dd(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
             if (k && p < b) {
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBTriangle_place_dd(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
@@ -1740,12 +1654,12 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBTriangle_place_dd(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
             if (!k && p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBTriangle_place_dd(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
@@ -1753,56 +1667,29 @@ Lfloat tMBTriangle_tick(tMBTriangle* const c)
         {
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBTriangle_place_dd(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBTriangle_place_dd(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
         }
     }
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
+    int currentSamp = j + DD_SAMPLE_DELAY;
     
-    c->_f[currentSamp] = x;
-
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
-    {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
-
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-
-    	if (c->BLEPproperties[whichBLEP][2] < 0.5f) //step blep
-    	{
-    		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
-    	else  // slope blep
-    	{
-    		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (slope_dd_table[c->BLEPindices[whichBLEP]] + c->BLEPproperties[whichBLEP][0] * (slope_dd_table[c->BLEPindices[whichBLEP]+1] - slope_dd_table[c->BLEPindices[whichBLEP]]));
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= (c->maxBLEPphaseSlope)) //slope bleps are 71 length instead of 72 length so subtract 1
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
-    }
+    c->_f[currentSamp] += x;
 
     z += 0.5f * (c->_f[j] - z);
     c->out = z;
-    j = (j+1) & 7;
+    if (++j == FILLEN)
+    {
+        j = 0;
+        memcpy (c->_f, c->_f + FILLEN, STEP_DD_PULSE_LENGTH * sizeof (Lfloat));
+        memset (c->_f + STEP_DD_PULSE_LENGTH, 0,  FILLEN * sizeof (Lfloat));
+    }
     c->_p = p;
     c->_w = w;
     c->_b = b;
@@ -1895,13 +1782,8 @@ void tMBSineTri_initToPool(tMBSineTri** const osc, tMempool** const pool)
     c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    c->maxBLEPphaseSlope = MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH;
     c->sineMask = 2047;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, (FILLEN + STEP_DD_PULSE_LENGTH) * sizeof (Lfloat));
 }
 
 void tMBSineTri_free(tMBSineTri** const osc)
@@ -1911,9 +1793,9 @@ void tMBSineTri_free(tMBSineTri** const osc)
 }
 
 //#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSineTri_place_dd(tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
 //#else
-void tMBSineTri_place_dd_noBuffer(tMBSineTri* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+void tMBSineTri_place_dd(tMBSineTri* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
 //#endif
 {
 	Lfloat r;
@@ -1924,12 +1806,13 @@ void tMBSineTri_place_dd_noBuffer(tMBSineTri* const c, int index, Lfloat phase,
 	r -= (Lfloat)i;
 	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
 	scale *= w;
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->BLEPproperties[c->mostRecentBLEP][2] = stepOrSlope;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+	if (stepOrSlope < 0.5f) add_step_dd(c->_f, index, (int) i, r, scale);
+	else add_slope_dd(c->_f, index, (int) i, r, scale * c->shape);
+}
+
+void tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+{
+    tMBSineTri_place_dd(osc, index, phase, inv_w, scale, stepOrSlope, w);
 }
 
 Lfloat tMBSineTri_tick(tMBSineTri* const c)
@@ -1985,13 +1868,13 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
             {
                 if (p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBSineTri_place_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBSineTri_place_dd(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
             }
@@ -2000,12 +1883,12 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b)  * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
                 if (k && p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
             }
@@ -2016,12 +1899,12 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBSineTri_place_dd(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
                 if (!k && p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBSineTri_place_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
             }
@@ -2029,13 +1912,13 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
             {
                 if (p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
             }
@@ -2045,26 +1928,26 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
         if (sw > 0)
         {
             if (k)
-            	tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
-            tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, 0.0f - x, 0.0f, sw);
+            	tMBSineTri_place_dd(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+            tMBSineTri_place_dd(c, j, p, inv_sw, 0.0f - x, 0.0f, sw);
             x = -0.5f + p * invB;
             k = 0;
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBSineTri_place_dd(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
         else if (sw < 0)
         {
             if (!k)
-            	tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
-            tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, 0.0f - x, 0.0f, -sw);
+            	tMBSineTri_place_dd(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+            tMBSineTri_place_dd(c, j, 1.0f - p, -inv_sw, 0.0f - x, 0.0f, -sw);
             x = 0.5f - (p - b) * invB1;
             k = 1;
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBSineTri_place_dd(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
@@ -2075,13 +1958,13 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
         {
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;;
-                tMBSineTri_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBSineTri_place_dd(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBSineTri_place_dd(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
         }
@@ -2090,12 +1973,12 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBSineTri_place_dd(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
             if (k && p < b) {
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBSineTri_place_dd(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
@@ -2108,12 +1991,12 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBSineTri_place_dd(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
             if (!k && p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBSineTri_place_dd(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
@@ -2121,20 +2004,20 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
         {
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBSineTri_place_dd(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBSineTri_place_dd(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
         }
     }
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
+    int currentSamp = j + DD_SAMPLE_DELAY;
 
-    c->_f[currentSamp] = x * c->shape; //add the triangle
+    c->_f[currentSamp] += x * c->shape; //add the triangle
 
 
     Lfloat tempFrac;
@@ -2164,40 +2047,13 @@ Lfloat tMBSineTri_tick(tMBSineTri* const c)
     c->_f[currentSamp] += sinOut * (1.0f - c->shape); //add the sine
 
 
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
+    z += 0.5f * (c->_f[j] - z);
+    if (++j == FILLEN)
     {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
-
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-
-    	if (c->BLEPproperties[whichBLEP][2] < 0.5f) //step blep
-    	{
-    		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
-    	else  // slope blep
-    	{
-    		c->_f[j] += (c->BLEPproperties[whichBLEP][1] * (slope_dd_table[c->BLEPindices[whichBLEP]] + c->BLEPproperties[whichBLEP][0] * (slope_dd_table[c->BLEPindices[whichBLEP]+1] - slope_dd_table[c->BLEPindices[whichBLEP]]))) * c->shape;
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= (c->maxBLEPphaseSlope)) //slope bleps are 71 length instead of 72 length so subtract 1
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
+        j = 0;
+        memcpy (c->_f, c->_f + FILLEN, STEP_DD_PULSE_LENGTH * sizeof (Lfloat));
+        memset (c->_f + STEP_DD_PULSE_LENGTH, 0,  FILLEN * sizeof (Lfloat));
     }
-
-    z += 0.5f * (c->_f[j] - z);
-    j = (j+1) & 7;
     c->out = z;
     c->_p = p;
     c->_w = w;
@@ -2291,11 +2147,7 @@ void tMBSaw_initToPool(tMBSaw** const osc, tMempool** const pool)
     c->_p = 0.0f;  /* phase [0, 1) */
     c->_w = c->freq * c->invSampleRate;  /* phase increment */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, (FILLEN + STEP_DD_PULSE_LENGTH) * sizeof (Lfloat));
 }
 
 void tMBSaw_free(tMBSaw** const osc)
@@ -2306,9 +2158,9 @@ void tMBSaw_free(tMBSaw** const osc)
 
 
 //#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw_place_step_dd_noBuffer(tMBSaw* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw_place_step_dd(tMBSaw* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
 //#else
-void tMBSaw_place_step_dd_noBuffer(tMBSaw* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+void tMBSaw_place_step_dd(tMBSaw* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
 //#endif
 {
 	Lfloat r;
@@ -2318,11 +2170,12 @@ void tMBSaw_place_step_dd_noBuffer(tMBSaw* const c, int index, Lfloat phase, Lfl
 	i = lrintf(r - 0.5f);
 	r -= (Lfloat)i;
 	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+	add_step_dd(c->_f, index, (int) i, r, scale);
+}
+
+void tMBSaw_place_step_dd_noBuffer(tMBSaw* const osc, int index, Lfloat phase, Lfloat w, Lfloat scale)
+{
+    tMBSaw_place_step_dd(osc, index, phase, w, scale);
 }
 
 
@@ -2370,56 +2223,42 @@ Lfloat tMBSaw_tick(tMBSaw* const c)
         /* place any DD that may have occurred in subsample before reset */
         if (p_at_reset >= 1.0f) {
             p_at_reset -= 1.0f;
-            tMBSaw_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+            tMBSaw_place_step_dd(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
         }
         if (p_at_reset < 0.0f) {
             p_at_reset += 1.0f;
-            tMBSaw_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+            tMBSaw_place_step_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
         }
 
         /* now place reset DD */
         if (sw > 0)
-        	tMBSaw_place_step_dd_noBuffer(c, j, p, inv_sw, p_at_reset);
+        	tMBSaw_place_step_dd(c, j, p, inv_sw, p_at_reset);
         else if (sw < 0)
-        	tMBSaw_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -p_at_reset);
+        	tMBSaw_place_step_dd(c, j, 1.0f - p, -inv_sw, -p_at_reset);
 
     } else if (p >= 1.0f) {  /* normal phase reset */
         p -= 1.0f;
-        tMBSaw_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+        tMBSaw_place_step_dd(c, j, p, inv_sw, 1.0f);
 
     } else if (p < 0.0f) {
         p += 1.0f;
-        tMBSaw_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+        tMBSaw_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f);
     }
 
-    //construct the current output sample based on the state of the active BLEPs
+    //the BLEP residuals were already added to _f when they were placed
 
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
+    int currentSamp = j + DD_SAMPLE_DELAY;
 
-    c->_f[currentSamp] = 0.5f - p;
-
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
-    {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
-
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-    	c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-
-    	//increment the position in the BLEP table
-		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-		{
-			c->numBLEPs--;
-		}
-
-    }
+    c->_f[currentSamp] += 0.5f - p;
 
     z += 0.5f * (c->_f[j] - z); // LP filtering
     c->out = z;
-    j = (j+1) & 7; //don't need 128 sample buffer just for lowpass, so only using the first 16 values before wrapping around (probably only need 4 or 8)
+    if (++j == FILLEN)
+    {
+        j = 0;
+        memcpy (c->_f, c->_f + FILLEN, STEP_DD_PULSE_LENGTH * sizeof (Lfloat));
+        memset (c->_f + STEP_DD_PULSE_LENGTH, 0,  FILLEN * sizeof (Lfloat));
+    }
 
     c->_p = p;
     c->_z = z;
@@ -2504,11 +2343,7 @@ void tMBSawPulse_initToPool(tMBSawPulse** const osc, tMempool** const pool)
     c->_x = 0.5f;  /* temporary output variable */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, (FILLEN + STEP_DD_PULSE_LENGTH) * sizeof (Lfloat));
 
 }
 
@@ -2520,9 +2355,9 @@ void tMBSawPulse_free(tMBSawPulse** const osc)
 
 
 #ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_place_step_dd(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
 #else
-void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+void tMBSawPulse_place_step_dd(tMBSawPulse* const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
 #endif
 {
     if (c->active)
@@ -2534,15 +2369,15 @@ void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const c, int index, Lfloat
 		i = lrintf(r - 0.5f);
 		r -= (Lfloat)i;
 		i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-		c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-		c->BLEPindices[c->mostRecentBLEP] = i;
-		c->BLEPproperties[c->mostRecentBLEP][0] = r;
-		c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-
-		c->numBLEPs = (c->numBLEPs + 1) & 63;
+		add_step_dd(c->_f, index, (int) i, r, scale);
     }
 }
 
+void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+{
+    tMBSawPulse_place_step_dd(osc, index, phase, inv_w, scale);
+}
+
 
 
 #ifdef ITCMRAM
@@ -2586,14 +2421,14 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 			 {
 				 if (p_at_reset >= b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
 					 k = 1;
 					 x = -0.5f;
 				 }
 				 if (p_at_reset >= 1.0f)
 				 {
 					 p_at_reset -= 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+					 tMBSawPulse_place_step_dd(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
 					 k = 0;
 					 x = 0.5f;
 				 }
@@ -2603,13 +2438,13 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 				 if (p_at_reset < 0.0f)
 				 {
 					 p_at_reset += 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+					 tMBSawPulse_place_step_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
 					 k = 1;
 					 x = -0.5f;
 				 }
 				 if (k && p_at_reset < b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
 					 k = 0;
 					 x = 0.5f;
 				 }
@@ -2622,13 +2457,13 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 				 if (p_at_reset >= 1.0f)
 				 {
 					 p_at_reset -= 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+					 tMBSawPulse_place_step_dd(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
 					 k = 0;
 					 x = 0.5f;
 				 }
 				 if (!k && p_at_reset >= b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
 					 k = 1;
 					 x = -0.5f;
 				 }
@@ -2637,14 +2472,14 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 			 {
 				 if (p_at_reset < b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
 					 k = 0;
 					 x = 0.5f;
 				 }
 				 if (p_at_reset < 0.0f)
 				 {
 					 p_at_reset += 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+					 tMBSawPulse_place_step_dd(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
 					 k = 1;
 					 x = -0.5f;
 				 }
@@ -2656,15 +2491,15 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 		if (sw > 0)
 		{
 			/* now place reset DD for saw*/
-			tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, p_at_reset * sawShape);
+			tMBSawPulse_place_step_dd(c, j, p, inv_sw, p_at_reset * sawShape);
             /* now place reset DD for pulse */
             if (k) {
-            	tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f * shape);
+            	tMBSawPulse_place_step_dd(c, j, p, inv_sw, 1.0f * shape);
 				k = 0;
 				x = 0.5f;
 			}
 			if (p >= b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, p - b, inv_sw, -1.0f * shape);
 				k = 1;
 				x = -0.5f;
 			}
@@ -2672,15 +2507,15 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 		else if (sw < 0)
 		{
 	        /* now place reset DD for saw*/
-			tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -p_at_reset * sawShape);
+			tMBSawPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -p_at_reset * sawShape);
 			 /* now place reset DD for pulse */
 			if (!k) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f * shape);
 				k = 1;
 				x = -0.5f;
 			}
 			if (p < b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, b - p, -inv_sw, 1.0f * shape);
 				k = 0;
 				x = 0.5f;
 			}
@@ -2696,13 +2531,13 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 		if (sw > 0)
 		{
 			if (p >= b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, p - b, inv_sw, -1.0f * shape);
 				k = 1;
 				x = -0.5f;
 			}
 			if (p >= 1.0f) {
 				p -= 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+				tMBSawPulse_place_step_dd(c, j, p, inv_sw, 1.0f);
 				k = 0;
 				x = 0.5f;
 			}
@@ -2711,12 +2546,12 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 		{
 			if (p < 0.0f) {
 				p += 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+				tMBSawPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f);
 				k = 1;
 				x = -0.5f;
 			}
 			if (k && p < b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, b - p, -inv_sw, 1.0f * shape);
 				k = 0;
 				x = 0.5f;
 			}
@@ -2728,12 +2563,12 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 		{
 			if (p >= 1.0f) {
 				p -= 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+				tMBSawPulse_place_step_dd(c, j, p, inv_sw, 1.0f);
 				k = 0;
 				x = 0.5f;
 			}
 			if (!k && p >= b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, p - b, inv_sw, -1.0f * shape);
 				k = 1;
 				x = -0.5f;
 			}
@@ -2741,46 +2576,32 @@ Lfloat tMBSawPulse_tick(tMBSawPulse* const c)
 		else if (sw < 0)
 		{
 			if (p < b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f * shape);
+				tMBSawPulse_place_step_dd(c, j, b - p, -inv_sw, 1.0f * shape);
 				k = 0;
 				x = 0.5f;
 			}
 			if (p < 0.0f) {
 				p += 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+				tMBSawPulse_place_step_dd(c, j, 1.0f - p, -inv_sw, -1.0f);
 				k = 1;
 				x = -0.5f;
 			}
 		}
 	}
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
-    c->_f[currentSamp] = ((0.5f - p) * sawShape); //saw
+    int currentSamp = j + DD_SAMPLE_DELAY;
+    c->_f[currentSamp] += ((0.5f - p) * sawShape); //saw
 
     c->_f[currentSamp] += (x * shape);//pulse
 
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
-    {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
-
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-    	c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-
-    	//increment the position in the BLEP table
-		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-		{
-			c->numBLEPs--;
-		}
-
-    }
-
 
     z += 0.5f * (c->_f[j] - z); // LP filtering
     c->out = z;
-    j = (j+1) & 7;
+    if (++j == FILLEN)
+    {
+        j = 0;
+        memcpy (c->_f, c->_f + FILLEN, STEP_DD_PULSE_LENGTH * sizeof (Lfloat));
+        memset (c->_f + STEP_DD_PULSE_LENGTH, 0,  FILLEN * sizeof (Lfloat));
+    }
 
     c->_p = p;
     c->_w = w;
@@ -3816,6 +3637,7 @@ void    tTriLFO_initToPool   (tTriLFO** const cy, tMempool** const mp)
     c->phase    =  0;
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = (c->invSampleRate * TWO_TO_32);
+    c->samplesPerTick = 1;
     tTriLFO_setFreq(c, 220.0f);
 }
 
@@ -3826,25 +3648,46 @@ void    tTriLFO_free(tTriLFO** const cy)
     mpool_free((char*)c, c->mempool);
 }
 
-//need to check bounds and wrap table properly to allow through-zero FM
-Lfloat   tTriLFO_tick(tTriLFO* const c)
+static inline Lfloat tTriLFO_phaseToOutput(int32_t phase)
 {
-    c->phase += c->inc;
-    
     //bitmask fun
-    int32_t shiftedPhase = c->phase + 1073741824; // offset by 1/4" wave by adding 2^30 to get things in phase with the other LFO oscillators
+    int32_t shiftedPhase = phase + 1073741824; // offset by 1/4" wave by adding 2^30 to get things in phase with the other LFO oscillators
     uint32_t mask = shiftedPhase >> 31; //get the sign bit
     shiftedPhase = shiftedPhase + mask; // add 1 if negative, zero if positive, to balance
     shiftedPhase = shiftedPhase ^ mask; //invert the value to get absolute value of integer
     Lfloat output = (((Lfloat)shiftedPhase * INV_TWO_TO_31) - 0.5f) * 2.0f; //scale it to -1.0f to 1.0f Lfloat
     return output;
+}
 
+//need to check bounds and wrap table properly to allow through-zero FM
+Lfloat   tTriLFO_tick(tTriLFO* const c)
+{
+    c->phase += c->inc;
+    return tTriLFO_phaseToOutput(c->phase);
+}
+
+void    tTriLFO_tickBlock(tTriLFO* const c, Lfloat* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i += c->samplesPerTick)
+    {
+        int n = LEAF_clipInt(1, numSamples - i, c->samplesPerTick);
+        Lfloat from = tTriLFO_phaseToOutput(c->phase);
+        LEAF_interpolateBlock(output + i, n, from, tTriLFO_tick(c));
+    }
 }
 
 void     tTriLFO_setFreq(tTriLFO* const c, Lfloat freq)
 {
     c->freq  = freq;
-    c->inc = freq * c->invSampleRateTimesTwoTo32;
+    // the increment covers every sample of a tick
+    c->inc = freq * c->samplesPerTick * c->invSampleRateTimesTwoTo32;
+}
+
+void    tTriLFO_setSamplesPerTick(tTriLFO* const c, int samplesPerTick)
+{
+    if (samplesPerTick < 1) samplesPerTick = 1;
+    c->samplesPerTick = samplesPerTick;
+    tTriLFO_setFreq(c, c->freq);
 }
 
 void    tTriLFO_setPhase(tTriLFO* const c, Lfloat phase)
@@ -3874,6 +3717,9 @@ void    tSineTriLFO_initToPool  (tSineTriLFO** const cy, tMempool** const mp)
     c->mempool = m;
     tTriLFO_initToPool(&c->tri,mp);
     tCycle_initToPool(&c->sine,mp); 
+    c->freq = 0.0f;
+    c->output = 0.0f;
+    c->samplesPerTick = 1;
    
 }
 void    tSineTriLFO_free        (tSineTriLFO** const cy)
@@ -3888,12 +3734,31 @@ Lfloat   tSineTriLFO_tick        (tSineTriLFO* const c)
 {
     Lfloat a = tCycle_tick(c->sine);
     Lfloat b = tTriLFO_tick(c->tri);
-    return  (1.0f - c->shape) * a + c->shape * b;
+    c->output = (1.0f - c->shape) * a + c->shape * b;
+    return c->output;
+}
+void    tSineTriLFO_tickBlock   (tSineTriLFO* const c, Lfloat* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i += c->samplesPerTick)
+    {
+        int n = LEAF_clipInt(1, numSamples - i, c->samplesPerTick);
+        Lfloat from = c->output;
+        LEAF_interpolateBlock(output + i, n, from, tSineTriLFO_tick(c));
+    }
 }
 void    tSineTriLFO_setFreq     (tSineTriLFO* const c, Lfloat freq)
 {
+    c->freq = freq;
     tTriLFO_setFreq(c->tri, freq);
-    tCycle_setFreq(c->sine, freq);
+    // tCycle has no control rate of its own, so its frequency is scaled instead
+    tCycle_setFreq(c->sine, freq * c->samplesPerTick);
+}
+void    tSineTriLFO_setSamplesPerTick (tSineTriLFO* const c, int samplesPerTick)
+{
+    if (samplesPerTick < 1) samplesPerTick = 1;
+    c->samplesPerTick = samplesPerTick;
+    tTriLFO_setSamplesPerTick(c->tri, samplesPerTick);
+    tCycle_setFreq(c->sine, c->freq * samplesPerTick);
 }
 void    tSineTriLFO_setSampleRate (tSineTriLFO* const c, Lfloat sr)
 {
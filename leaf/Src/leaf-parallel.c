@@ -0,0 +1,726 @@
+/*==============================================================================
+
+    leaf-parallel.c
+    Created: 18 Oct 2026 10:12:03am
+
+==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-parallel.h"
+#include "..\leaf.h"
+
+#else
+
+#include "../Inc/leaf-parallel.h"
+#include "../leaf.h"
+
+#endif
+
+#if LEAF_USE_THREADS
+#include <time.h>
+#include <sched.h>
+#endif
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ JobPool ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+#define QUEUE_HEAD(q) ((uint32_t)((q) & 0xFFFFFFFFu))
+#define QUEUE_TAIL(q) ((uint32_t)((q) >> 32))
+#define QUEUE_PACK(h, t) (((uint64_t)(t) << 32) | (uint64_t)(h))
+
+#if LEAF_USE_THREADS
+// Owner end of a lane queue. Returns the job to run, or -1 if the lane is empty.
+static int tJobPool_pop(tJobPool* const p, int lane)
+{
+    uint64_t q = LEAF_atomicLoad(&p->queues[lane]);
+    while (QUEUE_HEAD(q) < QUEUE_TAIL(q))
+    {
+        if (LEAF_atomicCAS(&p->queues[lane], &q, QUEUE_PACK(QUEUE_HEAD(q) + 1, QUEUE_TAIL(q))))
+            return (int) QUEUE_HEAD(q);
+    }
+    return -1;
+}
+
+// Thief end of a lane queue, so owners and thieves only contend for the last job.
+static int tJobPool_steal(tJobPool* const p, int lane)
+{
+    uint64_t q = LEAF_atomicLoad(&p->queues[lane]);
+    while (QUEUE_HEAD(q) < QUEUE_TAIL(q))
+    {
+        if (LEAF_atomicCAS(&p->queues[lane], &q, QUEUE_PACK(QUEUE_HEAD(q), QUEUE_TAIL(q) - 1)))
+            return (int) QUEUE_TAIL(q) - 1;
+    }
+    return -1;
+}
+
+// The job function is read after the job is claimed, so a worker that wakes late
+// for one batch can never run a job of the next batch with the old function.
+static void tJobPool_runJob(tJobPool* const p, int j)
+{
+    tJobFunction job = LEAF_atomicLoad(&p->job);
+    job(LEAF_atomicLoad(&p->context), j);
+    LEAF_atomicAdd(&p->remaining, -1);
+}
+
+static void tJobPool_runLane(tJobPool* const p, int lane)
+{
+    int j;
+
+    while ((j = tJobPool_pop(p, lane)) >= 0)
+        tJobPool_runJob(p, j);
+
+    for (int i = 1; i < p->numLanes; i++)
+    {
+        int victim = (lane + i) % p->numLanes;
+        while ((j = tJobPool_steal(p, victim)) >= 0)
+            tJobPool_runJob(p, j);
+    }
+}
+
+static double tJobPool_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+static void* tJobPool_workerLoop(void* arg)
+{
+    _tJobWorker* w = (_tJobWorker*) arg;
+    tJobPool* p = w->pool;
+    uint32_t lastGeneration = 0;
+    uint32_t fpState = LEAF_getFloatingPointState();
+
+    for (;;)
+    {
+        pthread_mutex_lock(&p->mutex);
+        while (p->running && p->generation == lastGeneration)
+            pthread_cond_wait(&p->cond, &p->mutex);
+        lastGeneration = p->generation;
+        int running = p->running;
+        uint32_t callerFPState = p->fpState;
+        pthread_mutex_unlock(&p->mutex);
+
+        if (!running) break;
+
+        // Run jobs with the caller's flush-to-zero mode so results don't depend on which thread got them
+        if (callerFPState != fpState)
+        {
+            LEAF_setFloatingPointState(callerFPState);
+            fpState = callerFPState;
+        }
+
+        tJobPool_runLane(p, w->lane);
+    }
+    return NULL;
+}
+#endif
+
+void tJobPool_init(tJobPool** const jp, int numWorkers, LEAF* const leaf)
+{
+    tJobPool_initToPool(jp, numWorkers, &leaf->mempool);
+}
+
+void tJobPool_initToPool(tJobPool** const jp, int numWorkers, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tJobPool* p = *jp = (tJobPool*) mpool_alloc(sizeof(tJobPool), m);
+    p->mempool = m;
+
+#if !LEAF_USE_THREADS
+    numWorkers = 0;
+#endif
+    if (numWorkers < 0) numWorkers = 0;
+
+    p->numWorkers = numWorkers;
+    p->numLanes = numWorkers + 1;
+
+    p->job = NULL;
+    p->context = NULL;
+    p->queues = (uint64_t*) mpool_alloc(sizeof(uint64_t) * p->numLanes, m);
+    for (int i = 0; i < p->numLanes; i++) p->queues[i] = 0;
+    p->remaining = 0;
+
+    p->generation = 0;
+    p->running = 1;
+    p->fpState = LEAF_getFloatingPointState();
+
+    p->workers = (_tJobWorker*) mpool_alloc(sizeof(_tJobWorker) * p->numLanes, m);
+    for (int i = 0; i < p->numLanes; i++)
+    {
+        p->workers[i].pool = p;
+        p->workers[i].lane = i;
+    }
+
+#if LEAF_USE_THREADS
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->cond, NULL);
+    p->threads = (pthread_t*) mpool_alloc(sizeof(pthread_t) * (numWorkers > 0 ? numWorkers : 1), m);
+    // Lane 0 belongs to the calling thread
+    for (int i = 0; i < numWorkers; i++)
+    {
+        if (pthread_create(&p->threads[i], NULL, tJobPool_workerLoop, &p->workers[i+1]) != 0)
+        {
+            // Run with whatever workers did start; the other lanes are still drained by stealing
+            p->numWorkers = i;
+            break;
+        }
+    }
+#endif
+}
+
+void tJobPool_free(tJobPool** const jp)
+{
+    tJobPool* p = *jp;
+
+#if LEAF_USE_THREADS
+    pthread_mutex_lock(&p->mutex);
+    p->running = 0;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->mutex);
+    for (int i = 0; i < p->numWorkers; i++) pthread_join(p->threads[i], NULL);
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->mutex);
+    mpool_free((char*)p->threads, p->mempool);
+#endif
+
+    mpool_free((char*)p->workers, p->mempool);
+    mpool_free((char*)p->queues, p->mempool);
+    mpool_free((char*)p, p->mempool);
+}
+
+int tJobPool_run(tJobPool* const p, tJobFunction job, void* context, int numJobs, Lfloat deadline)
+{
+    if (p->numWorkers == 0 || numJobs < 2)
+    {
+        for (int j = 0; j < numJobs; j++) job(context, j);
+        return 0;
+    }
+
+    int missed = 0;
+#if LEAF_USE_THREADS
+    double start = tJobPool_now();
+
+    // Contiguous slice of the batch per lane; stealing evens out uneven jobs
+    LEAF_atomicStore(&p->job, job);
+    LEAF_atomicStore(&p->context, context);
+    LEAF_atomicStore(&p->remaining, numJobs);
+    for (int lane = 0; lane < p->numLanes; lane++)
+    {
+        uint32_t head = (uint32_t)((numJobs * lane) / p->numLanes);
+        uint32_t tail = (uint32_t)((numJobs * (lane + 1)) / p->numLanes);
+        LEAF_atomicStore(&p->queues[lane], QUEUE_PACK(head, tail));
+    }
+
+    pthread_mutex_lock(&p->mutex);
+    p->fpState = LEAF_getFloatingPointState();
+    p->generation++;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->mutex);
+
+    // Any lane whose worker has not woken up yet gets stolen here,
+    // so at worst this degrades to running everything on this thread
+    tJobPool_runLane(p, 0);
+
+    // Only jobs already in flight on a worker are left to wait for
+    while (LEAF_atomicLoad(&p->remaining) > 0)
+    {
+        if (!missed && deadline > 0.0f && (tJobPool_now() - start) > deadline) missed = 1;
+        sched_yield();
+    }
+#else
+    (void) deadline;
+#endif
+    return missed;
+}
+
+int tJobPool_getNumWorkers(tJobPool* const p)
+{
+    return p->numWorkers;
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ VoiceScheduler ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+static void tVoiceScheduler_renderJob(void* context, int j)
+{
+    tVoiceScheduler* s = (tVoiceScheduler*) context;
+    int v = s->jobs[j];
+    s->render[v](s->userData[v], s->buffers[v], s->numSamples);
+}
+
+void tVoiceScheduler_init(tVoiceScheduler** const vs, int numVoices, int numWorkers, int maxBlockSize, LEAF* const leaf)
+{
+    tVoiceScheduler_initToPool(vs, numVoices, numWorkers, maxBlockSize, &leaf->mempool);
+}
+
+void tVoiceScheduler_initToPool(tVoiceScheduler** const vs, int numVoices, int numWorkers, int maxBlockSize, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tVoiceScheduler* s = *vs = (tVoiceScheduler*) mpool_alloc(sizeof(tVoiceScheduler), m);
+    s->mempool = m;
+
+    tJobPool_initToPool(&s->pool, numWorkers, mp);
+
+    s->numVoices = numVoices;
+    s->maxBlockSize = maxBlockSize;
+
+    s->render = (tVoiceRenderCallback*) mpool_alloc(sizeof(tVoiceRenderCallback) * numVoices, m);
+    s->userData = (void**) mpool_alloc(sizeof(void*) * numVoices, m);
+    s->active = (int*) mpool_alloc(sizeof(int) * numVoices, m);
+    s->buffers = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * numVoices, m);
+    s->jobs = (int*) mpool_alloc(sizeof(int) * numVoices, m);
+    for (int i = 0; i < numVoices; i++)
+    {
+        s->render[i] = NULL;
+        s->userData[i] = NULL;
+        s->active[i] = 0;
+        s->buffers[i] = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxBlockSize, m);
+        s->jobs[i] = i;
+    }
+    s->numSamples = 0;
+
+    s->deadline = 0.0f;
+    s->fallbackBlocks = 64;
+    s->fallbackCount = 0;
+    s->missedDeadlines = 0;
+}
+
+void tVoiceScheduler_free(tVoiceScheduler** const vs)
+{
+    tVoiceScheduler* s = *vs;
+
+    tJobPool_free(&s->pool);
+
+    for (int i = 0; i < s->numVoices; i++) mpool_free((char*)s->buffers[i], s->mempool);
+    mpool_free((char*)s->jobs, s->mempool);
+    mpool_free((char*)s->buffers, s->mempool);
+    mpool_free((char*)s->active, s->mempool);
+    mpool_free((char*)s->userData, s->mempool);
+    mpool_free((char*)s->render, s->mempool);
+    mpool_free((char*)s, s->mempool);
+}
+
+void tVoiceScheduler_render(tVoiceScheduler* const s, Lfloat* output, int numSamples)
+{
+    if (numSamples > s->maxBlockSize) numSamples = s->maxBlockSize;
+    s->numSamples = numSamples;
+
+    int numJobs = 0;
+    for (int v = 0; v < s->numVoices; v++)
+    {
+        if (s->active[v] && s->render[v] != NULL) s->jobs[numJobs++] = v;
+    }
+
+    if (s->fallbackCount > 0)
+    {
+        s->fallbackCount--;
+        for (int j = 0; j < numJobs; j++) tVoiceScheduler_renderJob(s, j);
+    }
+    else if (tJobPool_run(s->pool, tVoiceScheduler_renderJob, s, numJobs, s->deadline))
+    {
+        s->missedDeadlines++;
+        s->fallbackCount = s->fallbackBlocks;
+    }
+
+    // Fixed summation order keeps the mix independent of thread timing
+    for (int i = 0; i < numSamples; i++) output[i] = 0.0f;
+    for (int j = 0; j < numJobs; j++)
+    {
+        Lfloat* buff = s->buffers[s->jobs[j]];
+        for (int i = 0; i < numSamples; i++) output[i] += buff[i];
+    }
+}
+
+void tVoiceScheduler_setVoice(tVoiceScheduler* const s, int voice, tVoiceRenderCallback render, void* userData)
+{
+    if (voice < 0 || voice >= s->numVoices) return;
+    s->render[voice] = render;
+    s->userData[voice] = userData;
+    s->active[voice] = 1;
+}
+
+void tVoiceScheduler_setVoiceActive(tVoiceScheduler* const s, int voice, int active)
+{
+    if (voice < 0 || voice >= s->numVoices) return;
+    s->active[voice] = active;
+}
+
+void tVoiceScheduler_setDeadline(tVoiceScheduler* const s, Lfloat seconds)
+{
+    s->deadline = seconds < 0.0f ? 0.0f : seconds;
+}
+
+void tVoiceScheduler_setFallbackBlocks(tVoiceScheduler* const s, int numBlocks)
+{
+    s->fallbackBlocks = numBlocks < 0 ? 0 : numBlocks;
+}
+
+int tVoiceScheduler_getMissedDeadlines(tVoiceScheduler* const s)
+{
+    return s->missedDeadlines;
+}
+
+Lfloat* tVoiceScheduler_getVoiceBuffer(tVoiceScheduler* const s, int voice)
+{
+    return s->buffers[voice];
+}
+
+// ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Graph ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
+
+// Buffer 0 is always silent and feeds unconnected inputs,
+// buffers 1 to numInputs hold the external inputs.
+#define GRAPH_ZERO_BUFFER 0
+
+void tGraph_init(tGraph** const gr, int maxNodes, int maxEdges, int numInputs, int numOutputs, int maxBlockSize, int numWorkers, LEAF* const leaf)
+{
+    tGraph_initToPool(gr, maxNodes, maxEdges, numInputs, numOutputs, maxBlockSize, numWorkers, &leaf->mempool);
+}
+
+void tGraph_initToPool(tGraph** const gr, int maxNodes, int maxEdges, int numInputs, int numOutputs, int maxBlockSize, int numWorkers, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tGraph* g = *gr = (tGraph*) mpool_alloc(sizeof(tGraph), m);
+    g->mempool = m;
+
+    tJobPool_initToPool(&g->pool, numWorkers, mp);
+
+    g->maxNodes = maxNodes;
+    g->numNodes = 0;
+    g->maxEdges = maxEdges;
+    g->numEdges = 0;
+    g->numInputs = numInputs;
+    g->numOutputs = numOutputs;
+    g->maxBlockSize = maxBlockSize;
+
+    g->nodes = (_tGraphNode*) mpool_alloc(sizeof(_tGraphNode) * maxNodes, m);
+    g->edges = (_tGraphEdge*) mpool_alloc(sizeof(_tGraphEdge) * maxEdges, m);
+
+    g->compiled = 0;
+    g->numLevels = 0;
+    g->order = (int*) mpool_alloc(sizeof(int) * maxNodes, m);
+    g->levelStart = (int*) mpool_alloc(sizeof(int) * (maxNodes + 1), m);
+    g->sources = (int*) mpool_alloc(sizeof(int) * maxEdges, m);
+    g->outputSourceStart = (int*) mpool_alloc(sizeof(int) * numOutputs, m);
+    g->numOutputSources = (int*) mpool_alloc(sizeof(int) * numOutputs, m);
+    // Worst case is every port of every node holding its own buffer
+    g->lastUse = (int*) mpool_alloc(sizeof(int) * (1 + numInputs + maxNodes * LEAF_GRAPH_MAX_PORTS * 2), m);
+    g->numBuffers = 0;
+    g->bufferMemory = NULL;
+
+    g->currentLevel = 0;
+    g->numSamples = 0;
+}
+
+void tGraph_free(tGraph** const gr)
+{
+    tGraph* g = *gr;
+
+    tJobPool_free(&g->pool);
+
+    if (g->bufferMemory != NULL) mpool_free((char*)g->bufferMemory, g->mempool);
+    mpool_free((char*)g->lastUse, g->mempool);
+    mpool_free((char*)g->numOutputSources, g->mempool);
+    mpool_free((char*)g->outputSourceStart, g->mempool);
+    mpool_free((char*)g->sources, g->mempool);
+    mpool_free((char*)g->levelStart, g->mempool);
+    mpool_free((char*)g->order, g->mempool);
+    mpool_free((char*)g->edges, g->mempool);
+    mpool_free((char*)g->nodes, g->mempool);
+    mpool_free((char*)g, g->mempool);
+}
+
+// Claims the next node slot with no functions set, or returns NULL if there is none
+static _tGraphNode* tGraph_newNode(tGraph* const g, void* object, int numInputs, int numOutputs)
+{
+    if (g->numNodes >= g->maxNodes) return NULL;
+    if (numInputs < 0 || numInputs > LEAF_GRAPH_MAX_PORTS) return NULL;
+    if (numOutputs < 0 || numOutputs > LEAF_GRAPH_MAX_PORTS) return NULL;
+
+    _tGraphNode* n = &g->nodes[g->numNodes++];
+    n->object = object;
+    n->process = NULL;
+    n->tick = NULL;
+    n->tickIn = NULL;
+    n->numInputs = numInputs;
+    n->numOutputs = numOutputs;
+    n->level = 0;
+
+    g->compiled = 0;
+    return n;
+}
+
+int tGraph_addNode(tGraph* const g, void* object, int numInputs, int numOutputs, tGraphProcessFunction process)
+{
+    if (process == NULL) return -1;
+
+    _tGraphNode* n = tGraph_newNode(g, object, numInputs, numOutputs);
+    if (n == NULL) return -1;
+    n->process = process;
+    return (int) (n - g->nodes);
+}
+
+int tGraph_addGenerator(tGraph* const g, void* object, tGraphTickFunction tick)
+{
+    if (tick == NULL) return -1;
+
+    _tGraphNode* n = tGraph_newNode(g, object, 0, 1);
+    if (n == NULL) return -1;
+    n->tick = tick;
+    return (int) (n - g->nodes);
+}
+
+int tGraph_addProcessor(tGraph* const g, void* object, tGraphTickInFunction tick)
+{
+    if (tick == NULL) return -1;
+
+    _tGraphNode* n = tGraph_newNode(g, object, 1, 1);
+    if (n == NULL) return -1;
+    n->tickIn = tick;
+    return (int) (n - g->nodes);
+}
+
+int tGraph_connect(tGraph* const g, int source, int sourcePort, int dest, int destPort)
+{
+    if (g->numEdges >= g->maxEdges) return -1;
+
+    if (source == LEAF_GRAPH_IO)
+    {
+        if (sourcePort < 0 || sourcePort >= g->numInputs) return -1;
+    }
+    else if (source < 0 || source >= g->numNodes ||
+             sourcePort < 0 || sourcePort >= g->nodes[source].numOutputs) return -1;
+
+    if (dest == LEAF_GRAPH_IO)
+    {
+        if (destPort < 0 || destPort >= g->numOutputs) return -1;
+    }
+    else if (dest < 0 || dest >= g->numNodes ||
+             destPort < 0 || destPort >= g->nodes[dest].numInputs) return -1;
+
+    _tGraphEdge* e = &g->edges[g->numEdges];
+    e->source = source;
+    e->sourcePort = sourcePort;
+    e->dest = dest;
+    e->destPort = destPort;
+
+    g->compiled = 0;
+    return g->numEdges++;
+}
+
+static int tGraph_sourceBuffer(tGraph* const g, const _tGraphEdge* e)
+{
+    if (e->source == LEAF_GRAPH_IO) return 1 + e->sourcePort;
+    return g->nodes[e->source].outputBuffer[e->sourcePort];
+}
+
+// Lowest buffer that is free at this level, or a new one
+static int tGraph_allocBuffer(tGraph* const g, int level, int lastUse)
+{
+    int b;
+    for (b = 1 + g->numInputs; b < g->numBuffers; b++)
+    {
+        if (g->lastUse[b] < level) break;
+    }
+    if (b == g->numBuffers) g->numBuffers++;
+    g->lastUse[b] = lastUse;
+    return b;
+}
+
+int tGraph_compile(tGraph* const g)
+{
+    g->compiled = 0;
+
+    // Level of a node is the longest path to it. If levels are still
+    // changing after numNodes passes, the graph has a cycle.
+    for (int i = 0; i < g->numNodes; i++) g->nodes[i].level = 0;
+    int changed = 1;
+    for (int pass = 0; changed; pass++)
+    {
+        if (pass > g->numNodes) return -1;
+        changed = 0;
+        for (int i = 0; i < g->numEdges; i++)
+        {
+            _tGraphEdge* e = &g->edges[i];
+            if (e->source == LEAF_GRAPH_IO || e->dest == LEAF_GRAPH_IO) continue;
+            if (g->nodes[e->dest].level <= g->nodes[e->source].level)
+            {
+                g->nodes[e->dest].level = g->nodes[e->source].level + 1;
+                changed = 1;
+            }
+        }
+    }
+
+    g->numLevels = 0;
+    for (int i = 0; i < g->numNodes; i++)
+    {
+        if (g->nodes[i].level + 1 > g->numLevels) g->numLevels = g->nodes[i].level + 1;
+    }
+
+    // Counting sort by level, stable in node order
+    for (int l = 0; l <= g->numLevels; l++) g->levelStart[l] = 0;
+    for (int i = 0; i < g->numNodes; i++) g->levelStart[g->nodes[i].level + 1]++;
+    for (int l = 1; l <= g->numLevels; l++) g->levelStart[l] += g->levelStart[l - 1];
+    for (int i = 0; i < g->numNodes; i++) g->order[g->levelStart[g->nodes[i].level]++] = i;
+    for (int l = g->numLevels; l > 0; l--) g->levelStart[l] = g->levelStart[l - 1];
+    g->levelStart[0] = 0;
+
+    // Count the sources of every input port
+    for (int i = 0; i < g->numNodes; i++)
+    {
+        for (int p = 0; p < g->nodes[i].numInputs; p++) g->nodes[i].numSources[p] = 0;
+    }
+    for (int o = 0; o < g->numOutputs; o++) g->numOutputSources[o] = 0;
+    for (int i = 0; i < g->numEdges; i++)
+    {
+        _tGraphEdge* e = &g->edges[i];
+        if (e->dest == LEAF_GRAPH_IO) g->numOutputSources[e->destPort]++;
+        else g->nodes[e->dest].numSources[e->destPort]++;
+    }
+
+    // Assign buffers level by level. A buffer is free again once the last level
+    // that reads it has run; external outputs are read after the last level.
+    g->numBuffers = 1 + g->numInputs;
+    for (int b = 0; b < g->numBuffers; b++) g->lastUse[b] = INT_MAX;
+    for (int l = 0; l < g->numLevels; l++)
+    {
+        for (int k = g->levelStart[l]; k < g->levelStart[l + 1]; k++)
+        {
+            _tGraphNode* n = &g->nodes[g->order[k]];
+
+            for (int p = 0; p < n->numInputs; p++)
+            {
+                if (n->numSources[p] > 1) n->inputBuffer[p] = tGraph_allocBuffer(g, l, l);
+            }
+
+            for (int p = 0; p < n->numOutputs; p++)
+            {
+                int lastUse = l;
+                for (int i = 0; i < g->numEdges; i++)
+                {
+                    _tGraphEdge* e = &g->edges[i];
+                    if (e->source != g->order[k] || e->sourcePort != p) continue;
+                    if (e->dest == LEAF_GRAPH_IO) lastUse = g->numLevels;
+                    else if (g->nodes[e->dest].level > lastUse) lastUse = g->nodes[e->dest].level;
+                }
+                n->outputBuffer[p] = tGraph_allocBuffer(g, l, lastUse);
+            }
+        }
+    }
+
+    // Resolve the source lists now that every output has a buffer
+    int numSources = 0;
+    for (int i = 0; i < g->numNodes; i++)
+    {
+        _tGraphNode* n = &g->nodes[i];
+        for (int p = 0; p < n->numInputs; p++)
+        {
+            n->sourceStart[p] = numSources;
+            for (int j = 0; j < g->numEdges; j++)
+            {
+                _tGraphEdge* e = &g->edges[j];
+                if (e->dest == i && e->destPort == p) g->sources[numSources++] = tGraph_sourceBuffer(g, e);
+            }
+            if (n->numSources[p] == 0) n->inputBuffer[p] = GRAPH_ZERO_BUFFER;
+            else if (n->numSources[p] == 1) n->inputBuffer[p] = g->sources[n->sourceStart[p]];
+        }
+    }
+    for (int o = 0; o < g->numOutputs; o++)
+    {
+        g->outputSourceStart[o] = numSources;
+        for (int j = 0; j < g->numEdges; j++)
+        {
+            _tGraphEdge* e = &g->edges[j];
+            if (e->dest == LEAF_GRAPH_IO && e->destPort == o) g->sources[numSources++] = tGraph_sourceBuffer(g, e);
+        }
+    }
+
+    if (g->bufferMemory != NULL) mpool_free((char*)g->bufferMemory, g->mempool);
+    g->bufferMemory = (Lfloat*) mpool_calloc(sizeof(Lfloat) * g->numBuffers * g->maxBlockSize, g->mempool);
+    if (g->bufferMemory == NULL) return -1;
+
+    for (int i = 0; i < g->numNodes; i++)
+    {
+        _tGraphNode* n = &g->nodes[i];
+        for (int p = 0; p < n->numInputs; p++) n->inputs[p] = &g->bufferMemory[n->inputBuffer[p] * g->maxBlockSize];
+        for (int p = 0; p < n->numOutputs; p++) n->outputs[p] = &g->bufferMemory[n->outputBuffer[p] * g->maxBlockSize];
+    }
+
+    g->compiled = 1;
+    return g->numBuffers;
+}
+
+static void tGraph_runNode(tGraph* const g, _tGraphNode* const n)
+{
+    int numSamples = g->numSamples;
+
+    for (int p = 0; p < n->numInputs; p++)
+    {
+        if (n->numSources[p] < 2) continue;
+        Lfloat* mix = n->inputs[p];
+        int* src = &g->sources[n->sourceStart[p]];
+        Lfloat* first = &g->bufferMemory[src[0] * g->maxBlockSize];
+        for (int i = 0; i < numSamples; i++) mix[i] = first[i];
+        for (int s = 1; s < n->numSources[p]; s++)
+        {
+            Lfloat* buff = &g->bufferMemory[src[s] * g->maxBlockSize];
+            for (int i = 0; i < numSamples; i++) mix[i] += buff[i];
+        }
+    }
+
+    if (n->tickIn != NULL)
+    {
+        Lfloat* in = n->inputs[0];
+        Lfloat* out = n->outputs[0];
+        for (int i = 0; i < numSamples; i++) out[i] = n->tickIn(n->object, in[i]);
+    }
+    else if (n->tick != NULL)
+    {
+        Lfloat* out = n->outputs[0];
+        for (int i = 0; i < numSamples; i++) out[i] = n->tick(n->object);
+    }
+    else n->process(n->object, n->inputs, n->outputs, numSamples);
+}
+
+static void tGraph_levelJob(void* context, int j)
+{
+    tGraph* g = (tGraph*) context;
+    tGraph_runNode(g, &g->nodes[g->order[g->levelStart[g->currentLevel] + j]]);
+}
+
+void tGraph_process(tGraph* const g, Lfloat** inputs, Lfloat** outputs, int numSamples)
+{
+    if (numSamples > g->maxBlockSize) numSamples = g->maxBlockSize;
+
+    if (!g->compiled)
+    {
+        for (int o = 0; o < g->numOutputs; o++)
+        {
+            for (int i = 0; i < numSamples; i++) outputs[o][i] = 0.0f;
+        }
+        return;
+    }
+
+    g->numSamples = numSamples;
+
+    for (int c = 0; c < g->numInputs; c++)
+    {
+        Lfloat* buff = &g->bufferMemory[(1 + c) * g->maxBlockSize];
+        for (int i = 0; i < numSamples; i++) buff[i] = inputs[c][i];
+    }
+
+    for (int l = 0; l < g->numLevels; l++)
+    {
+        g->currentLevel = l;
+        tJobPool_run(g->pool, tGraph_levelJob, g, g->levelStart[l + 1] - g->levelStart[l], 0.0f);
+    }
+
+    for (int o = 0; o < g->numOutputs; o++)
+    {
+        for (int i = 0; i < numSamples; i++) outputs[o][i] = 0.0f;
+        for (int s = 0; s < g->numOutputSources[o]; s++)
+        {
+            Lfloat* buff = &g->bufferMemory[g->sources[g->outputSourceStart[o] + s] * g->maxBlockSize];
+            for (int i = 0; i < numSamples; i++) outputs[o][i] += buff[i];
+        }
+    }
+}
@@ -3621,7 +3621,7 @@ Lfloat   tStiffString_tick                  (tStiffString* const p)
     for (int i = 0; i < p->numModes; ++i) {
       //sample += tDampedOscillator_tick(p->osc[i]) * p->amplitudes[i] * p->outputWeights[i];
       sample += tCycle_tick(p->oscs[i]) * p->amplitudes[i] * p->outputWeights[i] * p->decayVal[i] * p->nyquistCoeff[i];
-      p->decayVal[i] *= p->decayScalar[i] * p->muteDecay;
+      p->decayVal[i] = LEAF_flushDenormal(p->decayVal[i] * p->decayScalar[i] * p->muteDecay);
     }
     return sample * p->amp * p->gainComp;
 }
@@ -105,18 +105,18 @@ Lfloat   tPRCReverb_tick(tPRCReverb* const r, Lfloat input)
     temp = tDelay_getLastOut(r->allpassDelays[0]);
     temp0 = r->allpassCoeff * temp;
     temp0 += input;
-    tDelay_tick(r->allpassDelays[0], temp0);
+    tDelay_tick(r->allpassDelays[0], LEAF_flushDenormal(temp0));
     temp0 = -(r->allpassCoeff * temp0) + temp;
     
     temp = tDelay_getLastOut(r->allpassDelays[1]);
     temp1 = r->allpassCoeff * temp;
     temp1 += temp0;
-    tDelay_tick(r->allpassDelays[1], temp1);
+    tDelay_tick(r->allpassDelays[1], LEAF_flushDenormal(temp1));
     temp1 = -(r->allpassCoeff * temp1) + temp;
     
     temp2 = temp1 + ( r->combCoeff * tDelay_getLastOut(r->combDelay));
     
-    out = r->mix * tDelay_tick(r->combDelay, temp2);
+    out = r->mix * tDelay_tick(r->combDelay, LEAF_flushDenormal(temp2));
     
     temp = (1.0f - r->mix) * input;
     
@@ -267,7 +267,7 @@ Lfloat   tNReverb_tick(tNReverb* const r, Lfloat input)
     for ( i=0; i<6; i++ )
     {
         temp = input + (r->combCoeffs[i] * tLinearDelay_getLastOut(r->combDelays[i]));
-        temp0 += tLinearDelay_tick(r->combDelays[i],temp);
+        temp0 += tLinearDelay_tick(r->combDelays[i], LEAF_flushDenormal(temp));
     }
     
     for ( i=0; i<3; i++ )
@@ -275,23 +275,23 @@ Lfloat   tNReverb_tick(tNReverb* const r, Lfloat input)
         temp = tLinearDelay_getLastOut(r->allpassDelays[i]);
         temp1 = r->allpassCoeff * temp;
         temp1 += temp0;
-        tLinearDelay_tick(r->allpassDelays[i], temp1);
+        tLinearDelay_tick(r->allpassDelays[i], LEAF_flushDenormal(temp1));
         temp0 = -(r->allpassCoeff * temp1) + temp;
     }
     
     // One-pole lowpass filter.
-    r->lowpassState = 0.7f * r->lowpassState + 0.3f * temp0;
+    r->lowpassState = LEAF_flushDenormal(0.7f * r->lowpassState + 0.3f * temp0);
 
     temp = tLinearDelay_getLastOut(r->allpassDelays[3]);
     temp1 = r->allpassCoeff * temp;
     temp1 += r->lowpassState;
-    tLinearDelay_tick(r->allpassDelays[3], temp1 );
+    tLinearDelay_tick(r->allpassDelays[3], LEAF_flushDenormal(temp1));
     temp1 = -(r->allpassCoeff * temp1) + temp;
     
     temp = tLinearDelay_getLastOut(r->allpassDelays[4]);
     temp2 = r->allpassCoeff * temp;
     temp2 += temp1;
-    tLinearDelay_tick(r->allpassDelays[4], temp2 );
+    tLinearDelay_tick(r->allpassDelays[4], LEAF_flushDenormal(temp2));
     out = -( r->allpassCoeff * temp2 ) + temp ;
     
     //the other channel in stereo version below
@@ -299,7 +299,7 @@ Lfloat   tNReverb_tick(tNReverb* const r, Lfloat input)
      temp = tLinearDelay_getLastOut(r->allpassDelays[5]);
      temp3 = r->allpassCoeff * temp;
      temp3 += temp1;
-     tLinearDelay_tick(r->allpassDelays[5], temp3 );
+     tLinearDelay_tick(r->allpassDelays[5], LEAF_flushDenormal(temp3));
      out = r->mix *( - ( r->allpassCoeff * temp3 ) + temp );
 */
 
@@ -323,7 +323,7 @@ void   tNReverb_tickStereo(tNReverb* const r, Lfloat input, Lfloat* output)
     for ( i=0; i<6; i++ )
     {
         temp = input + (r->combCoeffs[i] * tLinearDelay_getLastOut(r->combDelays[i]));
-        temp0 += tLinearDelay_tick(r->combDelays[i],temp);
+        temp0 += tLinearDelay_tick(r->combDelays[i], LEAF_flushDenormal(temp));
     }
 
     for ( i=0; i<3; i++ )
@@ -331,17 +331,17 @@ void   tNReverb_tickStereo(tNReverb* const r, Lfloat input, Lfloat* output)
         temp = tLinearDelay_getLastOut(r->allpassDelays[i]);
         temp1 = r->allpassCoeff * temp;
         temp1 += temp0;
-        tLinearDelay_tick(r->allpassDelays[i], temp1);
+        tLinearDelay_tick(r->allpassDelays[i], LEAF_flushDenormal(temp1));
         temp0 = -(r->allpassCoeff * temp1) + temp;
     }
 
     // One-pole lowpass filter.
-    r->lowpassState = 0.7f * r->lowpassState + 0.3f * temp0;
+    r->lowpassState = LEAF_flushDenormal(0.7f * r->lowpassState + 0.3f * temp0);
 
     temp = tLinearDelay_getLastOut(r->allpassDelays[3]);
     temp1 = r->allpassCoeff * temp;
     temp1 += r->lowpassState;
-    tLinearDelay_tick(r->allpassDelays[3], temp1 );
+    tLinearDelay_tick(r->allpassDelays[3], LEAF_flushDenormal(temp1));
     temp1 = -(r->allpassCoeff * temp1) + temp;
 
     Lfloat drymix = ( 1.0f - r->mix ) * input;
@@ -349,14 +349,14 @@ void   tNReverb_tickStereo(tNReverb* const r, Lfloat input, Lfloat* output)
     temp = tLinearDelay_getLastOut(r->allpassDelays[4]);
     temp2 = r->allpassCoeff * temp;
     temp2 += temp1;
-    tLinearDelay_tick(r->allpassDelays[4], temp2 );
+    tLinearDelay_tick(r->allpassDelays[4], LEAF_flushDenormal(temp2));
     output[0] = -( r->allpassCoeff * temp2 ) + temp + drymix;
     out = output[0];
 
     temp = tLinearDelay_getLastOut(r->allpassDelays[5]);
     temp3 = r->allpassCoeff * temp;
     temp3 += temp1;
-    tLinearDelay_tick(r->allpassDelays[5], temp3 );
+    tLinearDelay_tick(r->allpassDelays[5], LEAF_flushDenormal(temp3));
     output[1] = r->mix *( - ( r->allpassCoeff * temp3 ) + temp + drymix);
 
     r->lastOut = out;
@@ -559,7 +559,7 @@ Lfloat   tDattorroReverb_tick              (tDattorroReverb* const r, Lfloat inp
 
     f1_sample = f1_sample + r->f1_delay_2_last * 0.5f;
 
-    f1_delay_2_sample = tTapeDelay_tick(r->f1_delay_2, f1_sample * 0.5f);
+    f1_delay_2_sample = tTapeDelay_tick(r->f1_delay_2, LEAF_flushDenormal(f1_sample * 0.5f));
 
     r->f1_delay_2_last = f1_delay_2_sample;
 
@@ -567,7 +567,7 @@ Lfloat   tDattorroReverb_tick              (tDattorroReverb* const r, Lfloat inp
 
     f1_sample = tHighpass_tick(r->f1_hp, f1_sample);
 
-    f1_sample *= r->feedback_gain;
+    f1_sample = LEAF_flushDenormal(f1_sample * r->feedback_gain);
 
     r->f1_last = tTapeDelay_tick(r->f1_delay_3, f1_sample);
 
@@ -584,7 +584,7 @@ Lfloat   tDattorroReverb_tick              (tDattorroReverb* const r, Lfloat inp
 
     f2_sample = f2_sample + r->f2_delay_2_last * 0.5f;
 
-    f2_delay_2_sample = tTapeDelay_tick(r->f2_delay_2, f2_sample * 0.5f);
+    f2_delay_2_sample = tTapeDelay_tick(r->f2_delay_2, LEAF_flushDenormal(f2_sample * 0.5f));
 
     r->f2_delay_2_last = f2_delay_2_sample;
 
@@ -592,7 +592,7 @@ Lfloat   tDattorroReverb_tick              (tDattorroReverb* const r, Lfloat inp
 
     f2_sample = tHighpass_tick(r->f2_hp, f2_sample);
 
-    f2_sample *= r->feedback_gain;
+    f2_sample = LEAF_flushDenormal(f2_sample * r->feedback_gain);
 
     r->f2_last = tTapeDelay_tick(r->f2_delay_3, f2_sample);
     
@@ -666,7 +666,7 @@ void   tDattorroReverb_tickStereo              (tDattorroReverb* const r, Lfloat
     
     f1_sample = f1_sample + r->f1_delay_2_last * 0.5f;
     
-    f1_delay_2_sample = tTapeDelay_tick(r->f1_delay_2, f1_sample * 0.5f);
+    f1_delay_2_sample = tTapeDelay_tick(r->f1_delay_2, LEAF_flushDenormal(f1_sample * 0.5f));
     
     r->f1_delay_2_last = f1_delay_2_sample;
     
@@ -674,7 +674,7 @@ void   tDattorroReverb_tickStereo              (tDattorroReverb* const r, Lfloat
     
     f1_sample = tHighpass_tick(r->f1_hp, f1_sample);
     
-    f1_sample *= r->feedback_gain;
+    f1_sample = LEAF_flushDenormal(f1_sample * r->feedback_gain);
     
     if (r->frozen)
     {
@@ -696,7 +696,7 @@ void   tDattorroReverb_tickStereo              (tDattorroReverb* const r, Lfloat
     
     f2_sample = f2_sample + r->f2_delay_2_last * 0.5f;
     
-    f2_delay_2_sample = tTapeDelay_tick(r->f2_delay_2, f2_sample * 0.5f);
+    f2_delay_2_sample = tTapeDelay_tick(r->f2_delay_2, LEAF_flushDenormal(f2_sample * 0.5f));
     
     r->f2_delay_2_last = f2_delay_2_sample;
     
@@ -704,7 +704,7 @@ void   tDattorroReverb_tickStereo              (tDattorroReverb* const r, Lfloat
     
     f2_sample = tHighpass_tick(r->f2_hp, f2_sample);
     
-    f2_sample *= r->feedback_gain;
+    f2_sample = LEAF_flushDenormal(f2_sample * r->feedback_gain);
     
     if (r->frozen)
     {
@@ -22,21 +22,129 @@
 
 #endif
 
+#if LEAF_USE_FILE_STREAMING
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if LEAF_USE_THREADS
+#include <time.h>
+#endif
+#endif
+
 //==============================================================================
 
+// Full scale of the integer formats, used both ways so that stored values read back
+// and write again unchanged. +1.0 clips to the largest positive code.
+#define BUFFER_INT16_RANGE 32768.0f
+#define BUFFER_INT24_RANGE 8388608.0f
+#define BUFFER_INT16_SCALE (1.0f / BUFFER_INT16_RANGE)
+#define BUFFER_INT24_SCALE (1.0f / BUFFER_INT24_RANGE)
+
+static size_t bufferSampleSize(BufferFormat format)
+{
+    if (format == BufferInt16) return sizeof(int16_t);
+    if (format == BufferInt24) return 3;
+    return sizeof(Lfloat);
+}
+
+static inline int32_t readInt24(const uint8_t* p)
+{
+    return (int32_t) ((uint32_t) p[0] << 8 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 24) >> 8;
+}
+
+static inline Lfloat bufferRead(tBuffer* const s, int i)
+{
+    if (s->format == BufferInt16) return ((int16_t*) s->buff)[i] * BUFFER_INT16_SCALE;
+    if (s->format == BufferInt24) return readInt24((uint8_t*) s->buff + 3 * i) * BUFFER_INT24_SCALE;
+    return s->buff[i];
+}
+
+static inline void bufferWrite(tBuffer* const s, int i, Lfloat sample)
+{
+    if (s->format == BufferInt16)
+    {
+        int32_t v = (int32_t) lrintf(LEAF_clip(-1.0f, sample, 1.0f) * BUFFER_INT16_RANGE);
+        ((int16_t*) s->buff)[i] = (int16_t) (v > 32767 ? 32767 : v);
+    }
+    else if (s->format == BufferInt24)
+    {
+        int32_t v = (int32_t) lrintf(LEAF_clip(-1.0f, sample, 1.0f) * BUFFER_INT24_RANGE);
+        if (v > 8388607) v = 8388607;
+        uint8_t* d = (uint8_t*) s->buff + 3 * i;
+        d[0] = (uint8_t) v;
+        d[1] = (uint8_t) (v >> 8);
+        d[2] = (uint8_t) (v >> 16);
+    }
+    else s->buff[i] = sample;
+}
+
+// Hermite read for the samplers. The interpolation is linear in the taps, so the
+// integer formats are interpolated as they are stored and converted with one multiply.
+static inline Lfloat bufferHermite(tBuffer* const s, int i1, int i2, int i3, int i4,
+                                   int stride, int channel, Lfloat alpha)
+{
+    i1 = i1 * stride + channel;
+    i2 = i2 * stride + channel;
+    i3 = i3 * stride + channel;
+    i4 = i4 * stride + channel;
+    
+    if (s->format == BufferInt16)
+    {
+        int16_t* d = (int16_t*) s->buff;
+        return LEAF_interpolate_hermite_x(d[i1], d[i2], d[i3], d[i4], alpha) * BUFFER_INT16_SCALE;
+    }
+    if (s->format == BufferInt24)
+    {
+        uint8_t* d = (uint8_t*) s->buff;
+        return LEAF_interpolate_hermite_x(readInt24(d + 3 * i1), readInt24(d + 3 * i2),
+                                          readInt24(d + 3 * i3), readInt24(d + 3 * i4),
+                                          alpha) * BUFFER_INT24_SCALE;
+    }
+    Lfloat* d = s->buff;
+    return LEAF_interpolate_hermite_x(d[i1], d[i2], d[i3], d[i4], alpha);
+}
+
+static inline Lfloat bufferLerp(tBuffer* const s, int i, Lfloat f)
+{
+    if (s->format == BufferInt16)
+    {
+        int16_t* d = (int16_t*) s->buff;
+        return (d[i] * (1.0f - f) + d[i+1] * f) * BUFFER_INT16_SCALE;
+    }
+    if (s->format == BufferInt24)
+    {
+        uint8_t* d = (uint8_t*) s->buff + 3 * i;
+        return (readInt24(d) * (1.0f - f) + readInt24(d + 3) * f) * BUFFER_INT24_SCALE;
+    }
+    return s->buff[i] * (1.0f - f) + s->buff[i+1] * f;
+}
+
 void  tBuffer_init(tBuffer** const sb, uint32_t length, LEAF* const leaf)
 {
     tBuffer_initToPool(sb, length, &leaf->mempool);
 }
 
 void  tBuffer_initToPool (tBuffer** const sb, uint32_t length, tMempool** const mp)
+{
+    tBuffer_initWithFormatToPool(sb, length, BufferFloat, mp);
+}
+
+void  tBuffer_initWithFormat(tBuffer** const sb, uint32_t length, BufferFormat format, LEAF* const leaf)
+{
+    tBuffer_initWithFormatToPool(sb, length, format, &leaf->mempool);
+}
+
+void  tBuffer_initWithFormatToPool (tBuffer** const sb, uint32_t length, BufferFormat format, tMempool** const mp)
 {
     tMempool* m = *mp;
     tBuffer* s = *sb = (tBuffer*) mpool_alloc(sizeof(tBuffer), m);
     s->mempool = m;
     LEAF* leaf = s->mempool->leaf;
     
-    s->buff = (Lfloat*) mpool_alloc( sizeof(Lfloat) * length, m);
+    if (format >= BufferFormatNil) format = BufferFloat;
+    s->format = format;
+    s->buff = (Lfloat*) mpool_alloc(bufferSampleSize(format) * length, m);
     s->sampleRate = leaf->sampleRate;
     s->channels = 1;
     s->bufferLength = length;
@@ -44,13 +152,20 @@ void  tBuffer_initToPool (tBuffer** const sb, uint32_t length, tMempool** const
     s->active = 0;
     s->idx = 0;
     s->mode = RecordOneShot;
+    s->mapping = NULL;
+    s->mappingSize = 0;
+    s->preloadLength = 0;
 }
 
 void  tBuffer_free (tBuffer** const sb)
 {
     tBuffer* s = *sb;
     
-    mpool_free((char*)s->buff, s->mempool);
+#if LEAF_USE_FILE_STREAMING
+    if (s->mapping != NULL) munmap(s->mapping, s->mappingSize);
+    else
+#endif
+    if (s->buff != NULL) mpool_free((char*)s->buff, s->mempool);
     mpool_free((char*)s, s->mempool);
 }
 
@@ -58,7 +173,7 @@ void tBuffer_tick (tBuffer* const s, Lfloat sample)
 {
     if (s->active == 1)
     {
-        s->buff[s->idx] = sample;
+        bufferWrite(s, s->idx, sample);
         
         s->idx += 1;
         
@@ -79,10 +194,12 @@ void tBuffer_tick (tBuffer* const s, Lfloat sample)
 
 void  tBuffer_read(tBuffer* const s, Lfloat* buff, uint32_t len)
 {
+    if (s->mapping != NULL) return;     // file mappings are read-only
+    
     for (unsigned i = 0; i < s->bufferLength; i++)
     {
-        if (i < len)    s->buff[i] = buff[i];
-        else            s->buff[i] = 0.f;
+        if (i < len)    bufferWrite(s, i, buff[i]);
+        else            bufferWrite(s, i, 0.f);
     }
     s->recordedLength = len;
 }
@@ -90,11 +207,13 @@ void  tBuffer_read(tBuffer* const s, Lfloat* buff, uint32_t len)
 Lfloat tBuffer_get (tBuffer* const s, int idx)
 {
     if ((idx < 0) || (idx >= (int) s->bufferLength)) return 0.f;
-    return s->buff[idx];
+    return bufferRead(s, idx);
 }
 
 void  tBuffer_record(tBuffer* const s)
 {
+    if (s->mapping != NULL) return;
+    
     s->active = 1;
     s->idx = 0;
 }
@@ -121,22 +240,32 @@ void  tBuffer_setRecordMode (tBuffer* const s, RecordMode mode)
 
 void  tBuffer_clear (tBuffer* const s)
 {
-    for (unsigned i = 0; i < s->bufferLength; i++)
-    {
-        s->buff[i] = 0.f;
-    }
-
+    if (s->mapping != NULL) return;
+    
+    // All three formats store zero as all-zero bytes
+    memset(s->buff, 0, bufferSampleSize(s->format) * s->bufferLength);
 }
 
 void tBuffer_setBuffer(tBuffer* const s, Lfloat* externalBuffer, int length, int channels, int sampleRate)
 {
-    s->buff = externalBuffer;
+    tBuffer_setBufferWithFormat(s, externalBuffer, length, channels, sampleRate, BufferFloat);
+}
+
+void tBuffer_setBufferWithFormat(tBuffer* const s, void* externalBuffer, int length, int channels, int sampleRate, BufferFormat format)
+{
+    s->buff = (Lfloat*) externalBuffer;
+    s->format = format;
     s->channels = channels;
     s->sampleRate = sampleRate;
     s->recordedLength = length/channels;
     s->bufferLength = s->recordedLength;
 }
 
+BufferFormat tBuffer_getFormat(tBuffer* const s)
+{
+    return s->format;
+}
+
 uint32_t tBuffer_getBufferLength(tBuffer* const s)
 {
     return s->bufferLength;
@@ -157,6 +286,167 @@ int tBuffer_isActive(tBuffer* const s)
     return s->active;
 }
 
+int tBuffer_initFromFile(tBuffer** const sb, const char* path, uint32_t preloadLength, LEAF* const leaf)
+{
+    return tBuffer_initFromFileToPool(sb, path, preloadLength, &leaf->mempool);
+}
+
+#if LEAF_USE_FILE_STREAMING
+static uint32_t readLE32(const unsigned char* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t readLE16(const unsigned char* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Finds the sample data of a 32-bit float, 16-bit or 24-bit PCM WAV file. Returns 0 on success.
+static int parseWav(const unsigned char* data, size_t size, size_t* offset, size_t* length, uint32_t* channels, uint32_t* sampleRate, BufferFormat* bufferFormat)
+{
+    size_t pos = 12;
+    int haveFormat = 0;
+    
+    while (pos + 8 <= size)
+    {
+        uint32_t chunkSize = readLE32(data + pos + 4);
+        const unsigned char* chunk = data + pos + 8;
+        
+        if (memcmp(data + pos, "fmt ", 4) == 0 && chunkSize >= 16 && pos + 8 + 16 <= size)
+        {
+            uint16_t format = readLE16(chunk);
+            // WAVE_FORMAT_EXTENSIBLE keeps the real format at the start of the subformat GUID
+            if (format == 0xFFFE && chunkSize >= 40 && pos + 8 + 40 <= size) format = readLE16(chunk + 24);
+            uint16_t bits = readLE16(chunk + 14);
+            if (format == 3 && bits == 32) *bufferFormat = BufferFloat;
+            else if (format == 1 && bits == 16) *bufferFormat = BufferInt16;
+            else if (format == 1 && bits == 24) *bufferFormat = BufferInt24;
+            else return -1;
+            *channels = readLE16(chunk + 2);
+            *sampleRate = readLE32(chunk + 4);
+            haveFormat = 1;
+        }
+        else if (memcmp(data + pos, "data", 4) == 0)
+        {
+            if (!haveFormat || *channels == 0) return -1;
+            *offset = pos + 8;
+            *length = chunkSize;
+            if (*offset + *length > size) *length = size - *offset;
+            return 0;
+        }
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+    return -1;
+}
+#endif
+
+int tBuffer_initFromFileToPool(tBuffer** const sb, const char* path, uint32_t preloadLength, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tBuffer* s = *sb = (tBuffer*) mpool_alloc(sizeof(tBuffer), m);
+    s->mempool = m;
+    LEAF* leaf = s->mempool->leaf;
+    
+    s->buff = NULL;
+    s->format = BufferFloat;
+    s->sampleRate = leaf->sampleRate;
+    s->channels = 1;
+    s->bufferLength = 0;
+    s->recordedLength = 0;
+    s->active = 0;
+    s->idx = 0;
+    s->mode = RecordOneShot;
+    s->mapping = NULL;
+    s->mappingSize = 0;
+    s->preloadLength = 0;
+    
+#if LEAF_USE_FILE_STREAMING
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return -1;
+    }
+    
+    size_t size = (size_t) st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return -1;
+    
+    const unsigned char* data = (const unsigned char*) mapping;
+    size_t offset = 0;
+    size_t length = size;
+    uint32_t channels = 1;
+    uint32_t sampleRate = (uint32_t) leaf->sampleRate;
+    BufferFormat format = BufferFloat;
+    
+    if (size >= 12 && memcmp(data, "RIFF", 4) == 0 && memcmp(data + 8, "WAVE", 4) == 0)
+    {
+        if (parseWav(data, size, &offset, &length, &channels, &sampleRate, &format) != 0
+            || (offset % (format == BufferInt24 ? 1 : bufferSampleSize(format))))
+        {
+            munmap(mapping, size);
+            return -1;
+        }
+    }
+    
+    s->mapping = mapping;
+    s->mappingSize = size;
+    s->buff = (Lfloat*) (data + offset);
+    s->format = format;
+    s->channels = channels;
+    s->sampleRate = sampleRate;
+    s->bufferLength = (uint32_t) (length / (bufferSampleSize(format) * channels));
+    s->recordedLength = s->bufferLength;
+    
+    // Sequential readahead for the whole file, and the head read in right away
+    // so that note starts never wait on the disk
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    if (preloadLength > s->bufferLength) preloadLength = s->bufferLength;
+    s->preloadLength = preloadLength;
+    size_t preloadBytes = offset + (size_t) preloadLength * channels * bufferSampleSize(format);
+    if (preloadBytes > 0)
+    {
+        madvise(mapping, preloadBytes, MADV_WILLNEED);
+        long pageSize = sysconf(_SC_PAGESIZE);
+        volatile char sink = 0;
+        for (size_t i = 0; i < preloadBytes; i += (size_t) pageSize) sink += data[i];
+        (void) sink;
+    }
+    return 0;
+#else
+    (void) path;
+    (void) preloadLength;
+    return -1;
+#endif
+}
+
+int tBuffer_prefaultFile(tBuffer* const s, int lock)
+{
+#if LEAF_USE_FILE_STREAMING
+    if (s->mapping == NULL) return -1;
+    
+    // mlock() faults every page in itself; without it, touch each page once
+    if (lock) return (mlock(s->mapping, s->mappingSize) == 0) ? 0 : -1;
+    
+    const unsigned char* data = (const unsigned char*) s->mapping;
+    long pageSize = sysconf(_SC_PAGESIZE);
+    volatile char sink = 0;
+    madvise(s->mapping, s->mappingSize, MADV_WILLNEED);
+    for (size_t i = 0; i < s->mappingSize; i += (size_t) pageSize) sink += data[i];
+    (void) sink;
+    return 0;
+#else
+    (void) s;
+    (void) lock;
+    return -1;
+#endif
+}
+
 //================================tSampler=====================================
 
 static void handleStartEndChange(tSampler* const sp);
@@ -265,8 +555,6 @@ Lfloat tSampler_tick        (tSampler* const p)
     Lfloat flipsample = 0.0f;
     Lfloat flipMix = 0.0f;
     
-    Lfloat* buff = p->samp->buff;
-    
     // Variables so start is also before end
     int myStart = p->start;
     int myEnd = p->end;
@@ -300,11 +588,7 @@ Lfloat tSampler_tick        (tSampler* const p)
     i3 = (i3 < length*(1-rev)) ? i3 + (length * rev) : i3 - (length * (1-rev));
     i4 = (i4 < length*(1-rev)) ? i4 + (length * rev) : i4 - (length * (1-rev));
     
-    sample = LEAF_interpolate_hermite_x (buff[i1],
-                                         buff[i2],
-                                         buff[i3],
-                                         buff[i4],
-                                         alpha);
+    sample = bufferHermite(p->samp, i1, i2, i3, i4, 1, 0, alpha);
     
     int32_t cfxlen = p->cfxlen;
     if (p->len * 0.25f < cfxlen) cfxlen = p->len * 0.25f;
@@ -350,11 +634,7 @@ Lfloat tSampler_tick        (tSampler* const p)
             c3 = (c3 < length * (1-rev)) ? c3 + (length * rev) : c3 - (length * (1-rev));
             c4 = (c4 < length * (1-rev)) ? c4 + (length * rev) : c4 - (length * (1-rev));
             
-            cfxsample = LEAF_interpolate_hermite_x (buff[c1],
-                                                    buff[c2],
-                                                    buff[c3],
-                                                    buff[c4],
-                                                    alpha);
+            cfxsample = bufferHermite(p->samp, c1, c2, c3, c4, 1, 0, alpha);
             if (cfxlen > 0.0f) crossfadeMix = (Lfloat) offset / (Lfloat) cfxlen;
             else crossfadeMix = 0.0f;
         }
@@ -390,11 +670,7 @@ Lfloat tSampler_tick        (tSampler* const p)
             f3 = (f3 < length*rev) ? f3 + (length * (1-rev)) : f3 - (length * rev);
             f4 = (f4 < length*rev) ? f4 + (length * (1-rev)) : f4 - (length * rev);
             
-            flipsample = LEAF_interpolate_hermite_x (buff[f1],
-                                                     buff[f2],
-                                                     buff[f3],
-                                                     buff[f4],
-                                                     falpha);
+            flipsample = bufferHermite(p->samp, f1, f2, f3, f4, 1, 0, falpha);
             flipMix = (Lfloat) (cfxlen - flipLength) / (Lfloat) cfxlen;
         }
     }
@@ -503,6 +779,121 @@ Lfloat tSampler_tick        (tSampler* const p)
     return p->last;
 }
 
+// Whether a tick reading at integer position idx (already offset for reverse playback)
+// takes the straight path: no tap wrapping, no crossfade, no loop wrap and no note end.
+static inline int samplerIsStraight(tSampler* const p, int idx, int lo, int hi, int rev, int myStart, int myEnd)
+{
+    if ((idx < lo) || (idx > hi)) return 0;
+    if (p->mode == PlayNormal)
+    {
+        Lfloat ticksToEnd = rev ? ((idx - myStart) * p->iinc) : ((myEnd - idx) * p->iinc);
+        if (ticksToEnd < p->ticksPerSevenMs) return 0;
+    }
+    return 1;
+}
+
+void tSampler_tickBlock (tSampler* const p, Lfloat* output, int numSamples)
+{
+    int i = 0;
+    while (i < numSamples)
+    {
+        // Anything that changes the playback state mid-stream goes through tSampler_tick
+        if ((p->targetstart >= 0) || (p->targetend >= 0) || (p->active != 1) ||
+            (p->inc == 0.0f) || (p->len < 2) || (p->flipStart >= 0) ||
+            ((p->mode == PlayLoop) && (p->flipIdx >= 0)))
+        {
+            output[i++] = tSampler_tick(p);
+            continue;
+        }
+        
+        int myStart = p->start;
+        int myEnd = p->end;
+        if (p->flip < 0)
+        {
+            myStart = p->end;
+            myEnd = p->start;
+        }
+        
+        int dir = p->bnf * p->dir * p->flip;
+        int rev = 0;
+        if (dir < 0) rev = 1;
+        
+        int length = p->samp->recordedLength;
+        
+        // All four taps inside the buffer
+        int lo = 2;
+        int hi = length - 3;
+        if (p->mode == PlayLoop)
+        {
+            int32_t cfxlen = p->cfxlen;
+            if (p->len * 0.25f < cfxlen) cfxlen = p->len * 0.25f;
+            
+            int32_t fadeLeftStart = 0;
+            if (myStart >= cfxlen) fadeLeftStart = myStart - cfxlen;
+            int32_t fadeLeftEnd = fadeLeftStart + cfxlen;
+            int32_t fadeRightStart = myEnd - cfxlen;
+            
+            // Between the two crossfade regions
+            if (lo < fadeLeftEnd + 1) lo = fadeLeftEnd + 1;
+            if (hi > fadeRightStart - 1) hi = fadeRightStart - 1;
+        }
+        else
+        {
+            // Clear of the points where playback bounces or stops
+            if (lo < myStart + 1) lo = myStart + 1;
+            if (hi > myEnd - 1) hi = myEnd - 1;
+        }
+        
+        Lfloat step = dir * fmodf(p->inc, (Lfloat)p->len);
+        Lfloat x = p->idx;
+        
+        // A sample is rendered here only if both its own position and the one it
+        // advances to are straight, so the wrap and end checks after the advance are no-ops
+        int n = 0;
+        if (samplerIsStraight(p, (int) x + rev, lo, hi, rev, myStart, myEnd))
+        {
+            Lfloat y = x;
+            while (i + n < numSamples)
+            {
+                y += step;
+                if (!samplerIsStraight(p, (int) y + rev, lo, hi, rev, myStart, myEnd)) break;
+                n++;
+            }
+        }
+        if (n == 0)
+        {
+            output[i++] = tSampler_tick(p);
+            continue;
+        }
+        
+        Lfloat* out = &output[i];
+        tBuffer* b = p->samp;
+        for (int k = 0; k < n; k++)
+        {
+            int idx = (int) x;
+            Lfloat alpha = rev + (x - idx) * dir;
+            idx += rev;
+            out[k] = bufferHermite(b, idx-(1*dir), idx, idx+(1*dir), idx+(2*dir), 1, 0, alpha);
+            x += step;
+        }
+        
+        if (p->gain->inc == 0.0f)
+        {
+            Lfloat gain = tRamp_sample(p->gain);
+            for (int k = 0; k < n; k++) out[k] *= gain;
+        }
+        else
+        {
+            for (int k = 0; k < n; k++) out[k] *= tRamp_tick(p->gain);
+        }
+        
+        p->idx = x;
+        if (p->mode == PlayLoop) p->inCrossfade = 0;
+        p->last = out[n-1];
+        i += n;
+    }
+}
+
 Lfloat tSampler_tickStereo        (tSampler* const p, Lfloat* outputArray)
 {
     attemptStartEndChange(p);
@@ -520,8 +911,6 @@ Lfloat tSampler_tickStereo        (tSampler* const p, Lfloat* outputArray)
     Lfloat flipsample[2] = {0.0f, 0.0f};
     Lfloat flipMix = 0.0f;
 
-    Lfloat* buff = p->samp->buff;
-
     // Variables so start is also before end
     int myStart = p->start;
     int myEnd = p->end;
@@ -555,17 +944,9 @@ Lfloat tSampler_tickStereo        (tSampler* const p, Lfloat* outputArray)
     i3 = (i3 < length*(1-rev)) ? i3 + (length * rev) : i3 - (length * (1-rev));
     i4 = (i4 < length*(1-rev)) ? i4 + (length * rev) : i4 - (length * (1-rev));
 
-    outputArray[0] = LEAF_interpolate_hermite_x (buff[i1 * p->channels],
-                                         buff[i2 * p->channels],
-                                         buff[i3 * p->channels],
-                                         buff[i4 * p->channels],
-                                         alpha);
+    outputArray[0] = bufferHermite(p->samp, i1, i2, i3, i4, p->channels, 0, alpha);
 
-    outputArray[1] = LEAF_interpolate_hermite_x (buff[(i1 * p->channels) + 1],
-                                         buff[(i2 * p->channels) + 1],
-                                         buff[(i3 * p->channels) + 1],
-                                         buff[(i4 * p->channels) + 1],
-                                         alpha);
+    outputArray[1] = bufferHermite(p->samp, i1, i2, i3, i4, p->channels, 1, alpha);
 
     int32_t cfxlen = p->cfxlen;
     if (p->len * 0.25f < cfxlen) cfxlen = p->len * 0.25f;
@@ -611,17 +992,9 @@ Lfloat tSampler_tickStereo        (tSampler* const p, Lfloat* outputArray)
             c3 = (c3 < length * (1-rev)) ? c3 + (length * rev) : c3 - (length * (1-rev));
             c4 = (c4 < length * (1-rev)) ? c4 + (length * rev) : c4 - (length * (1-rev));
 
-            cfxsample[0] = LEAF_interpolate_hermite_x (buff[c1 * p->channels],
-                                                    buff[c2 * p->channels],
-                                                    buff[c3 * p->channels],
-                                                    buff[c4 * p->channels],
-                                                    alpha);
+            cfxsample[0] = bufferHermite(p->samp, c1, c2, c3, c4, p->channels, 0, alpha);
 
-            cfxsample[1] = LEAF_interpolate_hermite_x (buff[(c1 * p->channels) + 1],
-                                                                buff[(c2 * p->channels) + 1],
-                                                                buff[(c3 * p->channels) + 1],
-                                                                buff[(c4 * p->channels) + 1],
-                                                                alpha);
+            cfxsample[1] = bufferHermite(p->samp, c1, c2, c3, c4, p->channels, 1, alpha);
 
             crossfadeMix = (Lfloat) offset / (Lfloat) cfxlen;
         }
@@ -657,17 +1030,9 @@ Lfloat tSampler_tickStereo        (tSampler* const p, Lfloat* outputArray)
             f3 = (f3 < length*rev) ? f3 + (length * (1-rev)) : f3 - (length * rev);
             f4 = (f4 < length*rev) ? f4 + (length * (1-rev)) : f4 - (length * rev);
 
-            flipsample[0] = LEAF_interpolate_hermite_x (buff[f1 * p->channels],
-                                                     buff[f2 * p->channels],
-                                                     buff[f3 * p->channels],
-                                                     buff[f4 * p->channels],
-                                                     falpha);
+            flipsample[0] = bufferHermite(p->samp, f1, f2, f3, f4, p->channels, 0, falpha);
 
-            flipsample[1] = LEAF_interpolate_hermite_x (buff[(f1 * p->channels) + 1],
-                                                     buff[(f2 * p->channels) + 1],
-                                                     buff[(f3 * p->channels) + 1],
-                                                     buff[(f4 * p->channels) + 1],
-                                                     falpha);
+            flipsample[1] = bufferHermite(p->samp, f1, f2, f3, f4, p->channels, 1, falpha);
 
             if (cfxlen > 0) flipMix = (Lfloat) (cfxlen - flipLength) / (Lfloat) cfxlen;
             else flipMix = 1.0f;
@@ -1108,6 +1473,173 @@ void tSampler_setSampleRate(tSampler* const p, Lfloat sr)
 
 //==============================================================================
 
+#if LEAF_USE_FILE_STREAMING && LEAF_USE_THREADS
+static void* tSampleStreamer_threadLoop(void* arg)
+{
+    tSampleStreamer* ss = (tSampleStreamer*) arg;
+    struct timespec period = { 0, 2000000 };
+    
+    while (LEAF_atomicLoad(&ss->running))
+    {
+        tSampleStreamer_process(ss);
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+#endif
+
+void    tSampleStreamer_init(tSampleStreamer** const ss, int maxVoices, uint32_t prefetchLength, LEAF* const leaf)
+{
+    tSampleStreamer_initToPool(ss, maxVoices, prefetchLength, &leaf->mempool);
+}
+
+void    tSampleStreamer_initToPool(tSampleStreamer** const ss, int maxVoices, uint32_t prefetchLength, tMempool** const mp)
+{
+    tMempool* m = *mp;
+    tSampleStreamer* s = *ss = (tSampleStreamer*) mpool_alloc(sizeof(tSampleStreamer), m);
+    s->mempool = m;
+    
+    s->maxVoices = maxVoices;
+    s->prefetchLength = prefetchLength;
+    s->samplers = (tSampler**) mpool_alloc(sizeof(tSampler*) * maxVoices, m);
+    s->voices = (_tStreamVoice*) mpool_alloc(sizeof(_tStreamVoice) * maxVoices, m);
+    s->sequence = (uint32_t*) mpool_alloc(sizeof(uint32_t) * maxVoices, m);
+    for (int i = 0; i < maxVoices; i++)
+    {
+        s->samplers[i] = NULL;
+        s->voices[i].buffer = NULL;
+        s->voices[i].position = 0;
+        s->voices[i].loopStart = 0;
+        s->voices[i].direction = 1;
+        s->voices[i].looping = 0;
+        s->sequence[i] = 0;
+    }
+    s->sink = 0;
+    
+#if LEAF_USE_FILE_STREAMING
+    s->pageSize = (size_t) sysconf(_SC_PAGESIZE);
+#else
+    s->pageSize = 4096;
+#endif
+    
+#if LEAF_USE_FILE_STREAMING && LEAF_USE_THREADS
+    s->running = 1;
+    if (pthread_create(&s->thread, NULL, tSampleStreamer_threadLoop, s) != 0) s->running = 0;
+#elif LEAF_USE_THREADS
+    s->running = 0;
+#endif
+}
+
+void    tSampleStreamer_free(tSampleStreamer** const ss)
+{
+    tSampleStreamer* s = *ss;
+    
+#if LEAF_USE_FILE_STREAMING && LEAF_USE_THREADS
+    if (s->running)
+    {
+        LEAF_atomicStore(&s->running, 0);
+        pthread_join(s->thread, NULL);
+    }
+#endif
+    
+    mpool_free((char*)s->sequence, s->mempool);
+    mpool_free((char*)s->voices, s->mempool);
+    mpool_free((char*)s->samplers, s->mempool);
+    mpool_free((char*)s, s->mempool);
+}
+
+void    tSampleStreamer_setVoice(tSampleStreamer* const s, int voice, tSampler* const sampler)
+{
+    if (voice < 0 || voice >= s->maxVoices) return;
+    s->samplers[voice] = sampler;
+}
+
+void    tSampleStreamer_update(tSampleStreamer* const s)
+{
+    for (int i = 0; i < s->maxVoices; i++)
+    {
+        tSampler* p = s->samplers[i];
+        tBuffer* b = NULL;
+        if (p != NULL && p->active != 0 && p->samp->mapping != NULL) b = p->samp;
+        
+        // Sequence lock: odd while the slot is being written
+        LEAF_atomicAdd(&s->sequence[i], 1);
+        LEAF_atomicStore(&s->voices[i].buffer, b);
+        if (b != NULL)
+        {
+            int32_t position = (int32_t) p->idx;
+            LEAF_atomicStore(&s->voices[i].position, (uint32_t) (position < 0 ? 0 : position));
+            LEAF_atomicStore(&s->voices[i].loopStart, (uint32_t) (p->start < p->end ? p->start : p->end));
+            LEAF_atomicStore(&s->voices[i].direction, p->bnf * p->dir * p->flip);
+            LEAF_atomicStore(&s->voices[i].looping, p->mode != PlayNormal);
+        }
+        LEAF_atomicAdd(&s->sequence[i], 1);
+    }
+}
+
+#if LEAF_USE_FILE_STREAMING
+static void tSampleStreamer_touch(tSampleStreamer* const s, tBuffer* const b, uint32_t start, uint32_t end)
+{
+    if (end > b->recordedLength) end = b->recordedLength;
+    if (start >= end) return;
+    
+    // The head is already resident
+    if (start < b->preloadLength) start = b->preloadLength;
+    if (start >= end) return;
+    
+    size_t frameSize = bufferSampleSize(b->format) * b->channels;
+    char* first = (char*) b->buff + (size_t) start * frameSize;
+    char* last = (char*) b->buff + (size_t) end * frameSize;
+    uintptr_t mask = ~((uintptr_t) s->pageSize - 1);
+    char* page = (char*) ((uintptr_t) first & mask);
+    
+    madvise(page, (size_t) (last - page), MADV_WILLNEED);
+    char sum = 0;
+    for (; page < last; page += s->pageSize) sum += *(volatile char*) (page < first ? first : page);
+    s->sink = sum;
+}
+#endif
+
+void    tSampleStreamer_process(tSampleStreamer* const s)
+{
+#if LEAF_USE_FILE_STREAMING
+    for (int i = 0; i < s->maxVoices; i++)
+    {
+        _tStreamVoice v;
+        uint32_t seq;
+        do
+        {
+            seq = LEAF_atomicLoad(&s->sequence[i]);
+            v.buffer = LEAF_atomicLoad(&s->voices[i].buffer);
+            v.position = LEAF_atomicLoad(&s->voices[i].position);
+            v.loopStart = LEAF_atomicLoad(&s->voices[i].loopStart);
+            v.direction = LEAF_atomicLoad(&s->voices[i].direction);
+            v.looping = LEAF_atomicLoad(&s->voices[i].looping);
+        }
+        while ((seq & 1) || seq != LEAF_atomicLoad(&s->sequence[i]));
+        
+        if (v.buffer == NULL) continue;
+        
+        if (v.direction >= 0)
+        {
+            tSampleStreamer_touch(s, v.buffer, v.position, v.position + s->prefetchLength);
+        }
+        else
+        {
+            uint32_t start = v.position > s->prefetchLength ? v.position - s->prefetchLength : 0;
+            tSampleStreamer_touch(s, v.buffer, start, v.position + 4);
+        }
+        
+        // Looping voices jump back, so keep the start of the loop resident too
+        if (v.looping) tSampleStreamer_touch(s, v.buffer, v.loopStart, v.loopStart + s->prefetchLength);
+    }
+#else
+    (void) s;
+#endif
+}
+
+//==============================================================================
+
 void    tAutoSampler_init(tAutoSampler** const as, tBuffer** const b, LEAF* const leaf)
 {
     tAutoSampler_initToPool(as, b, &leaf->mempool, leaf);
@@ -1290,7 +1822,6 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
     
     Lfloat last, beforeLast;
     int start, end, length;
-    Lfloat* buff;
     int    j;
     //Lfloat  syncin;
     Lfloat  a, p, w, z;
@@ -1299,8 +1830,6 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
     start = c->start;
     end = c->end;
 
-    buff = c->samp->buff;
-    
     last = c->last;
     beforeLast = c->beforeLast;
     p = c->_p;  /* position */
@@ -1362,12 +1891,12 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = bufferLerp(c->samp, i, f);
             
             f = p + w;
             i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = bufferLerp(c->samp, i, f);
  
             place_step_dd(c->_f, j, p - start, w, next - last);
             Lfloat nextSlope = (afterNext - next) / w;
@@ -1399,7 +1928,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = bufferLerp(c->samp, i, f);
 
 
             if ((end - p) < 480) // 480 samples should be enough to let the tExpSmooth go from 1 to 0 (10ms at 48k, 5ms at 192k)
@@ -1414,7 +1943,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
             Lfloat f = p + w;
             int i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = bufferLerp(c->samp, i, f);
             
             Lfloat nextSlope = (afterNext - next) / w;
             Lfloat lastSlope = (last - beforeLast) / w;
@@ -1434,12 +1963,12 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = bufferLerp(c->samp, i, f);
 
             f = p + w;
             i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = bufferLerp(c->samp, i, f);
 
             place_step_dd(c->_f, j, end - p, w, next - last);
             Lfloat nextSlope = (afterNext - next) / w;
@@ -1477,7 +2006,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
             Lfloat f = p;
             int i = (int) f;
             f -= i;
-            next = buff[i] * (1.0f - f) + buff[i+1] * f;
+            next = bufferLerp(c->samp, i, f);
         }
         
         if (c->_last_w > 0.0f)
@@ -1485,7 +2014,7 @@ Lfloat tMBSampler_tick        (tMBSampler* const c)
             Lfloat f = p + w;
             int i = (int) f;
             f -= i;
-            afterNext = buff[i] * (1.0f - f) + buff[i+1] * f;
+            afterNext = bufferLerp(c->samp, i, f);
             
             Lfloat nextSlope = (afterNext - next) / w;
             Lfloat lastSlope = (last - beforeLast) / w;
@@ -18,6 +18,11 @@
 
 #endif
 
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define LEAF_FP_SSE 1
+#endif
+
 void LEAF_init(LEAF* const leaf, Lfloat sr, char* memory, size_t memorysize, Lfloat(*random)(void))
 {
     leaf->_internal_mempool.leaf = leaf;
@@ -45,6 +50,8 @@ void LEAF_init(LEAF* const leaf, Lfloat sr, char* memory, size_t memorysize, Lfl
     leaf->lfoRateTable = NULL;
     leaf->envTimeTable = NULL;
     leaf->resTable = NULL;
+    
+    LEAF_bindKernels(&leaf->kernels, LEAF_detectCPUFeatures());
 }
 
 void LEAF_setSampleRate(LEAF* const leaf, Lfloat sampleRate)
@@ -76,7 +83,62 @@ void LEAF_setErrorCallback(LEAF* const leaf, void (*callback)(LEAF* const, LEAFE
     leaf->errorCallback = callback;
 }
 
+uint32_t LEAF_setCPUFeatures(LEAF* const leaf, uint32_t features)
+{
+    // Never bind code the machine cannot run
+    features &= LEAF_detectCPUFeatures();
+    LEAF_bindKernels(&leaf->kernels, features);
+    return features;
+}
+
+uint32_t LEAF_getCPUFeatures(LEAF* const leaf)
+{
+    return leaf->kernels.features;
+}
+
 unsigned int getNextUuid(LEAF* leaf)
 {
     return ++leaf->uuid;
 }
+
+uint32_t LEAF_getFloatingPointState(void)
+{
+#if LEAF_FP_SSE
+    return (uint32_t) _mm_getcsr();
+#elif defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ __volatile__ ("mrs %0, fpcr" : "=r" (fpcr));
+    return (uint32_t) fpcr;
+#elif defined(__arm__) && defined(__ARM_FP) && !defined(__SOFTFP__)
+    uint32_t fpscr;
+    __asm__ __volatile__ ("vmrs %0, fpscr" : "=r" (fpscr));
+    return fpscr;
+#else
+    return 0;
+#endif
+}
+
+void LEAF_setFloatingPointState(uint32_t state)
+{
+#if LEAF_FP_SSE
+    _mm_setcsr(state);
+#elif defined(__aarch64__)
+    uint64_t fpcr = state;
+    __asm__ __volatile__ ("msr fpcr, %0" : : "r" (fpcr));
+#elif defined(__arm__) && defined(__ARM_FP) && !defined(__SOFTFP__)
+    __asm__ __volatile__ ("vmsr fpscr, %0" : : "r" (state));
+#else
+    (void) state;
+#endif
+}
+
+uint32_t LEAF_enableFlushToZero(void)
+{
+    uint32_t previous = LEAF_getFloatingPointState();
+#if LEAF_FP_SSE
+    LEAF_setFloatingPointState(previous | 0x8040); // FTZ (bit 15) and DAZ (bit 6) in MXCSR
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_FP) && !defined(__SOFTFP__))
+    LEAF_setFloatingPointState(previous | (1u << 24)); // FZ in FPCR / FPSCR flushes both inputs and results
+#endif
+    return previous;
+}
@@ -54,9 +54,41 @@
 //! Include tables for minblep insertion, required for all tMB objects.
 #define LEAF_INCLUDE_MINBLEP_TABLES 1
 
+//! Skip LEAF's per-sample denormal flushing in feedback paths. Only set this to 1 when every thread that ticks LEAF objects runs with flush-to-zero on (see LEAF_enableFlushToZero), otherwise decaying tails will hit slow denormal arithmetic.
+#ifndef LEAF_NO_DENORMAL_CHECK
 #define LEAF_NO_DENORMAL_CHECK 0
+#endif
 
+//! Bind the CMSIS-DSP versions of the dispatched kernels (see LEAFKernels) on Cortex-M targets. Needs arm_math.h on the include path.
+#ifndef LEAF_USE_CMSIS
 #define LEAF_USE_CMSIS 0
+#endif
+
+//! Use POSIX threads for the multithreaded objects in leaf-parallel.h. When 0 they render everything on the calling thread.
+#ifndef LEAF_USE_THREADS
+#define LEAF_USE_THREADS 0
+#endif
+
+//! Allow tBuffer to stream sample data from memory-mapped files (POSIX only). Background prefetching with tSampleStreamer also needs LEAF_USE_THREADS.
+#ifndef LEAF_USE_FILE_STREAMING
+#define LEAF_USE_FILE_STREAMING 0
+#endif
+
+//! Accuracy tier for the scalar LEAF_expf, LEAF_tanhf, etc. in leaf-simdmath.h. 0 uses libm, 1 uses the vectorised Cephes kernels (within a few ulp of libm), 2 uses the cheaper approximations from leaf-math.h.
+#ifndef LEAF_MATH_ACCURACY
+#define LEAF_MATH_ACCURACY 0
+#endif
+
+//! Define the tick functions and hot setters of the core oscillators, filters and envelopes (tCycle, tPBSaw, tPhasor, tOnePole, tBiQuad, tSVF, tHighpass, tADSRS, tExpSmooth) as static inline in their headers so they can be inlined into the caller's audio loop. Must be set the same way for LEAF and for the code that uses it.
+#ifndef LEAF_INLINE_TICKS
+#define LEAF_INLINE_TICKS 0
+#endif
+
+//! Round the buffers of tDelay and tLinearDelay up to a power of two and wrap their read and write points with a mask instead of a compare and reset. tHermiteDelay and tLagrangeDelay always do this.
+#ifndef LEAF_POW2_DELAYS
+#define LEAF_POW2_DELAYS 0
+#endif
+
 // #define LEAF_USE_DYNAMIC_ALLOCATION 1
 #ifdef __cplusplus
 //! Use stdlib malloc() and free() internally instead of LEAF's normal mempool behavior for when you want to avoid being limited to and managing mempool a fixed mempool size. Usage of all object remains essentially the same.
@@ -70,13 +102,8 @@
 #define _CONSTANT_DATA_LOCATION
 #endif
 
-#ifdef SIMD_64
-#include "leaf_polyvalues.h"
-#define Lfloat poly_float
-
-#else
+//! The sample type of every LEAF object. For several voices per object instance, see the poly_float type in leaf_polyvalues.h.
 #define Lfloat float
-#endif
 
 //==============================================================================
 
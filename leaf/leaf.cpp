@@ -3,6 +3,7 @@
 #include ".\leaf.h"
 #include ".\Src\leaf-math.c"
 #include ".\Src\leaf-mempool.c"
+#include ".\Src\leaf-kernels.c"
 #include ".\Src\leaf-tables.c"
 #include ".\Src\leaf-distortion.c"
 #include ".\Src\leaf-oscillators.c"
@@ -18,6 +19,8 @@
 #include ".\Src\leaf-sampling.c"
 #include ".\Src\leaf-physical.c"
 #include ".\Src\leaf-electrical.c"
+#include ".\Src\leaf-parallel.c"
+#include ".\Src\leaf-fixed.c"
 #include ".\Src\leaf.c"
 
 #include ".\Externals\d_fft_mayer.c"
@@ -27,6 +30,7 @@
 #include "./leaf.h"
 #include "./Src/leaf-math.c"
 #include "./Src/leaf-mempool.c"
+#include "./Src/leaf-kernels.c"
 #include "./Src/leaf-tables.c"
 #include "./Src/leaf-distortion.c"
 #include "./Src/leaf-dynamics.c"
@@ -43,6 +47,8 @@
 #include "./Src/leaf-physical.c"
 #include "./Src/leaf-electrical.c"
 #include "./Src/leaf-vocal.c"
+#include "./Src/leaf-parallel.c"
+#include "./Src/leaf-fixed.c"
 #include "./Src/leaf.c"
 
 
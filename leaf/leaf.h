@@ -35,6 +35,8 @@
 
 #include ".\Inc\leaf-global.h"
 #include ".\Inc\leaf-math.h"
+#include ".\Inc\leaf-simdmath.h"
+#include ".\Inc\leaf-kernels.h"
 #include ".\Inc\leaf-mempool.h"
 #include ".\Inc\leaf-tables.h"
 #include ".\Inc\leaf-distortion.h"
@@ -52,11 +54,15 @@
 #include ".\Inc\leaf-physical.h"
 #include ".\Inc\leaf-electrical.h"
 #include ".\Inc\leaf-vocal.h"
+#include ".\Inc\leaf-parallel.h"
+#include ".\Inc\leaf-fixed.h"
 
 #else
 
 #include "./Inc/leaf-global.h"
 #include "./Inc/leaf-math.h"
+#include "./Inc/leaf-simdmath.h"
+#include "./Inc/leaf-kernels.h"
 #include "./Inc/leaf-mempool.h"
 #include "./Inc/leaf-tables.h"
 #include "./Inc/leaf-distortion.h"
@@ -74,6 +80,8 @@
 #include "./Inc/leaf-physical.h"
 #include "./Inc/leaf-electrical.h"
 #include "./Inc/leaf-vocal.h"
+#include "./Inc/leaf-parallel.h"
+#include "./Inc/leaf-fixed.h"
 
 #endif
 
@@ -125,6 +133,12 @@
  @brief String models and more.
  @defgroup electrical Electrical Models
  @brief Circuit models.
+ @defgroup parallel Parallel
+ @brief Multithreaded rendering.
+ @defgroup kernels Kernels
+ @brief Runtime CPU dispatch for vectorised inner loops.
+ @defgroup fixed Fixed Point
+ @brief Q31 versions of core objects for targets without a fast FPU.
  @defgroup mempool Mempool
  @brief Memory allocation.
  @defgroup math Math
@@ -179,6 +193,30 @@ extern "C" {
      */
     void LEAF_setErrorCallback(LEAF* const leaf, void (*callback)(LEAF* const, LEAFErrorType));
     
+    //! Rebind the dispatched kernels of a LEAF instance (see LEAFKernels) to a subset of the CPU features.
+    /*!
+     LEAF_init binds them to everything LEAF_detectCPUFeatures finds. Use this to test or compare the narrower versions, for example pass 0 for plain C or LEAF_CPU_SSE2 for the baseline x86-64 path. Objects already made with this instance switch over too. Not safe to call while another thread is ticking those objects.
+     @param features A mask of LEAFCPUFeature bits. Bits the CPU does not have are ignored.
+     @return The features actually bound.
+     */
+    uint32_t    LEAF_setCPUFeatures(LEAF* const leaf, uint32_t features);
+    
+    //! Get the CPU features the dispatched kernels of a LEAF instance are bound for.
+    uint32_t    LEAF_getCPUFeatures(LEAF* const leaf);
+    
+    //! Turn on flush-to-zero and denormals-are-zero for the calling thread.
+    /*!
+     Denormal numbers are what decaying feedback (reverb tails, resonant filters, long envelopes) turns into just before it reaches zero, and most FPUs handle them many times slower than normal numbers. This sets FTZ and DAZ in MXCSR on x86 and FZ in FPCR/FPSCR on ARM, and does nothing on other targets. It only affects the calling thread, so call it at the top of each audio callback or once on the audio thread, and hand the result to LEAF_setFloatingPointState to put things back, for example when the callback returns into a host. tJobPool workers copy the caller's mode at every batch. With it in force, LEAF_NO_DENORMAL_CHECK can be set to drop LEAF's own per-sample checks.
+     @return The previous floating point state of the thread.
+     */
+    uint32_t    LEAF_enableFlushToZero(void);
+    
+    //! Get the floating point control state of the calling thread (MXCSR on x86, FPCR/FPSCR on ARM, 0 elsewhere).
+    uint32_t    LEAF_getFloatingPointState(void);
+    
+    //! Restore a floating point control state saved by LEAF_enableFlushToZero or LEAF_getFloatingPointState.
+    void        LEAF_setFloatingPointState(uint32_t state);
+    
     /*! @} */
     
 #ifdef __cplusplus
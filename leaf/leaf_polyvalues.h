@@ -0,0 +1,229 @@
+/*==============================================================================
+
+ leaf_polyvalues.h
+ Created: 19 Oct 2026 10:12:40am
+
+ ==============================================================================*/
+
+#ifndef LEAF_POLYVALUES_H_INCLUDED
+#define LEAF_POLYVALUES_H_INCLUDED
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/*!
+ @defgroup polyvalues Poly Values
+ @brief Lane-wise vector type for running several voices in lockstep.
+ @details A poly_float is LEAF_POLY_WIDTH floats (2, 4 or 8, default 4) that are processed together, one lane per voice. With GCC or Clang poly_float is a native vector, so +, -, *, / (also against plain floats, which are broadcast to every lane) and unary minus work as usual and compile to single SIMD instructions. Comparisons give a poly_int mask with all bits set in the lanes where they hold, which is what LEAF_poly_select and LEAF_poly_any/LEAF_poly_all take. Other compilers get LEAF_POLY_WIDTH 1 and a plain float, so the same code still builds one voice at a time.
+
+ This header stands on its own and LEAF's objects do not use it: Lfloat is always a float, because nearly every object branches on sample values or turns them into table and delay indices. Voice-parallel code written against poly_float does the same per lane, picking with LEAF_poly_select and indexing through LEAF_poly_toInt. Straight-line arithmetic needs no changes. In C++ the usual float functions (fabsf, expf, tanhf, powf and so on) are also overloaded for poly_float so scalar code can be moved over without renaming calls.
+
+ When LEAF_POLY_WIDTH matches LEAF_SIMD_WIDTH, poly_float and poly_int are the same types as Lfloatv and Lintv, so the kernels in leaf-simdmath.h can be used on them directly and are a lot faster than the lane-by-lane LEAF_poly_ math functions here.
+ @{
+ */
+
+#ifndef LEAF_POLY_WIDTH
+#define LEAF_POLY_WIDTH 4
+#endif
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#undef LEAF_POLY_WIDTH
+#define LEAF_POLY_WIDTH 1
+#endif
+
+#if LEAF_POLY_WIDTH != 1 && LEAF_POLY_WIDTH != 2 && LEAF_POLY_WIDTH != 4 && LEAF_POLY_WIDTH != 8
+#error "LEAF_POLY_WIDTH must be 1, 2, 4 or 8"
+#endif
+
+#if LEAF_POLY_WIDTH > 1
+typedef float poly_float __attribute__((vector_size(LEAF_POLY_WIDTH * 4)));
+typedef int32_t poly_int __attribute__((vector_size(LEAF_POLY_WIDTH * 4)));
+// Vector comparisons already give all-ones lanes.
+#define LEAF_POLY_MASK(c)   (c)
+#else
+typedef float poly_float;
+typedef int32_t poly_int;
+#define LEAF_POLY_MASK(c)   (-(poly_int)(c))
+#endif
+
+//! Loop over the lanes of a poly_float, applying a scalar float function to each.
+#define LEAF_POLY_MAP(out, in, f) \
+    do { float _pl[LEAF_POLY_WIDTH]; memcpy(_pl, &(in), sizeof(_pl)); \
+         for (int _i = 0; _i < LEAF_POLY_WIDTH; _i++) _pl[_i] = f(_pl[_i]); \
+         memcpy(&(out), _pl, sizeof(_pl)); } while (0)
+
+static inline poly_float LEAF_poly_set1(float x)
+{
+    poly_float v = { 0 };
+    return v + x;
+}
+
+static inline poly_float LEAF_poly_load(const float* p)
+{
+    poly_float v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void LEAF_poly_store(float* p, poly_float v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline float LEAF_poly_getLane(poly_float v, int lane)
+{
+    float l[LEAF_POLY_WIDTH];
+    memcpy(l, &v, sizeof(l));
+    return l[lane];
+}
+
+static inline poly_float LEAF_poly_setLane(poly_float v, int lane, float x)
+{
+    float l[LEAF_POLY_WIDTH];
+    memcpy(l, &v, sizeof(l));
+    l[lane] = x;
+    memcpy(&v, l, sizeof(l));
+    return v;
+}
+
+//! Truncate toward zero, like a (int) cast of each lane.
+static inline poly_int LEAF_poly_toInt(poly_float v)
+{
+#if LEAF_POLY_WIDTH > 1
+    return __builtin_convertvector(v, poly_int);
+#else
+    return (poly_int) v;
+#endif
+}
+
+static inline poly_float LEAF_poly_toFloat(poly_int i)
+{
+#if LEAF_POLY_WIDTH > 1
+    return __builtin_convertvector(i, poly_float);
+#else
+    return (poly_float) i;
+#endif
+}
+
+//! Lanes where mask is all ones take a, the rest take b.
+static inline poly_float LEAF_poly_select(poly_int mask, poly_float a, poly_float b)
+{
+    poly_int ia, ib, r;
+    poly_float v;
+    memcpy(&ia, &a, sizeof(ia));
+    memcpy(&ib, &b, sizeof(ib));
+    r = (mask & ia) | (~mask & ib);
+    memcpy(&v, &r, sizeof(v));
+    return v;
+}
+
+//! 1 if the mask is set in any lane. Use it to skip work no voice needs.
+static inline int LEAF_poly_any(poly_int mask)
+{
+    int32_t l[LEAF_POLY_WIDTH];
+    int32_t acc = 0;
+    memcpy(l, &mask, sizeof(l));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) acc |= l[i];
+    return acc != 0;
+}
+
+//! 1 if the mask is set in every lane.
+static inline int LEAF_poly_all(poly_int mask)
+{
+    int32_t l[LEAF_POLY_WIDTH];
+    int32_t acc = -1;
+    memcpy(l, &mask, sizeof(l));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) acc &= l[i];
+    return acc != 0;
+}
+
+static inline poly_float LEAF_poly_min(poly_float a, poly_float b)
+{
+    return LEAF_poly_select(LEAF_POLY_MASK(a < b), a, b);
+}
+
+static inline poly_float LEAF_poly_max(poly_float a, poly_float b)
+{
+    return LEAF_poly_select(LEAF_POLY_MASK(a > b), a, b);
+}
+
+static inline poly_float LEAF_poly_clip(poly_float min, poly_float val, poly_float max)
+{
+    return LEAF_poly_min(LEAF_poly_max(val, min), max);
+}
+
+static inline poly_float LEAF_poly_abs(poly_float x)
+{
+    return LEAF_poly_select(LEAF_POLY_MASK(x < 0.0f), -x, x);
+}
+
+static inline poly_float LEAF_poly_floor(poly_float x)
+{
+    poly_float t = LEAF_poly_toFloat(LEAF_poly_toInt(x));
+    return LEAF_poly_select(LEAF_POLY_MASK(t > x), t - 1.0f, t);
+}
+
+//! Sum of the lanes, for mixing all voices down to one output.
+static inline float LEAF_poly_sum(poly_float v)
+{
+    float l[LEAF_POLY_WIDTH];
+    float sum = 0.0f;
+    memcpy(l, &v, sizeof(l));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) sum += l[i];
+    return sum;
+}
+
+static inline poly_float LEAF_poly_sqrtf(poly_float x)  { LEAF_POLY_MAP(x, x, sqrtf); return x; }
+static inline poly_float LEAF_poly_expf(poly_float x)   { LEAF_POLY_MAP(x, x, expf); return x; }
+static inline poly_float LEAF_poly_exp2f(poly_float x)  { LEAF_POLY_MAP(x, x, exp2f); return x; }
+static inline poly_float LEAF_poly_logf(poly_float x)   { LEAF_POLY_MAP(x, x, logf); return x; }
+static inline poly_float LEAF_poly_log2f(poly_float x)  { LEAF_POLY_MAP(x, x, log2f); return x; }
+static inline poly_float LEAF_poly_sinf(poly_float x)   { LEAF_POLY_MAP(x, x, sinf); return x; }
+static inline poly_float LEAF_poly_cosf(poly_float x)   { LEAF_POLY_MAP(x, x, cosf); return x; }
+static inline poly_float LEAF_poly_tanf(poly_float x)   { LEAF_POLY_MAP(x, x, tanf); return x; }
+static inline poly_float LEAF_poly_tanhf(poly_float x)  { LEAF_POLY_MAP(x, x, tanhf); return x; }
+
+static inline poly_float LEAF_poly_powf(poly_float a, poly_float b)
+{
+    float la[LEAF_POLY_WIDTH], lb[LEAF_POLY_WIDTH];
+    memcpy(la, &a, sizeof(la));
+    memcpy(lb, &b, sizeof(lb));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) la[i] = powf(la[i], lb[i]);
+    memcpy(&a, la, sizeof(la));
+    return a;
+}
+
+static inline poly_float LEAF_poly_mtof(poly_float m)
+{
+    return LEAF_poly_exp2f((m - 69.0f) * (1.0f / 12.0f)) * 440.0f;
+}
+
+static inline poly_float LEAF_poly_dbtoa(poly_float db)
+{
+    return LEAF_poly_expf(db * 0.115129254649702f);
+}
+
+/*! @} */
+
+#if defined(__cplusplus) && LEAF_POLY_WIDTH > 1
+// Let code moved over from float keep calling the functions it already uses.
+extern "C++" {
+    static inline poly_float fabsf(poly_float x)                { return LEAF_poly_abs(x); }
+    static inline poly_float floorf(poly_float x)               { return LEAF_poly_floor(x); }
+    static inline poly_float fminf(poly_float a, poly_float b)  { return LEAF_poly_min(a, b); }
+    static inline poly_float fmaxf(poly_float a, poly_float b)  { return LEAF_poly_max(a, b); }
+    static inline poly_float sqrtf(poly_float x)                { return LEAF_poly_sqrtf(x); }
+    static inline poly_float expf(poly_float x)                 { return LEAF_poly_expf(x); }
+    static inline poly_float exp2f(poly_float x)                { return LEAF_poly_exp2f(x); }
+    static inline poly_float logf(poly_float x)                 { return LEAF_poly_logf(x); }
+    static inline poly_float log2f(poly_float x)                { return LEAF_poly_log2f(x); }
+    static inline poly_float sinf(poly_float x)                 { return LEAF_poly_sinf(x); }
+    static inline poly_float cosf(poly_float x)                 { return LEAF_poly_cosf(x); }
+    static inline poly_float tanf(poly_float x)                 { return LEAF_poly_tanf(x); }
+    static inline poly_float tanhf(poly_float x)                { return LEAF_poly_tanhf(x); }
+    static inline poly_float powf(poly_float a, poly_float b)   { return LEAF_poly_powf(a, b); }
+}
+#endif
+
+#endif // LEAF_POLYVALUES_H_INCLUDED
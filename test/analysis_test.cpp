@@ -0,0 +1,335 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include <string.h>
+#if LEAF_USE_THREADS
+#include <time.h>
+#endif
+#include "../leaf/Inc/leaf-analysis.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+// A note that steps between three pitches, with a little noise
+static Lfloat testInput(int i)
+{
+    Lfloat freq = (i < 12000) ? 220.0f : (i < 24000) ? 330.0f : 147.0f;
+    return 0.5f * sinf(TWO_PI * freq * (Lfloat) i / 48000.0f) + 0.01f * (myrand() - 0.5f);
+}
+
+#if !LEAF_USE_THREADS
+TEST_CASE("Tests for `tDualPitchDetector` async", "[tDualPitchDetector]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    Lfloat buffer1[2048], buffer2[2048];
+    tDualPitchDetector* sync;
+    tDualPitchDetector* async;
+    tDualPitchDetector_init(&sync, 60.0f, 1000.0f, buffer1, 2048, &leaf);
+    tDualPitchDetector_init(&async, 60.0f, 1000.0f, buffer2, 2048, &leaf);
+    tDualPitchDetector_setAsync(async, 1);
+
+    // Analysed every 64 samples, the async detector gives the sync detector's estimates one block late
+    srand(1);
+    int estimates = 0;
+    Lfloat last = 0.0f;
+    for (int i = 0; i < 36000; i += 64)
+    {
+        Lfloat expected = tDualPitchDetector_getFrequency(sync);
+        Lfloat periodicity = tDualPitchDetector_getPeriodicity(sync);
+        for (int j = 0; j < 64; j++)
+        {
+            Lfloat x = testInput(i + j);
+            tDualPitchDetector_tick(sync, x);
+            tDualPitchDetector_tick(async, x);
+            REQUIRE(tDualPitchDetector_getFrequency(async) == expected);
+            REQUIRE(tDualPitchDetector_getPeriodicity(async) == periodicity);
+        }
+        tDualPitchDetector_process(async);
+        if (tDualPitchDetector_getFrequency(sync) != last) estimates++;
+        last = tDualPitchDetector_getFrequency(sync);
+    }
+    REQUIRE(estimates > 3);
+    REQUIRE(fabsf(tDualPitchDetector_getFrequency(sync) - 147.0f) < 2.0f);
+
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&sync));
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&async));
+}
+
+TEST_CASE("Tests for `tDualPitchDetector` async snapshots", "[tDualPitchDetector]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    Lfloat buffer[2048];
+    tDualPitchDetector* detector;
+    tDualPitchDetector_init(&detector, 60.0f, 1000.0f, buffer, 2048, &leaf);
+    tDualPitchDetector_setAsync(detector, 1);
+
+    // An estimate is only taken once its sequence count is even and new
+    Lfloat before = tDualPitchDetector_getFrequency(detector);
+    Lfloat published = 440.0f;
+    memcpy(&detector->frequency, &published, sizeof(published));
+    detector->estimateCount += 1;
+    REQUIRE(tDualPitchDetector_tick(detector, 0.0f) == 0);
+    REQUIRE(tDualPitchDetector_getFrequency(detector) == before);
+    detector->estimateCount += 1;
+    REQUIRE(tDualPitchDetector_tick(detector, 0.0f) == 1);
+    REQUIRE(tDualPitchDetector_getFrequency(detector) == 440.0f);
+    REQUIRE(tDualPitchDetector_tick(detector, 0.0f) == 0);
+    REQUIRE(tDualPitchDetector_getFrequency(detector) == 440.0f);
+
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&detector));
+}
+
+TEST_CASE("Tests for `tDualPitchDetector` async off and on", "[tDualPitchDetector]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    Lfloat buffer1[2048], buffer2[2048];
+    tDualPitchDetector* reference;
+    tDualPitchDetector* detector;
+    tDualPitchDetector_init(&reference, 60.0f, 1000.0f, buffer1, 2048, &leaf);
+    tDualPitchDetector_init(&detector, 60.0f, 1000.0f, buffer2, 2048, &leaf);
+
+    srand(2);
+    int i = 0;
+    for (int round = 0; round < 3; round++)
+    {
+        // Async for a while, then a block that is pushed but never analysed before async goes off
+        tDualPitchDetector_setAsync(detector, 1);
+        REQUIRE(tDualPitchDetector_getFrequency(detector) == tDualPitchDetector_getFrequency(reference));
+        for (int end = i + 4096; i < end; i += 64)
+        {
+            Lfloat expected = tDualPitchDetector_getFrequency(reference);
+            for (int j = 0; j < 64; j++)
+            {
+                Lfloat x = testInput(i + j);
+                tDualPitchDetector_tick(reference, x);
+                tDualPitchDetector_tick(detector, x);
+                REQUIRE(tDualPitchDetector_getFrequency(detector) == expected);
+            }
+            tDualPitchDetector_process(detector);
+        }
+        for (int j = 0; j < 64; j++) tDualPitchDetector_tick(detector, testInput(i + j));
+        tDualPitchDetector_setAsync(detector, 0);
+        i += 64;
+
+        // Back in sync mode it picks up from its own analysis, and the unanalysed block is dropped
+        for (int end = i + 4096; i < end; i++)
+        {
+            Lfloat x = testInput(i);
+            tDualPitchDetector_tick(reference, x);
+            tDualPitchDetector_tick(detector, x);
+            REQUIRE(tDualPitchDetector_getFrequency(detector) == tDualPitchDetector_getFrequency(reference));
+        }
+    }
+
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&reference));
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&detector));
+}
+#else
+TEST_CASE("Tests for `tDualPitchDetector` async thread", "[tDualPitchDetector]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    Lfloat buffer1[2048], buffer2[2048];
+    tDualPitchDetector* sync;
+    tDualPitchDetector* async;
+    tDualPitchDetector_init(&sync, 60.0f, 1000.0f, buffer1, 2048, &leaf);
+    tDualPitchDetector_init(&async, 60.0f, 1000.0f, buffer2, 2048, &leaf);
+
+    // The detector's own thread follows the same pitches, a little behind
+    struct timespec pause = { 0, 100000 };
+    srand(1);
+    for (int round = 0; round < 2; round++)
+    {
+        tDualPitchDetector_setAsync(async, 1);
+        for (int i = round * 18000; i < (round + 1) * 18000; i += 64)
+        {
+            for (int j = 0; j < 64; j++)
+            {
+                Lfloat x = testInput(i + j);
+                tDualPitchDetector_tick(sync, x);
+                tDualPitchDetector_tick(async, x);
+            }
+            while (tSPSCRingBuffer_getNumReady(async->feed) > 0) nanosleep(&pause, NULL);
+        }
+        for (int k = 0; k < 200; k++) nanosleep(&pause, NULL);
+        tDualPitchDetector_tick(async, 0.0f);
+        REQUIRE(fabsf(tDualPitchDetector_getFrequency(async) - tDualPitchDetector_getFrequency(sync)) < 1.0f);
+        tDualPitchDetector_setAsync(async, 0);
+    }
+    REQUIRE(fabsf(tDualPitchDetector_getFrequency(sync) - 147.0f) < 2.0f);
+
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&sync));
+    REQUIRE_NOTHROW(tDualPitchDetector_free(&async));
+}
+#endif
+
+TEST_CASE("Tests for `tPeriodDetection` gate and hop off", "[tPeriodDetection]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+    leaf.clearOnAllocation = 1;
+
+    // A gate that never closes, and a gate and hop turned on and off again, leave the default analysis as it was
+    Lfloat buffers[3][2048];
+    tPeriodDetection* detections[3];
+    tPeriodDetector* detectors[3];
+    for (int k = 0; k < 3; k++)
+    {
+        tPeriodDetection_init(&detections[k], buffers[k], 2048, 1024, &leaf);
+        tPeriodDetector_init(&detectors[k], 60.0f, 1000.0f, -40.0f, &leaf);
+    }
+    tPeriodDetection_setGate(detections[1], 0.001f);
+    tPeriodDetector_setGate(detectors[1], 0.001f);
+    tPeriodDetection_setGate(detections[2], 0.5f);
+    tPeriodDetection_setMaxHop(detections[2], 8);
+    tPeriodDetection_setGate(detections[2], 0.0f);
+    tPeriodDetection_setMaxHop(detections[2], 1);
+    tPeriodDetector_setGate(detectors[2], 0.5f);
+    tPeriodDetector_setMaxHop(detectors[2], 8);
+    tPeriodDetector_setGate(detectors[2], 0.0f);
+    tPeriodDetector_setMaxHop(detectors[2], 1);
+
+    srand(3);
+    for (int i = 0; i < 36000; i++)
+    {
+        Lfloat x = testInput(i);
+        Lfloat period = tPeriodDetection_tick(detections[0], x);
+        int ready = tPeriodDetector_tick(detectors[0], x);
+        for (int k = 1; k < 3; k++)
+        {
+            REQUIRE(tPeriodDetection_tick(detections[k], x) == period);
+            REQUIRE(tPeriodDetection_getFidelity(detections[k]) == tPeriodDetection_getFidelity(detections[0]));
+            REQUIRE(tPeriodDetector_tick(detectors[k], x) == ready);
+            REQUIRE(tPeriodDetector_getPeriod(detectors[k]) == tPeriodDetector_getPeriod(detectors[0]));
+            REQUIRE(tPeriodDetector_getPeriodicity(detectors[k]) == tPeriodDetector_getPeriodicity(detectors[0]));
+        }
+    }
+    REQUIRE(fabsf(tPeriodDetection_getPeriod(detections[0]) - 48000.0f / 147.0f) < 2.0f);
+    REQUIRE(fabsf(tPeriodDetector_getPeriod(detectors[0]) - 48000.0f / 147.0f) < 2.0f);
+
+    for (int k = 0; k < 3; k++)
+    {
+        REQUIRE_NOTHROW(tPeriodDetection_free(&detections[k]));
+        REQUIRE_NOTHROW(tPeriodDetector_free(&detectors[k]));
+    }
+}
+
+TEST_CASE("Tests for `tPeriodDetection` gate", "[tPeriodDetection]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    Lfloat buffer[2048];
+    tPeriodDetection* detection;
+    tPeriodDetector* detector;
+    tPeriodDetection_init(&detection, buffer, 2048, 1024, &leaf);
+    tPeriodDetector_init(&detector, 60.0f, 1000.0f, -40.0f, &leaf);
+    tPeriodDetection_setGate(detection, 0.05f);
+    tPeriodDetector_setGate(detector, 0.05f);
+
+    srand(4);
+    for (int i = 0; i < 12000; i++)
+    {
+        Lfloat x = testInput(i);
+        tPeriodDetection_tick(detection, x);
+        tPeriodDetector_tick(detector, x);
+    }
+    REQUIRE(fabsf(tPeriodDetection_getPeriod(detection) - 48000.0f / 220.0f) < 2.0f);
+    REQUIRE(fabsf(tPeriodDetector_getPeriod(detector) - 48000.0f / 220.0f) < 2.0f);
+
+    // Once the power has fallen below the gate, quiet input holds the period or reports none
+    int gated = 0;
+    Lfloat held = 0.0f;
+    for (int i = 0; i < 24000; i++)
+    {
+        Lfloat x = 0.02f * sinf(TWO_PI * 330.0f * (Lfloat) i / 48000.0f);
+        tPeriodDetection_tick(detection, x);
+        int ready = tPeriodDetector_tick(detector, x);
+        if (i < 4800) continue;
+        if (i == 4800)
+        {
+            held = tPeriodDetection_getPeriod(detection);
+            REQUIRE(fabsf(held - 48000.0f / 220.0f) < 2.0f);
+        }
+        REQUIRE(tPeriodDetection_getPeriod(detection) == held);
+        if (ready)
+        {
+            REQUIRE(tPeriodDetector_getPeriod(detector) == -1.0f);
+            REQUIRE(tPeriodDetector_getPeriodicity(detector) == -1.0f);
+            gated++;
+        }
+    }
+    REQUIRE(gated > 0);
+
+    REQUIRE_NOTHROW(tPeriodDetection_free(&detection));
+    REQUIRE_NOTHROW(tPeriodDetector_free(&detector));
+}
+
+TEST_CASE("Tests for `tPeriodDetector` adaptive hop", "[tPeriodDetector]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    Lfloat buffer[2048];
+    tPeriodDetection* detection;
+    tPeriodDetector* detector;
+    tPeriodDetection_init(&detection, buffer, 2048, 1024, &leaf);
+    tPeriodDetector_init(&detector, 60.0f, 1000.0f, -40.0f, &leaf);
+    tPeriodDetection_setMaxHop(detection, 4);
+    tPeriodDetector_setMaxHop(detector, 8);
+
+    // A steady quiet note stretches the hop while the estimate holds
+    int i = 0;
+    for (; i < 48000; i++)
+    {
+        Lfloat x = 0.1f * sinf(TWO_PI * 220.0f * (Lfloat) i / 48000.0f);
+        tPeriodDetection_tick(detection, x);
+        tPeriodDetector_tick(detector, x);
+    }
+    REQUIRE(detection->gate.hop == 4);
+    REQUIRE(detector->_gate.hop == 8);
+    REQUIRE(fabsf(tPeriodDetection_getPeriod(detection) - 48000.0f / 220.0f) < 2.0f);
+    REQUIRE(fabsf(tPeriodDetector_getPeriod(detector) - 48000.0f / 220.0f) < 2.0f);
+
+    // A loud onset brings both back to every frame, from where the hop starts stretching again
+    int detectionHop = 4, detectorHop = 8;
+    for (int end = i + 4096; i < end; i++)
+    {
+        Lfloat x = 0.8f * sinf(TWO_PI * 220.0f * (Lfloat) i / 48000.0f);
+        tPeriodDetection_tick(detection, x);
+        tPeriodDetector_tick(detector, x);
+        detectionHop = LEAF_clipInt(1, detection->gate.hop, detectionHop);
+        detectorHop = LEAF_clipInt(1, detector->_gate.hop, detectorHop);
+    }
+    REQUIRE(detectionHop <= 2);
+    REQUIRE(detectorHop <= 2);
+
+    // So does a pitch change with no onset, for the detector that has a cheap period estimate
+    for (int end = i + 48000; i < end; i++) tPeriodDetector_tick(detector, 0.8f * sinf(TWO_PI * 220.0f * (Lfloat) i / 48000.0f));
+    REQUIRE(detector->_gate.hop == 8);
+    Lfloat phase = TWO_PI * 220.0f * (Lfloat) i / 48000.0f;
+    detectorHop = 8;
+    for (int j = 0; j < 4096; j++)
+    {
+        phase += TWO_PI * 262.0f / 48000.0f;
+        tPeriodDetector_tick(detector, 0.8f * sinf(phase));
+        detectorHop = LEAF_clipInt(1, detector->_gate.hop, detectorHop);
+    }
+    REQUIRE(detectorHop <= 2);
+
+    REQUIRE_NOTHROW(tPeriodDetection_free(&detection));
+    REQUIRE_NOTHROW(tPeriodDetector_free(&detector));
+}
@@ -0,0 +1,209 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-delay.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+TEST_CASE("Tests for `tSPSCRingBuffer`", "[tSPSCRingBuffer]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tSPSCRingBuffer* ring;
+    tSPSCRingBuffer_init(&ring, 100, &leaf);
+    REQUIRE(tSPSCRingBuffer_getSize(ring) == 128);
+    REQUIRE(tSPSCRingBuffer_getSpace(ring) == 128);
+
+    Lfloat input[200], output[200];
+    for (int i = 0; i < 200; i++) input[i] = (Lfloat) i;
+
+    // The ready count follows pushes and pops of any size across the wrap
+    int written = 0, read = 0;
+    for (int round = 0; round < 50; round++)
+    {
+        int n = tSPSCRingBuffer_push(ring, input, 1 + (round * 7) % 40);
+        written += n;
+
+        int m = tSPSCRingBuffer_pop(ring, output, 1 + (round * 5) % 40);
+        read += m;
+        REQUIRE(tSPSCRingBuffer_getNumReady(ring) == written - read);
+    }
+
+    // A full buffer drops what doesn't fit instead of overwriting
+    Lfloat discard[200];
+    tSPSCRingBuffer_pop(ring, discard, 200);
+    REQUIRE(tSPSCRingBuffer_push(ring, input, 200) == 128);
+    REQUIRE(tSPSCRingBuffer_getSpace(ring) == 0);
+    REQUIRE(tSPSCRingBuffer_push(ring, input, 10) == 0);
+    REQUIRE(tSPSCRingBuffer_pop(ring, output, 200) == 128);
+    for (int i = 0; i < 128; i++) REQUIRE(output[i] == input[i]);
+
+    // readLatest returns the newest samples, oldest first, and skips the rest
+    tSPSCRingBuffer_push(ring, input, 50);
+    REQUIRE(tSPSCRingBuffer_readLatest(ring, output, 8) == 8);
+    for (int i = 0; i < 8; i++) REQUIRE(output[i] == input[42 + i]);
+    REQUIRE(tSPSCRingBuffer_getNumReady(ring) == 0);
+    REQUIRE(tSPSCRingBuffer_readLatest(ring, output, 8) == 0);
+
+    REQUIRE_NOTHROW(tSPSCRingBuffer_free(&ring));
+}
+
+TEST_CASE("Tests for `tSPSCRingBuffer` order", "[tSPSCRingBuffer]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tSPSCRingBuffer* ring;
+    tSPSCRingBuffer_init(&ring, 64, &leaf);
+
+    // A running count pushed and popped in uneven blocks comes back without gaps
+    Lfloat block[48];
+    int next = 0, expected = 0;
+    for (int round = 0; round < 200; round++)
+    {
+        int n = 1 + (round * 13) % 48;
+        for (int i = 0; i < n; i++) block[i] = (Lfloat) (next + i);
+        next += tSPSCRingBuffer_push(ring, block, n);
+
+        int m = tSPSCRingBuffer_pop(ring, block, 1 + (round * 11) % 48);
+        for (int i = 0; i < m; i++) REQUIRE(block[i] == (Lfloat) expected++);
+    }
+    REQUIRE(expected + tSPSCRingBuffer_getNumReady(ring) == next);
+
+    REQUIRE_NOTHROW(tSPSCRingBuffer_free(&ring));
+}
+
+TEST_CASE("Tests for `tDelay` block processing", "[tDelay]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tDelay* tick;
+    tDelay* block;
+    tDelay_init(&tick, 100, 256, &leaf);
+    tDelay_init(&block, 100, 256, &leaf);
+    tDelay_clear(tick);
+    tDelay_clear(block);
+
+    Lfloat input[1000], expected[1000], output[1000];
+    for (int i = 0; i < 1000; i++) input[i] = myrand() * 2.0f - 1.0f;
+    for (int i = 0; i < 1000; i++) expected[i] = tDelay_tick(tick, input[i]);
+    for (int i = 100; i < 1000; i++) REQUIRE(expected[i] == input[i - 100]);
+
+    // writeBlock then readBlock matches ticking, including blocks that wrap the buffer
+    int i = 0, n = 1;
+    while (i < 1000)
+    {
+        if (n > 1000 - i) n = 1000 - i;
+        tDelay_writeBlock(block, &input[i], n);
+        tDelay_readBlock(block, &output[i], n);
+        i += n;
+        n = (n * 3) % 97 + 1;
+    }
+    for (i = 0; i < 1000; i++) REQUIRE(output[i] == expected[i]);
+    REQUIRE(tDelay_getLastOut(block) == tDelay_getLastOut(tick));
+
+    REQUIRE_NOTHROW(tDelay_free(&tick));
+    REQUIRE_NOTHROW(tDelay_free(&block));
+}
+
+TEST_CASE("Tests for `tLinearDelay` block processing", "[tLinearDelay]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tLinearDelay* tick;
+    tLinearDelay* block;
+    tLinearDelay_init(&tick, 37.25f, 128, &leaf);
+    tLinearDelay_init(&block, 37.25f, 128, &leaf);
+    tLinearDelay_clear(tick);
+    tLinearDelay_clear(block);
+
+    Lfloat input[1000], expected[1000], output[1000];
+    for (int i = 0; i < 1000; i++) input[i] = myrand() * 2.0f - 1.0f;
+    for (int i = 0; i < 1000; i++) expected[i] = tLinearDelay_tick(tick, input[i]);
+
+    int i = 0, n = 1;
+    while (i < 1000)
+    {
+        if (n > 1000 - i) n = 1000 - i;
+        tLinearDelay_writeBlock(block, &input[i], n);
+        tLinearDelay_readBlock(block, &output[i], n);
+        i += n;
+        n = (n * 5) % 33 + 1;
+    }
+    for (i = 0; i < 1000; i++) REQUIRE(fabsf(output[i] - expected[i]) < 1e-6f);
+
+    REQUIRE_NOTHROW(tLinearDelay_free(&tick));
+    REQUIRE_NOTHROW(tLinearDelay_free(&block));
+}
+
+TEST_CASE("Tests for `tMultiTapDelay`", "[tMultiTapDelay]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tMultiTapDelay* tick;
+    tMultiTapDelay* block;
+    tMultiTapDelay_init(&tick, 3, 256, &leaf);
+    tMultiTapDelay_init(&block, 3, 256, &leaf);
+
+    const Lfloat delays[3] = { 5.0f, 47.75f, 100.5f };
+    const Lfloat gains[3] = { 0.5f, -0.25f, 0.125f };
+    const Lfloat depths[3] = { 0.0f, 3.0f, 10.0f };
+    for (int t = 0; t < 3; t++)
+    {
+        tMultiTapDelay_setTapDelay(tick, t, delays[t]);
+        tMultiTapDelay_setTapGain(tick, t, gains[t]);
+        tMultiTapDelay_setTapModDepth(tick, t, depths[t]);
+        tMultiTapDelay_setTapDelay(block, t, delays[t]);
+        tMultiTapDelay_setTapGain(block, t, gains[t]);
+        tMultiTapDelay_setTapModDepth(block, t, depths[t]);
+    }
+
+    Lfloat input[1024], expected[1024], output[1024];
+    Lfloat mod1[1024], mod2[1024];
+    for (int i = 0; i < 1024; i++)
+    {
+        input[i] = myrand() * 2.0f - 1.0f;
+        mod1[i] = sinf((float) i * 0.01f);
+        mod2[i] = cosf((float) i * 0.003f);
+    }
+
+    // An unmodulated integer tap is the input delayed and scaled
+    tMultiTapDelay* single;
+    tMultiTapDelay_init(&single, 1, 64, &leaf);
+    tMultiTapDelay_setTapDelay(single, 0, 5.0f);
+    tMultiTapDelay_setTapGain(single, 0, 1.0f);
+    for (int i = 0; i < 100; i++)
+    {
+        Lfloat out = tMultiTapDelay_tick(single, input[i]);
+        if (i >= 5) REQUIRE(out == input[i - 5]);
+    }
+
+    for (int i = 0; i < 1024; i++)
+    {
+        Lfloat mod[3] = { 0.0f, mod1[i], mod2[i] };
+        tMultiTapDelay_setModulation(tick, mod);
+        expected[i] = tMultiTapDelay_tick(tick, input[i]);
+    }
+
+    // Blocks with per-sample modulation give the same output as ticking
+    for (int start = 0; start < 1024; start += 64)
+    {
+        const Lfloat* mod[3] = { NULL, &mod1[start], &mod2[start] };
+        tMultiTapDelay_tickBlock(block, &input[start], &output[start], mod, 64);
+    }
+    for (int i = 0; i < 1024; i++) REQUIRE(fabsf(output[i] - expected[i]) < 1e-5f);
+    REQUIRE(fabsf(tMultiTapDelay_getLastOut(block) - tMultiTapDelay_getLastOut(tick)) < 1e-5f);
+
+    REQUIRE_NOTHROW(tMultiTapDelay_free(&single));
+    REQUIRE_NOTHROW(tMultiTapDelay_free(&tick));
+    REQUIRE_NOTHROW(tMultiTapDelay_free(&block));
+}
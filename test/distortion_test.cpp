@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-distortion.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+static float shapeCurve(ADAAShape shape, float x)
+{
+    if (shape == ADAATanh) return LEAF_tanh(x);
+    if (shape == ADAASoftClip) return leaf_softClip(x);
+    return LEAF_clip(-1.0f, x, 1.0f);
+}
+
+TEST_CASE("Tests for `tADAAShaper` order 0", "[tADAAShaper]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    // Without anti-aliasing the shaper is the plain curve
+    for (int shape = ADAATanh; shape < ADAAShapeNil; shape++)
+    {
+        tADAAShaper* shaper;
+        tADAAShaper_init(&shaper, (ADAAShape) shape, 0, &leaf);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            float x = (myrand() * 2.0f - 1.0f) * 4.0f;
+            REQUIRE(fabsf(tADAAShaper_tick(shaper, x) - shapeCurve((ADAAShape) shape, x)) < 1e-6f);
+        }
+
+        REQUIRE_NOTHROW(tADAAShaper_free(&shaper));
+    }
+}
+
+TEST_CASE("Tests for `tADAAShaper` orders 1 and 2", "[tADAAShaper]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    for (int shape = ADAATanh; shape < ADAAShapeNil; shape++)
+    {
+        tADAAShaper* first;
+        tADAAShaper* second;
+        tADAAShaper_init(&first, (ADAAShape) shape, 1, &leaf);
+        tADAAShaper_init(&second, (ADAAShape) shape, 2, &leaf);
+
+        // On a slow input they follow the curve, half a sample and one sample late, once
+        // the zeros they start from have left their history. The hard clip's corners are
+        // rounded off by a fraction of the step between samples.
+        const float tolerance = (shape == ADAAHardClip) ? 5e-3f : 1e-4f;
+        float last = 0.0f;
+        for (int i = 0; i < 4800; i++)
+        {
+            float x = 2.0f * sinf(TWO_PI * 50.0f * (float) i / 48000.0f);
+            float y1 = tADAAShaper_tick(first, x);
+            float y2 = tADAAShaper_tick(second, x);
+            if (i >= 2)
+            {
+                REQUIRE(fabsf(y1 - shapeCurve((ADAAShape) shape, 0.5f * (x + last))) < tolerance);
+                REQUIRE(fabsf(y2 - shapeCurve((ADAAShape) shape, last)) < tolerance);
+            }
+            last = x;
+        }
+
+        // Large jumps and repeated values stay inside the curve's range
+        for (int i = 0; i < 4800; i++)
+        {
+            float x = (i % 5 == 0) ? last : (myrand() * 2.0f - 1.0f) * 8.0f;
+            REQUIRE(fabsf(tADAAShaper_tick(first, x)) <= 1.0f + 1e-5f);
+            REQUIRE(fabsf(tADAAShaper_tick(second, x)) <= 1.0f + 1e-5f);
+            last = x;
+        }
+
+        // A held input settles to the curve at that input
+        for (int i = 0; i < 4; i++)
+        {
+            tADAAShaper_tick(first, 0.3f);
+            tADAAShaper_tick(second, 0.3f);
+        }
+        REQUIRE(fabsf(tADAAShaper_tick(first, 0.3f) - shapeCurve((ADAAShape) shape, 0.3f)) < 1e-5f);
+        REQUIRE(fabsf(tADAAShaper_tick(second, 0.3f) - shapeCurve((ADAAShape) shape, 0.3f)) < 1e-5f);
+
+        REQUIRE_NOTHROW(tADAAShaper_free(&first));
+        REQUIRE_NOTHROW(tADAAShaper_free(&second));
+    }
+}
+
+TEST_CASE("Tests for `tWavefolder` ADAA under modulation", "[tWavefolder]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    // Changing the shape between samples must not leave spikes in the anti-aliased output
+    float peaks[3];
+    for (int order = 0; order < 3; order++)
+    {
+        srand(1);
+        tWavefolder* folder;
+        tWavefolder_init(&folder, 0.4f, 0.0f, 0.8f, &leaf);
+        tWavefolder_setADAAOrder(folder, order);
+
+        peaks[order] = 0.0f;
+        for (int i = 0; i < 48000; i++)
+        {
+            if (i % 64 == 0)
+            {
+                tWavefolder_setFFAmount(folder, 0.2f + 0.6f * myrand());
+                tWavefolder_setFoldDepth(folder, 0.2f + myrand());
+            }
+            float y = tWavefolder_tick(folder, sinf(TWO_PI * 220.0f * (float) i / 48000.0f));
+            peaks[order] = fmaxf(peaks[order], fabsf(y));
+        }
+
+        REQUIRE_NOTHROW(tWavefolder_free(&folder));
+    }
+    REQUIRE(peaks[1] < peaks[0] * 1.1f);
+    REQUIRE(peaks[2] < peaks[0] * 1.1f);
+}
+
+TEST_CASE("Tests for `tADAAShaper` out of range shapes", "[tADAAShaper]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    // Shapes past either end are clamped to the nearest curve
+    tADAAShaper* low;
+    tADAAShaper* high;
+    tADAAShaper* set;
+    tADAAShaper* tanhShaper;
+    tADAAShaper* hardShaper;
+    tADAAShaper_init(&low, (ADAAShape) -3, 1, &leaf);
+    tADAAShaper_init(&high, (ADAAShape) (ADAAShapeNil + 5), 1, &leaf);
+    tADAAShaper_init(&set, ADAASoftClip, 1, &leaf);
+    tADAAShaper_init(&tanhShaper, ADAATanh, 1, &leaf);
+    tADAAShaper_init(&hardShaper, ADAAHardClip, 1, &leaf);
+    tADAAShaper_setShape(set, ADAAShapeNil);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        float x = (myrand() * 2.0f - 1.0f) * 4.0f;
+        float tanhOut = tADAAShaper_tick(tanhShaper, x);
+        float hardOut = tADAAShaper_tick(hardShaper, x);
+        REQUIRE(tADAAShaper_tick(low, x) == tanhOut);
+        REQUIRE(tADAAShaper_tick(high, x) == hardOut);
+        REQUIRE(tADAAShaper_tick(set, x) == hardOut);
+    }
+
+    REQUIRE_NOTHROW(tADAAShaper_free(&low));
+    REQUIRE_NOTHROW(tADAAShaper_free(&high));
+    REQUIRE_NOTHROW(tADAAShaper_free(&set));
+    REQUIRE_NOTHROW(tADAAShaper_free(&tanhShaper));
+    REQUIRE_NOTHROW(tADAAShaper_free(&hardShaper));
+}
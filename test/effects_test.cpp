@@ -0,0 +1,350 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-effects.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+TEST_CASE("Tests for `tVocoder` coefficient caching", "[tVocoder]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tVocoder* reference;
+    tVocoder* cached;
+    tVocoder* lazy;
+    tVocoder_init(&reference, &leaf);
+    tVocoder_init(&cached, &leaf);
+    tVocoder_init(&lazy, &leaf);
+    tVocoder_setCoeffMode(lazy, LEAFCoeffsLazy);
+
+    // The reference forgets what its band filters were computed for, so every update redoes
+    // them. Skipping that work, or putting all of it off until the next tick, changes nothing.
+    for (int i = 0; i < 20000; i++)
+    {
+        int numUpdates = (i % 16 == 0) ? 1 + rand() % 3 : 0;
+        for (int u = 0; u < numUpdates; u++)
+        {
+            int p = rand() % NUM_VOCODER_PARAM;
+            Lfloat value = myrand();
+            reference->param[p] = value;
+            cached->param[p] = value;
+            lazy->param[p] = value;
+
+            reference->bandParams[0] = -1.0f;
+            tVocoder_update(reference);
+            tVocoder_update(cached);
+            tVocoder_update(lazy);
+        }
+
+        Lfloat synth = myrand() * 2.0f - 1.0f;
+        Lfloat voice = 0.5f * sinf((float) i * 0.05f) + 0.1f * (myrand() * 2.0f - 1.0f);
+        Lfloat expected = tVocoder_tick(reference, synth, voice);
+        REQUIRE(tVocoder_tick(cached, synth, voice) == expected);
+        REQUIRE(tVocoder_tick(lazy, synth, voice) == expected);
+    }
+
+    // Switching back to immediate settles anything still pending
+    lazy->param[6] = reference->param[6] = cached->param[6] = 0.2f;
+    reference->bandParams[0] = -1.0f;
+    tVocoder_update(reference);
+    tVocoder_update(lazy);
+    tVocoder_setCoeffMode(lazy, LEAFCoeffsImmediate);
+    REQUIRE(lazy->dirty == 0);
+    for (int b = 0; b < NBANDS; b++)
+        for (int c = 0; c < 3; c++)
+            REQUIRE(lazy->f[b][c] == reference->f[b][c]);
+
+    REQUIRE_NOTHROW(tVocoder_free(&reference));
+    REQUIRE_NOTHROW(tVocoder_free(&cached));
+    REQUIRE_NOTHROW(tVocoder_free(&lazy));
+}
+
+TEST_CASE("Tests for `tSOLAD` shared input", "[tSOLAD]") {
+
+    LEAF leaf;
+    char leafMemory[200000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 200000, &myrand);
+
+    // Voices reading one conditioned input match voices that each condition their own
+    const Lfloat factors[3] = { 0.75f, 1.0f, 1.5f };
+    tSOLAD* own[3];
+    tSOLAD* shared[3];
+    for (int v = 0; v < 3; v++)
+    {
+        tSOLAD_init(&own[v], 2048, &leaf);
+        tSOLAD_init(&shared[v], 2048, &leaf);
+        if (v > 0) tSOLAD_setInput(shared[v], shared[0]);
+    }
+
+    Lfloat in[64], outOwn[64], outShared[64];
+    for (int b = 0; b < 600; b++)
+    {
+        // Resetting every voice, source first, keeps them matching
+        if (b == 200)
+            for (int v = 0; v < 3; v++)
+            {
+                tSOLAD_resetState(own[v]);
+                tSOLAD_resetState(shared[v]);
+            }
+        // A sharing voice reset on its own starts again like one newly given the shared input
+        if (b == 333)
+        {
+            tSOLAD_resetState(shared[2]);
+            tSOLAD_free(&own[2]);
+            tSOLAD_init(&own[2], 2048, &leaf);
+            tSOLAD_setInput(own[2], shared[0]);
+        }
+
+        Lfloat freq = (b < 300) ? 220.0f : 310.0f;
+        for (int i = 0; i < 64; i++)
+        {
+            Lfloat t = (Lfloat) (b * 64 + i) / 48000.0f;
+            in[i] = sinf(TWO_PI * freq * t) * ((b % 100 < 5) ? 0.05f : 0.5f) + 0.01f * (myrand() - 0.5f);
+        }
+        for (int v = 0; v < 3; v++)
+        {
+            Lfloat factor = factors[v] * ((b % 150 < 75) ? 1.0f : 1.1f);
+            tSOLAD_setPeriod(own[v], 48000.0f / freq);
+            tSOLAD_setPeriod(shared[v], 48000.0f / freq);
+            tSOLAD_setPitchFactor(own[v], factor);
+            tSOLAD_setPitchFactor(shared[v], factor);
+            // tSOLAD adds into its output
+            for (int i = 0; i < 64; i++) outOwn[i] = outShared[i] = 0.0f;
+            tSOLAD_ioSamples(shared[v], in, outShared, 64);
+            tSOLAD_ioSamples(own[v], in, outOwn, 64);
+            for (int i = 0; i < 64; i++) REQUIRE(outShared[i] == outOwn[i]);
+        }
+    }
+
+    for (int v = 0; v < 3; v++)
+    {
+        REQUIRE_NOTHROW(tSOLAD_free(&own[v]));
+        REQUIRE_NOTHROW(tSOLAD_free(&shared[v]));
+    }
+}
+
+// tSOLAD's resynthesis done one sample at a time, reading the delay buffer of the tSOLAD under test
+typedef struct SOLADReference
+{
+    Lfloat readlag, jump, xfadevalue, xfadelength;
+} SOLADReference;
+
+static Lfloat referenceRead(tSOLAD* w, Lfloat index)
+{
+    int i = (int) index;
+    Lfloat fraction = index - (Lfloat) i;
+    i &= (w->loopSize - 1);
+    return w->delaybuf[i] + fraction * (w->delaybuf[i + 1] - w->delaybuf[i]);
+}
+
+// Runs on the block tSOLAD_ioSamples has just written, with timeindex where the block started
+static void referenceBlock(SOLADReference* r, tSOLAD* w, int timeindex, Lfloat* out, int n)
+{
+    int attack = (w->source != NULL) ? w->source->attack : w->attack;
+    if (attack && w->blocksize < r->readlag)
+    {
+        r->jump = r->readlag - w->blocksize;
+        r->readlag = w->blocksize;
+        r->xfadelength = w->blocksize;
+        r->xfadevalue = 1;
+    }
+
+    Lfloat refindex = (Lfloat) (timeindex + w->loopSize);
+    Lfloat pitchfactor = w->pitchfactor, period = w->period;
+    if (pitchfactor > 1)
+    {
+        Lfloat readlagstep = pitchfactor - 1;
+        Lfloat xfadespeed = pitchfactor * pitchfactor;
+        Lfloat xfadestep = xfadespeed / r->xfadelength;
+        Lfloat limitfactor = (pitchfactor - (Lfloat) 0.99) / xfadespeed;
+        Lfloat limit = period * limitfactor;
+        if ((r->readlag > (period + 2 * limit)) & (r->xfadevalue < 0))
+        {
+            r->jump = period;
+            while ((r->jump * 2) < (r->readlag - 2 * limit)) r->jump *= 2;
+            r->readlag -= r->jump;
+            r->xfadevalue = 1;
+            r->xfadelength = period - 1;
+            xfadestep = xfadespeed / r->xfadelength;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            if (r->readlag < limit && ((r->xfadevalue < 0) | (r->readlag < 0)))
+            {
+                r->xfadelength = r->readlag / limitfactor;
+                if (r->xfadelength < 1) r->xfadelength = 1;
+                xfadestep = xfadespeed / r->xfadelength;
+                r->jump = -period;
+                r->readlag += period;
+                r->xfadevalue = 1;
+            }
+            Lfloat readindex = refindex - r->readlag;
+            Lfloat sample = referenceRead(w, readindex);
+            if (r->xfadevalue > 0)
+            {
+                sample *= (1 - r->xfadevalue);
+                sample += referenceRead(w, readindex - r->jump) * r->xfadevalue;
+                r->xfadevalue -= xfadestep;
+            }
+            out[i] = sample;
+            refindex += 1;
+            r->readlag -= readlagstep;
+        }
+    }
+    else
+    {
+        Lfloat readlagstep = 1 - pitchfactor;
+        Lfloat xfadespeed = (pitchfactor > 0.5) ? pitchfactor : 1 - pitchfactor;
+        Lfloat xfadestep = xfadespeed / r->xfadelength;
+        for (int i = 0; i < n; i++)
+        {
+            if (r->readlag > period && r->xfadevalue <= 0)
+            {
+                r->jump = period;
+                while ((r->jump * 2) < r->readlag) r->jump *= 2;
+                r->readlag -= r->jump;
+                r->xfadevalue = 1;
+                r->xfadelength = period - 1;
+                xfadestep = xfadespeed / r->xfadelength;
+            }
+            Lfloat readindex = refindex - r->readlag;
+            Lfloat sample = referenceRead(w, readindex);
+            if (r->xfadevalue > 0)
+            {
+                sample *= (1 - r->xfadevalue);
+                sample += referenceRead(w, readindex - r->jump) * r->xfadevalue;
+                r->xfadevalue -= xfadestep;
+            }
+            out[i] = sample;
+            refindex += 1;
+            r->readlag += readlagstep;
+        }
+    }
+}
+
+TEST_CASE("Tests for `tSOLAD` against a per-sample reference", "[tSOLAD]") {
+
+    LEAF leaf;
+    char leafMemory[200000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 200000, &myrand);
+
+    // Below 1, exactly 1 where the read lag stands still, and above 1, with the factor and period
+    // moving now and then so jumps land anywhere in a block and crossfades run across blocks
+    const Lfloat factors[8] = { 0.3f, 0.5f, 0.8f, 0.97f, 1.0f, 1.03f, 1.5f, 3.0f };
+    for (int f = 0; f < 8; f++)
+    {
+        for (int blocksize = 16; blocksize <= 64; blocksize *= 4)
+        {
+            tSOLAD* solad;
+            tSOLAD_init(&solad, 2048, &leaf);
+            SOLADReference r = { solad->readlag, solad->jump, solad->xfadevalue, solad->xfadelength };
+
+            srand(5);
+            static Lfloat out[48000], expected[48000];
+            Lfloat in[64];
+            Lfloat signal = 0.0f, noise = 0.0f, steps = 0.0f, expectedSteps = 0.0f;
+            for (int start = 0; start + blocksize <= 48000; start += blocksize)
+            {
+                int b = start / 1024;
+                Lfloat freq = 150.0f + 23.0f * (Lfloat) (b % 7);
+                Lfloat factor = factors[f] * ((b % 5 == 4) ? 1.0f + 0.02f * (Lfloat) (b % 3) : 1.0f);
+                for (int i = 0; i < blocksize; i++)
+                {
+                    Lfloat t = (Lfloat) (start + i) / 48000.0f;
+                    in[i] = ((b % 11 == 10) ? 0.8f : 0.3f) * sinf(TWO_PI * freq * t);
+                    out[start + i] = 0.0f;
+                }
+                tSOLAD_setPeriod(solad, 48000.0f / freq);
+                tSOLAD_setPitchFactor(solad, factor);
+
+                int timeindex = solad->timeindex;
+                tSOLAD_ioSamples(solad, in, &out[start], blocksize);
+                referenceBlock(&r, solad, timeindex, &expected[start], blocksize);
+
+                // Jumps and crossfade ends land on the same samples as the reference's
+                REQUIRE(solad->readlag == r.readlag);
+                REQUIRE(solad->xfadevalue == r.xfadevalue);
+                REQUIRE(solad->jump == r.jump);
+            }
+            for (int i = 1; i < 48000; i++)
+            {
+                signal += expected[i] * expected[i];
+                noise += (out[i] - expected[i]) * (out[i] - expected[i]);
+                steps = fmaxf(steps, fabsf(out[i] - out[i - 1]));
+                expectedSteps = fmaxf(expectedSteps, fabsf(expected[i] - expected[i - 1]));
+            }
+
+            // Reads differ from the reference's only by rounding, so there are no steps it doesn't have
+            REQUIRE(steps <= expectedSteps + 1e-4f);
+            REQUIRE(10.0f * log10f(signal / (noise + 1e-20f)) > 80.0f);
+
+            REQUIRE_NOTHROW(tSOLAD_free(&solad));
+        }
+    }
+}
+
+TEST_CASE("Tests for `tRetune` against a per-sample reference", "[tRetune]") {
+
+    LEAF leaf;
+    char leafMemory[500000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 500000, &myrand);
+
+    // Voices sharing one input, with the pitch detector setting their periods
+    const Lfloat factors[4] = { 0.8f, 0.5f, 1.0f, 1.5f };
+    tRetune* retune;
+    tRetune_init(&retune, 4, 70.0f, 1000.0f, 64, &leaf);
+    tRetune_tuneVoices(retune, (Lfloat*) factors);
+    SOLADReference refs[4];
+    for (int v = 0; v < 4; v++)
+    {
+        tSOLAD* w = retune->ps[v]->sola;
+        refs[v] = { w->readlag, w->jump, w->xfadevalue, w->xfadelength };
+    }
+
+    srand(6);
+    static Lfloat out[4][96000], expected[4][96000];
+    Lfloat phase = 0.0f;
+    for (int i = 0; i < 96000; i++)
+    {
+        // A bright tone gliding between notes, with some noise and a couple of louder notes
+        Lfloat freq = 110.0f * powf(2.0f, (Lfloat) ((i / 12000) % 5) / 4.0f);
+        phase += freq / 48000.0f;
+        if (phase >= 1.0f) phase -= 1.0f;
+        Lfloat amplitude = (i % 24000 < 12000) ? 0.3f : 0.6f;
+        Lfloat x = amplitude * (sinf(TWO_PI * phase) + 0.5f * sinf(2.0f * TWO_PI * phase) + 0.25f * sinf(3.0f * TWO_PI * phase))
+                   + 0.01f * (myrand() - 0.5f);
+        tRetune_tick(retune, x);
+
+        if (retune->index == 0)
+        {
+            int start = i - 63;
+            for (int v = 0; v < 4; v++)
+            {
+                tSOLAD* w = retune->ps[v]->sola;
+                int timeindex = (w->timeindex - 64) & (w->loopSize - 1);
+                for (int j = 0; j < 64; j++) out[v][start + j] = retune->outBuffers[v][j];
+                referenceBlock(&refs[v], w, timeindex, &expected[v][start], 64);
+                REQUIRE(w->readlag == refs[v].readlag);
+                REQUIRE(w->xfadevalue == refs[v].xfadevalue);
+            }
+        }
+    }
+
+    for (int v = 0; v < 4; v++)
+    {
+        Lfloat signal = 0.0f, noise = 0.0f, steps = 0.0f, expectedSteps = 0.0f;
+        for (int i = 1; i < 96000; i++)
+        {
+            signal += expected[v][i] * expected[v][i];
+            noise += (out[v][i] - expected[v][i]) * (out[v][i] - expected[v][i]);
+            steps = fmaxf(steps, fabsf(out[v][i] - out[v][i - 1]));
+            expectedSteps = fmaxf(expectedSteps, fabsf(expected[v][i] - expected[v][i - 1]));
+        }
+        REQUIRE(steps <= expectedSteps + 1e-4f);
+        REQUIRE(10.0f * log10f(signal / (noise + 1e-20f)) > 80.0f);
+    }
+
+    REQUIRE_NOTHROW(tRetune_free(&retune));
+}
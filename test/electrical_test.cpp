@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-electrical.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+// The circuits under test. Each one is built twice, once for tWDF_tick and once for the program.
+typedef struct WDFCircuit
+{
+    tWDF* nodes[8];
+    int numNodes;
+    tWDF* root;
+    tWDF* output;
+    tWDF* tuned;        // the part whose value is changed mid-run
+} WDFCircuit;
+
+static tWDF* addNode(WDFCircuit* c, WDFComponentType type, Lfloat value, tWDF* left, tWDF* right, LEAF* leaf)
+{
+    tWDF* n;
+    tWDF_init(&n, type, value, &left, &right, leaf);
+    c->nodes[c->numNodes++] = n;
+    return n;
+}
+
+static void buildCircuit(WDFCircuit* c, int which, LEAF* leaf)
+{
+    c->numNodes = 0;
+    if (which == 0)
+    {
+        // RC lowpass into a diode pair clipper
+        tWDF* source = addNode(c, ResistiveSource, 1000.0f, NULL, NULL, leaf);
+        tWDF* cap = addNode(c, Capacitor, 1.0e-7f, NULL, NULL, leaf);
+        tWDF* par = addNode(c, ParallelAdaptor, 0.0f, source, cap, leaf);
+        c->root = addNode(c, DiodePair, 0.0f, par, NULL, leaf);
+        c->output = cap;
+        c->tuned = cap;
+    }
+    else if (which == 1)
+    {
+        // Series RLC driven by an ideal source, with the inductor behind an inverter
+        tWDF* res = addNode(c, Resistor, 100.0f, NULL, NULL, leaf);
+        tWDF* cap = addNode(c, Capacitor, 1.0e-6f, NULL, NULL, leaf);
+        tWDF* ind = addNode(c, Inductor, 0.01f, NULL, NULL, leaf);
+        tWDF* inv = addNode(c, Inverter, 0.0f, ind, NULL, leaf);
+        tWDF* par = addNode(c, ParallelAdaptor, 0.0f, cap, inv, leaf);
+        tWDF* ser = addNode(c, SeriesAdaptor, 0.0f, res, par, leaf);
+        c->root = addNode(c, IdealSource, 0.0f, ser, NULL, leaf);
+        c->output = cap;
+        c->tuned = ind;
+    }
+    else
+    {
+        // Half wave rectifier into an RC load
+        tWDF* source = addNode(c, ResistiveSource, 2200.0f, NULL, NULL, leaf);
+        tWDF* cap = addNode(c, Capacitor, 4.7e-8f, NULL, NULL, leaf);
+        tWDF* ser = addNode(c, SeriesAdaptor, 0.0f, source, cap, leaf);
+        c->root = addNode(c, Diode, 0.0f, ser, NULL, leaf);
+        c->output = cap;
+        c->tuned = source;
+    }
+}
+
+static void freeCircuit(WDFCircuit* c)
+{
+    for (int i = c->numNodes - 1; i >= 0; i--) tWDF_free(&c->nodes[i]);
+}
+
+TEST_CASE("Tests for `tWDFProgram` against `tWDF_tick`", "[tWDFProgram]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    const Lfloat newValues[3] = { 4.7e-8f, 0.022f, 4700.0f };
+    for (int which = 0; which < 3; which++)
+    {
+        WDFCircuit tree, compiled;
+        buildCircuit(&tree, which, &leaf);
+        buildCircuit(&compiled, which, &leaf);
+
+        tWDFProgram* program;
+        tWDFProgram* blockProgram;
+        tWDFProgram_init(&program, compiled.root, compiled.output, &leaf);
+        tWDFProgram_init(&blockProgram, compiled.root, compiled.output, &leaf);
+
+        // A tone with noise on top, loud enough to drive the diodes into conduction
+        Lfloat input[4800], expected[4800], output[4800], block[4800];
+        for (int i = 0; i < 4800; i++)
+            input[i] = 2.0f * sinf(TWO_PI * 440.0f * (float) i / 48000.0f) + 0.2f * (myrand() * 2.0f - 1.0f);
+
+        // Halfway through, one part changes value in both the tree and the program
+        Lfloat peak = 0.0f;
+        for (int i = 0; i < 4800; i++)
+        {
+            uint8_t changed = 0;
+            if (i == 2400)
+            {
+                tWDF_setValue(tree.tuned, newValues[which]);
+                tWDF_setValue(compiled.tuned, newValues[which]);
+                tWDF_setSampleRate(tree.tuned, 48000.0f);
+                tWDF_setSampleRate(compiled.tuned, 48000.0f);
+                tWDFProgram_update(program);
+                tWDFProgram_update(blockProgram);
+                changed = 1;
+            }
+            expected[i] = tWDF_tick(tree.root, input[i], tree.output, changed);
+            output[i] = tWDFProgram_tick(program, input[i]);
+            peak = fmaxf(peak, fabsf(expected[i]));
+        }
+
+        // Both run the same scattering, only the order of the float operations differs
+        REQUIRE(peak > 0.1f);
+        for (int i = 0; i < 4800; i++) REQUIRE(fabsf(output[i] - expected[i]) <= 1e-4f * peak);
+
+        // Blocks of any size give exactly what ticking the program does, from the same start
+        tWDFProgram_free(&program);
+        tWDFProgram_free(&blockProgram);
+        tWDFProgram_init(&program, compiled.root, compiled.output, &leaf);
+        tWDFProgram_init(&blockProgram, compiled.root, compiled.output, &leaf);
+        for (int i = 0; i < 4800; i++) output[i] = tWDFProgram_tick(program, input[i]);
+        int i = 0, n = 1;
+        while (i < 4800)
+        {
+            if (n > 4800 - i) n = 4800 - i;
+            tWDFProgram_tickBlock(blockProgram, &input[i], &block[i], n);
+            i += n;
+            n = (n * 7) % 129 + 1;
+        }
+        for (i = 0; i < 4800; i++) REQUIRE(block[i] == output[i]);
+
+        REQUIRE_NOTHROW(tWDFProgram_free(&program));
+        REQUIRE_NOTHROW(tWDFProgram_free(&blockProgram));
+        freeCircuit(&tree);
+        freeCircuit(&compiled);
+    }
+}
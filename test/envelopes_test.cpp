@@ -0,0 +1,339 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-envelopes.h"
+#include "../leaf/Inc/leaf-midi.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+#define EXP_BUFFER_SIZE 2048
+static Lfloat expBuffer[EXP_BUFFER_SIZE];
+
+static void fillExpBuffer(void)
+{
+    for (int i = 0; i < EXP_BUFFER_SIZE; i++) expBuffer[i] = expf(-6.0f * (float) i / (float) EXP_BUFFER_SIZE);
+}
+
+// Every sample of a control rate block sits on the line between the ticks either side of it
+static void requireInterpolated(const Lfloat* out, int numSamples, int samplesPerTick, Lfloat start)
+{
+    Lfloat from = start;
+    for (int i = 0; i < numSamples; i += samplesPerTick)
+    {
+        Lfloat to = out[i + samplesPerTick - 1];
+        for (int j = 0; j < samplesPerTick; j++)
+            REQUIRE(fabsf(out[i + j] - (from + (to - from) * (Lfloat) (j + 1) / (Lfloat) samplesPerTick)) < 1e-6f);
+        from = to;
+    }
+}
+
+TEST_CASE("Tests for `tExpSmooth` control rate", "[tExpSmooth]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tExpSmooth* audio;
+    tExpSmooth* block;
+    tExpSmooth* control;
+    tExpSmooth_init(&audio, 0.0f, 0.01f, &leaf);
+    tExpSmooth_init(&block, 0.0f, 0.01f, &leaf);
+    tExpSmooth_init(&control, 0.0f, 0.01f, &leaf);
+
+    // Going to control rate and back leaves the audio rate smoother as it was
+    tExpSmooth_setSamplesPerTick(block, 16);
+    tExpSmooth_setSamplesPerTick(block, 1);
+    tExpSmooth_setSamplesPerTick(control, 8);
+
+    Lfloat expected[64], out[64];
+    for (int b = 0; b < 200; b++)
+    {
+        if (b % 20 == 0)
+        {
+            Lfloat dest = myrand() * 2.0f - 1.0f;
+            tExpSmooth_setDest(audio, dest);
+            tExpSmooth_setDest(block, dest);
+            tExpSmooth_setDest(control, dest);
+        }
+
+        // One sample per tick is the audio rate smoother, bit for bit
+        for (int i = 0; i < 64; i++) expected[i] = tExpSmooth_tick(audio);
+        tExpSmooth_tickBlock(block, out, 64);
+        for (int i = 0; i < 64; i++) REQUIRE(out[i] == expected[i]);
+
+        // Eight samples per tick land where the audio rate smoother is at the end of each tick
+        Lfloat start = tExpSmooth_sample(control);
+        tExpSmooth_tickBlock(control, out, 64);
+        requireInterpolated(out, 64, 8, start);
+        for (int i = 7; i < 64; i += 8) REQUIRE(fabsf(out[i] - expected[i]) < 1e-5f);
+    }
+
+    REQUIRE_NOTHROW(tExpSmooth_free(&audio));
+    REQUIRE_NOTHROW(tExpSmooth_free(&block));
+    REQUIRE_NOTHROW(tExpSmooth_free(&control));
+}
+
+TEST_CASE("Tests for `tRamp` control rate", "[tRamp]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tRamp* audio;
+    tRamp* block;
+    tRamp* control;
+    tRamp_init(&audio, 20.0f, 1, &leaf);
+    tRamp_init(&block, 20.0f, 1, &leaf);
+    tRamp_init(&control, 20.0f, 1, &leaf);
+    tRamp_setSamplesPerTick(block, 4);
+    tRamp_setSamplesPerTick(block, 1);
+    tRamp_setSamplesPerTick(control, 16);
+
+    Lfloat expected[64], out[64];
+    for (int b = 0; b < 200; b++)
+    {
+        if (b % 25 == 0)
+        {
+            Lfloat dest = myrand() * 100.0f;
+            tRamp_setDest(audio, dest);
+            tRamp_setDest(block, dest);
+            tRamp_setDest(control, dest);
+        }
+
+        for (int i = 0; i < 64; i++) expected[i] = tRamp_tick(audio);
+        tRamp_tickBlock(block, out, 64);
+        for (int i = 0; i < 64; i++) REQUIRE(out[i] == expected[i]);
+
+        // The ramp takes the same time to get there at either rate
+        Lfloat start = tRamp_sample(control);
+        tRamp_tickBlock(control, out, 64);
+        requireInterpolated(out, 64, 16, start);
+        for (int i = 15; i < 64; i += 16) REQUIRE(fabsf(out[i] - expected[i]) < 5e-3f);
+    }
+
+    REQUIRE_NOTHROW(tRamp_free(&audio));
+    REQUIRE_NOTHROW(tRamp_free(&block));
+    REQUIRE_NOTHROW(tRamp_free(&control));
+}
+
+TEST_CASE("Tests for `tADSRT` control rate", "[tADSRT]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+    fillExpBuffer();
+
+    tADSRT* audio;
+    tADSRT* block;
+    tADSRT* control;
+    tADSRT_init(&audio, 10.0f, 40.0f, 0.5f, 60.0f, expBuffer, EXP_BUFFER_SIZE, &leaf);
+    tADSRT_init(&block, 10.0f, 40.0f, 0.5f, 60.0f, expBuffer, EXP_BUFFER_SIZE, &leaf);
+    tADSRT_init(&control, 10.0f, 40.0f, 0.5f, 60.0f, expBuffer, EXP_BUFFER_SIZE, &leaf);
+    tADSRT_setLeakFactor(audio, 0.99999f);
+    tADSRT_setLeakFactor(block, 0.99999f);
+    tADSRT_setLeakFactor(control, 0.99999f);
+    tADSRT_setSamplesPerTick(block, 32);
+    tADSRT_setSamplesPerTick(block, 1);
+    tADSRT_setSamplesPerTick(control, 8);
+
+    // Note on, held through the decay, off through the release, then retriggered
+    const int numSamples = 48000;
+    static Lfloat expected[48000], out[48000];
+    int i = 0;
+    while (i < numSamples)
+    {
+        if (i == 0 || i == 30000)
+        {
+            tADSRT_on(audio, 0.8f);
+            tADSRT_on(block, 0.8f);
+        }
+        if (i == 12000)
+        {
+            tADSRT_off(audio);
+            tADSRT_off(block);
+        }
+        for (int j = 0; j < 64; j++) expected[i + j] = tADSRT_tick(audio);
+        tADSRT_tickBlock(block, &out[i], 64);
+        for (int j = 0; j < 64; j++) REQUIRE(out[i + j] == expected[i + j]);
+        i += 64;
+    }
+
+    // Tick k of the control rate envelope reads it k * 8 samples in, so stage times are kept.
+    // Stage ends can only be seen on a tick, so allow what the envelope moves within one tick.
+    Lfloat start = control->next;
+    for (i = 0; i < numSamples; i += 64)
+    {
+        if (i == 0 || i == 30000) tADSRT_on(control, 0.8f);
+        if (i == 12000) tADSRT_off(control);
+        tADSRT_tickBlock(control, &out[i], 64);
+    }
+    requireInterpolated(out, numSamples, 8, start);
+    for (int k = 0; k < numSamples / 8; k++)
+    {
+        int n = k * 8;
+        Lfloat lo = expected[n], hi = expected[n];
+        for (int j = n - 8; j <= n + 8; j++)
+        {
+            if (j < 0 || j >= numSamples) continue;
+            lo = fminf(lo, expected[j]);
+            hi = fmaxf(hi, expected[j]);
+        }
+        REQUIRE(out[n + 7] >= lo - 1e-4f);
+        REQUIRE(out[n + 7] <= hi + 1e-4f);
+    }
+
+    REQUIRE_NOTHROW(tADSRT_free(&audio));
+    REQUIRE_NOTHROW(tADSRT_free(&block));
+    REQUIRE_NOTHROW(tADSRT_free(&control));
+}
+
+TEST_CASE("Tests for `tPoly` control rate pitch", "[tPoly]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tPoly* audio;
+    tPoly* control;
+    tPoly_init(&audio, 2, &leaf);
+    tPoly_init(&control, 2, &leaf);
+    tPoly_setSamplesPerTick(control, 8);
+
+    Lfloat pitch0[64], pitch1[64];
+    Lfloat* pitches[2] = { pitch0, pitch1 };
+    for (int b = 0; b < 100; b++)
+    {
+        if (b % 25 == 0)
+        {
+            int note = 40 + rand() % 40;
+            Lfloat bend = myrand() * 2.0f - 1.0f;
+            tPoly_noteOn(audio, note, 100);
+            tPoly_noteOn(control, note, 100);
+            tPoly_setPitchBend(audio, bend);
+            tPoly_setPitchBend(control, bend);
+        }
+
+        // The glides and bend reach each control point when the audio rate ones do
+        Lfloat expected[2][64];
+        for (int i = 0; i < 64; i++)
+        {
+            tPoly_tickPitch(audio);
+            for (int v = 0; v < 2; v++) expected[v][i] = tPoly_getPitch(audio, v);
+        }
+        tPoly_tickPitchBlock(control, pitches, 64);
+        for (int v = 0; v < 2; v++)
+            for (int i = 7; i < 64; i += 8)
+                REQUIRE(fabsf(pitches[v][i] - expected[v][i]) < 1e-3f);
+    }
+
+    REQUIRE_NOTHROW(tPoly_free(&audio));
+    REQUIRE_NOTHROW(tPoly_free(&control));
+}
+
+TEST_CASE("Tests for `tADSRT` recursive stage time changes", "[tADSRT]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+    fillExpBuffer();
+
+    tADSRT* table;
+    tADSRT* recursive;
+    tADSRT* block;
+    tADSRT_init(&table, 20.0f, 40.0f, 0.5f, 60.0f, expBuffer, EXP_BUFFER_SIZE, &leaf);
+    tADSRT_init(&recursive, 20.0f, 40.0f, 0.5f, 60.0f, expBuffer, EXP_BUFFER_SIZE, &leaf);
+    tADSRT_init(&block, 20.0f, 40.0f, 0.5f, 60.0f, expBuffer, EXP_BUFFER_SIZE, &leaf);
+    tADSRT* envs[3] = { table, recursive, block };
+
+    // Each stage time changes part way through its own stage, faster and slower
+    const int numSamples = 14400;
+    static Lfloat expected[14400], out[14400], outBlock[14400];
+    const int events[7] = { 0, 300, 1400, 8000, 8800, 10000, numSamples };
+    for (int e = 0; e < 6; e++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            if (e == 0) tADSRT_on(envs[k], 0.9f);
+            if (e == 1) tADSRT_setAttack(envs[k], 5.0f);
+            if (e == 2) tADSRT_setDecay(envs[k], 90.0f);
+            if (e == 3) tADSRT_off(envs[k]);
+            if (e == 4) tADSRT_setRelease(envs[k], 15.0f);
+        }
+        for (int i = events[e]; i < events[e + 1]; i++)
+        {
+            expected[i] = tADSRT_tick(table);
+            out[i] = tADSRT_tickRecursive(recursive);
+        }
+        for (int i = events[e], n = 1; i < events[e + 1]; i += n, n = n * 3 % 61 + 1)
+        {
+            if (n > events[e + 1] - i) n = events[e + 1] - i;
+            tADSRT_renderBlock(block, &outBlock[i], n);
+        }
+    }
+
+    // The recurrence keeps to the table's shape and timing, and blocks give the same output as ticking
+    for (int i = 0; i < numSamples; i++)
+    {
+        REQUIRE(fabsf(out[i] - expected[i]) < 5e-3f);
+        REQUIRE(outBlock[i] == out[i]);
+    }
+    REQUIRE(expected[numSamples - 1] == 0.0f);
+    REQUIRE(out[numSamples - 1] == 0.0f);
+
+    REQUIRE_NOTHROW(tADSRT_free(&table));
+    REQUIRE_NOTHROW(tADSRT_free(&recursive));
+    REQUIRE_NOTHROW(tADSRT_free(&block));
+}
+
+TEST_CASE("Tests for `tADSR` recursive stage time changes", "[tADSR]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tADSR* table;
+    tADSR* recursive;
+    tADSR* block;
+    tADSR_init(&table, 20.0f, 40.0f, 0.5f, 60.0f, &leaf);
+    tADSR_init(&recursive, 20.0f, 40.0f, 0.5f, 60.0f, &leaf);
+    tADSR_init(&block, 20.0f, 40.0f, 0.5f, 60.0f, &leaf);
+    tADSR* envs[3] = { table, recursive, block };
+
+    const int numSamples = 14400;
+    static Lfloat expected[14400], out[14400], outBlock[14400];
+    const int events[7] = { 0, 300, 1400, 8000, 8800, 10000, numSamples };
+    for (int e = 0; e < 6; e++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            if (e == 0) tADSR_on(envs[k], 0.9f);
+            if (e == 1) tADSR_setAttack(envs[k], 5.0f);
+            if (e == 2) tADSR_setDecay(envs[k], 90.0f);
+            if (e == 3) tADSR_off(envs[k]);
+            if (e == 4) tADSR_setRelease(envs[k], 15.0f);
+            if (e == 5) tADSR_setSampleRate(envs[k], 44100.0f);
+        }
+        for (int i = events[e]; i < events[e + 1]; i++)
+        {
+            expected[i] = tADSR_tick(table);
+            out[i] = tADSR_tickRecursive(recursive);
+        }
+        for (int i = events[e], n = 1; i < events[e + 1]; i += n, n = n * 3 % 61 + 1)
+        {
+            if (n > events[e + 1] - i) n = events[e + 1] - i;
+            tADSR_renderBlock(block, &outBlock[i], n);
+        }
+    }
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        REQUIRE(fabsf(out[i] - expected[i]) < 5e-3f);
+        REQUIRE(outBlock[i] == out[i]);
+    }
+    REQUIRE(expected[numSamples - 1] == 0.0f);
+    REQUIRE(out[numSamples - 1] == 0.0f);
+
+    REQUIRE_NOTHROW(tADSR_free(&table));
+    REQUIRE_NOTHROW(tADSR_free(&recursive));
+    REQUIRE_NOTHROW(tADSR_free(&block));
+}
@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
 #include "../leaf/Inc/leaf-filters.h"
 #include "../leaf/leaf.h"
 #include "../leaf/Inc/leaf-math.h"
@@ -365,6 +366,68 @@ tVZFilter* filter11;
     REQUIRE_NOTHROW(tVZFilter_free(&filter11));
 }
 
+static void applyVZSetter(tVZFilter* f, int which, float r1, float r2, float r3)
+{
+    switch (which)
+    {
+        case 0: tVZFilter_setFreq(f, 40.0f + r1 * 12000.0f); break;
+        case 1: tVZFilter_setBandwidth(f, 0.1f + r1 * 4.0f); break;
+        case 2: tVZFilter_setResonance(f, 0.3f + r1 * 8.0f); break;
+        case 3: tVZFilter_setGain(f, 0.1f + r1 * 4.0f); break;
+        case 4: tVZFilter_setMorph(f, r1); break;
+        case 5: tVZFilter_setFreqAndBandwidth(f, 40.0f + r1 * 12000.0f, 0.1f + r2 * 4.0f); break;
+        case 6: tVZFilter_setFrequencyAndResonance(f, 40.0f + r1 * 12000.0f, 0.3f + r2 * 8.0f); break;
+        case 7: tVZFilter_setFrequencyAndResonanceAndGain(f, 40.0f + r1 * 12000.0f, 0.3f + r2 * 8.0f, 0.1f + r3 * 4.0f); break;
+        case 8: tVZFilter_setFrequencyAndBandwidthAndGain(f, 40.0f + r1 * 12000.0f, 0.1f + r2 * 4.0f, 0.1f + r3 * 4.0f); break;
+        default: tVZFilter_setType(f, (VZFilterType) (int) (r1 * 10.99f)); break;
+    }
+}
+
+TEST_CASE("Tests for `tVZFilter` lazy coefficients", "[tVZFilter]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Any run of setters between ticks gives the same output whether the coefficients are
+    // worked out by each setter or once by the next tick. One sample blocks have nothing to
+    // interpolate across, so they behave as lazy.
+    for (int type = 0; type <= Morph; type++)
+    {
+        tVZFilter* immediate;
+        tVZFilter* lazy;
+        tVZFilter* interpolated;
+        tVZFilter_init(&immediate, (VZFilterType) type, 1000.0f, 1.0f, &leaf);
+        tVZFilter_init(&lazy, (VZFilterType) type, 1000.0f, 1.0f, &leaf);
+        tVZFilter_init(&interpolated, (VZFilterType) type, 1000.0f, 1.0f, &leaf);
+        tVZFilter_setCoeffMode(lazy, LEAFCoeffsLazy);
+        tVZFilter_setCoeffMode(interpolated, LEAFCoeffsInterpolated);
+
+        for (int i = 0; i < 4000; i++)
+        {
+            int numSetters = rand() % 4;
+            for (int s = 0; s < numSetters; s++)
+            {
+                // Mostly setters that keep the type, so each type gets a real workout
+                int which = rand() % ((i % 500 == 0) ? 10 : 9);
+                float r1 = myrand(), r2 = myrand(), r3 = myrand();
+                applyVZSetter(immediate, which, r1, r2, r3);
+                applyVZSetter(lazy, which, r1, r2, r3);
+                applyVZSetter(interpolated, which, r1, r2, r3);
+            }
+            float x = myrand() * 2.0f - 1.0f, y;
+            float expected = tVZFilter_tick(immediate, x);
+            REQUIRE(tVZFilter_tick(lazy, x) == expected);
+            tVZFilter_tickBlock(interpolated, &x, &y, 1);
+            REQUIRE(y == expected);
+        }
+
+        REQUIRE_NOTHROW(tVZFilter_free(&immediate));
+        REQUIRE_NOTHROW(tVZFilter_free(&lazy));
+        REQUIRE_NOTHROW(tVZFilter_free(&interpolated));
+    }
+}
+
 TEST_CASE("Tests for `tVZFilterLS` filer", "[tVZFilterLS]") {
 
     LEAF leaf;
@@ -454,4 +517,59 @@ tTiltFilter* filter;
 
     REQUIRE(filter != nullptr);
     REQUIRE_NOTHROW(tTiltFilter_free(&filter));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tests for `tMedianFilter` filer", "[tMedianFilter]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Odd and even windows against sorting the last size inputs, which start out as zeros
+    const int sizes[4] = { 1, 4, 7, 64 };
+    for (int s = 0; s < 4; s++)
+    {
+        const int size = sizes[s];
+        tMedianFilter* filter;
+        tMedianFilter_init(&filter, size, &leaf);
+
+        float input[600];
+        for (int i = 0; i < 600; i++) input[i] = myrand() * 2.0f - 1.0f;
+        // Runs of repeated values
+        for (int i = 300; i < 340; i++) input[i] = 0.25f;
+
+        float window[64];
+        for (int i = 0; i < 600; i++)
+        {
+            for (int k = 0; k < size; k++)
+                window[k] = (i - k >= 0) ? input[i - k] : 0.0f;
+            std::nth_element(window, window + size / 2, window + size);
+
+            REQUIRE(tMedianFilter_tick(filter, input[i]) == window[size / 2]);
+        }
+
+        REQUIRE_NOTHROW(tMedianFilter_free(&filter));
+    }
+}
+
+TEST_CASE("Tests for `tMedianFilter` block processing", "[tMedianFilter]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tMedianFilter* tick;
+    tMedianFilter* block;
+    tMedianFilter_init(&tick, 9, &leaf);
+    tMedianFilter_init(&block, 9, &leaf);
+
+    float input[256], output[256];
+    for (int i = 0; i < 256; i++) input[i] = myrand();
+
+    tMedianFilter_tickBlock(block, input, output, 100);
+    tMedianFilter_tickBlock(block, &input[100], &output[100], 156);
+    for (int i = 0; i < 256; i++) REQUIRE(output[i] == tMedianFilter_tick(tick, input[i]));
+
+    REQUIRE_NOTHROW(tMedianFilter_free(&tick));
+    REQUIRE_NOTHROW(tMedianFilter_free(&block));
+}
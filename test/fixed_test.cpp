@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-fixed.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+TEST_CASE("Tests for Q31 conversions and arithmetic", "[fixed]") {
+
+    REQUIRE(LEAF_floatToQ31(0.0f) == 0);
+    REQUIRE(LEAF_floatToQ31(0.5f) == 0x40000000);
+    REQUIRE(LEAF_floatToQ31(-1.0f) == INT32_MIN);
+    REQUIRE(LEAF_floatToQ31(2.0f) == INT32_MAX);
+    REQUIRE(LEAF_floatToQ31(-2.0f) == INT32_MIN);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        float x = myrand() * 2.0f - 1.0f;
+        REQUIRE(fabsf(LEAF_q31ToFloat(LEAF_floatToQ31(x)) - x) < 1e-7f);
+        REQUIRE(fabsf(LEAF_q15ToFloat(LEAF_floatToQ15(x)) - x) < 1e-4f);
+    }
+
+    // Add and subtract saturate instead of wrapping
+    REQUIRE(LEAF_q31Add(INT32_MAX, 1) == INT32_MAX);
+    REQUIRE(LEAF_q31Sub(INT32_MIN, 1) == INT32_MIN);
+    REQUIRE(LEAF_q31Mul(LEAF_floatToQ31(0.5f), LEAF_floatToQ31(0.5f)) == LEAF_floatToQ31(0.25f));
+    REQUIRE(LEAF_q31Mul(INT32_MIN, INT32_MIN) == INT32_MAX);
+}
+
+TEST_CASE("Tests for `tPhasorQ31`", "[tPhasorQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tPhasorQ31* phasor;
+    tPhasorQ31_init(&phasor, &leaf);
+    tPhasorQ31_setFreq(phasor, 440.0f);
+
+    for (int i = 0; i < 4800; i++)
+    {
+        double expected = fmod(440.0 * (i + 1) / 48000.0, 1.0);
+        double error = fabs(LEAF_q31ToFloat(tPhasorQ31_tick(phasor)) - expected);
+        REQUIRE(fmin(error, 1.0 - error) < 1e-5);
+    }
+
+    REQUIRE_NOTHROW(tPhasorQ31_free(&phasor));
+}
+
+TEST_CASE("Tests for `tCycleQ31`", "[tCycleQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tCycleQ31* osc;
+    tCycleQ31_init(&osc, &leaf);
+    tCycleQ31_setFreq(osc, 440.0f);
+
+    for (int i = 0; i < 4800; i++)
+    {
+        double expected = sin(TWO_PI * 440.0 * (i + 1) / 48000.0);
+        REQUIRE(fabs(LEAF_q31ToFloat(tCycleQ31_tick(osc)) - expected) < 1e-4);
+    }
+
+    REQUIRE_NOTHROW(tCycleQ31_free(&osc));
+}
+
+TEST_CASE("Tests for `tPBSawQ31`", "[tPBSawQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tPBSaw* saw;
+    tPBSaw_init(&saw, &leaf);
+    tPBSaw_setFreq(saw, 440.0f);
+
+    tPBSawQ31* sawQ31;
+    tPBSawQ31_init(&sawQ31, &leaf);
+    tPBSawQ31_setFreq(sawQ31, 440.0f);
+
+    for (int i = 0; i < 4800; i++)
+        REQUIRE(fabsf(LEAF_q31ToFloat(tPBSawQ31_tick(sawQ31)) - tPBSaw_tick(saw)) < 1e-3f);
+
+    REQUIRE_NOTHROW(tPBSaw_free(&saw));
+    REQUIRE_NOTHROW(tPBSawQ31_free(&sawQ31));
+}
+
+TEST_CASE("Tests for `tOnePoleQ31`", "[tOnePoleQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tOnePole* filter;
+    tOnePole_init(&filter, 1000.0f, &leaf);
+
+    tOnePoleQ31* filterQ31;
+    tOnePoleQ31_init(&filterQ31, 1000.0f, &leaf);
+
+    for (int i = 0; i < 4800; i++)
+    {
+        float x = myrand() - 0.5f;
+        REQUIRE(fabsf(LEAF_q31ToFloat(tOnePoleQ31_tick(filterQ31, LEAF_floatToQ31(x))) - tOnePole_tick(filter, x)) < 1e-6f);
+    }
+
+    REQUIRE_NOTHROW(tOnePole_free(&filter));
+    REQUIRE_NOTHROW(tOnePoleQ31_free(&filterQ31));
+}
+
+TEST_CASE("Tests for `tSVFQ31`", "[tSVFQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    const SVFType types[5] = { SVFTypeLowpass, SVFTypeHighpass, SVFTypeBandpass, SVFTypeNotch, SVFTypePeak };
+    for (int t = 0; t < 5; t++)
+    {
+        tSVF* filter;
+        tSVF_init(&filter, types[t], 1000.0f, 2.0f, &leaf);
+
+        tSVFQ31* filterQ31;
+        tSVFQ31_init(&filterQ31, types[t], 1000.0f, 2.0f, &leaf);
+
+        for (int i = 0; i < 4800; i++)
+        {
+            float x = (myrand() - 0.5f) * 0.5f;
+            REQUIRE(fabsf(LEAF_q31ToFloat(tSVFQ31_tick(filterQ31, LEAF_floatToQ31(x))) - tSVF_tick(filter, x)) < 1e-5f);
+        }
+
+        REQUIRE_NOTHROW(tSVF_free(&filter));
+        REQUIRE_NOTHROW(tSVFQ31_free(&filterQ31));
+    }
+}
+
+TEST_CASE("Tests for `tBiQuadQ31`", "[tBiQuadQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tBiQuad* filter;
+    tBiQuad_init(&filter, &leaf);
+    tBiQuad_setCoefficients(filter, 0.2f, 0.4f, 0.2f, -0.6f, 0.2f);
+
+    tBiQuadQ31* filterQ31;
+    tBiQuadQ31_init(&filterQ31, &leaf);
+    tBiQuadQ31_setCoefficients(filterQ31, 0.2f, 0.4f, 0.2f, -0.6f, 0.2f);
+
+    for (int i = 0; i < 4800; i++)
+    {
+        float x = myrand() - 0.5f;
+        REQUIRE(fabsf(LEAF_q31ToFloat(tBiQuadQ31_tick(filterQ31, LEAF_floatToQ31(x))) - tBiQuad_tick(filter, x)) < 1e-6f);
+    }
+
+    REQUIRE_NOTHROW(tBiQuad_free(&filter));
+    REQUIRE_NOTHROW(tBiQuadQ31_free(&filterQ31));
+}
+
+TEST_CASE("Tests for `tDelayQ31`", "[tDelayQ31]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tDelayQ31* delay;
+    tDelayQ31_init(&delay, 10, 64, &leaf);
+
+    Lq31 input[200];
+    for (int i = 0; i < 200; i++)
+    {
+        input[i] = LEAF_floatToQ31(myrand() * 2.0f - 1.0f);
+        REQUIRE(tDelayQ31_tick(delay, input[i]) == (i >= 10 ? input[i - 10] : 0));
+    }
+
+    REQUIRE_NOTHROW(tDelayQ31_free(&delay));
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include "../leaf/Inc/leaf-kernels.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+static double lerpReference(const float* buf, int mask, double p)
+{
+    int w = (int) p;
+    double f = p - w;
+    int j = w & mask;
+    return buf[j] + f * (buf[j + 1] - buf[j]);
+}
+
+TEST_CASE("Tests for `LEAFKernels`", "[LEAFKernels]") {
+
+    float a[67], b[67];
+    unsigned int bitsA[68], bitsB[68];
+    for (int i = 0; i < 67; i++)
+    {
+        a[i] = myrand() * 2.0f - 1.0f;
+        b[i] = myrand() * 2.0f - 1.0f;
+    }
+    for (int i = 0; i < 68; i++)
+    {
+        bitsA[i] = (unsigned int) rand() * 2654435761u;
+        bitsB[i] = (unsigned int) rand() * 2246822519u;
+    }
+
+    // The plain C versions, the SSE2 versions and the widest ones this CPU has
+    const uint32_t featureSets[3] = { 0, LEAF_CPU_SSE2 & LEAF_detectCPUFeatures(), LEAF_detectCPUFeatures() };
+    for (int f = 0; f < 3; f++)
+    {
+        LEAFKernels k;
+        LEAF_bindKernels(&k, featureSets[f]);
+
+        for (int n = 0; n <= 67; n += 3)
+        {
+            double expected = 0.0, magnitude = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                expected += (double) a[i] * b[i];
+                magnitude += fabs((double) a[i] * b[i]);
+            }
+            REQUIRE(fabs(k.dot(a, b, n) - expected) <= 1e-6 * (magnitude + 1.0));
+
+            int count = 0;
+            for (int i = 0; i < n; i++)
+                for (int bit = 0; bit < 32; bit++)
+                    count += ((bitsA[i] ^ bitsB[i]) >> bit) & 1u;
+            REQUIRE(k.xorPopcount(bitsA, bitsB, n) == count);
+
+            // b read as one long bitstream, bit 0 of b[0] first
+            for (int shift = 1; shift < 32; shift += 6)
+            {
+                count = 0;
+                for (int j = 0; j < n * 32; j++)
+                {
+                    int s = j + shift;
+                    unsigned int bitB = (bitsB[s / 32] >> (s % 32)) & 1u;
+                    unsigned int bitA = (bitsA[j / 32] >> (j % 32)) & 1u;
+                    count += (int) (bitA ^ bitB);
+                }
+                REQUIRE(k.xorPopcountShifted(bitsA, bitsB, n, shift) == count);
+            }
+        }
+    }
+}
+
+TEST_CASE("Tests for `LEAFKernels` ramp reads", "[LEAFKernels]") {
+
+    float buf[257];
+    for (int i = 0; i < 256; i++) buf[i] = myrand() * 2.0f - 1.0f;
+    buf[256] = buf[0];
+
+    LEAFKernels scalar;
+    LEAF_bindKernels(&scalar, 0);
+
+    // The vector versions match the plain C ones and a double reference, tails included
+    const uint32_t featureSets[3] = { 0, LEAF_CPU_SSE2 & LEAF_detectCPUFeatures(), LEAF_detectCPUFeatures() };
+    for (int f = 0; f < 3; f++)
+    {
+        LEAFKernels k;
+        LEAF_bindKernels(&k, featureSets[f]);
+
+        for (int n = 0; n <= 67; n += 3)
+        {
+            float out[67], outScalar[67];
+            for (int i = 0; i < 67; i++) out[i] = outScalar[i] = (float) i;
+            k.lerpRampAdd(out, buf, 255, 300.25f, 0.77f, n);
+            scalar.lerpRampAdd(outScalar, buf, 255, 300.25f, 0.77f, n);
+            for (int i = 0; i < 67; i++)
+            {
+                REQUIRE(out[i] == outScalar[i]);
+                if (i < n) REQUIRE(fabs(out[i] - (i + lerpReference(buf, 255, 300.25 + i * 0.77))) < 1e-4);
+                else REQUIRE(out[i] == (float) i);
+            }
+
+            for (int i = 0; i < 67; i++) out[i] = outScalar[i] = 0.0f;
+            k.lerpRampCrossfadeAdd(out, buf, 255, 520.5f, 1.25f, 100.125f, 1.0f, 0.015f, n);
+            scalar.lerpRampCrossfadeAdd(outScalar, buf, 255, 520.5f, 1.25f, 100.125f, 1.0f, 0.015f, n);
+            for (int i = 0; i < n; i++)
+            {
+                double p = 520.5 + i * 1.25;
+                double g = 1.0 - i * 0.015;
+                double expected = lerpReference(buf, 255, p) * (1.0 - g) + lerpReference(buf, 255, p - 100.125) * g;
+                REQUIRE(fabsf(out[i] - outScalar[i]) < 1e-6f);
+                REQUIRE(fabs(out[i] - expected) < 1e-4);
+            }
+        }
+    }
+}
+
+TEST_CASE("Tests for `LEAF_setCPUFeatures` on existing objects", "[LEAFKernels]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+    leaf.clearOnAllocation = 1;
+
+    tOversampler* vector;
+    tOversampler* scalar;
+    tOversampler_init(&vector, 8, 0, &leaf);
+    tOversampler_init(&scalar, 8, 0, &leaf);
+
+    // Objects pick up the narrower table, and it gives the same result up to rounding
+    float up[8], upScalar[8];
+    const uint32_t features = LEAF_getCPUFeatures(&leaf);
+    for (int i = 0; i < 500; i++)
+    {
+        float x = myrand() * 2.0f - 1.0f;
+
+        LEAF_setCPUFeatures(&leaf, features);
+        tOversampler_upsample(vector, x, up);
+        float y = tOversampler_downsample(vector, up);
+
+        LEAF_setCPUFeatures(&leaf, 0);
+        tOversampler_upsample(scalar, x, upScalar);
+        float yScalar = tOversampler_downsample(scalar, upScalar);
+
+        for (int j = 0; j < 8; j++) REQUIRE(fabsf(up[j] - upScalar[j]) < 1e-5f);
+        REQUIRE(fabsf(y - yScalar) < 1e-5f);
+    }
+    REQUIRE(LEAF_getCPUFeatures(&leaf) == 0);
+
+    REQUIRE_NOTHROW(tOversampler_free(&vector));
+    REQUIRE_NOTHROW(tOversampler_free(&scalar));
+}
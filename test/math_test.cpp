@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include <float.h>
+#include "../leaf/Inc/leaf-math.h"
+#include "../leaf/leaf.h"
+
+// Kept out of the compiler's reach so the arithmetic runs under the thread's floating point mode
+static volatile float denormal = FLT_MIN * 0.25f;
+static volatile float one = 1.0f;
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define HAS_FP_STATE 1
+static int flushesDenormals(uint32_t state) { return (state & 0x8040) != 0; } // FTZ and DAZ in MXCSR
+#elif defined(__aarch64__)
+#define HAS_FP_STATE 1
+static int flushesDenormals(uint32_t state) { return (state & (1u << 24)) != 0; } // FZ in FPCR
+#else
+#define HAS_FP_STATE 0
+#endif
+
+TEST_CASE("Tests for `LEAF_flushDenormal`", "[LEAF_flushDenormal]") {
+
+#if !LEAF_NO_DENORMAL_CHECK
+    // Everything below FLT_MIN is denormal, including the values just under it
+    REQUIRE(LEAF_flushDenormal(nextafterf(FLT_MIN, 0.0f)) == 0.0f);
+    REQUIRE(LEAF_flushDenormal(-nextafterf(FLT_MIN, 0.0f)) == 0.0f);
+    REQUIRE(LEAF_flushDenormal(denormal) == 0.0f);
+    REQUIRE(LEAF_flushDenormal(FLT_MIN) == FLT_MIN);
+    REQUIRE(LEAF_flushDenormal(-FLT_MIN) == -FLT_MIN);
+#endif
+    REQUIRE(LEAF_flushDenormal(0.5f) == 0.5f);
+    REQUIRE(LEAF_flushDenormal(0.0f) == 0.0f);
+}
+
+TEST_CASE("Tests for `LEAF_enableFlushToZero`", "[LEAF_enableFlushToZero]") {
+
+    const uint32_t before = LEAF_getFloatingPointState();
+
+    uint32_t previous = LEAF_enableFlushToZero();
+    REQUIRE(previous == before);
+#if HAS_FP_STATE
+    // Denormal results and denormal inputs both read as zero
+    REQUIRE(flushesDenormals(LEAF_getFloatingPointState()));
+    REQUIRE(denormal * one == 0.0f);
+    REQUIRE(FLT_MIN * 0.5f * one == 0.0f);
+#endif
+
+    // Calling it again returns the flushing state, and restoring that changes nothing
+    uint32_t flushing = LEAF_enableFlushToZero();
+    REQUIRE(flushing == LEAF_getFloatingPointState());
+    LEAF_setFloatingPointState(flushing);
+    REQUIRE(LEAF_getFloatingPointState() == flushing);
+
+    // The state it returned brings back gradual underflow
+    LEAF_setFloatingPointState(previous);
+    REQUIRE(LEAF_getFloatingPointState() == before);
+#if HAS_FP_STATE
+    if (!flushesDenormals(before)) REQUIRE(denormal * one == FLT_MIN * 0.25f);
+#endif
+}
+
+TEST_CASE("Tests for `LEAF_interpolateBlock`", "[LEAF_interpolateBlock]") {
+
+    // The line starts one step after from and ends exactly on to
+    Lfloat out[8];
+    LEAF_interpolateBlock(out, 4, 0.0f, 1.0f);
+    REQUIRE(out[0] == 0.25f);
+    REQUIRE(out[1] == 0.5f);
+    REQUIRE(out[2] == 0.75f);
+    REQUIRE(out[3] == 1.0f);
+
+    LEAF_interpolateBlock(out, 1, 3.0f, -2.0f);
+    REQUIRE(out[0] == -2.0f);
+
+    LEAF_interpolateBlock(out, 8, 0.1f, 0.3f);
+    for (int i = 0; i < 7; i++) REQUIRE(fabsf(out[i] - (0.1f + 0.025f * (float) (i + 1))) < 1e-7f);
+    REQUIRE(out[7] == 0.3f);
+}
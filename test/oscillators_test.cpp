@@ -396,6 +396,122 @@ tSineTriLFO* osc;
     REQUIRE_NOTHROW(tSineTriLFO_free(&osc));
 }
 
+// Power in the harmonics of the bin and everywhere else, over one exactly periodic window
+static void harmonicAndAliasPower(const float* x, int n, int bin, double* harmonic, double* alias)
+{
+    *harmonic = 0.0;
+    *alias = 0.0;
+    for (int k = 1; k <= n / 2; k++)
+    {
+        double re = 0.0, im = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            re += x[i] * cos(TWO_PI * (double) k * i / n);
+            im -= x[i] * sin(TWO_PI * (double) k * i / n);
+        }
+        if (k % bin == 0) *harmonic += re * re + im * im;
+        else *alias += re * re + im * im;
+    }
+}
+
+static float naiveWave(int shape, float phase)
+{
+    if (shape == 0) return 2.0f * phase - 1.0f;
+    if (shape == 1) return phase < 0.5f ? 1.0f : -1.0f;
+    return phase < 0.5f ? 4.0f * phase - 1.0f : 3.0f - 4.0f * phase;
+}
+
+TEST_CASE("Tests for MinBLEP oscillators aliasing", "[tMBSaw][tMBPulse][tMBTriangle]") {
+
+    LEAF leaf;
+    static char leafMemory[200000];
+    LEAF_init(&leaf, 48000.f, leafMemory, 200000, &myrand);
+    leaf.clearOnAllocation = 1;
+
+    // Frequencies on exact DFT bins, so harmonics land on multiples of the bin and
+    // anything else is aliasing. The MinBLEP versions must alias far less than the
+    // same waveforms stepped sample by sample.
+    const int n = 4096;
+    static float band[4096], naive[4096];
+    const int bins[2] = { 200, 520 };
+    for (int b = 0; b < 2; b++)
+    {
+        const float freq = 48000.0f * bins[b] / n;
+        tMBSaw* saw;
+        tMBPulse* pulse;
+        tMBTriangle* triangle;
+        tMBSaw_init(&saw, &leaf);
+        tMBPulse_init(&pulse, &leaf);
+        tMBTriangle_init(&triangle, &leaf);
+        tMBSaw_setFreq(saw, freq);
+        tMBPulse_setFreq(pulse, freq);
+        tMBTriangle_setFreq(triangle, freq);
+        for (int i = 0; i < 2000; i++)
+        {
+            tMBSaw_tick(saw);
+            tMBPulse_tick(pulse);
+            tMBTriangle_tick(triangle);
+        }
+
+        for (int shape = 0; shape < 3; shape++)
+        {
+            float phase = 0.0f;
+            for (int i = 0; i < n; i++)
+            {
+                if (shape == 0) band[i] = tMBSaw_tick(saw);
+                else if (shape == 1) band[i] = tMBPulse_tick(pulse);
+                else band[i] = tMBTriangle_tick(triangle);
+                naive[i] = naiveWave(shape, phase);
+                phase += (float) bins[b] / n;
+                if (phase >= 1.0f) phase -= 1.0f;
+            }
+
+            double harmonic, alias, naiveHarmonic, naiveAlias;
+            harmonicAndAliasPower(band, n, bins[b], &harmonic, &alias);
+            harmonicAndAliasPower(naive, n, bins[b], &naiveHarmonic, &naiveAlias);
+            // The triangle's slope corners alias less to begin with
+            const double margin = (shape == 2) ? 0.01 : 0.001;
+            REQUIRE(harmonic > 0.01 * naiveHarmonic);
+            REQUIRE(alias / harmonic < margin * (naiveAlias / naiveHarmonic));
+        }
+
+        REQUIRE_NOTHROW(tMBSaw_free(&saw));
+        REQUIRE_NOTHROW(tMBPulse_free(&pulse));
+        REQUIRE_NOTHROW(tMBTriangle_free(&triangle));
+    }
+}
+
+TEST_CASE("Tests for MinBLEP oscillators under dense discontinuities", "[tMBSaw]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+    leaf.clearOnAllocation = 1;
+
+    // Near Nyquist with hard sync there are dozens of steps inside one residual
+    // length. The output stays bounded and its level doesn't drift as they pile up.
+    tMBSaw* master;
+    tMBSaw* slave;
+    tMBSaw_init(&master, &leaf);
+    tMBSaw_init(&slave, &leaf);
+    tMBSaw_setFreq(master, 5000.0f);
+    tMBSaw_setFreq(slave, 19000.0f);
+
+    double sums[2] = { 0.0, 0.0 };
+    for (int i = 0; i < 48000; i++)
+    {
+        tMBSaw_sync(slave, tMBSaw_tick(master));
+        float y = tMBSaw_tick(slave);
+        REQUIRE(isfinite(y));
+        REQUIRE(fabsf(y) < 2.0f);
+        sums[i / 24000] += y;
+    }
+    REQUIRE(fabs(sums[0] - sums[1]) / 24000.0 < 0.01);
+
+    REQUIRE_NOTHROW(tMBSaw_free(&master));
+    REQUIRE_NOTHROW(tMBSaw_free(&slave));
+}
+
 // TEST_CASE("Tests for `tDampedOscillator` object", "[tDampedOscillator]") {
 //
 //    LEAF leaf;
@@ -408,3 +524,79 @@ tSineTriLFO* osc;
 //    REQUIRE(osc != nullptr);
 //    REQUIRE_NOTHROW(tDampedOscillator_free(&osc));
 //}
+
+TEST_CASE("Tests for `tTriLFO` and `tSineTriLFO` control rate", "[tTriLFO]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 48000.f, leafMemory, 65535, &myrand);
+
+    tTriLFO* tri[3];
+    tSineTriLFO* sineTri[3];
+    for (int k = 0; k < 3; k++)
+    {
+        tTriLFO_init(&tri[k], &leaf);
+        tSineTriLFO_init(&sineTri[k], &leaf);
+        tSineTriLFO_setShape(sineTri[k], 0.3f);
+    }
+    // Audio rate, one sample per tick through tickBlock, and eight samples per tick
+    tTriLFO_setSamplesPerTick(tri[1], 5);
+    tTriLFO_setSamplesPerTick(tri[1], 1);
+    tTriLFO_setSamplesPerTick(tri[2], 8);
+    tSineTriLFO_setSamplesPerTick(sineTri[1], 5);
+    tSineTriLFO_setSamplesPerTick(sineTri[1], 1);
+    tSineTriLFO_setSamplesPerTick(sineTri[2], 8);
+
+    Lfloat expectedTri[64], expectedSineTri[64], out[64];
+    Lfloat lastTri = 0.0f, lastSineTri = 0.0f;
+    for (int b = 0; b < 300; b++)
+    {
+        if (b % 50 == 0)
+        {
+            Lfloat freq = 0.5f + myrand() * 20.0f;
+            for (int k = 0; k < 3; k++)
+            {
+                tTriLFO_setFreq(tri[k], freq);
+                tSineTriLFO_setFreq(sineTri[k], freq);
+            }
+        }
+
+        for (int i = 0; i < 64; i++)
+        {
+            expectedTri[i] = tTriLFO_tick(tri[0]);
+            expectedSineTri[i] = tSineTriLFO_tick(sineTri[0]);
+        }
+
+        tTriLFO_tickBlock(tri[1], out, 64);
+        for (int i = 0; i < 64; i++) REQUIRE(out[i] == expectedTri[i]);
+        tSineTriLFO_tickBlock(sineTri[1], out, 64);
+        for (int i = 0; i < 64; i++) REQUIRE(out[i] == expectedSineTri[i]);
+
+        // Each tick lands where the audio rate LFO is at the end of it, with straight lines in between
+        tTriLFO_tickBlock(tri[2], out, 64);
+        for (int i = 0; i < 64; i++)
+        {
+            Lfloat to = out[(i / 8) * 8 + 7];
+            Lfloat from = (i < 8) ? lastTri : out[(i / 8) * 8 - 1];
+            REQUIRE(fabsf(out[i] - (from + (to - from) * (Lfloat) (i % 8 + 1) / 8.0f)) < 1e-6f);
+            if (i % 8 == 7) REQUIRE(fabsf(out[i] - expectedTri[i]) < 1e-4f);
+        }
+        lastTri = out[63];
+
+        tSineTriLFO_tickBlock(sineTri[2], out, 64);
+        for (int i = 0; i < 64; i++)
+        {
+            Lfloat to = out[(i / 8) * 8 + 7];
+            Lfloat from = (i < 8) ? lastSineTri : out[(i / 8) * 8 - 1];
+            REQUIRE(fabsf(out[i] - (from + (to - from) * (Lfloat) (i % 8 + 1) / 8.0f)) < 1e-6f);
+            if (i % 8 == 7) REQUIRE(fabsf(out[i] - expectedSineTri[i]) < 1e-3f);
+        }
+        lastSineTri = out[63];
+    }
+
+    for (int k = 0; k < 3; k++)
+    {
+        REQUIRE_NOTHROW(tTriLFO_free(&tri[k]));
+        REQUIRE_NOTHROW(tSineTriLFO_free(&sineTri[k]));
+    }
+}
@@ -0,0 +1,206 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../leaf/Inc/leaf-parallel.h"
+#include "../leaf/leaf.h"
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+typedef struct
+{
+    float input[256];
+    float output[256];
+    int runs[256];
+} JobData;
+
+static float jobValue(float x, int job)
+{
+    float y = x;
+    for (int i = 0; i < 64; i++) y = y * 0.99f + (float) ((job * 31 + i) % 7) * 0.01f;
+    return y;
+}
+
+static void valueJob(void* context, int job)
+{
+    JobData* data = (JobData*) context;
+    data->output[job] = jobValue(data->input[job], job);
+    data->runs[job]++;
+}
+
+TEST_CASE("Tests for `tJobPool`", "[tJobPool]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tJobPool* pool;
+    tJobPool_init(&pool, 3, &leaf);
+    REQUIRE(pool != nullptr);
+    REQUIRE(tJobPool_getNumWorkers(pool) == (LEAF_USE_THREADS ? 3 : 0));
+
+    static JobData data;
+    for (int i = 0; i < 256; i++) data.input[i] = myrand();
+
+    // Batches of every size run each job exactly once and match a serial run
+    for (int numJobs = 0; numJobs <= 256; numJobs += 37)
+    {
+        for (int i = 0; i < 256; i++) { data.output[i] = -1.0f; data.runs[i] = 0; }
+
+        REQUIRE(tJobPool_run(pool, valueJob, &data, numJobs, 0.0f) == 0);
+
+        for (int i = 0; i < numJobs; i++)
+        {
+            REQUIRE(data.runs[i] == 1);
+            REQUIRE(data.output[i] == jobValue(data.input[i], i));
+        }
+        for (int i = numJobs; i < 256; i++) REQUIRE(data.runs[i] == 0);
+    }
+
+    REQUIRE_NOTHROW(tJobPool_free(&pool));
+}
+
+static void renderRamp(void* userData, Lfloat* output, int numSamples)
+{
+    float* level = (float*) userData;
+    for (int i = 0; i < numSamples; i++) output[i] = *level * (float) i;
+}
+
+TEST_CASE("Tests for `tVoiceScheduler`", "[tVoiceScheduler]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tVoiceScheduler* scheduler;
+    tVoiceScheduler_init(&scheduler, 4, 2, 64, &leaf);
+
+    float levels[4] = { 1.0f, 0.5f, 0.25f, 0.125f };
+    for (int v = 0; v < 4; v++)
+    {
+        tVoiceScheduler_setVoice(scheduler, v, renderRamp, &levels[v]);
+        tVoiceScheduler_setVoiceActive(scheduler, v, 1);
+    }
+    tVoiceScheduler_setVoiceActive(scheduler, 2, 0);
+
+    // The mix is the sum of the active voices only
+    Lfloat output[64];
+    tVoiceScheduler_render(scheduler, output, 64);
+    for (int i = 0; i < 64; i++) REQUIRE(output[i] == (1.0f + 0.5f + 0.125f) * (float) i);
+    for (int i = 0; i < 64; i++) REQUIRE(tVoiceScheduler_getVoiceBuffer(scheduler, 1)[i] == 0.5f * (float) i);
+
+    REQUIRE_NOTHROW(tVoiceScheduler_free(&scheduler));
+}
+
+typedef struct
+{
+    tCycle* cycles[2];
+    tSVF* filters[2];
+} GraphObjects;
+
+static void initGraphObjects(GraphObjects* objects, LEAF* leaf)
+{
+    tCycle_init(&objects->cycles[0], leaf);
+    tCycle_init(&objects->cycles[1], leaf);
+    tCycle_setFreq(objects->cycles[0], 220.0f);
+    tCycle_setFreq(objects->cycles[1], 331.0f);
+    tSVF_init(&objects->filters[0], SVFTypeLowpass, 800.0f, 0.7f, leaf);
+    tSVF_init(&objects->filters[1], SVFTypeBandpass, 1200.0f, 2.0f, leaf);
+}
+
+static void freeGraphObjects(GraphObjects* objects)
+{
+    tCycle_free(&objects->cycles[0]);
+    tCycle_free(&objects->cycles[1]);
+    tSVF_free(&objects->filters[0]);
+    tSVF_free(&objects->filters[1]);
+}
+
+static Lfloat mixValue(Lfloat a, Lfloat b)
+{
+    return a * 0.5f + b * 0.25f;
+}
+
+static void mixNode(void* object, Lfloat** inputs, Lfloat** outputs, int numSamples)
+{
+    (void) object;
+    for (int i = 0; i < numSamples; i++) outputs[0][i] = mixValue(inputs[0][i], inputs[1][i]);
+}
+
+TEST_CASE("Tests for `tGraph` node checks", "[tGraph]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tGraph* graph;
+    tGraph_init(&graph, 2, 4, 0, 1, 16, 0, &leaf);
+
+    // Nodes without a function or with too many ports are rejected and take no slot
+    REQUIRE(tGraph_addNode(graph, NULL, 1, 1, NULL) == -1);
+    REQUIRE(tGraph_addGenerator(graph, NULL, NULL) == -1);
+    REQUIRE(tGraph_addProcessor(graph, NULL, NULL) == -1);
+    REQUIRE(tGraph_addNode(graph, NULL, LEAF_GRAPH_MAX_PORTS + 1, 1, mixNode) == -1);
+    REQUIRE(tGraph_addNode(graph, NULL, 2, 1, mixNode) == 0);
+    REQUIRE(tGraph_addNode(graph, NULL, 2, 1, mixNode) == 1);
+    REQUIRE(tGraph_addNode(graph, NULL, 2, 1, mixNode) == -1);
+
+    REQUIRE_NOTHROW(tGraph_free(&graph));
+}
+
+TEST_CASE("Tests for `tGraph` against ticking by hand", "[tGraph]") {
+
+    LEAF leaf;
+    static char leafMemory[500000];
+    LEAF_init(&leaf, 44100.f, leafMemory, 500000, &myrand);
+    leaf.clearOnAllocation = 1;
+
+    // Serially and with worker threads, the compiled graph gives exactly what
+    // ticking the same objects in the same order by hand does
+    for (int numWorkers = 0; numWorkers <= 3; numWorkers += 3)
+    {
+        GraphObjects graphed, reference;
+        initGraphObjects(&graphed, &leaf);
+        initGraphObjects(&reference, &leaf);
+
+        tGraph* graph;
+        tGraph_init(&graph, 8, 16, 1, 2, 64, numWorkers, &leaf);
+
+        int lowpass = tGraph_addProcessor(graph, graphed.filters[0], (tGraphTickInFunction) tSVF_tick);
+        int cycleA = tGraph_addGenerator(graph, graphed.cycles[0], (tGraphTickFunction) tCycle_tick);
+        int cycleB = tGraph_addGenerator(graph, graphed.cycles[1], (tGraphTickFunction) tCycle_tick);
+        int bandpass = tGraph_addProcessor(graph, graphed.filters[1], (tGraphTickInFunction) tSVF_tick);
+        int mix = tGraph_addNode(graph, NULL, 2, 1, mixNode);
+
+        REQUIRE(tGraph_connect(graph, LEAF_GRAPH_IO, 0, lowpass, 0) >= 0);
+        REQUIRE(tGraph_connect(graph, cycleA, 0, bandpass, 0) >= 0);
+        REQUIRE(tGraph_connect(graph, cycleB, 0, bandpass, 0) >= 0);
+        REQUIRE(tGraph_connect(graph, lowpass, 0, mix, 0) >= 0);
+        REQUIRE(tGraph_connect(graph, bandpass, 0, mix, 1) >= 0);
+        REQUIRE(tGraph_connect(graph, mix, 0, LEAF_GRAPH_IO, 0) >= 0);
+        REQUIRE(tGraph_connect(graph, lowpass, 0, LEAF_GRAPH_IO, 0) >= 0);
+        REQUIRE(tGraph_connect(graph, bandpass, 0, LEAF_GRAPH_IO, 1) >= 0);
+        REQUIRE(tGraph_compile(graph) > 0);
+
+        Lfloat input[64], output0[64], output1[64];
+        Lfloat* inputs[1] = { input };
+        Lfloat* outputs[2] = { output0, output1 };
+        for (int block = 0; block < 40; block++)
+        {
+            int numSamples = 64 - (block % 5) * 7;
+            for (int i = 0; i < numSamples; i++) input[i] = myrand() * 2.0f - 1.0f;
+            tGraph_process(graph, inputs, outputs, numSamples);
+
+            for (int i = 0; i < numSamples; i++)
+            {
+                Lfloat low = tSVF_tick(reference.filters[0], input[i]);
+                Lfloat a = tCycle_tick(reference.cycles[0]);
+                Lfloat b = tCycle_tick(reference.cycles[1]);
+                Lfloat band = tSVF_tick(reference.filters[1], a + b);
+                REQUIRE(output0[i] == mixValue(low, band) + low);
+                REQUIRE(output1[i] == band);
+            }
+        }
+
+        REQUIRE_NOTHROW(tGraph_free(&graph));
+        freeGraphObjects(&graphed);
+        freeGraphObjects(&reference);
+    }
+}
@@ -0,0 +1,288 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "../leaf/Inc/leaf-sampling.h"
+#include "../leaf/leaf.h"
+
+#if LEAF_USE_FILE_STREAMING
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+TEST_CASE("Tests for `tBuffer` integer formats", "[tBuffer]") {
+
+    LEAF leaf;
+    static char leafMemory[500000];
+    LEAF_init(&leaf, 44100.f, leafMemory, 500000, &myrand);
+
+    const BufferFormat formats[2] = { BufferInt16, BufferInt24 };
+    const float ranges[2] = { 32768.0f, 8388608.0f };
+    static Lfloat input[65536];
+    for (int f = 0; f < 2; f++)
+    {
+        tBuffer* buffer;
+        tBuffer_initWithFormat(&buffer, 65536, formats[f], &leaf);
+
+        // Every stored 16-bit code, and a spread of 24-bit ones, read back and
+        // write again unchanged
+        const int step = (f == 0) ? 1 : 256;
+        for (int i = 0; i < 65536; i++) input[i] = (float) (i * step - 65536 / 2 * step) / ranges[f];
+        tBuffer_read(buffer, input, 65536);
+        for (int i = 0; i < 65536; i++) REQUIRE(tBuffer_get(buffer, i) == input[i]);
+
+        // Any value in range comes back within half a step, and full scale clips
+        // to the largest code on either side
+        for (int i = 0; i < 65536; i++) input[i] = myrand() * 2.0f - 1.0f;
+        input[0] = 1.0f;
+        input[1] = 2.0f;
+        input[2] = -2.0f;
+        tBuffer_read(buffer, input, 65536);
+        REQUIRE(tBuffer_get(buffer, 0) == (ranges[f] - 1.0f) / ranges[f]);
+        REQUIRE(tBuffer_get(buffer, 1) == (ranges[f] - 1.0f) / ranges[f]);
+        REQUIRE(tBuffer_get(buffer, 2) == -1.0f);
+        for (int i = 3; i < 65536; i++)
+        {
+            if (input[i] < (ranges[f] - 1.0f) / ranges[f]) REQUIRE(fabsf(tBuffer_get(buffer, i) - input[i]) <= 0.5f / ranges[f]);
+        }
+
+        REQUIRE_NOTHROW(tBuffer_free(&buffer));
+    }
+}
+
+#if LEAF_USE_FILE_STREAMING
+
+static void putLE(unsigned char* p, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) p[i] = (unsigned char) (v >> (8 * i));
+}
+
+// Writes a canonical 44-byte header WAV file to a new temporary path
+static void writeWav(char* path, int format, int bits, int channels, int sampleRate, const void* data, uint32_t dataSize)
+{
+    unsigned char header[44];
+    memcpy(header, "RIFF", 4);
+    putLE(header + 4, 36 + dataSize, 4);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    putLE(header + 16, 16, 4);
+    putLE(header + 20, (uint32_t) format, 2);
+    putLE(header + 22, (uint32_t) channels, 2);
+    putLE(header + 24, (uint32_t) sampleRate, 4);
+    putLE(header + 28, (uint32_t) (sampleRate * channels * bits / 8), 4);
+    putLE(header + 32, (uint32_t) (channels * bits / 8), 2);
+    putLE(header + 34, (uint32_t) bits, 2);
+    memcpy(header + 36, "data", 4);
+    putLE(header + 40, dataSize, 4);
+
+    strcpy(path, "/tmp/leafStreamXXXXXX");
+    int fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    REQUIRE(write(fd, header, 44) == 44);
+    REQUIRE(write(fd, data, dataSize) == (ssize_t) dataSize);
+    close(fd);
+}
+
+TEST_CASE("Tests for `tBuffer_initFromFile`", "[tBuffer]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    int16_t samples[1000];
+    for (int i = 0; i < 1000; i++) samples[i] = (int16_t) ((i * 997) % 65536 - 32768);
+
+    char path[32];
+    writeWav(path, 1, 16, 1, 22050, samples, sizeof(samples));
+
+    // A 16-bit file is played in place, with the header's rate and the preload
+    // clamped to the file length
+    tBuffer* mapped;
+    REQUIRE(tBuffer_initFromFile(&mapped, path, 5000, &leaf) == 0);
+    REQUIRE(tBuffer_getFormat(mapped) == BufferInt16);
+    REQUIRE(tBuffer_getBufferLength(mapped) == 1000);
+    REQUIRE(tBuffer_getRecordedLength(mapped) == 1000);
+    REQUIRE(mapped->sampleRate == 22050);
+    REQUIRE(mapped->preloadLength == 1000);
+    for (int i = 0; i < 1000; i++) REQUIRE(tBuffer_get(mapped, i) == samples[i] / 32768.0f);
+
+    // The mapping is read-only, so recording and clearing leave it alone
+    tBuffer_record(mapped);
+    REQUIRE(tBuffer_isActive(mapped) == 0);
+    tBuffer_clear(mapped);
+    REQUIRE(tBuffer_get(mapped, 10) == samples[10] / 32768.0f);
+    REQUIRE(tBuffer_prefaultFile(mapped, 0) == 0);
+
+    // A sampler on the mapping plays exactly what it plays from the same data in memory
+    tBuffer* memory;
+    tBuffer_initWithFormat(&memory, 1000, BufferInt16, &leaf);
+    memcpy(memory->buff, samples, sizeof(samples));
+    tBuffer_setRecordedLength(memory, 1000);
+    memory->sampleRate = 22050;
+
+    tSampler* fromFile;
+    tSampler* fromMemory;
+    tSampler_init(&fromFile, &mapped, &leaf);
+    tSampler_init(&fromMemory, &memory, &leaf);
+    tSampler_setMode(fromFile, PlayLoop);
+    tSampler_setMode(fromMemory, PlayLoop);
+    tSampler_setRate(fromFile, 1.37f);
+    tSampler_setRate(fromMemory, 1.37f);
+    tSampler_play(fromFile);
+    tSampler_play(fromMemory);
+
+    // The streamer follows the playing voice without touching its output
+    tSampleStreamer* streamer;
+    tSampleStreamer_init(&streamer, 2, 256, &leaf);
+    tSampleStreamer_setVoice(streamer, 0, fromFile);
+    for (int i = 0; i < 3000; i++)
+    {
+        if (i % 64 == 0)
+        {
+            tSampleStreamer_update(streamer);
+            if (!LEAF_USE_THREADS) tSampleStreamer_process(streamer);
+        }
+        REQUIRE(tSampler_tick(fromFile) == tSampler_tick(fromMemory));
+    }
+    tSampleStreamer_setVoice(streamer, 0, NULL);
+    tSampleStreamer_update(streamer);
+    REQUIRE_NOTHROW(tSampleStreamer_free(&streamer));
+
+    REQUIRE_NOTHROW(tSampler_free(&fromFile));
+    REQUIRE_NOTHROW(tSampler_free(&fromMemory));
+    REQUIRE_NOTHROW(tBuffer_free(&mapped));
+    REQUIRE_NOTHROW(tBuffer_free(&memory));
+    remove(path);
+}
+
+TEST_CASE("Tests for `tBuffer_initFromFile` formats", "[tBuffer]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // 24-bit stereo counts frames, not samples, and reads back sign-extended
+    unsigned char packed[3 * 200];
+    for (int i = 0; i < 200; i++) putLE(&packed[3 * i], (uint32_t) (i * 41943 - 4194304), 3);
+
+    char path[32];
+    writeWav(path, 1, 24, 2, 48000, packed, sizeof(packed));
+    tBuffer* buffer;
+    REQUIRE(tBuffer_initFromFile(&buffer, path, 10, &leaf) == 0);
+    REQUIRE(tBuffer_getFormat(buffer) == BufferInt24);
+    REQUIRE(buffer->channels == 2);
+    REQUIRE(tBuffer_getBufferLength(buffer) == 100);
+    REQUIRE(buffer->preloadLength == 10);
+    for (int i = 0; i < 100; i++) REQUIRE(tBuffer_get(buffer, i) == (i * 41943 - 4194304) / 8388608.0f);
+    REQUIRE_NOTHROW(tBuffer_free(&buffer));
+    remove(path);
+
+    // A headerless file is mono float at the LEAF sample rate
+    float raw[300];
+    for (int i = 0; i < 300; i++) raw[i] = sinf((float) i * 0.1f);
+    strcpy(path, "/tmp/leafStreamXXXXXX");
+    int fd = mkstemp(path);
+    REQUIRE(write(fd, raw, sizeof(raw)) == (ssize_t) sizeof(raw));
+    close(fd);
+    REQUIRE(tBuffer_initFromFile(&buffer, path, 0, &leaf) == 0);
+    REQUIRE(tBuffer_getFormat(buffer) == BufferFloat);
+    REQUIRE(tBuffer_getBufferLength(buffer) == 300);
+    REQUIRE(buffer->sampleRate == 44100);
+    for (int i = 0; i < 300; i++) REQUIRE(tBuffer_get(buffer, i) == raw[i]);
+    REQUIRE_NOTHROW(tBuffer_free(&buffer));
+    remove(path);
+
+    // 8-bit PCM is refused, and so is a missing file, leaving an empty buffer
+    writeWav(path, 1, 8, 1, 44100, packed, 100);
+    REQUIRE(tBuffer_initFromFile(&buffer, path, 0, &leaf) == -1);
+    REQUIRE(tBuffer_getBufferLength(buffer) == 0);
+    REQUIRE(tBuffer_prefaultFile(buffer, 0) == -1);
+    REQUIRE_NOTHROW(tBuffer_free(&buffer));
+    remove(path);
+    REQUIRE(tBuffer_initFromFile(&buffer, path, 0, &leaf) == -1);
+    REQUIRE_NOTHROW(tBuffer_free(&buffer));
+}
+
+#else
+
+TEST_CASE("Tests for `tBuffer_initFromFile` without streaming", "[tBuffer]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Without LEAF_USE_FILE_STREAMING the buffer is left empty but usable
+    tBuffer* buffer;
+    REQUIRE(tBuffer_initFromFile(&buffer, "missing.wav", 100, &leaf) == -1);
+    REQUIRE(tBuffer_getBufferLength(buffer) == 0);
+    REQUIRE(tBuffer_get(buffer, 0) == 0.0f);
+    REQUIRE(tBuffer_prefaultFile(buffer, 0) == -1);
+    REQUIRE_NOTHROW(tBuffer_free(&buffer));
+}
+
+#endif
+
+TEST_CASE("Tests for `tSampler_tickBlock`", "[tSampler]") {
+
+    LEAF leaf;
+    static char leafMemory[200000];
+    LEAF_init(&leaf, 44100.f, leafMemory, 200000, &myrand);
+
+    tBuffer* buffer;
+    tBuffer_init(&buffer, 4000, &leaf);
+    static Lfloat data[4000];
+    for (int i = 0; i < 4000; i++) data[i] = sinf((float) i * 0.05f) + 0.3f * (myrand() * 2.0f - 1.0f);
+    tBuffer_read(buffer, data, 4000);
+
+    // Blocks of uneven size give what ticking gives, through loop points, crossfades,
+    // bounces, reversals, start and end moves, and rate changes between blocks
+    const PlayMode modes[3] = { PlayNormal, PlayLoop, PlayBackAndForth };
+    for (int m = 0; m < 3; m++)
+    {
+        for (int crossfade = 0; crossfade <= 300; crossfade += 300)
+        {
+            srand(m * 7 + crossfade);
+            tSampler* tick;
+            tSampler* block;
+            tSampler_init(&tick, &buffer, &leaf);
+            tSampler_init(&block, &buffer, &leaf);
+            tSampler* both[2] = { tick, block };
+            for (int s = 0; s < 2; s++)
+            {
+                tSampler_setMode(both[s], modes[m]);
+                tSampler_setCrossfadeLength(both[s], crossfade);
+                tSampler_setStart(both[s], 200);
+                tSampler_setEnd(both[s], 3500);
+                tSampler_play(both[s]);
+            }
+
+            Lfloat expected[128], output[128];
+            for (int round = 0; round < 400; round++)
+            {
+                int n = 1 + rand() % 128;
+                for (int i = 0; i < n; i++) expected[i] = tSampler_tick(tick);
+                tSampler_tickBlock(block, output, n);
+                for (int i = 0; i < n; i++) REQUIRE(output[i] == expected[i]);
+
+                float rate = (myrand() * 2.0f - 1.0f) * 3.0f;
+                int start = 100 + rand() % 1500;
+                int end = 2000 + rand() % 1800;
+                int action = rand() % 8;
+                for (int s = 0; s < 2; s++)
+                {
+                    if (action < 3) tSampler_setRate(both[s], rate);
+                    else if (action == 3) tSampler_setStart(both[s], start);
+                    else if (action == 4) tSampler_setEnd(both[s], end);
+                    else if (action == 5 && modes[m] == PlayNormal) tSampler_play(both[s]);
+                }
+            }
+
+            REQUIRE_NOTHROW(tSampler_free(&tick));
+            REQUIRE_NOTHROW(tSampler_free(&block));
+        }
+    }
+
+    REQUIRE_NOTHROW(tBuffer_free(&buffer));
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <math.h>
+#include <float.h>
+#include "../leaf/Inc/leaf-simdmath.h"
+#include "../leaf/leaf_polyvalues.h"
+#include "../leaf/leaf.h"
+
+typedef void (*SimdBlockFunction)(Lfloat* out, const Lfloat* in, int numSamples);
+typedef float (*ScalarFunction)(float x);
+typedef double (*ReferenceFunction)(double x);
+
+static double mtofReference(double m) { return 440.0 * exp2((m - 69.0) / 12.0); }
+static double dbtoaReference(double db) { return pow(10.0, db / 20.0); }
+static double atodbReference(double a) { return 20.0 * log10(a); }
+
+#define NUM_POINTS 200003
+
+// Inputs spread evenly, or evenly in log for the functions that take any positive float
+static void sweep(float* x, double lo, double hi, int logSpaced)
+{
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        double t = (double) i / (NUM_POINTS - 1);
+        x[i] = logSpaced ? (float) exp(log(lo) + t * (log(hi) - log(lo))) : (float) (lo + t * (hi - lo));
+    }
+}
+
+// Every point must be within the absolute or the relative bound, whichever is looser,
+// with 10% slack over the figures in leaf-simdmath.h
+static void requireWithin(const float* x, const float* y, ReferenceFunction reference, double absolute, double relative)
+{
+    double worst = 0.0;
+    for (int i = 0; i < NUM_POINTS; i++)
+    {
+        double expected = reference(x[i]);
+        double bound = fmax(absolute, relative * fabs(expected));
+        double error = fabs(y[i] - expected) / bound;
+        if (error > worst) worst = error;
+    }
+    REQUIRE(worst <= 1.1);
+}
+
+static void requireBlockWithin(SimdBlockFunction f, ReferenceFunction reference, double lo, double hi, int logSpaced,
+                               double absolute, double relative)
+{
+    static float x[NUM_POINTS], y[NUM_POINTS];
+    sweep(x, lo, hi, logSpaced);
+    // An odd count, so the remainder that does not fill a vector is covered too
+    f(y, x, NUM_POINTS);
+    requireWithin(x, y, reference, absolute, relative);
+}
+
+static void requireScalarWithin(ScalarFunction f, ReferenceFunction reference, double lo, double hi, int logSpaced,
+                                double absolute, double relative)
+{
+    static float x[NUM_POINTS], y[NUM_POINTS];
+    sweep(x, lo, hi, logSpaced);
+    for (int i = 0; i < NUM_POINTS; i++) y[i] = f(x[i]);
+    requireWithin(x, y, reference, absolute, relative);
+}
+
+TEST_CASE("Tests for `LEAF_vexpf` and the other SIMD kernels", "[simdmath]") {
+
+    requireBlockWithin(LEAF_exp2f_block, exp2, -126.0, 127.0, 0, 0.0, 1.0e-7);
+    requireBlockWithin(LEAF_expf_block, exp, -87.3, 88.0, 0, 0.0, 8.0e-8);
+    requireBlockWithin(LEAF_logf_block, log, FLT_MIN, FLT_MAX, 1, 0.0, 8.0e-8);
+    requireBlockWithin(LEAF_logf_block, log, 0.5, 2.0, 0, 3.9e-8, 8.0e-8);
+    requireBlockWithin(LEAF_log2f_block, log2, FLT_MIN, FLT_MAX, 1, 0.0, 1.3e-7);
+    requireBlockWithin(LEAF_log2f_block, log2, 0.5, 2.0, 0, 9.5e-8, 1.3e-7);
+    requireBlockWithin(LEAF_sinf_block, sin, -8192.0, 8192.0, 0, 7.7e-8, 0.0);
+    requireBlockWithin(LEAF_cosf_block, cos, -8192.0, 8192.0, 0, 7.7e-8, 0.0);
+    requireBlockWithin(LEAF_tanf_block, tan, -1.5707, 1.5707, 0, 0.0, 1.7e-7);
+    requireBlockWithin(LEAF_tanhf_block, tanh, -20.0, 20.0, 0, 7.6e-8, 1.4e-7);
+    requireBlockWithin(LEAF_mtof_block, mtofReference, 0.0, 135.0, 0, 0.0, 5.5e-7);
+    requireBlockWithin(LEAF_dbtoa_block, dbtoaReference, -120.0, 120.0, 0, 0.0, 7.7e-7);
+    requireBlockWithin(LEAF_atodb_block, atodbReference, FLT_MIN, FLT_MAX, 1, 0.0, 1.7e-7);
+    requireBlockWithin(LEAF_atodb_block, atodbReference, 0.5, 2.0, 0, 7.8e-7, 1.7e-7);
+
+    // powf's bound grows with the size of the exponent it ends up taking
+    double worst = 0.0;
+    for (int i = 0; i <= 2000; i++)
+    {
+        float b[LEAF_SIMD_WIDTH], y[LEAF_SIMD_WIDTH];
+        float a = (float) exp(log(1e-6) + i / 2000.0 * log(1e12));
+        for (int k = 0; k < LEAF_SIMD_WIDTH; k++) b[k] = -10.0f + (float) ((i * 7 + k * 13) % 200) * 0.1f;
+        LEAF_vstore(y, LEAF_vpowf(LEAF_vset1(a), LEAF_vload(b)));
+        for (int k = 0; k < LEAF_SIMD_WIDTH; k++)
+        {
+            double size = fabs(b[k] * log2(a));
+            if (size >= 125.0) continue;
+            double expected = pow(a, b[k]);
+            worst = fmax(worst, fabs(y[k] - expected) / (1.2e-7 * (1.0 + size) * expected));
+        }
+    }
+    REQUIRE(worst <= 1.1);
+}
+
+TEST_CASE("Tests for the SIMD kernels outside their ranges", "[simdmath]") {
+
+    // Out of range inputs saturate instead of giving inf or NaN, including in place
+    float x[7] = { -1000.0f, -200.0f, 0.0f, -1.0f, 200.0f, 1000.0f, FLT_MAX };
+    float y[7];
+    SimdBlockFunction functions[6] = { LEAF_exp2f_block, LEAF_expf_block, LEAF_logf_block,
+                                       LEAF_tanhf_block, LEAF_dbtoa_block, LEAF_atodb_block };
+    for (int f = 0; f < 6; f++)
+    {
+        functions[f](y, x, 7);
+        for (int i = 0; i < 7; i++) REQUIRE(isfinite(y[i]));
+    }
+    float inPlace[7];
+    for (int i = 0; i < 7; i++) inPlace[i] = x[i];
+    LEAF_expf_block(inPlace, inPlace, 7);
+    LEAF_expf_block(y, x, 7);
+    for (int i = 0; i < 7; i++) REQUIRE(inPlace[i] == y[i]);
+    REQUIRE(y[0] >= 0.0f);
+    REQUIRE(y[5] > 1e38f);
+}
+
+TEST_CASE("Tests for the cheap approximations behind LEAF_MATH_ACCURACY 2", "[simdmath]") {
+
+    requireScalarWithin(fastExp4, exp, -87.3, 88.0, 0, 0.0, 1.2e-5);
+    requireScalarWithin(fastexp2f, exp2, -126.0, 127.0, 0, 0.0, 3.5e-6);
+    requireScalarWithin(my_faster_logf, log, FLT_MIN, FLT_MAX, 1, 1.9e-5, 0.0);
+    requireScalarWithin(log2f_approx, log2, FLT_MIN, FLT_MAX, 1, 1.3e-3, 0.0);
+    requireScalarWithin(fast_tanh5, tanh, -20.0, 20.0, 0, 1.9e-3, 0.0);
+    requireScalarWithin(fast_mtof, mtofReference, 0.0, 135.0, 0, 0.0, 2.9e-2);
+    requireScalarWithin(fasterdbtoa, dbtoaReference, -60.0, 60.0, 0, 0.0, 9.0e-2);
+
+    double worst = 0.0;
+    for (int i = 0; i <= 1000; i++)
+    {
+        float a = (float) exp(log(0.01) + i / 1000.0 * log(1e4));
+        for (int j = 0; j <= 200; j++)
+        {
+            float b = -3.0f + j * 0.03f;
+            double expected = pow(a, b);
+            worst = fmax(worst, fabs(fastPowf(a, b) - expected) / expected);
+        }
+    }
+    REQUIRE(worst <= 0.15 * 1.1);
+}
+
+TEST_CASE("Tests for `poly_float`", "[poly_float]") {
+
+    float a[LEAF_POLY_WIDTH], b[LEAF_POLY_WIDTH], out[LEAF_POLY_WIDTH];
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++)
+    {
+        a[i] = ((float) rand() / RAND_MAX * 2.0f - 1.0f) * 4.0f;
+        b[i] = ((float) rand() / RAND_MAX * 2.0f - 1.0f) * 4.0f;
+    }
+    poly_float va = LEAF_poly_load(a);
+    poly_float vb = LEAF_poly_load(b);
+
+    // Every lane gets the scalar result for its own voice
+    LEAF_poly_store(out, va * vb + 1.0f);
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) REQUIRE(out[i] == a[i] * b[i] + 1.0f);
+    LEAF_poly_store(out, LEAF_poly_select(LEAF_POLY_MASK(va > vb), va, vb));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) REQUIRE(out[i] == fmaxf(a[i], b[i]));
+    LEAF_poly_store(out, LEAF_poly_clip(LEAF_poly_set1(-1.0f), va, LEAF_poly_set1(1.0f)));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) REQUIRE(out[i] == fminf(fmaxf(a[i], -1.0f), 1.0f));
+    LEAF_poly_store(out, LEAF_poly_floor(va));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) REQUIRE(out[i] == floorf(a[i]));
+    LEAF_poly_store(out, LEAF_poly_abs(va));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) REQUIRE(out[i] == fabsf(a[i]));
+    LEAF_poly_store(out, LEAF_poly_tanhf(va));
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) REQUIRE(out[i] == tanhf(a[i]));
+
+    float sum = 0.0f;
+    for (int i = 0; i < LEAF_POLY_WIDTH; i++) sum += a[i];
+    REQUIRE(LEAF_poly_sum(va) == sum);
+    REQUIRE(LEAF_poly_getLane(LEAF_poly_setLane(va, LEAF_POLY_WIDTH - 1, 7.0f), LEAF_POLY_WIDTH - 1) == 7.0f);
+
+    // Masks reduce to whether any or every voice needs something
+    REQUIRE(LEAF_poly_all(LEAF_POLY_MASK(LEAF_poly_abs(va) >= 0.0f)));
+    REQUIRE_FALSE(LEAF_poly_any(LEAF_POLY_MASK(LEAF_poly_abs(va) < 0.0f)));
+}